@@ -0,0 +1,863 @@
+/*******************************************************************************
+  MPLAB Harmony Application ECC Campaign Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_ecc_campaign.c
+
+  Summary:
+    ECC fault injection campaign.
+
+  Description:
+    One error is injected at a time. The injected word and its original data
+    are kept while the campaign waits for the ECC interrupt reporting it,
+    followed through the fault map callback. The outcome of each injection is
+    checked from the main loop, the original data is restored when the ECC
+    callbacks could not correct it and the next error is injected once the
+    profile period has elapsed.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include <stdio.h>
+#include "app_ecc_error.h"
+#include "app_ecc_fault_map.h"
+#include "app_ecc_campaign.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* CPU cycles per microsecond and per millisecond */
+#define APP_ECC_CAMPAIGN_CYCLES_PER_US     (CPU_CLOCK_FREQUENCY / 1000000U)
+#define APP_ECC_CAMPAIGN_CYCLES_PER_MS     (CPU_CLOCK_FREQUENCY / 1000U)
+
+/* Campaign states */
+typedef enum
+{
+    APP_ECC_CAMPAIGN_STATE_IDLE = 0,
+    APP_ECC_CAMPAIGN_STATE_PERIOD,
+    APP_ECC_CAMPAIGN_STATE_WAIT
+} app_ecc_campaign_state_t;
+
+/* Outcome of one injection */
+typedef enum
+{
+    APP_ECC_CAMPAIGN_RESULT_DETECTED = 0,
+    APP_ECC_CAMPAIGN_RESULT_MISSED,
+    APP_ECC_CAMPAIGN_RESULT_WRONG_TYPE,
+    APP_ECC_CAMPAIGN_RESULT_WRONG_DATA
+} app_ecc_campaign_result_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Campaign parameters */
+static app_ecc_campaign_profile_t campaignProfile;
+static const app_ecc_campaign_target_t* campaignTargets;
+static app_ecc_campaign_inject_t campaignInject;
+
+/* Campaign results */
+static app_ecc_campaign_report_t campaignReport;
+
+/* Campaign state, random generator state, sequential and hot spot positions */
+static app_ecc_campaign_state_t campaignState;
+static uint32_t campaignRandom;
+static uint32_t campaignCursor[APP_MEMORY_REGION_NUM];
+static uint32_t campaignHotspot[APP_MEMORY_REGION_NUM];
+
+/* Time of the last state change and cycles elapsed since the start */
+static uint32_t campaignLastCall;
+static uint64_t campaignCycles;
+static uint32_t campaignStateStart;
+
+/* Injection in progress : region, word index, type, ECC word address and original data */
+static app_memory_region_t pendingRegion;
+static uint32_t pendingIndex;
+static app_error_type_t pendingType;
+static uint32_t pendingAddress;
+static uint32_t pendingData[2];
+
+/* Set by the fault map callback when the injected address is reported */
+static volatile bool pendingArmed;
+static volatile bool pendingDetected;
+static volatile app_ecc_fault_type_t pendingFault;
+static volatile uint32_t pendingCycles;
+
+/* Number of mismatching injections printed */
+static uint32_t campaignPrinted;
+
+/* Result names for output print */
+static const char* const campaignResultString[] = { "detected", "missed", "wrong type", "wrong data" };
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_ECC_CAMPAIGN_random(void)
+
+   Summary:
+    Get the next pseudo random number of the campaign.
+
+   Parameters:
+    None.
+
+   Returns:
+    32-bit xorshift value.
+*/
+static uint32_t APP_ECC_CAMPAIGN_random(void)
+{
+    uint32_t x = campaignRandom;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    campaignRandom = x;
+    return x;
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_ECC_CAMPAIGN_random_below(uint32_t range)
+
+   Summary:
+    Get a pseudo random number lower than range.
+
+   Parameters:
+    range - upper bound, not 0.
+
+   Returns:
+    Value from 0 to range - 1.
+*/
+static uint32_t APP_ECC_CAMPAIGN_random_below(uint32_t range)
+{
+    return (uint32_t)(((uint64_t)APP_ECC_CAMPAIGN_random() * range) >> 32);
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ECC_CAMPAIGN_FaultCallback(app_memory_region_t region, uint32_t address,
+                                               app_ecc_fault_type_t type, uintptr_t context)
+
+   Summary:
+    Fault map callback.
+
+   Description:
+    Runs in the ECC interrupt context. The first fault reported at the
+    injected address completes the detection, any other fault is counted as
+    unexpected.
+
+   Parameters:
+    region - memory region of the fault.
+    address - ECC word address.
+    type - fixable or not fixable fault.
+    context - not used.
+
+   Returns:
+    None.
+*/
+static void APP_ECC_CAMPAIGN_FaultCallback(app_memory_region_t region, uint32_t address,
+                                           app_ecc_fault_type_t type, uintptr_t context)
+{
+    (void)context;
+
+    if ( ( pendingArmed == true ) && ( pendingDetected == false ) &&
+         ( region == pendingRegion ) && ( address == pendingAddress ) )
+    {
+        pendingCycles = DWT->CYCCNT;
+        pendingFault = type;
+        pendingDetected = true;
+    }
+    else
+    {
+        campaignReport.unexpected++;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_ECC_CAMPAIGN_advance(void)
+
+   Summary:
+    Accumulate the cycles elapsed since the last call.
+
+   Parameters:
+    None.
+
+   Returns:
+    Current DWT cycle count.
+*/
+static uint32_t APP_ECC_CAMPAIGN_advance(void)
+{
+    uint32_t now = DWT->CYCCNT;
+
+    campaignCycles += (uint32_t)(now - campaignLastCall);
+    campaignLastCall = now;
+    return now;
+}
+
+// *****************************************************************************
+/* Function:
+    static volatile uint32_t* APP_ECC_CAMPAIGN_word(void)
+
+   Summary:
+    Get the first word of the ECC word of the injection in progress.
+
+   Parameters:
+    None.
+
+   Returns:
+    Pointer to the word, 8 bytes aligned in ITCM.
+*/
+static volatile uint32_t* APP_ECC_CAMPAIGN_word(void)
+{
+    return (volatile uint32_t *)pendingAddress;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ECC_CAMPAIGN_sync(bool clean)
+
+   Summary:
+    Make the next CPU access to the injected word reach the memory.
+
+   Parameters:
+    clean - true to write the cached data back before invalidating it.
+
+   Returns:
+    None.
+*/
+static void APP_ECC_CAMPAIGN_sync(bool clean)
+{
+    if ( ( pendingRegion >= APP_MEMORY_REGION_INTERNAL_SRAM ) && ( DATA_CACHE_IS_ENABLED() != 0U ) )
+    {
+        if ( clean == true )
+        {
+            DCACHE_CLEAN_INVALIDATE_BY_ADDR((uint32_t *)pendingAddress, (int32_t)(2U * sizeof(uint32_t)));
+        }
+        else
+        {
+            DCACHE_INVALIDATE_BY_ADDR((uint32_t *)pendingAddress, (int32_t)(2U * sizeof(uint32_t)));
+        }
+    }
+    __DSB();
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ECC_CAMPAIGN_restore(void)
+
+   Summary:
+    Write the original data of the injected ECC word back.
+
+   Description:
+    A plain write of the whole ECC word stores new check bits and clears an
+    uncorrected error. ITCM ECC words are written with one 64-bit store.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ECC_CAMPAIGN_restore(void)
+{
+    if ( pendingRegion == APP_MEMORY_REGION_ITCM )
+    {
+        *(volatile uint64_t *)pendingAddress = ((uint64_t)pendingData[1] << 32) | pendingData[0];
+    }
+    else
+    {
+        *APP_ECC_CAMPAIGN_word() = pendingData[0];
+    }
+    APP_ECC_CAMPAIGN_sync(true);
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ECC_CAMPAIGN_inject(void)
+
+   Summary:
+    Pick and inject the next error.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ECC_CAMPAIGN_inject(void)
+{
+    const app_ecc_campaign_target_t* target;
+    uint32_t weightSum = 0U;
+    uint32_t pick;
+    uint32_t region;
+    uint32_t index;
+
+    for (region = 0U; region < APP_MEMORY_REGION_NUM; region++)
+    {
+        weightSum += campaignProfile.region_weight[region];
+    }
+    pick = APP_ECC_CAMPAIGN_random_below(weightSum);
+    for (region = 0U; region < (APP_MEMORY_REGION_NUM - 1U); region++)
+    {
+        if ( pick < campaignProfile.region_weight[region] )
+        {
+            break;
+        }
+        pick -= campaignProfile.region_weight[region];
+    }
+    target = &campaignTargets[region];
+
+    switch ( campaignProfile.address )
+    {
+        case APP_ECC_CAMPAIGN_ADDRESS_SEQUENTIAL:
+            index = campaignCursor[region];
+            campaignCursor[region] = ((index + 1U) < target->words) ? (index + 1U) : 0U;
+            break;
+        case APP_ECC_CAMPAIGN_ADDRESS_HOTSPOT:
+            index = campaignHotspot[region] + APP_ECC_CAMPAIGN_random_below(campaignProfile.hotspot_words);
+            break;
+        default:
+            index = APP_ECC_CAMPAIGN_random_below(target->words);
+            break;
+    }
+
+    pendingRegion = (app_memory_region_t)region;
+    pendingIndex = index;
+    pendingType = ( APP_ECC_CAMPAIGN_random_below(100U) < campaignProfile.unfixable_percent ) ?
+                  APP_ERROR_TYPE_UNFIXABLE : APP_ERROR_TYPE_FIXABLE;
+
+    /* Keep the original content of the ECC word */
+    pendingAddress = (uint32_t)&target->buffer[index];
+    pendingAddress &= ( pendingRegion == APP_MEMORY_REGION_ITCM ) ? ~0x7UL : ~0x3UL;
+    APP_ECC_CAMPAIGN_sync(true);
+    pendingData[0] = APP_ECC_CAMPAIGN_word()[0];
+    pendingData[1] = ( pendingRegion == APP_MEMORY_REGION_ITCM ) ? APP_ECC_CAMPAIGN_word()[1] : 0U;
+
+    pendingDetected = false;
+    pendingArmed = true;
+    campaignReport.region[region].injected[pendingType]++;
+
+    campaignInject(pendingRegion, pendingIndex, pendingType);
+
+    campaignStateStart = APP_ECC_CAMPAIGN_advance();
+    if ( campaignProfile.detect == APP_ECC_CAMPAIGN_DETECT_READ )
+    {
+        APP_ECC_CAMPAIGN_sync(false);
+        (void)APP_ECC_CAMPAIGN_word()[0];
+        __DSB();
+    }
+    campaignState = APP_ECC_CAMPAIGN_STATE_WAIT;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ECC_CAMPAIGN_complete(app_ecc_campaign_result_t result)
+
+   Summary:
+    Account the outcome of the injection in progress.
+
+   Parameters:
+    result - outcome of the injection.
+
+   Returns:
+    None.
+*/
+static void APP_ECC_CAMPAIGN_complete(app_ecc_campaign_result_t result)
+{
+    app_ecc_campaign_region_t* stats = &campaignReport.region[pendingRegion];
+
+    pendingArmed = false;
+
+    switch ( result )
+    {
+        case APP_ECC_CAMPAIGN_RESULT_MISSED:
+            stats->missed++;
+            break;
+        case APP_ECC_CAMPAIGN_RESULT_WRONG_TYPE:
+            stats->wrong_type++;
+            break;
+        case APP_ECC_CAMPAIGN_RESULT_WRONG_DATA:
+            stats->wrong_data++;
+            break;
+        default:
+            break;
+    }
+
+    if ( ( result != APP_ECC_CAMPAIGN_RESULT_DETECTED ) &&
+         ( campaignPrinted < APP_ECC_CAMPAIGN_PRINT_MISMATCH_MAX ) )
+    {
+        printf("  ECC campaign injection %u : %s error in %s at 0x%08x %s\n\r",
+                (unsigned int)campaignReport.done,
+                ( pendingType == APP_ERROR_TYPE_FIXABLE ) ? "fixable" : "not fixable",
+                g_memoryRegionString[pendingRegion],
+                (unsigned int)pendingAddress,
+                campaignResultString[result]);
+        campaignPrinted++;
+    }
+
+    campaignReport.done++;
+    if ( campaignReport.done >= campaignProfile.injection_num )
+    {
+        APP_ECC_CAMPAIGN_stop();
+    }
+    else
+    {
+        campaignState = APP_ECC_CAMPAIGN_STATE_PERIOD;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ECC_CAMPAIGN_check(void)
+
+   Summary:
+    Check the injection in progress once its interrupt was reported.
+
+   Description:
+    The latency is recorded for errors reported by the interrupt of their
+    type. A fixable error must read back with its original data after the
+    fix callback. The original data is written back in all other cases.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ECC_CAMPAIGN_check(void)
+{
+    app_ecc_campaign_region_t* stats = &campaignReport.region[pendingRegion];
+    app_ecc_fault_type_t expected = ( pendingType == APP_ERROR_TYPE_FIXABLE ) ? APP_ECC_FAULT_FIX : APP_ECC_FAULT_NOFIX;
+    app_ecc_campaign_result_t result = APP_ECC_CAMPAIGN_RESULT_DETECTED;
+    int32_t latency = (int32_t)(pendingCycles - campaignStateStart);
+    uint32_t us;
+    uint32_t bin = 0U;
+
+    if ( pendingFault != expected )
+    {
+        APP_ECC_CAMPAIGN_restore();
+        APP_ECC_CAMPAIGN_complete(APP_ECC_CAMPAIGN_RESULT_WRONG_TYPE);
+        return;
+    }
+
+    /* The read of a detection by READ may complete after the interrupt */
+    if ( latency < 0 )
+    {
+        latency = 0;
+    }
+    stats->detected[pendingType]++;
+    stats->latency_sum += (uint32_t)latency;
+    if ( (uint32_t)latency < stats->latency_min )
+    {
+        stats->latency_min = (uint32_t)latency;
+    }
+    if ( (uint32_t)latency > stats->latency_max )
+    {
+        stats->latency_max = (uint32_t)latency;
+    }
+    us = (uint32_t)latency / APP_ECC_CAMPAIGN_CYCLES_PER_US;
+    if ( us != 0U )
+    {
+        bin = 32U - __CLZ(us);
+        if ( bin >= APP_ECC_CAMPAIGN_HISTOGRAM_BINS )
+        {
+            bin = APP_ECC_CAMPAIGN_HISTOGRAM_BINS - 1U;
+        }
+    }
+    stats->histogram[bin]++;
+
+    if ( pendingType == APP_ERROR_TYPE_FIXABLE )
+    {
+        bool corrected;
+
+        APP_ECC_CAMPAIGN_sync(false);
+        corrected = ( APP_ECC_CAMPAIGN_word()[0] == pendingData[0] );
+        if ( pendingRegion == APP_MEMORY_REGION_ITCM )
+        {
+            corrected = corrected && ( APP_ECC_CAMPAIGN_word()[1] == pendingData[1] );
+        }
+        if ( corrected == true )
+        {
+            stats->corrected++;
+        }
+        else
+        {
+            APP_ECC_CAMPAIGN_restore();
+            result = APP_ECC_CAMPAIGN_RESULT_WRONG_DATA;
+        }
+    }
+    else
+    {
+        /* The not fixable callback overwrites the data */
+        APP_ECC_CAMPAIGN_restore();
+    }
+
+    APP_ECC_CAMPAIGN_complete(result);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Initialization and State Machine Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool APP_ECC_CAMPAIGN_start(const app_ecc_campaign_profile_t* profile,
+                                const app_ecc_campaign_target_t* targets,
+                                app_ecc_campaign_inject_t inject)
+
+   Summary:
+    Start an ECC fault injection campaign.
+
+   Description:
+    This function checks the profile, clears the report and registers the
+    fault map callback. The first error is injected by the next call of
+    APP_ECC_CAMPAIGN_task.
+
+   Precondition:
+    APP_ECC_FAULT_MAP_init must have been called and the ECC interrupts
+    enabled. The buffers must have been written since power up.
+
+   Parameters:
+    profile - pointer to the campaign profile, copied.
+    targets - pointer to APP_MEMORY_REGION_NUM buffers, must remain valid
+              during the campaign.
+    inject - function injecting one error.
+
+   Returns:
+    true if the campaign is started, false if the profile is not valid.
+*/
+bool APP_ECC_CAMPAIGN_start(const app_ecc_campaign_profile_t* profile,
+                            const app_ecc_campaign_target_t* targets,
+                            app_ecc_campaign_inject_t inject)
+{
+    uint32_t weightSum = 0U;
+    uint32_t region;
+
+    if ( ( profile == NULL ) || ( targets == NULL ) || ( inject == NULL ) ||
+         ( profile->injection_num == 0U ) || ( profile->unfixable_percent > 100U ) ||
+         ( profile->period >= 0x80000000UL ) || ( profile->timeout >= 0x80000000UL ) )
+    {
+        return false;
+    }
+
+    for (region = 0U; region < APP_MEMORY_REGION_NUM; region++)
+    {
+        if ( profile->region_weight[region] == 0U )
+        {
+            continue;
+        }
+        if ( ( targets[region].buffer == NULL ) || ( targets[region].words < 2U ) ||
+             ( ( profile->address == APP_ECC_CAMPAIGN_ADDRESS_HOTSPOT ) &&
+               ( ( profile->hotspot_words == 0U ) || ( profile->hotspot_words > targets[region].words ) ) ) )
+        {
+            return false;
+        }
+        if ( ( region == APP_MEMORY_REGION_ITCM ) &&
+             ( ( ((uint32_t)targets[region].buffer & 0x7U) != 0U ) || ( (targets[region].words & 1U) != 0U ) ) )
+        {
+            return false;
+        }
+        weightSum += profile->region_weight[region];
+    }
+    if ( weightSum == 0U )
+    {
+        return false;
+    }
+
+    APP_ECC_CAMPAIGN_stop();
+
+    campaignProfile = *profile;
+    campaignTargets = targets;
+    campaignInject = inject;
+    campaignReport = (app_ecc_campaign_report_t){ 0 };
+    campaignReport.seed = profile->seed;
+    campaignPrinted = 0U;
+
+    /* xorshift state must not be 0 */
+    campaignRandom = ( profile->seed != 0U ) ? profile->seed : 0x9E3779B9UL;
+    for (region = 0U; region < APP_MEMORY_REGION_NUM; region++)
+    {
+        campaignReport.region[region].latency_min = UINT32_MAX;
+        campaignCursor[region] = 0U;
+        campaignHotspot[region] = 0U;
+        if ( ( profile->region_weight[region] != 0U ) && ( profile->address == APP_ECC_CAMPAIGN_ADDRESS_HOTSPOT ) )
+        {
+            campaignHotspot[region] = APP_ECC_CAMPAIGN_random_below(targets[region].words - profile->hotspot_words + 1U);
+        }
+    }
+
+    campaignLastCall = DWT->CYCCNT;
+    campaignCycles = 0U;
+    campaignStateStart = campaignLastCall - profile->period;
+    campaignReport.running = true;
+    campaignState = APP_ECC_CAMPAIGN_STATE_PERIOD;
+
+    APP_ECC_FAULT_MAP_callback_register(APP_ECC_CAMPAIGN_FaultCallback, (uintptr_t)NULL);
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_CAMPAIGN_stop(void)
+
+   Summary:
+    Stop the campaign.
+
+   Description:
+    The original data of an injection in progress is written back.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ECC_CAMPAIGN_stop(void)
+{
+    if ( campaignState == APP_ECC_CAMPAIGN_STATE_IDLE )
+    {
+        return;
+    }
+
+    APP_ECC_FAULT_MAP_callback_register(NULL, (uintptr_t)NULL);
+    if ( ( campaignState == APP_ECC_CAMPAIGN_STATE_WAIT ) && ( pendingArmed == true ) )
+    {
+        APP_ECC_CAMPAIGN_restore();
+    }
+    pendingArmed = false;
+
+    (void)APP_ECC_CAMPAIGN_advance();
+    campaignReport.elapsed_ms = (uint32_t)(campaignCycles / APP_ECC_CAMPAIGN_CYCLES_PER_MS);
+    campaignReport.running = false;
+    campaignState = APP_ECC_CAMPAIGN_STATE_IDLE;
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_ECC_CAMPAIGN_is_running(void)
+
+   Summary:
+    Get the campaign state.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    true while the campaign is running.
+*/
+bool APP_ECC_CAMPAIGN_is_running(void)
+{
+    return ( campaignState != APP_ECC_CAMPAIGN_STATE_IDLE );
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_CAMPAIGN_task(void)
+
+   Summary:
+    ECC campaign task.
+
+   Description:
+    This function checks the injection in progress and injects the next
+    error when the period has elapsed. It must be called from the main loop,
+    at least once every 2^31 CPU cycles.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ECC_CAMPAIGN_task(void)
+{
+    uint32_t now;
+
+    if ( campaignState == APP_ECC_CAMPAIGN_STATE_IDLE )
+    {
+        return;
+    }
+    now = APP_ECC_CAMPAIGN_advance();
+
+    if ( campaignState == APP_ECC_CAMPAIGN_STATE_WAIT )
+    {
+        if ( pendingDetected == true )
+        {
+            APP_ECC_CAMPAIGN_check();
+        }
+        else if ( (uint32_t)(now - campaignStateStart) > campaignProfile.timeout )
+        {
+            APP_ECC_CAMPAIGN_restore();
+            APP_ECC_CAMPAIGN_complete(APP_ECC_CAMPAIGN_RESULT_MISSED);
+        }
+        else
+        {
+            /* Wait for the interrupt */
+        }
+    }
+    else if ( (uint32_t)(now - campaignStateStart) >= campaignProfile.period )
+    {
+        APP_ECC_CAMPAIGN_inject();
+    }
+    else
+    {
+        /* Wait for the injection period */
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_CAMPAIGN_get_report(app_ecc_campaign_report_t* report)
+
+   Summary:
+    Get the campaign results.
+
+   Precondition:
+    None.
+
+   Parameters:
+    report - pointer to the structure filled with the results.
+
+   Returns:
+    None.
+*/
+void APP_ECC_CAMPAIGN_get_report(app_ecc_campaign_report_t* report)
+{
+    *report = campaignReport;
+    if ( campaignReport.running == true )
+    {
+        report->elapsed_ms = (uint32_t)(campaignCycles / APP_ECC_CAMPAIGN_CYCLES_PER_MS);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_CAMPAIGN_print_report(const app_ecc_campaign_report_t* report)
+
+   Summary:
+    Print the campaign results.
+
+   Description:
+    One line of counts and one line of latency histogram per region where
+    errors were injected. Latencies are printed in microseconds, histogram
+    bins are labelled with their upper bound.
+
+   Precondition:
+    None.
+
+   Parameters:
+    report - pointer to the results.
+
+   Returns:
+    None.
+*/
+void APP_ECC_CAMPAIGN_print_report(const app_ecc_campaign_report_t* report)
+{
+    uint32_t region;
+    uint32_t bin;
+
+    printf("ECC campaign : seed 0x%08x, %u injections in %u ms, %u unexpected interrupts\n\r",
+            (unsigned int)report->seed,
+            (unsigned int)report->done,
+            (unsigned int)report->elapsed_ms,
+            (unsigned int)report->unexpected);
+
+    for (region = 0U; region < APP_MEMORY_REGION_NUM; region++)
+    {
+        const app_ecc_campaign_region_t* stats = &report->region[region];
+        uint32_t detected = stats->detected[APP_ERROR_TYPE_FIXABLE] + stats->detected[APP_ERROR_TYPE_UNFIXABLE];
+
+        if ( ( stats->injected[APP_ERROR_TYPE_FIXABLE] + stats->injected[APP_ERROR_TYPE_UNFIXABLE] ) == 0U )
+        {
+            continue;
+        }
+
+        printf("  %-14s : FIX %u/%u (%u corrected), NOFIX %u/%u, missed %u, wrong type %u, wrong data %u\n\r",
+                g_memoryRegionString[region],
+                (unsigned int)stats->detected[APP_ERROR_TYPE_FIXABLE],
+                (unsigned int)stats->injected[APP_ERROR_TYPE_FIXABLE],
+                (unsigned int)stats->corrected,
+                (unsigned int)stats->detected[APP_ERROR_TYPE_UNFIXABLE],
+                (unsigned int)stats->injected[APP_ERROR_TYPE_UNFIXABLE],
+                (unsigned int)stats->missed,
+                (unsigned int)stats->wrong_type,
+                (unsigned int)stats->wrong_data);
+
+        if ( detected == 0U )
+        {
+            continue;
+        }
+        printf("  %-14s : latency min %u us, avg %u us, max %u us :",
+                "",
+                (unsigned int)(stats->latency_min / APP_ECC_CAMPAIGN_CYCLES_PER_US),
+                (unsigned int)((stats->latency_sum / detected) / APP_ECC_CAMPAIGN_CYCLES_PER_US),
+                (unsigned int)(stats->latency_max / APP_ECC_CAMPAIGN_CYCLES_PER_US));
+        for (bin = 0U; bin < APP_ECC_CAMPAIGN_HISTOGRAM_BINS; bin++)
+        {
+            if ( stats->histogram[bin] == 0U )
+            {
+                continue;
+            }
+            if ( bin == (APP_ECC_CAMPAIGN_HISTOGRAM_BINS - 1U) )
+            {
+                printf(" >=%u:%u", (unsigned int)(1UL << (bin - 1U)), (unsigned int)stats->histogram[bin]);
+            }
+            else
+            {
+                printf(" <%u:%u", (unsigned int)(1UL << bin), (unsigned int)stats->histogram[bin]);
+            }
+        }
+        printf("\n\r");
+    }
+}
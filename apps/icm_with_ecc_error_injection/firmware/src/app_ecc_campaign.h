@@ -0,0 +1,267 @@
+/*******************************************************************************
+  MPLAB Harmony Application ECC Campaign Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_ecc_campaign.h
+
+  Summary:
+    ECC fault injection campaign Prototypes and definitions file.
+
+  Description:
+    The campaign injects fixable and not fixable ECC errors in the memory
+    regions, following a seeded random profile, through the error injection
+    functions of the application. It checks that each error is reported by
+    the expected ECC interrupt at the injected address and that fixable
+    errors are corrected, and measures the detection latency.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_ECC_CAMPAIGN_H
+#define	APP_ECC_CAMPAIGN_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_ecc_error.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Number of bins of the latency histograms : bin 0 below 1 us, bin k from 2^(k-1) to 2^k us, last bin above */
+#define APP_ECC_CAMPAIGN_HISTOGRAM_BINS                           (16U)
+
+/* Maximum number of mismatching injections printed during a campaign */
+#define APP_ECC_CAMPAIGN_PRINT_MISMATCH_MAX                       (16U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application ECC campaign address distribution
+
+   Summary:
+    Selection of the injected word in a region buffer.
+
+   Description:
+    UNIFORM picks any word of the buffer, SEQUENTIAL walks the buffer one
+    word per injection, HOTSPOT picks any word of a window of hotspot_words
+    words placed at random in the buffer when the campaign starts.
+
+   Remarks:
+    None.
+*/
+typedef enum
+{
+    APP_ECC_CAMPAIGN_ADDRESS_UNIFORM = 0,
+    APP_ECC_CAMPAIGN_ADDRESS_SEQUENTIAL,
+    APP_ECC_CAMPAIGN_ADDRESS_HOTSPOT
+} app_ecc_campaign_address_t;
+
+// *****************************************************************************
+/* Application ECC campaign detection mode
+
+   Summary:
+    How an injected error is read back.
+
+   Description:
+    READ reads the injected word right after the injection, the latency is
+    the one of the ECC interrupt and its callback. BACKGROUND lets the ICM
+    and ECC scrubbers or the application find the error, the latency is the
+    one of the software fault tolerance mechanisms.
+
+   Remarks:
+    None.
+*/
+typedef enum
+{
+    APP_ECC_CAMPAIGN_DETECT_READ = 0,
+    APP_ECC_CAMPAIGN_DETECT_BACKGROUND
+} app_ecc_campaign_detect_t;
+
+// *****************************************************************************
+/* Application ECC campaign injection function
+
+   Summary:
+    Injects one error of a type at a word of a region buffer.
+
+   Description:
+    The function must use the APP_ECC_INJECT_*_initialize_error and
+    APP_ECC_INJECT_*_generate_error functions of the region, with the
+    scrubbers suspended.
+
+   Remarks:
+    None.
+*/
+typedef void (*app_ecc_campaign_inject_t)(app_memory_region_t region, uint32_t index, app_error_type_t type);
+
+// *****************************************************************************
+/* Application ECC campaign target
+
+   Summary:
+    Buffer of a region where errors are injected.
+
+   Description:
+    words is the number of 32-bit words of the buffer. The buffer of the
+    ITCM region must be 8 bytes aligned and hold an even number of words.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t* buffer;
+    uint32_t words;
+} app_ecc_campaign_target_t;
+
+// *****************************************************************************
+/* Application ECC campaign profile
+
+   Summary:
+    Campaign parameters.
+
+   Description:
+    The same seed and profile give the same sequence of injections. Regions
+    are picked in proportion to region_weight, 0 excludes a region, and
+    unfixable_percent of the injections are not fixable errors. One error is
+    injected at a time, no sooner than period CPU cycles after the previous
+    one, and is counted as missed when no interrupt reports it within timeout
+    CPU cycles.
+
+   Remarks:
+    period and timeout must be lower than 2^31 cycles.
+*/
+typedef struct
+{
+    uint32_t seed;
+    uint32_t injection_num;
+    uint8_t region_weight[APP_MEMORY_REGION_NUM];
+    uint8_t unfixable_percent;
+    app_ecc_campaign_address_t address;
+    uint32_t hotspot_words;
+    app_ecc_campaign_detect_t detect;
+    uint32_t period;
+    uint32_t timeout;
+} app_ecc_campaign_profile_t;
+
+// *****************************************************************************
+/* Application ECC campaign region results
+
+   Summary:
+    Results of the injections in one region.
+
+   Description:
+    injected and detected are counted per error type. An injection is
+    detected when the interrupt of its type reports its address, wrong_type
+    counts the ones reported by the interrupt of the other type and missed
+    the ones not reported before the timeout. corrected counts the fixable
+    errors read back with their original data after the fix callback,
+    wrong_data the ones read back with other data. Latencies are in CPU
+    cycles from the end of the injection to the interrupt callback.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t injected[2];
+    uint32_t detected[2];
+    uint32_t corrected;
+    uint32_t missed;
+    uint32_t wrong_type;
+    uint32_t wrong_data;
+    uint32_t latency_min;
+    uint32_t latency_max;
+    uint64_t latency_sum;
+    uint32_t histogram[APP_ECC_CAMPAIGN_HISTOGRAM_BINS];
+} app_ecc_campaign_region_t;
+
+// *****************************************************************************
+/* Application ECC campaign report
+
+   Summary:
+    Results of the campaign.
+
+   Description:
+    done is the number of injections completed. unexpected counts the ECC
+    interrupts reported during the campaign at an address not injected.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    bool running;
+    uint32_t seed;
+    uint32_t done;
+    uint32_t unexpected;
+    uint32_t elapsed_ms;
+    app_ecc_campaign_region_t region[APP_MEMORY_REGION_NUM];
+} app_ecc_campaign_report_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool APP_ECC_CAMPAIGN_start(const app_ecc_campaign_profile_t* profile,
+                            const app_ecc_campaign_target_t* targets,
+                            app_ecc_campaign_inject_t inject);
+
+void APP_ECC_CAMPAIGN_stop(void);
+
+bool APP_ECC_CAMPAIGN_is_running(void);
+
+void APP_ECC_CAMPAIGN_task(void);
+
+void APP_ECC_CAMPAIGN_get_report(app_ecc_campaign_report_t* report);
+
+void APP_ECC_CAMPAIGN_print_report(const app_ecc_campaign_report_t* report);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_ECC_CAMPAIGN_H */
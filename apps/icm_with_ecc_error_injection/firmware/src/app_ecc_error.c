@@ -43,9 +43,18 @@
 // Section: Included Files
 // *****************************************************************************
 // *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
 #include <stdio.h>
 #include "app_ecc_error.h"
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Size of a data cache line in bytes */
+#define APP_ECC_ERROR_CACHE_LINE_SIZE      (32U)
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Globals
@@ -57,6 +66,10 @@ volatile app_ecc_error_count_t g_areaEccErrCountTable[APP_MEMORY_REGION_NUM] = {
 /* Region name strings for output print */
 const char* g_memoryRegionString[] = { "ITCM", "DTCM", "int SRAM", "ext RAM memory" };
 
+/* Golden source of the data repaired after a not fixable error */
+static app_ecc_error_golden_t goldenSource = NULL;
+static uintptr_t goldenContext = 0U;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Application Initialization and State Machine Functions
@@ -104,5 +117,178 @@ void APP_ECC_ERROR_print_interrupt_count(void)
                     g_memoryRegionString[area]);
             g_areaEccErrCountTable[area].last_nofix = tmp;
         }
+
+        tmp = g_areaEccErrCountTable[area].current_reload;
+        if ( tmp != g_areaEccErrCountTable[area].last_reload )
+        {
+            printf("  %u NOFIX word reloaded from golden source on region %s\n\r",
+                    (unsigned int)(tmp - g_areaEccErrCountTable[area].last_reload),
+                    g_memoryRegionString[area]);
+            g_areaEccErrCountTable[area].last_reload = tmp;
+        }
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_ERROR_golden_register(app_ecc_error_golden_t golden, uintptr_t context)
+
+   Summary:
+    Register the golden source of the not fixable error repair.
+
+   Description:
+    APP_ECC_ERROR_nofix_repair() reloads the faulty words from the golden
+    source when it knows their address. NULL removes the golden source, the
+    faulty words are then overwritten with APP_ECC_ERROR_NOFIX_PATTERN.
+
+   Precondition:
+    None.
+
+   Parameters:
+    golden - golden source function, or NULL.
+    context - value passed back to the golden source function.
+
+   Returns:
+    None.
+*/
+void APP_ECC_ERROR_golden_register(app_ecc_error_golden_t golden, uintptr_t context)
+{
+    bool interruptState = NVIC_INT_Disable();
+
+    goldenSource = golden;
+    goldenContext = context;
+    NVIC_INT_Restore(interruptState);
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_ERROR_write_line(uint32_t* address, const uint32_t* data, uint32_t words)
+
+   Summary:
+    Write words of a cacheable memory without filling their cache line.
+
+   Description:
+    The cache line of the address is cleaned and invalidated, so the dirty
+    words of the line are written back and the faulty word is no longer
+    cached. The words are then stored with write-through forced: the store
+    goes to the memory, the ECC controller computes new check bits, and no
+    line fill reads the faulty word again. The rest of the caches is not
+    touched.
+
+   Precondition:
+    None. Safe to call from the ECC interrupt context.
+
+   Parameters:
+    address - address of the words, in one cache line.
+    data - words to write.
+    words - number of words.
+
+   Returns:
+    None.
+*/
+void APP_ECC_ERROR_write_line(uint32_t* address, const uint32_t* data, uint32_t words)
+{
+    uint32_t* line = (uint32_t*)((uint32_t)address & ~(APP_ECC_ERROR_CACHE_LINE_SIZE - 1U));
+    uint32_t cacr = SCB->CACR;
+    uint32_t index;
+
+    if ( DATA_CACHE_IS_ENABLED() != 0U )
+    {
+        DCACHE_CLEAN_INVALIDATE_BY_ADDR(line, (int32_t)APP_ECC_ERROR_CACHE_LINE_SIZE);
+        SCB->CACR = cacr | SCB_CACR_FORCEWT_Msk;
+        __DSB();
+        __ISB();
+    }
+
+    for (index = 0U; index < words; index++)
+    {
+        address[index] = data[index];
+    }
+    __DSB();
+    __ISB();
+
+    if ( DATA_CACHE_IS_ENABLED() != 0U )
+    {
+        SCB->CACR = cacr;
+        __DSB();
+        __ISB();
+    }
+
+    /* The repaired words may hold code */
+    if ( INSTRUCTION_CACHE_IS_ENABLED() != 0U )
+    {
+        SCB_InvalidateICache_by_Addr(line, (int32_t)APP_ECC_ERROR_CACHE_LINE_SIZE);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_ECC_ERROR_nofix_repair(app_memory_region_t region, uint32_t* fault_pointer)
+
+   Summary:
+    Repair the ECC word of a not fixable error.
+
+   Description:
+    The ECC word at the fault address, 64 bits in ITCM and 32 bits in the
+    other regions, is written with the golden data, or with
+    APP_ECC_ERROR_NOFIX_PATTERN when there is no golden copy, so that its
+    check bits are valid again. In the cacheable FlexRAM and external RAM
+    only the cache line of the word is maintained: the caches stay enabled.
+
+   Precondition:
+    Called from the not fixable error callback of the region.
+
+   Parameters:
+    region - memory region of the fault.
+    fault_pointer - fault address reported by the ECC controller.
+
+   Returns:
+    true when the word was reloaded from the golden source.
+*/
+bool APP_ECC_ERROR_nofix_repair(app_memory_region_t region, uint32_t* fault_pointer)
+{
+    uint32_t data[2] = { APP_ECC_ERROR_NOFIX_PATTERN, APP_ECC_ERROR_NOFIX_PATTERN };
+    uint32_t words = 1U;
+    bool reloaded = false;
+
+    if ( region == APP_MEMORY_REGION_ITCM )
+    {
+        fault_pointer = (uint32_t*)((uint32_t)fault_pointer & ~7UL);
+        words = 2U;
+    }
+
+    if ( goldenSource != NULL )
+    {
+        reloaded = goldenSource(region, (uint32_t)fault_pointer, data, words, goldenContext);
+        if ( reloaded == true )
+        {
+            g_areaEccErrCountTable[region].current_reload++;
+        }
+        else
+        {
+            data[0] = APP_ECC_ERROR_NOFIX_PATTERN;
+            data[1] = APP_ECC_ERROR_NOFIX_PATTERN;
+        }
+    }
+
+    if ( ( region == APP_MEMORY_REGION_INTERNAL_SRAM ) || ( region == APP_MEMORY_REGION_EXTERNAL_RAM ) )
+    {
+        APP_ECC_ERROR_write_line(fault_pointer, data, words);
     }
+    else
+    {
+        /* TCM are not cached */
+        if ( words == 2U )
+        {
+            *(volatile uint64_t*)fault_pointer = ((uint64_t)data[1] << 32) | data[0];
+        }
+        else
+        {
+            *fault_pointer = data[0];
+        }
+        __ISB();
+        __DSB();
+    }
+
+    return reloaded;
 }
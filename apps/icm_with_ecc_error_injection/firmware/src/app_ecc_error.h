@@ -48,6 +48,7 @@
 // *****************************************************************************
 // *****************************************************************************
 #include <stdint.h>
+#include <stdbool.h>
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus // Provide C++ Compatibility
@@ -63,6 +64,9 @@
 /* Lenght of data buffer hashed by ICM */
 #define APP_BUFFER_LENGTH                                         (2512)
 
+/* Data written at a not fixable error address without golden source */
+#define APP_ECC_ERROR_NOFIX_PATTERN                               (0xDEADDEADUL)
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Type Definitions
@@ -143,10 +147,30 @@ typedef struct
 {
     uint32_t current_fix;
     uint32_t current_nofix;
+    uint32_t current_reload;
     uint32_t last_fix;
     uint32_t last_nofix;
+    uint32_t last_reload;
 } app_ecc_error_count_t;
 
+// *****************************************************************************
+/* Application ECC Error golden source
+
+   Summary:
+    Provides the correct content of a word hit by a not fixable error.
+
+   Description:
+    Called from the ECC interrupt context with the region and address of the
+    faulty ECC word. The function writes the words of correct data to data and
+    returns true, or returns false when it has no copy of the address. words
+    is 2 for the ITCM 64-bit ECC words and 1 for the other regions.
+
+   Remarks:
+    None.
+*/
+typedef bool (*app_ecc_error_golden_t)(app_memory_region_t region, uint32_t address,
+                                       uint32_t* data, uint32_t words, uintptr_t context);
+
 // *****************************************************************************
 // *****************************************************************************
 // Extern
@@ -165,6 +189,12 @@ extern const char* g_memoryRegionString[];
 
 void APP_ECC_ERROR_print_interrupt_count(void);
 
+void APP_ECC_ERROR_golden_register(app_ecc_error_golden_t golden, uintptr_t context);
+
+void APP_ECC_ERROR_write_line(uint32_t* address, const uint32_t* data, uint32_t words);
+
+bool APP_ECC_ERROR_nofix_repair(app_memory_region_t region, uint32_t* fault_pointer);
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
 }
@@ -0,0 +1,498 @@
+/*******************************************************************************
+ MPLAB Harmony Application ECC Fault Map Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_ecc_fault_map.c
+
+  Summary:
+    ECC fault map Implementation File
+
+  Description:
+    None
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include <stdio.h>
+#include "app_ecc_error.h"
+#include "app_ecc_fault_map.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Region value of a free entry */
+#define APP_ECC_FAULT_MAP_FREE             (0xFFU)
+
+/* Saturation value of the entry counts */
+#define APP_ECC_FAULT_MAP_COUNT_MAX        (0xFFFFU)
+
+/* CPU cycles per millisecond */
+#define APP_ECC_FAULT_MAP_CYCLES_PER_MS    (CPU_CLOCK_FREQUENCY / 1000U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Fault map, open addressing with linear probing */
+static app_ecc_fault_entry_t faultMap[APP_ECC_FAULT_MAP_SIZE];
+
+/* Number of addresses recorded and of faults not recorded */
+static uint32_t faultEntryUsed;
+static uint32_t faultDropped;
+
+/* Incremented on each recorded fault */
+static volatile uint32_t faultSequence;
+
+/* Millisecond time base : time at faultTimeCycles DWT cycle count */
+static uint32_t faultTimeMs;
+static uint32_t faultTimeCycles;
+
+/* Periodic snapshot : period, time and sequence of the last snapshot */
+static uint32_t faultSnapshotPeriod;
+static uint32_t faultSnapshotMs;
+static uint32_t faultSnapshotSequence;
+
+/* Callback called for each recorded fault */
+static app_ecc_fault_map_callback_t faultCallback;
+static uintptr_t faultCallbackContext;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_ECC_FAULT_MAP_time(void)
+
+   Summary:
+    Get the time since initialization.
+
+   Parameters:
+    None.
+
+   Returns:
+    Time in milliseconds.
+*/
+static uint32_t APP_ECC_FAULT_MAP_time(void)
+{
+    return faultTimeMs + ((DWT->CYCCNT - faultTimeCycles) / APP_ECC_FAULT_MAP_CYCLES_PER_MS);
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_ECC_FAULT_MAP_hash(uint32_t address)
+
+   Summary:
+    Get the first fault map index of an address.
+
+   Parameters:
+    address - ECC word address.
+
+   Returns:
+    Index in the fault map.
+*/
+static uint32_t APP_ECC_FAULT_MAP_hash(uint32_t address)
+{
+    uint32_t hash = (address >> 2) * 2654435761UL;
+
+    return (hash ^ (hash >> 16)) & (APP_ECC_FAULT_MAP_SIZE - 1U);
+}
+
+// *****************************************************************************
+/* Function:
+    static bool APP_ECC_FAULT_MAP_is_weaker(const app_ecc_fault_entry_t* entry,
+                                            const app_ecc_fault_entry_t* other)
+
+   Summary:
+    Compare two entries of the fault map.
+
+   Parameters:
+    entry - entry to compare.
+    other - entry to compare with.
+
+   Returns:
+    true if entry has more not fixable faults, or as many and more fixable
+    faults, than other.
+*/
+static bool APP_ECC_FAULT_MAP_is_weaker(const app_ecc_fault_entry_t* entry,
+                                        const app_ecc_fault_entry_t* other)
+{
+    if ( entry->nofix_count != other->nofix_count )
+    {
+        return ( entry->nofix_count > other->nofix_count );
+    }
+    return ( entry->fix_count > other->fix_count );
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Initialization and State Machine Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_FAULT_MAP_init(uint32_t snapshot_period_ms)
+
+   Summary:
+    Initialize the ECC fault map.
+
+   Description:
+    This function empties the fault map and starts its time base.
+
+   Precondition:
+    Must be called before the ECC interrupts are enabled.
+
+   Parameters:
+    snapshot_period_ms - period of the snapshot printed by APP_ECC_FAULT_MAP_task
+                         when new faults were recorded, 0 to disable.
+
+   Returns:
+    None.
+*/
+void APP_ECC_FAULT_MAP_init(uint32_t snapshot_period_ms)
+{
+    uint32_t index;
+
+    for (index = 0U; index < APP_ECC_FAULT_MAP_SIZE; index++)
+    {
+        faultMap[index] = (app_ecc_fault_entry_t){ 0 };
+        faultMap[index].region = APP_ECC_FAULT_MAP_FREE;
+    }
+    faultEntryUsed = 0U;
+    faultDropped = 0U;
+    faultSequence = 0U;
+
+    /* Time base uses the DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    faultTimeMs = 0U;
+    faultTimeCycles = DWT->CYCCNT;
+
+    faultSnapshotPeriod = snapshot_period_ms;
+    faultSnapshotMs = 0U;
+    faultSnapshotSequence = 0U;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_FAULT_MAP_record(app_memory_region_t region, uint32_t address,
+                                  app_ecc_fault_type_t type)
+
+   Summary:
+    Record an ECC fault.
+
+   Description:
+    This function is called from the ECC interrupt callbacks with the fail
+    address read from the memory controller. It looks at no more than
+    APP_ECC_FAULT_MAP_MAX_PROBE entries, the fault is counted as dropped if
+    none of them holds the address or is free.
+
+   Precondition:
+    APP_ECC_FAULT_MAP_init must have been called.
+
+   Parameters:
+    region - memory region of the fault.
+    address - fail address.
+    type - fixable or not fixable fault.
+
+   Returns:
+    None.
+*/
+void APP_ECC_FAULT_MAP_record(app_memory_region_t region, uint32_t address, app_ecc_fault_type_t type)
+{
+    uint32_t index;
+    uint32_t probe;
+    bool interruptState;
+
+    /* ITCM check bits cover 64-bit words */
+    address &= ( region == APP_MEMORY_REGION_ITCM ) ? ~0x7UL : ~0x3UL;
+    index = APP_ECC_FAULT_MAP_hash(address);
+
+    /* ECC interrupts of different memories may preempt each other */
+    interruptState = NVIC_INT_Disable();
+
+    for (probe = 0U; probe < APP_ECC_FAULT_MAP_MAX_PROBE; probe++)
+    {
+        app_ecc_fault_entry_t* entry = &faultMap[index];
+
+        if ( entry->region == APP_ECC_FAULT_MAP_FREE )
+        {
+            entry->address = address;
+            entry->region = (uint8_t)region;
+            entry->first_seen = APP_ECC_FAULT_MAP_time();
+            faultEntryUsed++;
+        }
+
+        if ( ( entry->address == address ) && ( entry->region == (uint8_t)region ) )
+        {
+            if ( ( type == APP_ECC_FAULT_NOFIX ) && ( entry->nofix_count < APP_ECC_FAULT_MAP_COUNT_MAX ) )
+            {
+                entry->nofix_count++;
+            }
+            else if ( ( type == APP_ECC_FAULT_FIX ) && ( entry->fix_count < APP_ECC_FAULT_MAP_COUNT_MAX ) )
+            {
+                entry->fix_count++;
+            }
+            else
+            {
+                /* Count saturated */
+            }
+            entry->last_seen = APP_ECC_FAULT_MAP_time();
+            break;
+        }
+
+        index = (index + 1U) & (APP_ECC_FAULT_MAP_SIZE - 1U);
+    }
+
+    if ( probe == APP_ECC_FAULT_MAP_MAX_PROBE )
+    {
+        faultDropped++;
+    }
+    faultSequence++;
+
+    NVIC_INT_Restore(interruptState);
+
+    if ( faultCallback != NULL )
+    {
+        faultCallback(region, address, type, faultCallbackContext);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_FAULT_MAP_snapshot(app_ecc_fault_snapshot_t* snapshot)
+
+   Summary:
+    Take a telemetry snapshot of the fault map.
+
+   Description:
+    This function copies the region counts and selects the weakest
+    addresses. Interrupts are disabled while each entry is copied only.
+
+   Precondition:
+    APP_ECC_FAULT_MAP_init must have been called.
+
+   Parameters:
+    snapshot - pointer to the structure filled with the snapshot.
+
+   Returns:
+    None.
+*/
+void APP_ECC_FAULT_MAP_snapshot(app_ecc_fault_snapshot_t* snapshot)
+{
+    uint32_t index;
+    bool interruptState;
+
+    interruptState = NVIC_INT_Disable();
+    snapshot->timestamp = APP_ECC_FAULT_MAP_time();
+    snapshot->sequence = faultSequence;
+    snapshot->entry_used = faultEntryUsed;
+    snapshot->dropped = faultDropped;
+    NVIC_INT_Restore(interruptState);
+
+    for (index = 0U; index < APP_MEMORY_REGION_NUM; index++)
+    {
+        snapshot->fix_total[index] = g_areaEccErrCountTable[index].current_fix;
+        snapshot->nofix_total[index] = g_areaEccErrCountTable[index].current_nofix;
+    }
+
+    /* Insertion in the top list, sorted from the weakest address */
+    snapshot->top_num = 0U;
+    for (index = 0U; index < APP_ECC_FAULT_MAP_SIZE; index++)
+    {
+        app_ecc_fault_entry_t entry;
+        uint32_t position;
+
+        interruptState = NVIC_INT_Disable();
+        entry = faultMap[index];
+        NVIC_INT_Restore(interruptState);
+
+        if ( entry.region == APP_ECC_FAULT_MAP_FREE )
+        {
+            continue;
+        }
+
+        position = snapshot->top_num;
+        while ( ( position > 0U ) && ( APP_ECC_FAULT_MAP_is_weaker(&entry, &snapshot->top[position - 1U]) == true ) )
+        {
+            if ( position < APP_ECC_FAULT_MAP_TOP_NUM )
+            {
+                snapshot->top[position] = snapshot->top[position - 1U];
+            }
+            position--;
+        }
+        if ( position < APP_ECC_FAULT_MAP_TOP_NUM )
+        {
+            snapshot->top[position] = entry;
+            if ( snapshot->top_num < APP_ECC_FAULT_MAP_TOP_NUM )
+            {
+                snapshot->top_num++;
+            }
+        }
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_FAULT_MAP_print_snapshot(const app_ecc_fault_snapshot_t* snapshot)
+
+   Summary:
+    Print a telemetry snapshot.
+
+   Precondition:
+    None.
+
+   Parameters:
+    snapshot - pointer to the snapshot to print.
+
+   Returns:
+    None.
+*/
+void APP_ECC_FAULT_MAP_print_snapshot(const app_ecc_fault_snapshot_t* snapshot)
+{
+    uint32_t index;
+
+    printf("  ECC fault map @ %u ms : %u address(es), %u fault(s) not mapped\n\r",
+            (unsigned int)snapshot->timestamp,
+            (unsigned int)snapshot->entry_used,
+            (unsigned int)snapshot->dropped);
+
+    for (index = 0U; index < APP_MEMORY_REGION_NUM; index++)
+    {
+        printf("    %-14s : %u FIX, %u NOFIX\n\r",
+                g_memoryRegionString[index],
+                (unsigned int)snapshot->fix_total[index],
+                (unsigned int)snapshot->nofix_total[index]);
+    }
+
+    for (index = 0U; index < snapshot->top_num; index++)
+    {
+        const app_ecc_fault_entry_t* entry = &snapshot->top[index];
+
+        printf("    0x%08x %-14s : %u FIX, %u NOFIX, first %u ms, last %u ms\n\r",
+                (unsigned int)entry->address,
+                g_memoryRegionString[entry->region],
+                (unsigned int)entry->fix_count,
+                (unsigned int)entry->nofix_count,
+                (unsigned int)entry->first_seen,
+                (unsigned int)entry->last_seen);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_FAULT_MAP_task(void)
+
+   Summary:
+    ECC fault map task.
+
+   Description:
+    This function keeps the time base running and prints a snapshot every
+    snapshot period when new faults were recorded. It must be called from
+    the main loop at least once every 2^32 CPU cycles.
+
+   Precondition:
+    APP_ECC_FAULT_MAP_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ECC_FAULT_MAP_task(void)
+{
+    uint32_t elapsed;
+    uint32_t now;
+    bool interruptState;
+
+    /* Move the time base forward by whole milliseconds */
+    interruptState = NVIC_INT_Disable();
+    elapsed = (DWT->CYCCNT - faultTimeCycles) / APP_ECC_FAULT_MAP_CYCLES_PER_MS;
+    faultTimeMs += elapsed;
+    faultTimeCycles += elapsed * APP_ECC_FAULT_MAP_CYCLES_PER_MS;
+    now = faultTimeMs;
+    NVIC_INT_Restore(interruptState);
+
+    if ( ( faultSnapshotPeriod != 0U ) &&
+         ( (now - faultSnapshotMs) >= faultSnapshotPeriod ) &&
+         ( faultSequence != faultSnapshotSequence ) )
+    {
+        app_ecc_fault_snapshot_t snapshot;
+
+        APP_ECC_FAULT_MAP_snapshot(&snapshot);
+        APP_ECC_FAULT_MAP_print_snapshot(&snapshot);
+        faultSnapshotMs = now;
+        faultSnapshotSequence = snapshot.sequence;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_FAULT_MAP_callback_register(app_ecc_fault_map_callback_t callback,
+                                             uintptr_t context)
+
+   Summary:
+    Register the function called for each recorded fault.
+
+   Description:
+    The callback runs in the ECC interrupt context, after the fault map is
+    updated. It is used to follow the faults of an injection campaign.
+
+   Precondition:
+    APP_ECC_FAULT_MAP_init must have been called.
+
+   Parameters:
+    callback - function to call, NULL to remove the callback.
+    context - value passed to the callback.
+
+   Returns:
+    None.
+*/
+void APP_ECC_FAULT_MAP_callback_register(app_ecc_fault_map_callback_t callback, uintptr_t context)
+{
+    bool interruptState = NVIC_INT_Disable();
+
+    faultCallback = callback;
+    faultCallbackContext = context;
+
+    NVIC_INT_Restore(interruptState);
+}
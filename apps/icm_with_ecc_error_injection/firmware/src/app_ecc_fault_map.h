@@ -0,0 +1,187 @@
+/*******************************************************************************
+  MPLAB Harmony Application ECC Fault Map Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_ecc_fault_map.h
+
+  Summary:
+    ECC fault map Prototypes and definitions file.
+
+  Description:
+    The fault map records the fail address of every ECC interrupt in a small
+    hashed table, with a fix and a not fixable count and the first and last
+    time the address failed, to find the weak memory cells.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_ECC_FAULT_MAP_H
+#define	APP_ECC_FAULT_MAP_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_ecc_error.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Number of addresses held by the fault map, power of 2 */
+#define APP_ECC_FAULT_MAP_SIZE                                    (64U)
+
+/* Maximum number of entries looked at to record one fault */
+#define APP_ECC_FAULT_MAP_MAX_PROBE                               (8U)
+
+/* Number of weakest addresses reported in a snapshot */
+#define APP_ECC_FAULT_MAP_TOP_NUM                                 (8U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application ECC fault type
+
+   Summary:
+    Type of ECC interrupt recorded.
+
+   Remarks:
+    None.
+*/
+typedef enum
+{
+    APP_ECC_FAULT_FIX = 0,
+    APP_ECC_FAULT_NOFIX = 1
+} app_ecc_fault_type_t;
+
+// *****************************************************************************
+/* Application ECC fault map entry
+
+   Summary:
+    Faults recorded at one address.
+
+   Description:
+    address is the address of the ECC word (8 bytes in ITCM, 4 bytes
+    elsewhere). Counts saturate at 0xFFFF. Times are in milliseconds since
+    APP_ECC_FAULT_MAP_init.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t address;
+    uint32_t first_seen;
+    uint32_t last_seen;
+    uint16_t fix_count;
+    uint16_t nofix_count;
+    uint8_t region;
+} app_ecc_fault_entry_t;
+
+// *****************************************************************************
+/* Application ECC fault map snapshot
+
+   Summary:
+    Telemetry snapshot of the fault map.
+
+   Description:
+    fix_total and nofix_total are the interrupt counts of each region.
+    entry_used is the number of distinct addresses recorded and dropped the
+    number of faults that could not be recorded because the map was full
+    around their hash. top holds the top_num addresses with the most faults,
+    not fixable faults first.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t timestamp;
+    uint32_t sequence;
+    uint32_t fix_total[APP_MEMORY_REGION_NUM];
+    uint32_t nofix_total[APP_MEMORY_REGION_NUM];
+    uint32_t entry_used;
+    uint32_t dropped;
+    uint32_t top_num;
+    app_ecc_fault_entry_t top[APP_ECC_FAULT_MAP_TOP_NUM];
+} app_ecc_fault_snapshot_t;
+
+// *****************************************************************************
+/* Application ECC fault map callback
+
+   Summary:
+    Called for each recorded fault.
+
+   Description:
+    The callback is called from the ECC interrupt callbacks once the fault is
+    recorded, with the ECC word address.
+
+   Remarks:
+    None.
+*/
+typedef void (*app_ecc_fault_map_callback_t)(app_memory_region_t region, uint32_t address,
+                                             app_ecc_fault_type_t type, uintptr_t context);
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_ECC_FAULT_MAP_init(uint32_t snapshot_period_ms);
+
+void APP_ECC_FAULT_MAP_record(app_memory_region_t region, uint32_t address, app_ecc_fault_type_t type);
+
+void APP_ECC_FAULT_MAP_snapshot(app_ecc_fault_snapshot_t* snapshot);
+
+void APP_ECC_FAULT_MAP_print_snapshot(const app_ecc_fault_snapshot_t* snapshot);
+
+void APP_ECC_FAULT_MAP_task(void);
+
+void APP_ECC_FAULT_MAP_callback_register(app_ecc_fault_map_callback_t callback, uintptr_t context);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_ECC_FAULT_MAP_H */
@@ -45,6 +45,7 @@
 // *****************************************************************************
 #include "definitions.h"                // SYS function prototypes
 #include "app_ecc_error.h"
+#include "app_ecc_fault_map.h"
 #include "app_ecc_inject_ext_sdram.h"
 
 // *****************************************************************************
@@ -137,6 +138,7 @@ static void APP_ECC_INJECT_EXT_SDRAM_FixCallback(uintptr_t context)
         }
 
         g_areaEccErrCountTable[APP_MEMORY_REGION_EXTERNAL_RAM].current_fix++;
+        APP_ECC_FAULT_MAP_record(APP_MEMORY_REGION_EXTERNAL_RAM, (uint32_t)fault_pointer, APP_ECC_FAULT_FIX);
     }
 }
 
@@ -148,8 +150,8 @@ static void APP_ECC_INJECT_EXT_SDRAM_FixCallback(uintptr_t context)
     Interrupt callback for not fixable error.
 
    Description:
-    This function handle write 0xDEADDEAD at fault address for double error
-    on HEMC memory.
+    This function handle write of the golden data, or 0xDEADDEAD, at fault
+    address for double error on HEMC memory, without disabling the caches.
 
    Precondition:
     None.
@@ -171,45 +173,21 @@ static void APP_ECC_INJECT_EXT_SDRAM_NoFixCallback(uintptr_t context)
 {
     /* Read the fault address before clearing the interrupt*/
     uint32_t* fault_pointer = HEMC_HeccGetFailAddress();
-    bool isDataCacheWasEnabled = false;
-    bool isInstCacheWasEnabled = false;
     HEMC_HECC_STATUS value = HEMC_HeccGetStatus();
 
     if ( (value & HEMC_HECC_STATUS_MEM_NOFIX) == HEMC_HECC_STATUS_MEM_NOFIX )
     {
-        if ( DATA_CACHE_IS_ENABLED() != 0U )
-        {
-            isDataCacheWasEnabled = true;
-            DCACHE_DISABLE();
-        }
-        if ( INSTRUCTION_CACHE_IS_ENABLED() != 0U )
-        {
-            isInstCacheWasEnabled = true;
-            ICACHE_DISABLE();
-        }
-
-        (*fault_pointer) = 0xDEADDEADUL;
-        __DSB();
-        __ISB();
+        /* Only the cache line of the fault word is maintained, no line fill reads it again */
+        (void)APP_ECC_ERROR_nofix_repair(APP_MEMORY_REGION_EXTERNAL_RAM, fault_pointer);
 
         /* HECC controller issue with ICM : write back also the previous address */
         if ( (uint32_t)fault_pointer > 0x64000000UL )
         {
-            *(fault_pointer - 1) = 0xDEADDEADUL;
-            __DSB();
-            __ISB();
-        }
-
-        if ( isDataCacheWasEnabled )
-        {
-            DCACHE_ENABLE();
-        }
-        if ( isInstCacheWasEnabled )
-        {
-            ICACHE_ENABLE();
+            (void)APP_ECC_ERROR_nofix_repair(APP_MEMORY_REGION_EXTERNAL_RAM, fault_pointer - 1);
         }
 
         g_areaEccErrCountTable[APP_MEMORY_REGION_EXTERNAL_RAM].current_nofix++;
+        APP_ECC_FAULT_MAP_record(APP_MEMORY_REGION_EXTERNAL_RAM, (uint32_t)fault_pointer, APP_ECC_FAULT_NOFIX);
     }
 }
 
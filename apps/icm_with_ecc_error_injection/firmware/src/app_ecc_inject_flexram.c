@@ -45,6 +45,7 @@
 // *****************************************************************************
 #include "definitions.h"                // SYS function prototypes
 #include "app_ecc_error.h"
+#include "app_ecc_fault_map.h"
 #include "app_ecc_inject_flexram.h"
 
 // *****************************************************************************
@@ -67,6 +68,10 @@
 
    Description:
     This function handle write back for single error on FlexRAM memory.
+    Without write back the error stays in memory and is reported again at
+    each read, until a second upset in the same word makes it not fixable.
+    Only the cache line of the fault is maintained, so a scrub sweep hitting
+    many errors does not flush the caches of the whole system.
 
    Precondition:
     None.
@@ -79,14 +84,20 @@
 */
 static void APP_ECC_INJECT_FLEXRAM_FixCallback(uintptr_t context)
 {
+    /* Read the data corrected on the fly at fault address before clearing the interrupt */
     uint32_t* fault_pointer = FLEXRAMECC_GetFailAddress();
+    uint32_t fault_data = *fault_pointer;
+    __DSB();
+    __ISB();
     FLEXRAMECC_STATUS status_reg = FLEXRAMECC_StatusGet();
 
     if ( ( status_reg & FLEXRAMECC_STATUS_MEM_FIX ) != 0U )
     {
-        // Fault address not used
-        (void)(fault_pointer);
+        /* Write back only the cache line of the fault, the caches stay enabled */
+        APP_ECC_ERROR_write_line(fault_pointer, &fault_data, 1U);
+
         g_areaEccErrCountTable[APP_MEMORY_REGION_INTERNAL_SRAM].current_fix++;
+        APP_ECC_FAULT_MAP_record(APP_MEMORY_REGION_INTERNAL_SRAM, (uint32_t)fault_pointer, APP_ECC_FAULT_FIX);
     }
 }
 
@@ -98,8 +109,8 @@ static void APP_ECC_INJECT_FLEXRAM_FixCallback(uintptr_t context)
     Interrupt callback for not fixable error.
 
    Description:
-    This function handle write 0xDEADDEAD at fault address for double error
-    on FlexRAM memory.
+    This function handle write of the golden data, or 0xDEADDEAD, at fault
+    address for double error on FlexRAM memory, without disabling the caches.
 
    Precondition:
     None.
@@ -115,38 +126,15 @@ static void APP_ECC_INJECT_FLEXRAM_NoFixCallback(uintptr_t context)
     uint32_t* fault_pointer = FLEXRAMECC_GetFailAddress();
     __DSB();
     __ISB();
-    bool isDataCacheWasEnabled = false;
-    bool isInstCacheWasEnabled = false;
     FLEXRAMECC_STATUS status_reg = FLEXRAMECC_StatusGet();
 
     if ( ( status_reg & FLEXRAMECC_STATUS_MEM_NOFIX ) != 0U )
     {
-        if ( DATA_CACHE_IS_ENABLED() != 0U )
-        {
-            isDataCacheWasEnabled = true;
-            DCACHE_DISABLE();
-        }
-        if ( INSTRUCTION_CACHE_IS_ENABLED() != 0U )
-        {
-            isInstCacheWasEnabled = true;
-            ICACHE_DISABLE();
-        }
-
-        //write backs shall be implemented to avoid dead lock when MPU of flexRAM is in normal mode.
-        (*fault_pointer) = 0xDEADDEADUL;
-        __ISB();
-        __DSB();
-
-        if ( isDataCacheWasEnabled )
-        {
-            DCACHE_ENABLE();
-        }
-        if ( isInstCacheWasEnabled )
-        {
-            ICACHE_ENABLE();
-        }
+        /* Only the cache line of the fault word is maintained, no line fill reads it again */
+        (void)APP_ECC_ERROR_nofix_repair(APP_MEMORY_REGION_INTERNAL_SRAM, fault_pointer);
 
         g_areaEccErrCountTable[APP_MEMORY_REGION_INTERNAL_SRAM].current_nofix++;
+        APP_ECC_FAULT_MAP_record(APP_MEMORY_REGION_INTERNAL_SRAM, (uint32_t)fault_pointer, APP_ECC_FAULT_NOFIX);
     }
 }
 
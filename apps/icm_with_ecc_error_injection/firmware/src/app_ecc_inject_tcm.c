@@ -45,8 +45,17 @@
 // *****************************************************************************
 #include "definitions.h"                // SYS function prototypes
 #include "app_ecc_error.h"
+#include "app_ecc_fault_map.h"
 #include "app_ecc_inject_tcm.h"
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Define the number of test mode check bit reads before a zero value is accepted */
+#define APP_ECC_INJECT_TCM_CB_READ_RETRY   (16U)
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Globals
@@ -97,6 +106,7 @@ static void APP_ECC_INJECT_TCM_FixCallback(uintptr_t context)
         __ISB();
         __DSB();
         g_areaEccErrCountTable[APP_MEMORY_REGION_ITCM].current_fix++;
+        APP_ECC_FAULT_MAP_record(APP_MEMORY_REGION_ITCM, (uint32_t)fault_pointer, APP_ECC_FAULT_FIX);
     }
 
     if ( ( status_reg & TCMECC_STATUS_MEM_FIX_D ) != 0U )
@@ -107,6 +117,7 @@ static void APP_ECC_INJECT_TCM_FixCallback(uintptr_t context)
             __ISB();
             __DSB();
             g_areaEccErrCountTable[APP_MEMORY_REGION_DTCM].current_fix++;
+            APP_ECC_FAULT_MAP_record(APP_MEMORY_REGION_DTCM, (uint32_t)fault_pointer_word, APP_ECC_FAULT_FIX);
         }
     }
 }
@@ -119,8 +130,8 @@ static void APP_ECC_INJECT_TCM_FixCallback(uintptr_t context)
     Interrupt callback for not fixable error.
 
    Description:
-    This function handle write 0xDEADDEAD at fault address for double error
-    on TCM memory.
+    This function handle write of the golden data, or 0xDEADDEAD, at fault
+    address for double error on TCM memory.
 
    Precondition:
     None.
@@ -139,20 +150,18 @@ static void APP_ECC_INJECT_TCM_NoFixCallback(uintptr_t context)
 
     if ( ( status_reg & TCMECC_STATUS_MEM_NOFIX_I ) != 0U )
     {
-        (*fault_pointer) = 0xDEADDEADDEADDEADULL;
-        __ISB();
-        __DSB();
+        (void)APP_ECC_ERROR_nofix_repair(APP_MEMORY_REGION_ITCM, (uint32_t*)fault_pointer);
         g_areaEccErrCountTable[APP_MEMORY_REGION_ITCM].current_nofix++;
+        APP_ECC_FAULT_MAP_record(APP_MEMORY_REGION_ITCM, (uint32_t)fault_pointer, APP_ECC_FAULT_NOFIX);
     }
 
     if ( (status_reg & TCMECC_STATUS_MEM_NOFIX_D) != 0U )
     {
         if ( ( (uint32_t)fault_pointer_word >= 0x20000000UL) && ( (uint32_t)fault_pointer_word <= 0x2003FFFFUL) )
         {
-            (*fault_pointer_word) = 0xDEADDEADUL;
-            __ISB();
-            __DSB();
+            (void)APP_ECC_ERROR_nofix_repair(APP_MEMORY_REGION_DTCM, fault_pointer_word);
              g_areaEccErrCountTable[APP_MEMORY_REGION_DTCM].current_nofix++;
+             APP_ECC_FAULT_MAP_record(APP_MEMORY_REGION_DTCM, (uint32_t)fault_pointer_word, APP_ECC_FAULT_NOFIX);
         }
     }
 }
@@ -212,6 +221,8 @@ void APP_ECC_INJECT_TCM_initialize_error(
         app_ecc_error_inject_t* pEccErrorInject, uint32_t* pBuffer,
         uint32_t buffer_index)
 {
+    uint32_t retry = 0U;
+
     pEccErrorInject->buffer_index = buffer_index;
     __DSB();
     __ISB();
@@ -229,11 +240,14 @@ void APP_ECC_INJECT_TCM_initialize_error(
     __DSB();
     __ISB();
 
+    /* Zero is also a valid check bit value : bound the wait for the test mode capture */
     do
     {
         TCMECC_TestModeGetCbValue(&(pEccErrorInject->ecc_tcb1), &(pEccErrorInject->ecc_tcb2));
+        retry++;
     }
-    while ( (pEccErrorInject->ecc_tcb1 == 0U) && (pEccErrorInject->ecc_tcb2 == 0U) );
+    while ( (pEccErrorInject->ecc_tcb1 == 0U) && (pEccErrorInject->ecc_tcb2 == 0U) &&
+            (retry < APP_ECC_INJECT_TCM_CB_READ_RETRY) );
 }
 
 // *****************************************************************************
@@ -0,0 +1,382 @@
+/*******************************************************************************
+ MPLAB Harmony Application ECC Scrub Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_ecc_scrub.c
+
+  Summary:
+    ECC memory scrubber Implementation File
+
+  Description:
+    None
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include "app_ecc_scrub.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Size of the reads, the ECC checker verifies the whole ECC word holding the read data */
+#define APP_ECC_SCRUB_WORD_SIZE            (4U)
+
+/* CPU cycles per millisecond */
+#define APP_ECC_SCRUB_CYCLES_PER_MS        (CPU_CLOCK_FREQUENCY / 1000U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Scrub configuration */
+static const app_ecc_scrub_config_t* scrubConfig;
+
+/* Scrub statistics */
+static app_ecc_scrub_status_t scrubStatus;
+
+/* Current position : area index and offset in the area */
+static uint32_t scrubArea;
+static uint32_t scrubOffset;
+
+/* Start of the current slice and bytes read during this slice */
+static uint32_t scrubSliceStart;
+static uint32_t scrubSliceBytes;
+
+/* Last call of the task, cycles elapsed and spent reading since the start of the sweep */
+static uint32_t scrubLastCall;
+static uint64_t scrubSweepCycles;
+static uint32_t scrubReadCycles;
+
+/* Scrubber state */
+static bool scrubSuspended;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static void APP_ECC_SCRUB_read(uint32_t address, uint32_t size)
+
+   Summary:
+    Read a chunk of memory.
+
+   Description:
+    Every word of the chunk is read once. A single bit error raises the
+    fix interrupt of the memory controller and its callback writes the
+    corrected data back, a double error raises the not fixable interrupt.
+
+   Parameters:
+    address - address of the chunk.
+    size - size of the chunk in bytes, multiple of APP_ECC_SCRUB_WORD_SIZE.
+
+   Returns:
+    None.
+*/
+static void APP_ECC_SCRUB_read(uint32_t address, uint32_t size)
+{
+    const volatile uint32_t* word = (const volatile uint32_t *)address;
+    const volatile uint32_t* end = word + (size / APP_ECC_SCRUB_WORD_SIZE);
+
+    while ( (end - word) >= 4 )
+    {
+        (void)word[0];
+        (void)word[1];
+        (void)word[2];
+        (void)word[3];
+        word += 4;
+    }
+    while ( word < end )
+    {
+        (void)*word;
+        word++;
+    }
+    __DSB();
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Initialization and State Machine Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool APP_ECC_SCRUB_init(const app_ecc_scrub_config_t* config)
+
+   Summary:
+    Initialize the ECC scrubber.
+
+   Description:
+    This function checks the configuration and computes the planned full
+    sweep period.
+
+   Precondition:
+    The ECC fix callbacks of the scrubbed memories must be registered.
+
+   Parameters:
+    config - scrub configuration, must stay valid while the scrubber is used.
+
+   Returns:
+    true if the configuration is valid.
+*/
+bool APP_ECC_SCRUB_init(const app_ecc_scrub_config_t* config)
+{
+    uint32_t sweepBytes = 0U;
+    uint32_t slices = 1U;
+    uint32_t sliceBytes = 0U;
+    uint32_t index;
+
+    if ( ( config->area_num == 0U ) ||
+         ( config->chunk_size == 0U ) ||
+         ( (config->chunk_size % APP_ECC_SCRUB_WORD_SIZE) != 0U ) ||
+         ( config->chunk_size > config->budget_bytes ) ||
+         ( config->slice_period == 0U ) )
+    {
+        return false;
+    }
+
+    /* Pack the chunks in slices as APP_ECC_SCRUB_task does */
+    for (index = 0U; index < config->area_num; index++)
+    {
+        const app_ecc_scrub_area_t* area = &config->areas[index];
+        uint32_t offset;
+
+        if ( ( area->size == 0U ) ||
+             ( (area->size % APP_ECC_SCRUB_WORD_SIZE) != 0U ) ||
+             ( (area->address % APP_ECC_SCRUB_WORD_SIZE) != 0U ) )
+        {
+            return false;
+        }
+
+        for (offset = 0U; offset < area->size; offset += config->chunk_size)
+        {
+            uint32_t bytes = area->size - offset;
+
+            if ( bytes > config->chunk_size )
+            {
+                bytes = config->chunk_size;
+            }
+            if ( (sliceBytes + bytes) > config->budget_bytes )
+            {
+                slices++;
+                sliceBytes = 0U;
+            }
+            sliceBytes += bytes;
+        }
+        sweepBytes += area->size;
+    }
+
+    scrubConfig = config;
+    scrubStatus = (app_ecc_scrub_status_t){ 0 };
+    scrubStatus.sweep_bytes = sweepBytes;
+    scrubStatus.coverage_slices = slices;
+    scrubStatus.sweep_period_ms = (uint32_t)(((uint64_t)slices * config->slice_period) / APP_ECC_SCRUB_CYCLES_PER_MS);
+    scrubArea = 0U;
+    scrubOffset = 0U;
+    scrubSuspended = false;
+
+    /* Slices and sweeps are timed with the DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    scrubSliceStart = DWT->CYCCNT;
+    scrubSliceBytes = 0U;
+    scrubLastCall = scrubSliceStart;
+    scrubSweepCycles = 0U;
+    scrubReadCycles = 0U;
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_SCRUB_task(void)
+
+   Summary:
+    ECC scrubber task.
+
+   Description:
+    This function reads the next chunk when it fits in the budget of the
+    current slice. It must be called from the main loop, or from a low
+    priority task, at least once per slice to reach the planned sweep period.
+
+   Precondition:
+    APP_ECC_SCRUB_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ECC_SCRUB_task(void)
+{
+    uint32_t now = DWT->CYCCNT;
+    uint32_t elapsed = now - scrubSliceStart;
+    const app_ecc_scrub_area_t* area;
+    uint32_t bytes;
+
+    scrubSweepCycles += (uint32_t)(now - scrubLastCall);
+    scrubLastCall = now;
+
+    if ( elapsed >= scrubConfig->slice_period )
+    {
+        scrubSliceStart += (elapsed / scrubConfig->slice_period) * scrubConfig->slice_period;
+        scrubSliceBytes = 0U;
+    }
+
+    if ( scrubSuspended == true )
+    {
+        return;
+    }
+
+    area = &scrubConfig->areas[scrubArea];
+    bytes = area->size - scrubOffset;
+    if ( bytes > scrubConfig->chunk_size )
+    {
+        bytes = scrubConfig->chunk_size;
+    }
+
+    if ( (scrubSliceBytes + bytes) > scrubConfig->budget_bytes )
+    {
+        return;
+    }
+
+    scrubSliceBytes += bytes;
+    if ( scrubSliceBytes > scrubStatus.max_slice_bytes )
+    {
+        scrubStatus.max_slice_bytes = scrubSliceBytes;
+    }
+
+    /* Dirty lines are written back first, the read then misses in the cache */
+    if ( ( area->cached == true ) && ( DATA_CACHE_IS_ENABLED() != 0U ) )
+    {
+        DCACHE_CLEAN_INVALIDATE_BY_ADDR((uint32_t *)(area->address + scrubOffset), (int32_t)bytes);
+    }
+    APP_ECC_SCRUB_read(area->address + scrubOffset, bytes);
+    scrubReadCycles += DWT->CYCCNT - now;
+
+    scrubOffset += bytes;
+    if ( scrubOffset >= area->size )
+    {
+        scrubOffset = 0U;
+        scrubArea++;
+        if ( scrubArea >= scrubConfig->area_num )
+        {
+            scrubArea = 0U;
+            scrubStatus.sweep_count++;
+            scrubStatus.last_sweep_ms = (uint32_t)(scrubSweepCycles / APP_ECC_SCRUB_CYCLES_PER_MS);
+            scrubStatus.last_read_cycles = scrubReadCycles;
+            scrubSweepCycles = 0U;
+            scrubReadCycles = 0U;
+        }
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_SCRUB_suspend(void)
+
+   Summary:
+    Stop reading the memory areas.
+
+   Description:
+    This function must be called before an ECC test mode sequence, the
+    scrubber reads would use the test check bits.
+
+   Precondition:
+    APP_ECC_SCRUB_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ECC_SCRUB_suspend(void)
+{
+    scrubSuspended = true;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_SCRUB_resume(void)
+
+   Summary:
+    Read the memory areas again.
+
+   Precondition:
+    APP_ECC_SCRUB_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ECC_SCRUB_resume(void)
+{
+    scrubSuspended = false;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ECC_SCRUB_get_status(app_ecc_scrub_status_t* status)
+
+   Summary:
+    Get the ECC scrubber statistics.
+
+   Precondition:
+    APP_ECC_SCRUB_init must have been called.
+
+   Parameters:
+    status - pointer to the structure filled with the statistics.
+
+   Returns:
+    None.
+*/
+void APP_ECC_SCRUB_get_status(app_ecc_scrub_status_t* status)
+{
+    *status = scrubStatus;
+}
+
+/*******************************************************************************
+ End of File
+*/
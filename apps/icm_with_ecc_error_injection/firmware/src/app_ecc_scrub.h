@@ -0,0 +1,162 @@
+/*******************************************************************************
+  MPLAB Harmony Application ECC Scrub Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_ecc_scrub.h
+
+  Summary:
+    ECC memory scrubber Prototypes and definitions file.
+
+  Description:
+    The scrubber reads the ECC protected memory areas in chunks, within a
+    bandwidth budget per time slice, so that single bit errors are corrected
+    by the ECC fix interrupts before they add up to double errors.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_ECC_SCRUB_H
+#define	APP_ECC_SCRUB_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application ECC scrub memory area
+
+   Summary:
+    Memory area read by the ECC scrubber.
+
+   Description:
+    This data structure defines one memory area. The address and size must
+    be multiple of 4 bytes. cached must be set for
+    areas cached by the data cache (FlexRAM, external SDRAM) : the lines of
+    the chunk are cleaned and invalidated before it is read so that the read
+    reaches the memory and its ECC checker.
+
+   Remarks:
+    The whole area must have been written since power up, reading a word
+    never initialized triggers a not fixable error.
+*/
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+    bool cached;
+} app_ecc_scrub_area_t;
+
+// *****************************************************************************
+/* Application ECC scrub configuration
+
+   Summary:
+    ECC scrubber configuration structure.
+
+   Description:
+    At most budget_bytes are read in each slice of slice_period CPU cycles,
+    in chunks of chunk_size bytes. One chunk is read per call of
+    APP_ECC_SCRUB_task, chunk_size bounds the time spent in one call.
+
+   Remarks:
+    chunk_size must be a multiple of 4 bytes, not larger than budget_bytes.
+*/
+typedef struct
+{
+    const app_ecc_scrub_area_t* areas;
+    uint32_t area_num;
+    uint32_t chunk_size;
+    uint32_t budget_bytes;
+    uint32_t slice_period;
+} app_ecc_scrub_config_t;
+
+// *****************************************************************************
+/* Application ECC scrub status
+
+   Summary:
+    ECC scrubber statistics.
+
+   Description:
+    sweep_bytes is the total size of the areas and coverage_slices the number
+    of slices needed to read them once, computed at initialization from the
+    budget. sweep_period_ms is the planned full sweep period, coverage_slices
+    slices, and last_sweep_ms the measured period of the last sweep.
+    last_read_cycles is the CPU time spent reading during the last sweep.
+
+   Remarks:
+    Time is measured with the DWT cycle counter, APP_ECC_SCRUB_task must be
+    called at least once every 2^32 cycles (about 43 s at 100 MHz).
+*/
+typedef struct
+{
+    uint32_t sweep_count;
+    uint32_t sweep_bytes;
+    uint32_t coverage_slices;
+    uint32_t sweep_period_ms;
+    uint32_t last_sweep_ms;
+    uint32_t last_read_cycles;
+    uint32_t max_slice_bytes;
+} app_ecc_scrub_status_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool APP_ECC_SCRUB_init(const app_ecc_scrub_config_t* config);
+
+void APP_ECC_SCRUB_task(void);
+
+void APP_ECC_SCRUB_suspend(void);
+
+void APP_ECC_SCRUB_resume(void);
+
+void APP_ECC_SCRUB_get_status(app_ecc_scrub_status_t* status);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_ECC_SCRUB_H */
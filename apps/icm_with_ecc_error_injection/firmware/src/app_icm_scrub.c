@@ -0,0 +1,1058 @@
+/*******************************************************************************
+ MPLAB Harmony Application ICM Scrub Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_icm_scrub.c
+
+  Summary:
+    ICM scrub scheduler Implementation File
+
+  Description:
+    None
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include <stdio.h>
+#include <string.h>
+#include "app_icm_scrub.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Flags of app_icm_scrub_digest_t.learned */
+#define APP_ICM_SCRUB_LEARNED_DIGEST       (0x1U)
+#define APP_ICM_SCRUB_LEARNED_TREE         (0x2U)
+
+/* CPU cycles per millisecond, for the sweep period */
+#define APP_ICM_SCRUB_CYCLES_PER_MS        (CPU_CLOCK_FREQUENCY / 1000U)
+
+/* Scheduler phases : check a chunk, learn or check the digests of its sub-blocks */
+typedef enum
+{
+    APP_ICM_SCRUB_PHASE_CHUNK = 0,
+    APP_ICM_SCRUB_PHASE_TREE,
+    APP_ICM_SCRUB_PHASE_LOCATE
+} app_icm_scrub_phase_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Descriptors of the ICM job : one chunk or up to ICM_REGION_NUM sub-blocks */
+static icm_descriptor_registers_t __attribute__((aligned (64))) scrubDescriptor[ICM_REGION_NUM];
+
+/* Region list holding the job descriptors */
+static ICM_REGION_LIST scrubList;
+
+/* Hash area of the sub-block jobs */
+static uint32_t __attribute__((aligned (128))) scrubNodeHash[ICM_REGION_NUM][ICM_HASH_REGION_SIZE / 4U];
+
+/* Scrub configuration */
+static const app_icm_scrub_config_t* scrubConfig;
+
+/* Scrub statistics */
+static app_icm_scrub_status_t scrubStatus;
+
+/* Current position : area index, offset in the area and digest index */
+static uint32_t scrubArea;
+static uint32_t scrubOffset;
+static uint32_t scrubDigest;
+
+/* Size in bytes of the chunk being hashed */
+static uint32_t scrubChunkBytes;
+
+/* Start of the current slice and bytes given to the ICM during this slice */
+static uint32_t scrubSliceStart;
+static uint32_t scrubSliceBytes;
+
+/* Cycles of the current sweep, accumulated at each call of the task */
+static uint64_t scrubSweepCycles;
+static uint32_t scrubLastCall;
+
+/* Scheduler states */
+static bool scrubBusy;
+static bool scrubSuspended;
+static bool scrubLearning;
+static app_icm_scrub_phase_t scrubPhase;
+
+/* Sub-block tree : number of levels below the chunk and of nodes per chunk */
+static uint32_t scrubTreeDepth;
+static uint32_t scrubTreeNodes;
+
+/* Tree level in progress, next node of the level, nodes to check and nodes found corrupted */
+static uint32_t scrubLevel;
+static uint32_t scrubNode;
+static uint32_t scrubCandidates;
+static uint32_t scrubFound;
+
+/* Sub-blocks of the ICM job, one per region, and next node after the job */
+static uint32_t scrubJobNodes[ICM_REGION_NUM];
+static uint32_t scrubJobNum;
+static uint32_t scrubJobNext;
+
+/* Interrupt ending the ICM job */
+static ICM_INT_MSK scrubJobEnd;
+
+/* Events set by the ICM interrupt */
+static volatile bool scrubHashDone;
+static volatile bool scrubMismatch;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_callback(uintptr_t context)
+
+   Summary:
+    ICM interrupt callback.
+
+   Description:
+    This function records the end of the job and the digest mismatch
+    events, and stops the ICM at the end of the job.
+
+   Parameters:
+    context - not used.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_callback(uintptr_t context)
+{
+    ICM_INT_MSK status = (ICM_InterruptGet() & ICM_InterruptMasked());
+    (void)context;
+
+    if ( ( status & ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK ) != 0U )
+    {
+        scrubMismatch = true;
+    }
+
+    if ( ( status & (scrubJobEnd | ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK) ) != 0U )
+    {
+        ICM_InterruptDisable(scrubJobEnd | ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK);
+        ICM_Disable();
+        scrubHashDone = true;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_wait_idle(void)
+
+   Summary:
+    Wait the ICM is disabled.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_wait_idle(void)
+{
+    while ( (ICM_StatusGet() & ICM_STATUS_ENABLE) == ICM_STATUS_ENABLE )
+    {
+        /* Wait end of current memory region monitored */
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_ICM_SCRUB_chunk_size(void)
+
+   Summary:
+    Size of the chunk at the current position.
+
+   Parameters:
+    None.
+
+   Returns:
+    Size in bytes of the chunk, the last chunk of an area may be smaller
+    than the configured chunk size.
+*/
+static uint32_t APP_ICM_SCRUB_chunk_size(void)
+{
+    uint32_t remaining = scrubConfig->areas[scrubArea].size - scrubOffset;
+
+    return (remaining < scrubConfig->chunk_size) ? remaining : scrubConfig->chunk_size;
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_ICM_SCRUB_node_size(uint32_t level, uint32_t node)
+
+   Summary:
+    Size of a sub-block of the current chunk.
+
+   Description:
+    At level n the chunk is split in 2^n sub-blocks of chunk_size / 2^n
+    bytes. The sub-blocks of a smaller last chunk may be shorter or empty.
+
+   Parameters:
+    level - tree level, from 1 to scrubTreeDepth.
+    node  - sub-block index in the level.
+
+   Returns:
+    Size in bytes of the sub-block, 0 if it is out of the chunk.
+*/
+static uint32_t APP_ICM_SCRUB_node_size(uint32_t level, uint32_t node)
+{
+    uint32_t size = scrubConfig->chunk_size >> level;
+    uint32_t start = node * size;
+
+    if ( start >= scrubChunkBytes )
+    {
+        return 0U;
+    }
+
+    return ((scrubChunkBytes - start) < size) ? (scrubChunkBytes - start) : size;
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t* APP_ICM_SCRUB_node_digest(uint32_t level, uint32_t node)
+
+   Summary:
+    Reference digest of a sub-block of the current chunk.
+
+   Parameters:
+    level - tree level, from 1 to scrubTreeDepth.
+    node  - sub-block index in the level.
+
+   Returns:
+    Pointer to the digest words.
+*/
+static uint32_t* APP_ICM_SCRUB_node_digest(uint32_t level, uint32_t node)
+{
+    return scrubConfig->tree[(scrubDigest * scrubTreeNodes) + ((1UL << level) - 2U) + node];
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_ICM_SCRUB_next_nodes(void)
+
+   Summary:
+    Select the sub-blocks of the next job.
+
+   Description:
+    Up to ICM_REGION_NUM sub-blocks of the current level are hashed by one
+    ICM job, one per region. When learning, all sub-blocks of the level are
+    selected, when locating only the candidate ones.
+
+   Parameters:
+    None.
+
+   Returns:
+    Number of bytes of the job, 0 if the level is completed.
+*/
+static uint32_t APP_ICM_SCRUB_next_nodes(void)
+{
+    uint32_t node = scrubNode;
+    uint32_t bytes = 0U;
+
+    scrubJobNum = 0U;
+    while ( ( node < (1UL << scrubLevel) ) && ( scrubJobNum < ICM_REGION_NUM ) )
+    {
+        uint32_t size = APP_ICM_SCRUB_node_size(scrubLevel, node);
+
+        if ( ( size != 0U ) &&
+             ( ( scrubPhase == APP_ICM_SCRUB_PHASE_TREE ) || ( (scrubCandidates & (1UL << node)) != 0U ) ) )
+        {
+            scrubJobNodes[scrubJobNum] = node;
+            scrubJobNum++;
+            bytes += size;
+        }
+        node++;
+    }
+    scrubJobNext = node;
+
+    return bytes;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_start_job(void)
+
+   Summary:
+    Start the ICM on the current chunk or on the selected sub-blocks.
+
+   Description:
+    For a chunk, a one region list is built and its digest entry is used as
+    hash area. A chunk not yet learned is hashed with write back enabled to
+    store its reference digest, otherwise the ICM compares the digest.
+    Sub-blocks are hashed with write back enabled in a temporary hash area,
+    one region each, and compared by the CPU.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_start_job(void)
+{
+    uint32_t address = scrubConfig->areas[scrubArea].address + scrubOffset;
+    ICM_REGION_RANGE ranges[ICM_REGION_NUM];
+    uint32_t rangeNum;
+    uint32_t hashAddr;
+    ICM_INT_MSK interrupts;
+
+    if ( scrubPhase == APP_ICM_SCRUB_PHASE_CHUNK )
+    {
+        app_icm_scrub_digest_t* digest = &scrubConfig->digests[scrubDigest];
+
+        ranges[0] = (ICM_REGION_RANGE)
+        {
+            .region = 0U,
+            .address = address,
+            .size = scrubChunkBytes,
+            .algo = scrubConfig->algo,
+            .interrupts = ICM_REGION_INT_HASH | ICM_REGION_INT_DIGEST_MISMATCH,
+            .processingDelay = scrubConfig->processing_delay,
+        };
+        rangeNum = 1U;
+        hashAddr = (uint32_t)digest;
+        scrubLearning = (digest->learned == 0U);
+        interrupts = ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK;
+    }
+    else
+    {
+        uint32_t index;
+
+        for (index = 0U; index < scrubJobNum; index++)
+        {
+            uint32_t node = scrubJobNodes[index];
+
+            ranges[index] = (ICM_REGION_RANGE)
+            {
+                .region = (uint8_t)index,
+                .address = address + (node * (scrubConfig->chunk_size >> scrubLevel)),
+                .size = APP_ICM_SCRUB_node_size(scrubLevel, node),
+                .algo = scrubConfig->algo,
+                .interrupts = ICM_REGION_INT_HASH,
+                .processingDelay = scrubConfig->processing_delay,
+            };
+        }
+        rangeNum = scrubJobNum;
+        hashAddr = (uint32_t)scrubNodeHash;
+        scrubLearning = true;
+        interrupts = 0U;
+    }
+
+    /* Ranges are checked by APP_ICM_SCRUB_init */
+    (void)ICM_RegionListBuild(&scrubList, ranges, rangeNum);
+    ICM_WriteBackDisable(scrubLearning == false);
+    (void)ICM_RegionListSwap(&scrubList, hashAddr);
+
+    /* Regions are processed in order : the job ends with the hash of the last one */
+    scrubJobEnd = ICM_IER_RHC(1UL << (rangeNum - 1U));
+    scrubHashDone = false;
+    scrubMismatch = false;
+    scrubBusy = true;
+
+    ICM_MonitorEnable(ICM_RegionListMaskGet(&scrubList));
+    ICM_InterruptEnable(scrubJobEnd | interrupts);
+    ICM_Enable();
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_report(uint32_t address, uint32_t size)
+
+   Summary:
+    Report a corrupted block of the current area.
+
+   Parameters:
+    address - start address of the block.
+    size    - size in bytes of the block.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_report(uint32_t address, uint32_t size)
+{
+    scrubStatus.block_count++;
+    if ( scrubConfig->callback != NULL )
+    {
+        scrubConfig->callback(scrubArea, address, size, scrubConfig->context);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_next_chunk(void)
+
+   Summary:
+    Move to the next chunk.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_next_chunk(void)
+{
+    scrubPhase = APP_ICM_SCRUB_PHASE_CHUNK;
+    scrubOffset += scrubChunkBytes;
+    scrubDigest++;
+    if ( scrubOffset >= scrubConfig->areas[scrubArea].size )
+    {
+        scrubOffset = 0U;
+        scrubArea++;
+        if ( scrubArea >= scrubConfig->area_num )
+        {
+            scrubArea = 0U;
+            scrubDigest = 0U;
+            scrubStatus.sweep_count++;
+            scrubStatus.last_sweep_ms = (uint32_t)(scrubSweepCycles / APP_ICM_SCRUB_CYCLES_PER_MS);
+            scrubSweepCycles = 0U;
+        }
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_start_level(app_icm_scrub_phase_t phase, uint32_t level, uint32_t candidates)
+
+   Summary:
+    Start to learn or check a level of the sub-block tree.
+
+   Parameters:
+    phase      - APP_ICM_SCRUB_PHASE_TREE or APP_ICM_SCRUB_PHASE_LOCATE.
+    level      - tree level.
+    candidates - bitfield of the sub-blocks to check when locating.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_start_level(app_icm_scrub_phase_t phase, uint32_t level, uint32_t candidates)
+{
+    scrubPhase = phase;
+    scrubLevel = level;
+    scrubNode = 0U;
+    scrubCandidates = candidates;
+    scrubFound = 0U;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_end_chunk(void)
+
+   Summary:
+    Handle the end of a chunk hash.
+
+   Description:
+    A learned chunk continues with the learning of its sub-block digests.
+    A corrupted chunk is bisected when its sub-block digests are known,
+    otherwise the whole chunk is reported.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_end_chunk(void)
+{
+    app_icm_scrub_digest_t* digest = &scrubConfig->digests[scrubDigest];
+
+    if ( scrubLearning == true )
+    {
+        digest->learned = APP_ICM_SCRUB_LEARNED_DIGEST;
+    }
+    else if ( scrubMismatch == true )
+    {
+        scrubStatus.mismatch_count++;
+        if ( ( scrubTreeDepth != 0U ) && ( (digest->learned & APP_ICM_SCRUB_LEARNED_TREE) != 0U ) )
+        {
+            APP_ICM_SCRUB_start_level(APP_ICM_SCRUB_PHASE_LOCATE, 1U, 0x3U);
+            return;
+        }
+        APP_ICM_SCRUB_report(scrubConfig->areas[scrubArea].address + scrubOffset, scrubChunkBytes);
+        APP_ICM_SCRUB_next_chunk();
+        return;
+    }
+    else
+    {
+        /* Chunk digest match */
+    }
+
+    /* Sub-block digests are learned from a chunk known to be correct */
+    if ( ( scrubTreeDepth != 0U ) && ( (digest->learned & APP_ICM_SCRUB_LEARNED_TREE) == 0U ) )
+    {
+        APP_ICM_SCRUB_start_level(APP_ICM_SCRUB_PHASE_TREE, 1U, 0U);
+        return;
+    }
+
+    APP_ICM_SCRUB_next_chunk();
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_end_nodes(void)
+
+   Summary:
+    Handle the end of a sub-block job.
+
+   Description:
+    When learning, the sub-block digests are stored in the tree. When
+    locating, they are compared with the tree and the children of the
+    corrupted sub-blocks are checked at the next level, down to the
+    configured granularity.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_end_nodes(void)
+{
+    uint32_t index;
+
+    /* Hash area is written by the ICM */
+    if ( DATA_CACHE_IS_ENABLED() != 0U )
+    {
+        DCACHE_INVALIDATE_BY_ADDR((uint32_t *)scrubNodeHash, (int32_t)sizeof(scrubNodeHash));
+    }
+
+    for (index = 0U; index < scrubJobNum; index++)
+    {
+        uint32_t* reference = APP_ICM_SCRUB_node_digest(scrubLevel, scrubJobNodes[index]);
+
+        if ( scrubPhase == APP_ICM_SCRUB_PHASE_TREE )
+        {
+            memcpy(reference, scrubNodeHash[index], sizeof(scrubNodeHash[index]));
+        }
+        else if ( memcmp(reference, scrubNodeHash[index], sizeof(scrubNodeHash[index])) != 0 )
+        {
+            scrubFound |= (1UL << scrubJobNodes[index]);
+        }
+        else
+        {
+            /* Sub-block digest match */
+        }
+    }
+
+    scrubNode = scrubJobNext;
+    if ( APP_ICM_SCRUB_next_nodes() != 0U )
+    {
+        /* Level not completed */
+        return;
+    }
+
+    if ( scrubPhase == APP_ICM_SCRUB_PHASE_TREE )
+    {
+        if ( scrubLevel < scrubTreeDepth )
+        {
+            APP_ICM_SCRUB_start_level(APP_ICM_SCRUB_PHASE_TREE, scrubLevel + 1U, 0U);
+            return;
+        }
+        scrubConfig->digests[scrubDigest].learned |= APP_ICM_SCRUB_LEARNED_TREE;
+    }
+    else if ( scrubFound == 0U )
+    {
+        /* Corruption no longer visible in the sub-blocks : report the chunk */
+        APP_ICM_SCRUB_report(scrubConfig->areas[scrubArea].address + scrubOffset, scrubChunkBytes);
+    }
+    else if ( scrubLevel < scrubTreeDepth )
+    {
+        uint32_t children = 0U;
+
+        for (index = 0U; index < (1UL << scrubLevel); index++)
+        {
+            if ( (scrubFound & (1UL << index)) != 0U )
+            {
+                children |= (0x3UL << (2U * index));
+            }
+        }
+        APP_ICM_SCRUB_start_level(APP_ICM_SCRUB_PHASE_LOCATE, scrubLevel + 1U, children);
+        return;
+    }
+    else
+    {
+        uint32_t blockSize = scrubConfig->chunk_size >> scrubTreeDepth;
+
+        for (index = 0U; index < (1UL << scrubTreeDepth); index++)
+        {
+            if ( (scrubFound & (1UL << index)) != 0U )
+            {
+                APP_ICM_SCRUB_report(scrubConfig->areas[scrubArea].address + scrubOffset + (index * blockSize),
+                                     APP_ICM_SCRUB_node_size(scrubTreeDepth, index));
+            }
+        }
+    }
+
+    APP_ICM_SCRUB_next_chunk();
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_ICM_SCRUB_end_job(void)
+
+   Summary:
+    Handle the end of the ICM job.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_ICM_SCRUB_end_job(void)
+{
+    APP_ICM_SCRUB_wait_idle();
+    scrubBusy = false;
+
+    if ( scrubPhase == APP_ICM_SCRUB_PHASE_CHUNK )
+    {
+        APP_ICM_SCRUB_end_chunk();
+    }
+    else
+    {
+        APP_ICM_SCRUB_end_nodes();
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Initialization and State Machine Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool APP_ICM_SCRUB_init(const app_icm_scrub_config_t* config)
+
+   Summary:
+    Initialize the ICM scrub scheduler.
+
+   Description:
+    This function checks the configuration, computes the full coverage period
+    and takes control of the ICM. All chunks are learned during the first
+    sweep.
+
+   Precondition:
+    ICM_Initialize must have been called.
+
+   Parameters:
+    config - scrub configuration, must stay valid while the scheduler is used.
+
+   Returns:
+    true if the configuration is valid.
+*/
+bool APP_ICM_SCRUB_init(const app_icm_scrub_config_t* config)
+{
+    uint32_t chunkCount = 0U;
+    uint32_t slices = 1U;
+    uint32_t sliceBytes = 0U;
+    uint32_t treeDepth = 0U;
+    uint32_t index;
+
+    if ( ( config->area_num == 0U ) ||
+         ( config->chunk_size == 0U ) ||
+         ( (config->chunk_size % ICM_BLOCK_SIZE) != 0U ) ||
+         ( config->chunk_size > config->budget_bytes ) ||
+         ( config->chunk_size > ICM_DESCRIPTOR_MAX_SIZE ) ||
+         ( config->slice_period == 0U ) ||
+         ( config->bus_burden > 15U ) )
+    {
+        return false;
+    }
+
+    /* Localization splits the chunk in 2^depth blocks of granularity bytes */
+    if ( ( config->granularity != 0U ) && ( config->granularity != config->chunk_size ) )
+    {
+        if ( ( (config->granularity % ICM_BLOCK_SIZE) != 0U ) ||
+             ( config->granularity > config->chunk_size ) ||
+             ( (config->chunk_size % config->granularity) != 0U ) )
+        {
+            return false;
+        }
+        while ( (config->granularity << treeDepth) < config->chunk_size )
+        {
+            treeDepth++;
+        }
+        if ( ( (config->granularity << treeDepth) != config->chunk_size ) || ( treeDepth > 5U ) )
+        {
+            /* Block number must be a power of 2, at most 32 */
+            return false;
+        }
+    }
+
+    /* Count the chunks and pack them in slices as APP_ICM_SCRUB_task does */
+    for (index = 0U; index < config->area_num; index++)
+    {
+        const app_icm_scrub_area_t* area = &config->areas[index];
+        uint32_t offset;
+
+        if ( ( area->size == 0U ) ||
+             ( (area->size % ICM_BLOCK_SIZE) != 0U ) ||
+             ( (area->address & 0x3UL) != 0U ) )
+        {
+            return false;
+        }
+
+        for (offset = 0U; offset < area->size; offset += config->chunk_size)
+        {
+            uint32_t bytes = area->size - offset;
+
+            if ( bytes > config->chunk_size )
+            {
+                bytes = config->chunk_size;
+            }
+            if ( (sliceBytes + bytes) > config->budget_bytes )
+            {
+                slices++;
+                sliceBytes = 0U;
+            }
+            sliceBytes += bytes;
+            chunkCount++;
+        }
+    }
+
+    if ( ( chunkCount > config->digest_num ) ||
+         ( ( config->golden != NULL ) && ( config->golden_num != chunkCount ) ) ||
+         ( ( treeDepth != 0U ) &&
+           ( ( config->tree == NULL ) ||
+             ( config->tree_num < APP_ICM_SCRUB_TREE_COUNT(chunkCount, config->chunk_size, config->granularity) ) ) ) )
+    {
+        return false;
+    }
+
+    ICM_Disable();
+    APP_ICM_SCRUB_wait_idle();
+
+    scrubConfig = config;
+    scrubStatus = (app_icm_scrub_status_t){ 0 };
+    scrubStatus.coverage_slices = slices;
+    scrubStatus.chunk_count = chunkCount;
+    scrubArea = 0U;
+    scrubOffset = 0U;
+    scrubDigest = 0U;
+    scrubBusy = false;
+    scrubSuspended = false;
+    scrubPhase = APP_ICM_SCRUB_PHASE_CHUNK;
+    scrubTreeDepth = treeDepth;
+    scrubTreeNodes = (2UL << treeDepth) - 2U;
+
+    /* Reference digests are loaded from the golden table or written by the ICM */
+    for (index = 0U; index < chunkCount; index++)
+    {
+        if ( config->golden != NULL )
+        {
+            memcpy(config->digests[index].hash, config->golden[index], sizeof(config->digests[index].hash));
+            config->digests[index].learned = APP_ICM_SCRUB_LEARNED_DIGEST;
+        }
+        else
+        {
+            config->digests[index].learned = 0U;
+        }
+    }
+    if ( DATA_CACHE_IS_ENABLED() != 0U )
+    {
+        DCACHE_CLEAN_INVALIDATE_BY_ADDR((uint32_t *)config->digests,
+                                        (int32_t)(chunkCount * sizeof(app_icm_scrub_digest_t)));
+        DCACHE_CLEAN_INVALIDATE_BY_ADDR((uint32_t *)scrubNodeHash, (int32_t)sizeof(scrubNodeHash));
+    }
+
+    ICM_BusBurdenSet(config->bus_burden);
+    ICM_RegionListInit(&scrubList, scrubDescriptor, ICM_REGION_NUM, false);
+    ICM_CallbackRegister(APP_ICM_SCRUB_callback, (uintptr_t)NULL);
+
+    /* Slices and sweeps are timed with the DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    scrubSliceStart = DWT->CYCCNT;
+    scrubSliceBytes = 0U;
+    scrubLastCall = scrubSliceStart;
+    scrubSweepCycles = 0U;
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ICM_SCRUB_task(void)
+
+   Summary:
+    Scrub scheduler task.
+
+   Description:
+    This function handles the end of the current job and starts the next
+    one when it fits in the budget of the current slice. It must be called
+    from the main loop at least once per slice to reach the coverage period.
+
+   Precondition:
+    APP_ICM_SCRUB_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ICM_SCRUB_task(void)
+{
+    uint32_t now = DWT->CYCCNT;
+    uint32_t elapsed = now - scrubSliceStart;
+
+    scrubSweepCycles += (uint32_t)(now - scrubLastCall);
+    scrubLastCall = now;
+
+    if ( elapsed >= scrubConfig->slice_period )
+    {
+        scrubSliceStart += (elapsed / scrubConfig->slice_period) * scrubConfig->slice_period;
+        scrubSliceBytes = 0U;
+    }
+
+    if ( ( scrubBusy == true ) && ( scrubHashDone == true ) )
+    {
+        APP_ICM_SCRUB_end_job();
+    }
+
+    if ( ( scrubBusy == false ) && ( scrubSuspended == false ) )
+    {
+        uint32_t jobBytes;
+
+        if ( scrubPhase == APP_ICM_SCRUB_PHASE_CHUNK )
+        {
+            scrubChunkBytes = APP_ICM_SCRUB_chunk_size();
+            jobBytes = scrubChunkBytes;
+        }
+        else
+        {
+            jobBytes = APP_ICM_SCRUB_next_nodes();
+        }
+
+        if ( (scrubSliceBytes + jobBytes) <= scrubConfig->budget_bytes )
+        {
+            scrubSliceBytes += jobBytes;
+            if ( scrubSliceBytes > scrubStatus.max_slice_bytes )
+            {
+                scrubStatus.max_slice_bytes = scrubSliceBytes;
+            }
+            APP_ICM_SCRUB_start_job();
+        }
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ICM_SCRUB_suspend(void)
+
+   Summary:
+    Stop the ICM accesses.
+
+   Description:
+    The ICM is stopped immediately. A job not completed is started again
+    after APP_ICM_SCRUB_resume.
+
+   Precondition:
+    APP_ICM_SCRUB_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ICM_SCRUB_suspend(void)
+{
+    scrubSuspended = true;
+
+    if ( scrubBusy == true )
+    {
+        ICM_Disable();
+        APP_ICM_SCRUB_wait_idle();
+
+        if ( scrubHashDone == false )
+        {
+            ICM_InterruptDisable(scrubJobEnd | ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK);
+            ICM_MonitorDisable(ICM_RegionListMaskGet(&scrubList));
+            scrubBusy = false;
+        }
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ICM_SCRUB_resume(void)
+
+   Summary:
+    Allow the ICM accesses again.
+
+   Precondition:
+    APP_ICM_SCRUB_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ICM_SCRUB_resume(void)
+{
+    scrubSuspended = false;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ICM_SCRUB_relearn(uint32_t area)
+
+   Summary:
+    Learn again the reference digests of an area.
+
+   Description:
+    This function must be called after the application modified the content
+    of an area, the new digests are stored during the next sweep.
+
+   Precondition:
+    APP_ICM_SCRUB_init must have been called.
+
+   Parameters:
+    area - index of the area in the configuration.
+
+   Returns:
+    None.
+*/
+void APP_ICM_SCRUB_relearn(uint32_t area)
+{
+    uint32_t first = 0U;
+    uint32_t index;
+
+    if ( area >= scrubConfig->area_num )
+    {
+        return;
+    }
+
+    for (index = 0U; index < area; index++)
+    {
+        first += APP_ICM_SCRUB_DIGEST_COUNT(scrubConfig->areas[index].size, scrubConfig->chunk_size);
+    }
+
+    for (index = 0U; index < APP_ICM_SCRUB_DIGEST_COUNT(scrubConfig->areas[area].size, scrubConfig->chunk_size); index++)
+    {
+        scrubConfig->digests[first + index].learned = 0U;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ICM_SCRUB_get_status(app_icm_scrub_status_t* status)
+
+   Summary:
+    Get the scrub scheduler statistics.
+
+   Precondition:
+    APP_ICM_SCRUB_init must have been called.
+
+   Parameters:
+    status - pointer to the structure filled with the statistics.
+
+   Returns:
+    None.
+*/
+void APP_ICM_SCRUB_get_status(app_icm_scrub_status_t* status)
+{
+    *status = scrubStatus;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_ICM_SCRUB_print_digests(void)
+
+   Summary:
+    Print the reference digest of each chunk.
+
+   Description:
+    One line "ICM_DIGEST <chunk> <address> <size>: <8 words>" is printed per
+    learned chunk. The log can be checked on the host with tools/icm_digest.
+
+   Precondition:
+    APP_ICM_SCRUB_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_ICM_SCRUB_print_digests(void)
+{
+    uint32_t area;
+    uint32_t chunk = 0U;
+
+    /* Digests are written by the ICM behind the cache */
+    if ( DATA_CACHE_IS_ENABLED() != 0U )
+    {
+        DCACHE_CLEAN_INVALIDATE_BY_ADDR((uint32_t *)scrubConfig->digests,
+                                        (int32_t)(scrubStatus.chunk_count * sizeof(app_icm_scrub_digest_t)));
+    }
+
+    for (area = 0U; area < scrubConfig->area_num; area++)
+    {
+        uint32_t offset;
+
+        for (offset = 0U; offset < scrubConfig->areas[area].size; offset += scrubConfig->chunk_size)
+        {
+            const app_icm_scrub_digest_t* digest = &scrubConfig->digests[chunk];
+            uint32_t size = scrubConfig->areas[area].size - offset;
+
+            if ( size > scrubConfig->chunk_size )
+            {
+                size = scrubConfig->chunk_size;
+            }
+            if ( digest->learned != 0U )
+            {
+                printf("ICM_DIGEST %u 0x%08x %u: %08x %08x %08x %08x %08x %08x %08x %08x\n\r",
+                        (unsigned int)chunk, (unsigned int)(scrubConfig->areas[area].address + offset), (unsigned int)size,
+                        (unsigned int)digest->hash[0], (unsigned int)digest->hash[1],
+                        (unsigned int)digest->hash[2], (unsigned int)digest->hash[3],
+                        (unsigned int)digest->hash[4], (unsigned int)digest->hash[5],
+                        (unsigned int)digest->hash[6], (unsigned int)digest->hash[7]);
+            }
+            chunk++;
+        }
+    }
+}
@@ -0,0 +1,232 @@
+/*******************************************************************************
+  MPLAB Harmony Application ICM Scrub Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_icm_scrub.h
+
+  Summary:
+    ICM scrub scheduler Prototypes and definitions file.
+
+  Description:
+    The scrub scheduler splits the monitored memory areas in chunks and lets
+    the ICM hash one chunk at a time, within a bandwidth budget per time slice.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_ICM_SCRUB_H
+#define	APP_ICM_SCRUB_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include "peripheral/icm/plib_icm.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Number of digests needed to scrub an area of size bytes with chunk bytes chunks */
+#define APP_ICM_SCRUB_DIGEST_COUNT(size, chunk)        (((size) + (chunk) - 1UL) / (chunk))
+
+/* Number of sub-block digests needed to locate corrupted blocks of granularity bytes in chunks chunks */
+#define APP_ICM_SCRUB_TREE_COUNT(chunks, chunk, granularity) ((chunks) * ((2UL * ((chunk) / (granularity))) - 2UL))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application ICM scrub memory area
+
+   Summary:
+    Memory area checked by the scrub scheduler.
+
+   Description:
+    This data structure defines one memory area. The address must be word
+    aligned and the size a multiple of ICM_BLOCK_SIZE.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+} app_icm_scrub_area_t;
+
+// *****************************************************************************
+/* Application ICM scrub chunk digest
+
+   Summary:
+    Reference digest of one chunk.
+
+   Description:
+    The ICM hash area of a chunk. The ICM writes the digest in the first
+    32 bytes when the chunk is learned and compares against it afterwards.
+
+   Remarks:
+    The ICM requires a hash area aligned on ICM_HASH_AREA_ALIGN bytes, the
+    learned flag is kept in the alignment padding.
+*/
+typedef struct
+{
+    uint32_t hash[ICM_HASH_REGION_SIZE / 4U];
+    volatile uint32_t learned;
+} __attribute__((aligned (128))) app_icm_scrub_digest_t;
+
+// *****************************************************************************
+/* Application ICM scrub mismatch callback
+
+   Summary:
+    Function called when the digest of a chunk does not match.
+
+   Description:
+    The callback is called from APP_ICM_SCRUB_task with the area index and
+    the address and size of the corrupted block : a block of granularity
+    bytes when localization is enabled, the whole chunk otherwise. The ICM
+    is stopped while the callback runs, the block can be repaired in place.
+
+   Remarks:
+    None.
+*/
+typedef void (*app_icm_scrub_callback_t)(uint32_t area, uint32_t address, uint32_t size, uintptr_t context);
+
+// *****************************************************************************
+/* Application ICM scrub configuration
+
+   Summary:
+    Scrub scheduler configuration structure.
+
+   Description:
+    At most budget_bytes are given to the ICM in each slice of slice_period
+    CPU cycles, in chunks of chunk_size bytes. A chunk is never started if it
+    does not fit in what remains of the budget of the current slice.
+
+   Remarks:
+    chunk_size must be a multiple of ICM_BLOCK_SIZE, not larger than
+    budget_bytes nor ICM_DESCRIPTOR_MAX_SIZE. digests must hold one entry per
+    chunk of every area (see APP_ICM_SCRUB_DIGEST_COUNT). When golden is not
+    NULL, it holds golden_num reference digests generated on the host by
+    tools/icm_digest and the ICM compares from the first sweep.
+
+    When granularity is smaller than chunk_size, a corrupted chunk is
+    bisected down to blocks of granularity bytes. chunk_size / granularity
+    must be a power of 2 up to 32 and tree must hold the sub-block digests
+    (see APP_ICM_SCRUB_TREE_COUNT), learned after each chunk digest.
+*/
+typedef struct
+{
+    const app_icm_scrub_area_t* areas;
+    uint32_t area_num;
+    app_icm_scrub_digest_t* digests;
+    uint32_t digest_num;
+    const uint32_t (*golden)[ICM_HASH_REGION_SIZE / 4U];
+    uint32_t golden_num;
+    uint32_t granularity;
+    uint32_t (*tree)[ICM_HASH_REGION_SIZE / 4U];
+    uint32_t tree_num;
+    uint32_t chunk_size;
+    uint32_t budget_bytes;
+    uint32_t slice_period;
+    ICM_ALGO algo;
+    /* Slow down the SHA engine and the ICM bus accesses inside a chunk */
+    bool processing_delay;
+    uint8_t bus_burden;
+    app_icm_scrub_callback_t callback;
+    uintptr_t context;
+} app_icm_scrub_config_t;
+
+// *****************************************************************************
+/* Application ICM scrub status
+
+   Summary:
+    Scrub scheduler statistics.
+
+   Description:
+    coverage_slices is the number of slices needed to check every chunk once,
+    computed at initialization from the budget. It is an upper bound of the
+    full coverage period as long as the ICM processes a chunk in less than
+    one slice. last_sweep_ms is the measured period of the last sweep.
+    mismatch_count counts the corrupted chunks and block_count the reported
+    blocks.
+
+   Remarks:
+    Time is measured with the DWT cycle counter, APP_ICM_SCRUB_task must be
+    called at least once every 2^32 cycles (about 43 s at 100 MHz).
+*/
+typedef struct
+{
+    uint32_t sweep_count;
+    uint32_t coverage_slices;
+    uint32_t last_sweep_ms;
+    uint32_t max_slice_bytes;
+    uint32_t mismatch_count;
+    uint32_t block_count;
+    uint32_t chunk_count;
+} app_icm_scrub_status_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool APP_ICM_SCRUB_init(const app_icm_scrub_config_t* config);
+
+void APP_ICM_SCRUB_task(void);
+
+void APP_ICM_SCRUB_suspend(void);
+
+void APP_ICM_SCRUB_resume(void);
+
+void APP_ICM_SCRUB_relearn(uint32_t area);
+
+void APP_ICM_SCRUB_get_status(app_icm_scrub_status_t* status);
+
+void APP_ICM_SCRUB_print_digests(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_ICM_SCRUB_H */
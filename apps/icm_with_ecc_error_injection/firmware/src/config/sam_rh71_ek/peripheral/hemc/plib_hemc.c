@@ -48,6 +48,17 @@
 
 static volatile HEMC_OBJ hemcObj;
 
+/* Control register of each chip select, the ECC enable bit is at the same position in all */
+static volatile uint32_t* const hemcCrNcsReg[HEMC_CHIP_SELECT_NUM] =
+{
+    &(HEMC_REGS->HEMC_CR_NCS0),
+    &(HEMC_REGS->HEMC_CR_NCS1),
+    &(HEMC_REGS->HEMC_CR_NCS2),
+    &(HEMC_REGS->HEMC_CR_NCS3),
+    &(HEMC_REGS->HEMC_CR_NCS4),
+    &(HEMC_REGS->HEMC_CR_NCS5),
+};
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: HEMC Implementation
@@ -192,85 +203,360 @@ void HEMC_Initialize( void )
 
 // *****************************************************************************
 /* Function:
-    void HEMC_DisableECC(uint8_t chipSelect);
+    static uint32_t HEMC_ECCIrqMask(void)
 
    Summary:
-    Disable the ECC for the given chip select.
+    Mask the HEMC ECC error interrupts.
+
+   Description:
+    The ECC error callbacks run from these interrupts and may change the ECC
+    enable of a chip select. They are masked while a change is in progress
+    so they cannot start another one in the middle of it.
+
+   Returns:
+    The interrupts enabled before, for HEMC_ECCIrqRestore.
+*/
+static uint32_t HEMC_ECCIrqMask(void)
+{
+    uint32_t enabled = 0U;
+
+    if ( NVIC_GetEnableIRQ(HEMC_INTFIX_IRQn) != 0U )
+    {
+        enabled |= 0x1U;
+    }
+    if ( NVIC_GetEnableIRQ(HEMC_INTNOFIX_IRQn) != 0U )
+    {
+        enabled |= 0x2U;
+    }
+    NVIC_DisableIRQ(HEMC_INTFIX_IRQn);
+    NVIC_DisableIRQ(HEMC_INTNOFIX_IRQn);
+    __DSB();
+    __ISB();
+
+    return enabled;
+}
+
+// *****************************************************************************
+/* Function:
+    static void HEMC_ECCIrqRestore(uint32_t enabled)
+
+   Summary:
+    Enable again the HEMC ECC error interrupts masked by HEMC_ECCIrqMask.
+*/
+static void HEMC_ECCIrqRestore(uint32_t enabled)
+{
+    if ( (enabled & 0x1U) != 0U )
+    {
+        NVIC_EnableIRQ(HEMC_INTFIX_IRQn);
+    }
+    if ( (enabled & 0x2U) != 0U )
+    {
+        NVIC_EnableIRQ(HEMC_INTNOFIX_IRQn);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static bool HEMC_ECCChangeStart(uint8_t enableMask, uint8_t disableMask, bool notify)
+
+   Summary:
+    Write the ECC enable bit of the chip selects to change.
+
+   Description:
+    Only the chip selects whose ECC enable bit differs from the requested one
+    are written, their register update is followed by HEMC_ECCIsBusy. The
+    completion callback is only called for a change started with notify,
+    from the asynchronous API. Such a change masks the HEMC ECC error
+    interrupts until HEMC_ECCIsBusy sees it complete.
 
    Precondition:
     None.
 
    Parameters:
-    chipSelect - The chip select for which ECC is disabled.
+    enableMask - chip selects (bit n for NCSn) for which ECC is enabled.
+    disableMask - chip selects (bit n for NCSn) for which ECC is disabled.
+    notify - call the completion callback when the change is complete.
 
    Returns:
-    True if ECC was disable for this chip select, False otherwise.
+    True if the change is started, False on a wrong mask or when a change is
+    in progress.
 */
-bool HEMC_DisableECC(uint8_t chipSelect)
+static bool HEMC_ECCChangeStart(uint8_t enableMask, uint8_t disableMask, bool notify)
 {
-    bool ret = false;
-    volatile uint32_t* pHemcCrNcsReg = NULL;
-    uint32_t hemcCrEnableMask = 0;
-    bool DisEccCheck = true;
+    uint8_t chipSelect;
+    uint8_t pendingMask = 0U;
 
-    switch (chipSelect)
+    if ( ( ((enableMask | disableMask) & ~HEMC_CHIP_SELECT_ALL) != 0U ) ||
+         ( (enableMask & disableMask) != 0U ) ||
+         ( hemcObj.ecc_pending != 0U ) )
     {
-        case 0:
-        {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS0);
-            hemcCrEnableMask = HEMC_CR_NCS0_ECC_ENABLE_Msk;
-            break;
-        }
-        case 1:
-        {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS1);
-            hemcCrEnableMask = HEMC_CR_NCS1_ECC_ENABLE_Msk;
-            break;
-        }
-        case 2:
+        return false;
+    }
+
+    if ( notify == true )
+    {
+        hemcObj.ecc_irq_enabled = HEMC_ECCIrqMask();
+        hemcObj.ecc_irq_masked = true;
+    }
+
+    for (chipSelect = 0U; chipSelect < HEMC_CHIP_SELECT_NUM; chipSelect++)
+    {
+        volatile uint32_t* pHemcCrNcsReg = hemcCrNcsReg[chipSelect];
+        uint8_t chipSelectMask = (uint8_t)(1U << chipSelect);
+
+        if ( ( (enableMask & chipSelectMask) != 0U ) &&
+             ( (*pHemcCrNcsReg & HEMC_CR_NCS0_ECC_ENABLE_Msk) == 0U ) )
         {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS2);
-            hemcCrEnableMask = HEMC_CR_NCS2_ECC_ENABLE_Msk;
-            break;
+            *pHemcCrNcsReg |= HEMC_CR_NCS0_ECC_ENABLE_Msk;
+            pendingMask |= chipSelectMask;
         }
-        case 3:
+        else if ( ( (disableMask & chipSelectMask) != 0U ) &&
+                  ( (*pHemcCrNcsReg & HEMC_CR_NCS0_ECC_ENABLE_Msk) != 0U ) )
         {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS3);
-            hemcCrEnableMask = HEMC_CR_NCS3_ECC_ENABLE_Msk;
-            break;
+            *pHemcCrNcsReg &= ~(HEMC_CR_NCS0_ECC_ENABLE_Msk);
+            pendingMask |= chipSelectMask;
         }
-        case 4:
+        else
         {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS4);
-            hemcCrEnableMask = HEMC_CR_NCS4_ECC_ENABLE_Msk;
-            break;
+            /* Nothing to do */
         }
-        case 5:
+    }
+
+    hemcObj.ecc_enable = enableMask;
+    hemcObj.ecc_pending = pendingMask;
+    hemcObj.ecc_notify = notify;
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    bool HEMC_ECCConfigureStart(uint8_t enableMask, uint8_t disableMask)
+
+   Summary:
+    Start to enable and disable the ECC of several chip selects.
+
+   Description:
+    The ECC enable bit of all the chip selects of both masks is written in
+    one pass, the function does not wait for the register update. Completion
+    is polled with HEMC_ECCIsBusy, which calls the callback registered with
+    HEMC_ECCCallbackRegister. Chip selects in none of the masks are not
+    changed.
+
+   Precondition:
+    None.
+
+   Parameters:
+    enableMask - chip selects (bit n for NCSn) for which ECC is enabled.
+    disableMask - chip selects (bit n for NCSn) for which ECC is disabled.
+
+   Returns:
+    True if the change is started, False on a chip select out of range, a
+    chip select in both masks or when a change is in progress.
+*/
+bool HEMC_ECCConfigureStart(uint8_t enableMask, uint8_t disableMask)
+{
+    return HEMC_ECCChangeStart(enableMask, disableMask, true);
+}
+
+// *****************************************************************************
+/* Function:
+    bool HEMC_DisableECCStart(uint8_t chipSelect)
+
+   Summary:
+    Start to disable the ECC for the given chip select.
+
+   Precondition:
+    None.
+
+   Parameters:
+    chipSelect - The chip select for which ECC is disabled.
+
+   Returns:
+    True if the change is started, False otherwise.
+*/
+bool HEMC_DisableECCStart(uint8_t chipSelect)
+{
+    if ( chipSelect >= HEMC_CHIP_SELECT_NUM )
+    {
+        return false;
+    }
+
+    return HEMC_ECCChangeStart(0U, (uint8_t)(1U << chipSelect), true);
+}
+
+// *****************************************************************************
+/* Function:
+    bool HEMC_EnableECCStart(uint8_t chipSelect)
+
+   Summary:
+    Start to enable the ECC for the given chip select.
+
+   Precondition:
+    None.
+
+   Parameters:
+    chipSelect - The chip select for which ECC is enabled.
+
+   Returns:
+    True if the change is started, False otherwise.
+*/
+bool HEMC_EnableECCStart(uint8_t chipSelect)
+{
+    if ( chipSelect >= HEMC_CHIP_SELECT_NUM )
+    {
+        return false;
+    }
+
+    return HEMC_ECCChangeStart((uint8_t)(1U << chipSelect), 0U, true);
+}
+
+// *****************************************************************************
+/* Function:
+    bool HEMC_ECCIsBusy(void)
+
+   Summary:
+    Poll the ECC enable change in progress.
+
+   Description:
+    The chip selects whose ECC enable bit reads back the requested value are
+    removed from the pending ones. When none is left, the callback registered
+    with HEMC_ECCCallbackRegister is called once, from this function, for a
+    change started with the asynchronous API.
+
+   Precondition:
+    None.
+
+   Parameters:
+    None.
+
+   Returns:
+    True while the register of a chip select is not updated, False otherwise.
+*/
+bool HEMC_ECCIsBusy(void)
+{
+    uint8_t chipSelect;
+    uint8_t pendingMask = hemcObj.ecc_pending;
+
+    for (chipSelect = 0U; chipSelect < HEMC_CHIP_SELECT_NUM; chipSelect++)
+    {
+        uint8_t chipSelectMask = (uint8_t)(1U << chipSelect);
+
+        if ( (pendingMask & chipSelectMask) != 0U )
         {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS5);
-            hemcCrEnableMask = HEMC_CR_NCS5_ECC_ENABLE_Msk;
-            break;
+            bool enabled = ((*hemcCrNcsReg[chipSelect] & HEMC_CR_NCS0_ECC_ENABLE_Msk) != 0U);
+
+            if ( enabled == ((hemcObj.ecc_enable & chipSelectMask) != 0U) )
+            {
+                pendingMask &= (uint8_t)~chipSelectMask;
+            }
         }
-        default:
-            DisEccCheck = false;
-            break;
     }
+    hemcObj.ecc_pending = pendingMask;
 
-    if( DisEccCheck == false)
+    if ( pendingMask != 0U )
     {
-        return DisEccCheck;
+        return true;
     }
-    if ( (*pHemcCrNcsReg & hemcCrEnableMask) == hemcCrEnableMask)
+
+    if ( hemcObj.ecc_irq_masked == true )
+    {
+        hemcObj.ecc_irq_masked = false;
+        HEMC_ECCIrqRestore(hemcObj.ecc_irq_enabled);
+    }
+
+    if ( hemcObj.ecc_notify == true )
     {
-        *pHemcCrNcsReg &= ~(hemcCrEnableMask);
-        while((*pHemcCrNcsReg & hemcCrEnableMask) == hemcCrEnableMask)
+        hemcObj.ecc_notify = false;
+        if ( hemcObj.ecc_callback != NULL )
         {
-            /* Nothing to do */
+            uintptr_t ecc_context = hemcObj.ecc_context;
+
+            hemcObj.ecc_callback(ecc_context);
         }
-        ret = true;
     }
 
-    return ret;
+    return false;
+}
+
+// *****************************************************************************
+/* Function:
+    void HEMC_ECCCallbackRegister(HEMC_CALLBACK callback, uintptr_t contextHandle)
+
+   Summary:
+    Sets the pointer to the function (and it's context) to be called when an
+    ECC enable change started with the asynchronous API is complete.
+
+   Description:
+    The callback is called from HEMC_ECCIsBusy, not from an interrupt
+    context. Setting callback to NULL disables the callback feature.
+
+   Precondition:
+    None.
+
+   Parameters:
+    callback - A pointer to a function with a calling signature defined by
+               the HEMC_CALLBACK data type.
+
+    contextHandle - A value (usually a pointer) passed (unused) into the
+                    function identified by the callback parameter.
+
+   Returns:
+    None.
+*/
+void HEMC_ECCCallbackRegister(HEMC_CALLBACK callback, uintptr_t contextHandle)
+{
+    hemcObj.ecc_callback = callback;
+    hemcObj.ecc_context = contextHandle;
+}
+
+// *****************************************************************************
+/* Function:
+    void HEMC_DisableECC(uint8_t chipSelect);
+
+   Summary:
+    Disable the ECC for the given chip select.
+
+   Description:
+    Waits for an asynchronous change in progress, then changes the ECC
+    enable with the HEMC ECC error interrupts masked, so their callbacks
+    cannot interleave with it. It must not be called from another interrupt:
+    it would wait there for an asynchronous change polled by the interrupted
+    code.
+
+   Precondition:
+    None.
+
+   Parameters:
+    chipSelect - The chip select for which ECC is disabled.
+
+   Returns:
+    True if ECC was disable for this chip select, False otherwise.
+*/
+bool HEMC_DisableECC(uint8_t chipSelect)
+{
+    uint32_t irqEnabled;
+
+    if ( ( chipSelect >= HEMC_CHIP_SELECT_NUM ) ||
+         ( (*hemcCrNcsReg[chipSelect] & HEMC_CR_NCS0_ECC_ENABLE_Msk) == 0U ) )
+    {
+        return false;
+    }
+
+    while ( HEMC_ECCIsBusy() == true )
+    {
+        /* Wait for the change in progress */
+    }
+    /* Blocking change, the callback of the asynchronous API is not called */
+    irqEnabled = HEMC_ECCIrqMask();
+    (void)HEMC_ECCChangeStart(0U, (uint8_t)(1U << chipSelect), false);
+    while ( HEMC_ECCIsBusy() == true )
+    {
+        /* Nothing to do */
+    }
+    HEMC_ECCIrqRestore(irqEnabled);
+
+    return true;
 }
 
 // *****************************************************************************
@@ -280,6 +566,13 @@ bool HEMC_DisableECC(uint8_t chipSelect)
    Summary:
     Enable the ECC for the given chip select.
 
+   Description:
+    Waits for an asynchronous change in progress, then changes the ECC
+    enable with the HEMC ECC error interrupts masked, so their callbacks
+    cannot interleave with it. It must not be called from another interrupt:
+    it would wait there for an asynchronous change polled by the interrupted
+    code.
+
    Precondition:
     None.
 
@@ -291,66 +584,27 @@ bool HEMC_DisableECC(uint8_t chipSelect)
 */
 bool HEMC_EnableECC(uint8_t chipSelect)
 {
-    bool ret = false, EnEccCheck = true;
-    volatile uint32_t* pHemcCrNcsReg = NULL;
-    uint32_t hemcCrEnableMask = 0;
+    uint32_t irqEnabled;
 
-    switch (chipSelect)
+    if ( chipSelect >= HEMC_CHIP_SELECT_NUM )
     {
-        case 0:
-        {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS0);
-            hemcCrEnableMask = HEMC_CR_NCS0_ECC_ENABLE_Msk;
-            break;
-        }
-        case 1:
-        {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS1);
-            hemcCrEnableMask = HEMC_CR_NCS1_ECC_ENABLE_Msk;
-            break;
-        }
-        case 2:
-        {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS2);
-            hemcCrEnableMask = HEMC_CR_NCS2_ECC_ENABLE_Msk;
-            break;
-        }
-        case 3:
-        {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS3);
-            hemcCrEnableMask = HEMC_CR_NCS3_ECC_ENABLE_Msk;
-            break;
-        }
-        case 4:
-        {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS4);
-            hemcCrEnableMask = HEMC_CR_NCS4_ECC_ENABLE_Msk;
-            break;
-        }
-        case 5:
-        {
-            pHemcCrNcsReg = &(HEMC_REGS->HEMC_CR_NCS5);
-            hemcCrEnableMask = HEMC_CR_NCS5_ECC_ENABLE_Msk;
-            break;
-        }
-        default:
-             EnEccCheck = false;
-             break;
+        return false;
     }
 
-    if( EnEccCheck == false)
+    while ( HEMC_ECCIsBusy() == true )
     {
-        return EnEccCheck;
+        /* Wait for the change in progress */
     }
-
-    *pHemcCrNcsReg |= hemcCrEnableMask;
-    while((*pHemcCrNcsReg & hemcCrEnableMask) != hemcCrEnableMask)
+    /* Blocking change, the callback of the asynchronous API is not called */
+    irqEnabled = HEMC_ECCIrqMask();
+    (void)HEMC_ECCChangeStart((uint8_t)(1U << chipSelect), 0U, false);
+    while ( HEMC_ECCIsBusy() == true )
     {
         /* Nothing to do */
     }
-    ret = true;
+    HEMC_ECCIrqRestore(irqEnabled);
 
-    return ret;
+    return true;
 }
 
 // *****************************************************************************
@@ -71,6 +71,17 @@ typedef enum
     HEMC_HEMC_CH_HSDRAMC = 1  /* HECC Channel for HSDRAMC memories */
 } HEMC_HEMC_CHANNEL;
 
+// *****************************************************************************
+/* HEMC chip selects
+   Summary:
+    Number of HEMC chip selects and mask of all of them
+
+   Description:
+    The chip select masks of the batch ECC functions have bit n set for NCSn.
+*/
+#define    HEMC_CHIP_SELECT_NUM  6U
+#define    HEMC_CHIP_SELECT_ALL  0x3FU
+
 // *****************************************************************************
 /* HEMC HECC status
    Summary:
@@ -134,6 +145,24 @@ typedef struct
 
     /* Transfer Event Callback Context for NoFixable Error interrupt*/
     uintptr_t nofix_context;
+
+    /* Callback for ECC enable change completion */
+    HEMC_CALLBACK ecc_callback;
+
+    /* Callback Context for ECC enable change completion */
+    uintptr_t ecc_context;
+
+    /* Chip selects requested with ECC enabled, and not yet updated */
+    uint8_t ecc_enable;
+    uint8_t ecc_pending;
+
+    /* ECC enable change completion not yet notified */
+    bool ecc_notify;
+
+    /* HEMC ECC interrupts masked during an asynchronous change, and their
+       enable state before it */
+    bool ecc_irq_masked;
+    uint32_t ecc_irq_enabled;
 } HEMC_OBJ;
 
 // *****************************************************************************
@@ -149,6 +178,16 @@ bool HEMC_DisableECC(uint8_t chipSelect);
 
 bool HEMC_EnableECC(uint8_t chipSelect);
 
+bool HEMC_ECCConfigureStart(uint8_t enableMask, uint8_t disableMask);
+
+bool HEMC_DisableECCStart(uint8_t chipSelect);
+
+bool HEMC_EnableECCStart(uint8_t chipSelect);
+
+bool HEMC_ECCIsBusy(void);
+
+void HEMC_ECCCallbackRegister(HEMC_CALLBACK callback, uintptr_t contextHandle);
+
 HEMC_HECC_STATUS HEMC_HeccGetStatus(void);
 
 uint32_t* HEMC_HeccGetFailAddress(void);
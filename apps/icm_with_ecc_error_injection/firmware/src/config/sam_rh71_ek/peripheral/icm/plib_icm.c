@@ -233,6 +233,36 @@ void ICM_WriteBackDisable(bool disable)
     ICM_REGS->ICM_CFG = cfgReg;
 }
 
+// *****************************************************************************
+/* Function:
+    void ICM_BusBurdenSet(uint8_t burden)
+
+   Summary:
+    Set the ICM Bus Burden Control
+
+   Description:
+    The ICM waits 2^burden cycles between two consecutive memory accesses,
+    which limits its bandwidth on the bus matrix.
+
+   Precondition:
+    The ICM must be disabled.
+
+   Parameters:
+    burden - Bus burden value, from 0 (no wait) to 15.
+
+   Returns:
+    None
+
+   Remarks:
+    None
+*/
+void ICM_BusBurdenSet(uint8_t burden)
+{
+    uint32_t cfgReg = ( ICM_REGS->ICM_CFG & ~ICM_CFG_BBC_Msk );
+    cfgReg |= ICM_CFG_BBC(burden);
+    ICM_REGS->ICM_CFG = cfgReg;
+}
+
 // *****************************************************************************
 /* Function:
     void ICM_SoftwareReset(void)
@@ -586,6 +616,298 @@ void ICM_CallbackRegister(ICM_CALLBACK callback, uintptr_t contextHandle)
     icmObj.context = contextHandle;
 }
 
+// *****************************************************************************
+/* Function:
+    void ICM_RegionListInit(ICM_REGION_LIST* list, icm_descriptor_registers_t* descriptors,
+                            uint32_t descriptorNum, bool wrap)
+
+   Summary:
+    Initialize an empty ICM descriptor list.
+
+   Description:
+    This function attaches the descriptor storage to the list object. The
+    list is then filled with ICM_RegionListBuild.
+
+   Precondition:
+    None.
+
+   Parameters:
+    list          - Pointer to the list object.
+    descriptors   - Descriptor storage, aligned on ICM_DESCRIPTOR_LIST_ALIGN bytes.
+    descriptorNum - Number of descriptors in the storage.
+    wrap          - If true, the ICM restarts from the first region after the
+                    last one, otherwise monitoring ends after the last region.
+
+   Returns:
+    None.
+*/
+void ICM_RegionListInit(ICM_REGION_LIST* list, icm_descriptor_registers_t* descriptors,
+                        uint32_t descriptorNum, bool wrap)
+{
+    list->descriptors = descriptors;
+    list->descriptorNum = descriptorNum;
+    list->descriptorUsed = 0U;
+    list->regionNum = 0U;
+    list->wrap = wrap;
+}
+
+// *****************************************************************************
+/* Function:
+    bool ICM_RegionListBuild(ICM_REGION_LIST* list, const ICM_REGION_RANGE* ranges,
+                             uint32_t rangeNum)
+
+   Summary:
+    Build an ICM descriptor list from a table of memory ranges.
+
+   Description:
+    The first range of each region is placed in the main list at the region
+    position. The other ranges of the region, and the parts of ranges larger
+    than ICM_DESCRIPTOR_MAX_SIZE, are linked to it through the ICM_RNEXT
+    field as a secondary list. All ranges of a region produce one digest.
+
+   Precondition:
+    ICM_RegionListInit must have been called for the list.
+
+   Parameters:
+    list     - Pointer to the list object.
+    ranges   - Table of memory ranges.
+    rangeNum - Number of entries in the table.
+
+   Returns:
+    true if the list is built, false if a range is invalid, if the regions are
+    not numbered from 0 without gap or if the descriptor storage is too small.
+
+   Remarks:
+    The list is not used by the ICM before ICM_RegionListSwap is called.
+*/
+bool ICM_RegionListBuild(ICM_REGION_LIST* list, const ICM_REGION_RANGE* ranges, uint32_t rangeNum)
+{
+    const ICM_REGION_RANGE* regionFirst[ICM_REGION_NUM] = { NULL };
+    uint32_t regionNum = 0U;
+    uint32_t descriptorCount = 0U;
+    uint32_t index;
+
+    list->descriptorUsed = 0U;
+    list->regionNum = 0U;
+
+    if ( ( rangeNum == 0U ) || ( ((uint32_t)list->descriptors & (ICM_DESCRIPTOR_LIST_ALIGN - 1UL)) != 0U ) )
+    {
+        return false;
+    }
+
+    /* Check ranges and count the needed descriptors */
+    for (index = 0U; index < rangeNum; index++)
+    {
+        const ICM_REGION_RANGE* range = &ranges[index];
+
+        if ( ( range->region >= ICM_REGION_NUM ) ||
+             ( range->size == 0U ) ||
+             ( (range->size % ICM_BLOCK_SIZE) != 0U ) ||
+             ( (range->address & 0x3UL) != 0U ) )
+        {
+            return false;
+        }
+
+        if ( regionFirst[range->region] == NULL )
+        {
+            regionFirst[range->region] = range;
+        }
+        if ( (uint32_t)range->region >= regionNum )
+        {
+            regionNum = (uint32_t)range->region + 1U;
+        }
+        descriptorCount += ICM_DESCRIPTOR_COUNT(range->size);
+    }
+
+    for (index = 0U; index < regionNum; index++)
+    {
+        if ( regionFirst[index] == NULL )
+        {
+            /* The region identifier is the position in the main list */
+            return false;
+        }
+    }
+
+    if ( descriptorCount > list->descriptorNum )
+    {
+        return false;
+    }
+
+    /* Main list first, secondary list descriptors allocated after it */
+    uint32_t nextFree = regionNum;
+
+    for (uint32_t region = 0U; region < regionNum; region++)
+    {
+        const ICM_REGION_RANGE* first = regionFirst[region];
+        icm_descriptor_registers_t* previous = NULL;
+
+        for (index = 0U; index < rangeNum; index++)
+        {
+            const ICM_REGION_RANGE* range = &ranges[index];
+            uint32_t address = range->address;
+            uint32_t remaining = range->size;
+
+            if ( (uint32_t)range->region != region )
+            {
+                continue;
+            }
+
+            while ( remaining != 0U )
+            {
+                uint32_t chunk = (remaining > ICM_DESCRIPTOR_MAX_SIZE) ? ICM_DESCRIPTOR_MAX_SIZE : remaining;
+                icm_descriptor_registers_t* desc;
+
+                if ( previous == NULL )
+                {
+                    desc = &list->descriptors[region];
+                    desc->ICM_RCFG = ICM_RCFG_ALGO(first->algo) |
+                                     ICM_RCFG_PROCDLY( (first->processingDelay == true) ? 1U : 0U ) |
+                                     (ICM_REGION_INT_ALL & ~(first->interrupts)) |
+                                     ICM_RCFG_EOM( ((region == (regionNum - 1U)) && (list->wrap == false)) ? 1U : 0U ) |
+                                     ICM_RCFG_WRAP( ((region == (regionNum - 1U)) && (list->wrap == true)) ? 1U : 0U );
+                }
+                else
+                {
+                    desc = &list->descriptors[nextFree];
+                    nextFree++;
+                    /* Configuration is only read from the main list */
+                    desc->ICM_RCFG = 0U;
+                    previous->ICM_RNEXT = (uint32_t)desc & ICM_RNEXT_Msk;
+                }
+
+                desc->ICM_RADDR = ICM_RADDR_RADDR(address);
+                desc->ICM_RCTRL = ICM_RCTRL_TRSIZE((chunk / ICM_BLOCK_SIZE) - 1U);
+                desc->ICM_RNEXT = 0U;
+
+                previous = desc;
+                address += chunk;
+                remaining -= chunk;
+            }
+        }
+    }
+
+    list->descriptorUsed = nextFree;
+    list->regionNum = regionNum;
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    ICM_REGION_MASK ICM_RegionListMaskGet(const ICM_REGION_LIST* list)
+
+   Summary:
+    Get the mask of the regions defined by a descriptor list.
+
+   Precondition:
+    ICM_RegionListBuild must have been called for the list.
+
+   Parameters:
+    list - Pointer to the list object.
+
+   Returns:
+    Mask of the regions of the list, to be used with ICM_MonitorEnable,
+    ICM_MonitorDisable and ICM_ReComputeHash.
+*/
+ICM_REGION_MASK ICM_RegionListMaskGet(const ICM_REGION_LIST* list)
+{
+    return (ICM_REGION_MASK)((1UL << list->regionNum) - 1UL);
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t ICM_RegionListHashSizeGet(const ICM_REGION_LIST* list)
+
+   Summary:
+    Get the size of the hash area needed by a descriptor list.
+
+   Precondition:
+    ICM_RegionListBuild must have been called for the list.
+
+   Parameters:
+    list - Pointer to the list object.
+
+   Returns:
+    Size in bytes of the hash area.
+*/
+uint32_t ICM_RegionListHashSizeGet(const ICM_REGION_LIST* list)
+{
+    return list->regionNum * ICM_HASH_REGION_SIZE;
+}
+
+// *****************************************************************************
+/* Function:
+    bool ICM_RegionListSwap(const ICM_REGION_LIST* list, uint32_t hashAddr)
+
+   Summary:
+    Make the ICM use a descriptor list and hash area.
+
+   Description:
+    The ICM is disabled and the function waits the end of the region being
+    processed, so the controller never fetches a partially updated list.
+    The descriptor and hash area addresses are then updated, secondary list
+    branching is enabled if the list needs it, and the ICM is enabled again
+    if it was enabled on entry.
+
+   Precondition:
+    ICM_RegionListBuild must have been called for the list.
+
+   Parameters:
+    list     - Pointer to the list object.
+    hashAddr - Address of the hash area, aligned on ICM_HASH_AREA_ALIGN bytes
+               and at least ICM_RegionListHashSizeGet bytes long.
+
+   Returns:
+    true if the list is now used by the ICM, false if the list is empty or the
+    hash area is not aligned.
+
+   Remarks:
+    The digests of the previous list are not valid for the new one: they must
+    be computed again, or preloaded when the ICM is used in compare mode.
+*/
+bool ICM_RegionListSwap(const ICM_REGION_LIST* list, uint32_t hashAddr)
+{
+    bool wasEnabled = ((ICM_REGS->ICM_SR & ICM_SR_ENABLE_Msk) != 0U);
+    uint32_t cfgReg;
+
+    if ( ( list->regionNum == 0U ) || ( (hashAddr & (ICM_HASH_AREA_ALIGN - 1UL)) != 0U ) )
+    {
+        return false;
+    }
+
+    /* The ICM reads the descriptors from memory */
+    if ( DATA_CACHE_IS_ENABLED() != 0U )
+    {
+        DCACHE_CLEAN_BY_ADDR((uint32_t*)list->descriptors,
+                             (int32_t)(list->descriptorUsed * sizeof(icm_descriptor_registers_t)));
+    }
+
+    if ( wasEnabled )
+    {
+        ICM_REGS->ICM_CTRL = ICM_CTRL_DISABLE(1);
+        while ( (ICM_REGS->ICM_SR & ICM_SR_ENABLE_Msk) != 0U )
+        {
+            /* Wait end of current region processing */
+        }
+    }
+
+    cfgReg = ICM_REGS->ICM_CFG & ~ICM_CFG_SLBDIS_Msk;
+    if ( list->descriptorUsed == list->regionNum )
+    {
+        cfgReg |= ICM_CFG_SLBDIS(1);
+    }
+    ICM_REGS->ICM_CFG = cfgReg;
+    ICM_REGS->ICM_DSCR = (uint32_t)list->descriptors;
+    ICM_REGS->ICM_HASH = hashAddr;
+
+    if ( wasEnabled )
+    {
+        ICM_REGS->ICM_CTRL = ICM_CTRL_ENABLE(1);
+    }
+
+    return true;
+}
+
 // *****************************************************************************
 /* Function:
     void ICM_InterruptHandler(void)
@@ -65,6 +65,29 @@
 // Section: ICM defines
 // *****************************************************************************
 // *****************************************************************************
+/* Number of regions the ICM can monitor */
+#define ICM_REGION_NUM                           (4U)
+
+/* Size in bytes of one SHA block, unit of the descriptor TRSIZE field */
+#define ICM_BLOCK_SIZE                           (64UL)
+
+/* Maximum size in bytes hashed by one descriptor (TRSIZE is 16 bits) */
+#define ICM_DESCRIPTOR_MAX_SIZE                  (ICM_BLOCK_SIZE * 0x10000UL)
+
+/* Size in bytes reserved in the hash area for each region digest */
+#define ICM_HASH_REGION_SIZE                     (32UL)
+
+/* Required alignment in bytes of the hash area */
+#define ICM_HASH_AREA_ALIGN                      (128UL)
+
+/* Required alignment in bytes of the main descriptor list */
+#define ICM_DESCRIPTOR_LIST_ALIGN                (64UL)
+
+/* Size in 32 bit words of the hash area needed for 'regionNum' regions */
+#define ICM_HASH_AREA_WORDS(regionNum)           (((regionNum) * ICM_HASH_REGION_SIZE) / 4UL)
+
+/* Number of descriptors needed to hash 'size' bytes */
+#define ICM_DESCRIPTOR_COUNT(size)               (((size) + ICM_DESCRIPTOR_MAX_SIZE - 1UL) / ICM_DESCRIPTOR_MAX_SIZE)
 
 
 // *****************************************************************************
@@ -155,6 +178,125 @@ typedef uint32_t ICM_STATUS;
 #define ICM_STATUS_MON_DIS_R3                 (ICM_SR_RMDIS(ICM_REGION3_MASK))
 #define ICM_STATUS_INVALID                    (0xFFFFFFFFUL)
 
+// *****************************************************************************
+/* ICM SHA Algorithm
+
+   Summary:
+    ICM region hash algorithm.
+
+   Description:
+    This data type defines the SHA algorithm used to hash a region.
+
+   Remarks:
+    None.
+*/
+typedef enum
+{
+    ICM_ALGO_SHA1 = ICM_RCFG_ALGO_SHA1_Val,
+    ICM_ALGO_SHA256 = ICM_RCFG_ALGO_SHA256_Val,
+    ICM_ALGO_SHA224 = ICM_RCFG_ALGO_SHA224_Val
+} ICM_ALGO;
+
+// *****************************************************************************
+/* ICM Region Interrupt Sources
+
+   Summary:
+    ICM region interrupt sources.
+
+   Description:
+    This data type defines the interrupt sources a region descriptor allows to
+    be raised. Sources not set are disabled in the region configuration, the
+    allowed ones still need to be enabled with ICM_InterruptEnable.
+
+   Remarks:
+    None.
+*/
+typedef uint32_t ICM_REGION_INT;
+
+#define ICM_REGION_INT_NONE                      (0x0UL)
+#define ICM_REGION_INT_HASH                      (ICM_RCFG_RHIEN_Msk)
+#define ICM_REGION_INT_DIGEST_MISMATCH           (ICM_RCFG_DMIEN_Msk)
+#define ICM_REGION_INT_BUS_ERROR                 (ICM_RCFG_BEIEN_Msk)
+#define ICM_REGION_INT_WRAP                      (ICM_RCFG_WCIEN_Msk)
+#define ICM_REGION_INT_END_BIT                   (ICM_RCFG_ECIEN_Msk)
+#define ICM_REGION_INT_STATUS_UPDATE             (ICM_RCFG_SUIEN_Msk)
+#define ICM_REGION_INT_ALL                       (ICM_REGION_INT_HASH | \
+                                                  ICM_REGION_INT_DIGEST_MISMATCH | \
+                                                  ICM_REGION_INT_BUS_ERROR | \
+                                                  ICM_REGION_INT_WRAP | \
+                                                  ICM_REGION_INT_END_BIT | \
+                                                  ICM_REGION_INT_STATUS_UPDATE)
+
+// *****************************************************************************
+/* ICM Memory Range
+
+   Summary:
+    Memory range monitored by the ICM.
+
+   Description:
+    This data structure describes one memory range and the region it belongs
+    to. Several ranges given for the same region are chained through the
+    secondary list and produce a single digest.
+
+   Remarks:
+    The address must be word aligned and the size a multiple of ICM_BLOCK_SIZE.
+    Ranges larger than ICM_DESCRIPTOR_MAX_SIZE are split over several
+    descriptors. The algorithm and interrupts of a region are taken from its
+    first range.
+*/
+typedef struct
+{
+    /* Region identifier, from 0 to ICM_REGION_NUM - 1 */
+    uint8_t region;
+
+    /* Start address of the range */
+    uint32_t address;
+
+    /* Size in bytes of the range */
+    uint32_t size;
+
+    /* Hash algorithm of the region */
+    ICM_ALGO algo;
+
+    /* Interrupt sources allowed for the region */
+    ICM_REGION_INT interrupts;
+
+    /* If true, the SHA engine uses its longest processing time (PROCDLY) */
+    bool processingDelay;
+} ICM_REGION_RANGE;
+
+// *****************************************************************************
+/* ICM Region Descriptor List
+
+   Summary:
+    ICM descriptor list built at runtime.
+
+   Description:
+    This data structure holds a descriptor list built in RAM by
+    ICM_RegionListBuild. The first descriptors form the main list, one per
+    region, followed by the secondary list descriptors.
+
+   Remarks:
+    The descriptor storage must be aligned on ICM_DESCRIPTOR_LIST_ALIGN bytes.
+*/
+typedef struct
+{
+    /* Descriptor storage */
+    icm_descriptor_registers_t* descriptors;
+
+    /* Number of descriptors in the storage */
+    uint32_t descriptorNum;
+
+    /* Number of descriptors used by the list */
+    uint32_t descriptorUsed;
+
+    /* Number of regions of the main list */
+    uint32_t regionNum;
+
+    /* Restart from the first region after the last one */
+    bool wrap;
+} ICM_REGION_LIST;
+
 // *****************************************************************************
 
 /* ICM Callback
@@ -209,6 +351,8 @@ void ICM_SetEndOfMonitoringDisable(bool disable);
 
 void ICM_WriteBackDisable(bool disable);
 
+void ICM_BusBurdenSet(uint8_t burden);
+
 void ICM_SoftwareReset(void);
 
 void ICM_SetDescStartAddress(icm_descriptor_registers_t* addr);
@@ -238,6 +382,17 @@ ICM_STATUS ICM_StatusGet(void);
 
 void ICM_CallbackRegister(ICM_CALLBACK callback, uintptr_t contextHandle);
 
+void ICM_RegionListInit(ICM_REGION_LIST* list, icm_descriptor_registers_t* descriptors,
+                        uint32_t descriptorNum, bool wrap);
+
+bool ICM_RegionListBuild(ICM_REGION_LIST* list, const ICM_REGION_RANGE* ranges, uint32_t rangeNum);
+
+ICM_REGION_MASK ICM_RegionListMaskGet(const ICM_REGION_LIST* list);
+
+uint32_t ICM_RegionListHashSizeGet(const ICM_REGION_LIST* list);
+
+bool ICM_RegionListSwap(const ICM_REGION_LIST* list, uint32_t hashAddr);
+
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
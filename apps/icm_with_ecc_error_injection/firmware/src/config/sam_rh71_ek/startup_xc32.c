@@ -60,6 +60,9 @@ extern void __attribute__((long_call)) __libc_init_array(void);
 extern void __attribute__((weak,long_call, alias("Dummy_App_Func"))) _on_reset(void);
 extern void __attribute__((weak,long_call, alias("Dummy_App_Func"))) _on_bootstrap(void);
 
+/* Optional application-provided boot time report, in CPU cycles from reset */
+extern void __attribute__((weak,long_call, alias("Dummy_Boot_Time_Func"))) _on_boot_time(uint32_t eccCycles, uint32_t bootCycles);
+
 /* Reserved for use by the MPLAB XC32 Compiler */
 extern void __attribute__((weak,long_call, alias("Dummy_App_Func"))) __xc32_on_reset(void);
 extern void __attribute__((weak,long_call, alias("Dummy_App_Func"))) __xc32_on_bootstrap(void);
@@ -70,6 +73,19 @@ extern uint32_t __svectors;
 extern uint32_t _stack;
 #endif
 
+/*
+ *  Define VECTORS_IN_ITCM to fetch the vectors from the ITCM. The startup
+ *  code copies the vector table in .vectors_itcm when the linker did not
+ *  already place it in the ITCM. VECTORS_ITCM_WORDS holds the 90 vectors
+ *  and is the alignment of the table required by VTOR. The ITCM must be
+ *  enabled with the -mitcm option, otherwise the link fails on the empty
+ *  itcm region.
+ */
+#ifdef VECTORS_IN_ITCM
+#define VECTORS_ITCM_WORDS 128U
+static uint32_t __attribute__((section(".vectors_itcm"), aligned(VECTORS_ITCM_WORDS * 4U), used)) vectorsItcm[VECTORS_ITCM_WORDS];
+#endif
+
 /* MISRAC 2012 deviation block end */
 
 
@@ -91,6 +107,38 @@ __STATIC_INLINE void __attribute__((optimize("-O1"))) TCM_Enable(void)
 
 #define TRANSFER_CHUNK_SIZE 0x80U
 
+/*
+ *  ECC initialization of the TCM and FlexRAM memories.
+ *
+ *  After a power up reset the content of the memories is random: they are
+ *  filled with zeros in 128 byte bursts with the ECC on, without barrier
+ *  between the bursts. Only the chunks around the stack pointer are read with
+ *  the ECC off and written back, to keep the stack of the startup code.
+ *
+ *  The memories keep their content and check bits after the other resets.
+ *  The reset types set in ECC_WARM_RESET_MASK skip the initialization, the
+ *  other ones read and write back every chunk as before to keep the content
+ *  loaded by a debugger.
+ *
+ *  When the linker script defines __ecc_flexram_used_end, the FlexRAM above
+ *  this address is not used by the application image and is left for
+ *  ECC_InitializeDeferred(). Only the linker script of an application calling
+ *  it defines the symbol, otherwise the whole FlexRAM is initialized here.
+ *
+ *  Define ECC_FLEXRAM_XDMAC_CHANNEL to let this XDMAC channel fill the
+ *  FlexRAM while the CPU fills the TCM after a power up reset.
+ */
+#ifndef ECC_WARM_RESET_MASK
+#  define ECC_WARM_RESET_MASK (1UL << RSTC_SR_RSTTYP_WDT_RST_Val)
+#endif
+
+/* Stack kept below and above the stack pointer while the memories are filled */
+#define ECC_STACK_KEEP_BELOW 0x80U
+#define ECC_STACK_KEEP_ABOVE 0x200U
+
+/* End of the FlexRAM used by the application image, defined by the linker script */
+extern uint32_t __attribute__((weak)) __ecc_flexram_used_end;
+
 __STATIC_INLINE void Read_Chunk(uint32_t address)
 {
     __asm__ volatile (
@@ -110,7 +158,38 @@ __STATIC_INLINE void Write_Chunk(uint32_t address)
     );
 }
 
-// initialize the ECC for a single TCM region (defined by addr and size) in 128 byte chunks
+// fill [start, end) with zeros in 128 byte chunks, using 64-bit stores for the ITCM check bits
+__STATIC_INLINE void Zero_Chunks(uint32_t start, uint32_t end)
+{
+    __asm__ volatile (
+         "MOV      r8, #0\n"
+         "VMOV     d0, r8, r8\n"
+         "VMOV     d1, r8, r8\n"
+         "VMOV     d2, r8, r8\n"
+         "VMOV     d3, r8, r8\n"
+         "VMOV     d4, r8, r8\n"
+         "VMOV     d5, r8, r8\n"
+         "VMOV     d6, r8, r8\n"
+         "VMOV     d7, r8, r8\n"
+         "VMOV     d8, r8, r8\n"
+         "VMOV     d9, r8, r8\n"
+         "VMOV     d10, r8, r8\n"
+         "VMOV     d11, r8, r8\n"
+         "VMOV     d12, r8, r8\n"
+         "VMOV     d13, r8, r8\n"
+         "VMOV     d14, r8, r8\n"
+         "VMOV     d15, r8, r8\n"
+         "1:\n"
+         "CMP      %[addr], %[end]\n"
+         "BHS      2f\n"
+         "VSTMIA   %[addr]!,{d0-d15}\n"
+         "B        1b\n"
+         "2:\n"
+           : [addr] "+l" (start) : [end] "l" (end) : "r8", "cc", "memory"
+    );
+}
+
+// initialize the ECC for a single TCM region (defined by addr and size) in 128 byte chunks, keeping its content
 static void  __attribute__((optimize("-O1")))  TCM_EccInitOne(uint32_t addr, uint32_t size) {
 
     uint32_t pTcm;
@@ -120,21 +199,102 @@ static void  __attribute__((optimize("-O1")))  TCM_EccInitOne(uint32_t addr, uin
         //read ECC OFF
         TCMECC_REGS->TCMECC_CR = 0x0U;
         __DSB();
-        __ISB();
         Read_Chunk(pTcm);
 
         //Write ECC ON
         TCMECC_REGS->TCMECC_CR = 0x1U;
         __DSB();
-        __ISB();
         Write_Chunk(pTcm);
         __DSB();
-        __ISB();
     }
 }
 
+// initialize the ECC for a single FlexRAM region in 128 byte chunks, keeping its content
+static void  __attribute__((optimize("-O1")))  FlexRAM_EccInitOne(uint32_t addr, uint32_t size) {
+
+    uint32_t pFlexRam;
+
+    for (pFlexRam = addr; pFlexRam < (addr + size); pFlexRam += TRANSFER_CHUNK_SIZE)
+    {
+        Read_Chunk(pFlexRam);
+        Write_Chunk(pFlexRam);
+    }
+    __DSB();
+}
+
+// zero fill a region with the ECC on, the chunks holding the stack keep their content
+static void  __attribute__((optimize("-O1")))  ECC_FillOne(uint32_t addr, uint32_t size, bool isTcm) {
+
+    uint32_t end = addr + size;
+    uint32_t keepStart = (__get_MSP() - ECC_STACK_KEEP_BELOW) & ~(TRANSFER_CHUNK_SIZE - 1U);
+    uint32_t keepEnd = (__get_MSP() + ECC_STACK_KEEP_ABOVE) & ~(TRANSFER_CHUNK_SIZE - 1U);
+
+    if ((keepEnd <= addr) || (keepStart >= end))
+    {
+        Zero_Chunks(addr, end);
+    }
+    else
+    {
+        keepStart = (keepStart < addr) ? addr : keepStart;
+        keepEnd = (keepEnd > end) ? end : keepEnd;
+
+        Zero_Chunks(addr, keepStart);
+        if (isTcm)
+        {
+            TCM_EccInitOne(keepStart, keepEnd - keepStart);
+        }
+        else
+        {
+            FlexRAM_EccInitOne(keepStart, keepEnd - keepStart);
+        }
+        Zero_Chunks(keepEnd, end);
+    }
+    __DSB();
+}
+
+/* End of the FlexRAM initialized at boot */
+__STATIC_INLINE uint32_t FlexRAM_EccBootEnd(void)
+{
+    uint32_t usedEnd = (uint32_t)&__ecc_flexram_used_end;
+
+    if ((usedEnd <= FLEXRAM_ADDR) || (usedEnd >= (FLEXRAM_ADDR + FlexRAM_SIZE)))
+    {
+        return FLEXRAM_ADDR + FlexRAM_SIZE;
+    }
+    return (usedEnd + (TRANSFER_CHUNK_SIZE - 1U)) & ~(TRANSFER_CHUNK_SIZE - 1U);
+}
+
+#ifdef ECC_FLEXRAM_XDMAC_CHANNEL
+/* Start the XDMAC zero fill of a FlexRAM region, on a 32-bit basis */
+__STATIC_INLINE void  __attribute__((optimize("-O1"))) FlexRAM_EccFillStart(uint32_t addr, uint32_t size)
+{
+    PMC_REGS->PMC_PCR = PMC_PCR_EN_Msk | PMC_PCR_CMD_Msk | PMC_PCR_PID(ID_XDMAC);
+
+    XDMAC_REGS->XDMAC_CHID[ECC_FLEXRAM_XDMAC_CHANNEL].XDMAC_CDA = addr;
+    XDMAC_REGS->XDMAC_CHID[ECC_FLEXRAM_XDMAC_CHANNEL].XDMAC_CUBC = XDMAC_CUBC_UBLEN(size / 4U);
+    XDMAC_REGS->XDMAC_CHID[ECC_FLEXRAM_XDMAC_CHANNEL].XDMAC_CDS_MSP = 0U;
+    XDMAC_REGS->XDMAC_CHID[ECC_FLEXRAM_XDMAC_CHANNEL].XDMAC_CNDC = 0U;
+    XDMAC_REGS->XDMAC_CHID[ECC_FLEXRAM_XDMAC_CHANNEL].XDMAC_CBC = 0U;
+    XDMAC_REGS->XDMAC_CHID[ECC_FLEXRAM_XDMAC_CHANNEL].XDMAC_CC = XDMAC_CC_TYPE_MEM_TRAN | XDMAC_CC_MBSIZE_SIXTEEN |
+                                                                 XDMAC_CC_MEMSET_HW_MODE | XDMAC_CC_DWIDTH_WORD |
+                                                                 XDMAC_CC_DIF_AHB_IF1 | XDMAC_CC_DAM_INCREMENTED_AM;
+    (void)XDMAC_REGS->XDMAC_CHID[ECC_FLEXRAM_XDMAC_CHANNEL].XDMAC_CIS;
+    XDMAC_REGS->XDMAC_GE = (1UL << ECC_FLEXRAM_XDMAC_CHANNEL);
+}
+
+/* Wait the end of the XDMAC zero fill */
+__STATIC_INLINE void  __attribute__((optimize("-O1"))) FlexRAM_EccFillWait(void)
+{
+    while ((XDMAC_REGS->XDMAC_GS & (1UL << ECC_FLEXRAM_XDMAC_CHANNEL)) != 0U)
+    {
+        /* Wait the end of the transfer */
+    }
+    PMC_REGS->PMC_PCR = PMC_PCR_CMD_Msk | PMC_PCR_PID(ID_XDMAC);
+}
+#endif /* ECC_FLEXRAM_XDMAC_CHANNEL */
+
 /* Initialize ECC for TCM memories */
-__STATIC_INLINE void  __attribute__((optimize("-O1"))) TCM_EccInitialize(void)
+__STATIC_INLINE void  __attribute__((optimize("-O1"))) TCM_EccInitialize(uint32_t resetType)
 {
 
     __DSB();
@@ -148,19 +308,30 @@ __STATIC_INLINE void  __attribute__((optimize("-O1"))) TCM_EccInitialize(void)
     __DSB();
     __ISB();
 
-    //enable Icache and Dcache
-    SCB_EnableICache();
-    SCB_EnableDCache();
-
-
-
-    //  initalize both TCM's (to handle ECC properly prior activating RMW/RETEN features)
-    TCM_EccInitOne(ITCM_ADDR, ITCM_SIZE);
-    TCM_EccInitOne(DTCM_ADDR, DTCM_SIZE);
-
-    //disable cache I et data D
-    SCB_DisableICache();
-    SCB_DisableDCache();
+    if (((1UL << resetType) & ECC_WARM_RESET_MASK) == 0U)
+    {
+        //enable Icache and Dcache
+        SCB_EnableICache();
+        SCB_EnableDCache();
+
+        //  initalize both TCM's (to handle ECC properly prior activating RMW/RETEN features)
+        if (resetType == RSTC_SR_RSTTYP_GENERAL_RST_Val)
+        {
+            TCMECC_REGS->TCMECC_CR = 0x1U;
+            __DSB();
+            ECC_FillOne(ITCM_ADDR, ITCM_SIZE, true);
+            ECC_FillOne(DTCM_ADDR, DTCM_SIZE, true);
+        }
+        else
+        {
+            TCM_EccInitOne(ITCM_ADDR, ITCM_SIZE);
+            TCM_EccInitOne(DTCM_ADDR, DTCM_SIZE);
+        }
+
+        //disable cache I et data D
+        SCB_DisableICache();
+        SCB_DisableDCache();
+    }
 
     __DSB();
     __ISB();
@@ -180,29 +351,83 @@ __STATIC_INLINE void  __attribute__((optimize("-O1"))) TCM_EccInitialize(void)
 }
 
 
-__STATIC_INLINE void  __attribute__((optimize("-O1"))) FlexRAM_EccInitialize(void)
+/* Initialize ECC for FlexRAM memory, TCM_EccInitialize runs between the two calls */
+__STATIC_INLINE void  __attribute__((optimize("-O1"))) FlexRAM_EccInitializeStart(uint32_t resetType)
 {
-    uint32_t pFlexRam;
+#ifdef ECC_FLEXRAM_XDMAC_CHANNEL
+    uint32_t keepStart = (__get_MSP() - ECC_STACK_KEEP_BELOW) & ~(TRANSFER_CHUNK_SIZE - 1U);
+    uint32_t bootEnd = FlexRAM_EccBootEnd();
+
+    /* The XDMAC fills the FlexRAM below the stack, or all of it when the stack is in a TCM */
+    if (resetType == RSTC_SR_RSTTYP_GENERAL_RST_Val)
+    {
+        if ((keepStart > FLEXRAM_ADDR) && (keepStart < bootEnd))
+        {
+            FlexRAM_EccFillStart(FLEXRAM_ADDR, keepStart - FLEXRAM_ADDR);
+        }
+        else
+        {
+            FlexRAM_EccFillStart(FLEXRAM_ADDR, bootEnd - FLEXRAM_ADDR);
+        }
+    }
+#else
+    (void)resetType;
+#endif
+}
+
+__STATIC_INLINE void  __attribute__((optimize("-O1"))) FlexRAM_EccInitialize(uint32_t resetType)
+{
+    uint32_t bootEnd = FlexRAM_EccBootEnd();
 
     __DSB();
     __ISB();
 
     // FlexRAM initialization loop (to handle ECC properly)
-    for (pFlexRam = FLEXRAM_ADDR ; pFlexRam < (FLEXRAM_ADDR + FlexRAM_SIZE) ; pFlexRam += TRANSFER_CHUNK_SIZE)
+    if (((1UL << resetType) & ECC_WARM_RESET_MASK) != 0U)
     {
-        Read_Chunk(pFlexRam);
-        __DSB();
-        __ISB();
-        Write_Chunk(pFlexRam);
-        __DSB();
-        __ISB();
+        /* Content and check bits kept through the reset */
+    }
+    else if (resetType == RSTC_SR_RSTTYP_GENERAL_RST_Val)
+    {
+#ifdef ECC_FLEXRAM_XDMAC_CHANNEL
+        uint32_t keepStart = (__get_MSP() - ECC_STACK_KEEP_BELOW) & ~(TRANSFER_CHUNK_SIZE - 1U);
+
+        FlexRAM_EccFillWait();
+        if ((keepStart > FLEXRAM_ADDR) && (keepStart < bootEnd))
+        {
+            ECC_FillOne(keepStart, bootEnd - keepStart, false);
+        }
+#else
+        ECC_FillOne(FLEXRAM_ADDR, bootEnd - FLEXRAM_ADDR, false);
+#endif
+    }
+    else
+    {
+        FlexRAM_EccInitOne(FLEXRAM_ADDR, bootEnd - FLEXRAM_ADDR);
     }
-
 
     __DSB();
     __ISB();
 }
 
+/*
+ *  Initialize ECC for the FlexRAM not used by the application image. The
+ *  deferred area must be non-cacheable in the MPU, as ram_nocache is: a
+ *  line fill would read words without check bits.
+ */
+void __attribute__((optimize("-O1"), long_call)) ECC_InitializeDeferred(void)
+{
+    uint32_t start = FlexRAM_EccBootEnd();
+    volatile uint64_t *pFlexRam = (volatile uint64_t *)start;
+
+    while ((uint32_t)pFlexRam < (FLEXRAM_ADDR + FlexRAM_SIZE))
+    {
+        *pFlexRam = 0U;
+        pFlexRam++;
+    }
+    __DSB();
+}
+
 
 #if (__ARM_FP==14) || (__ARM_FP==4)
 
@@ -231,6 +456,16 @@ void __attribute__((optimize("-O1"),long_call))Dummy_App_Func(void)
     return;
 }
 
+/* Brief default boot time function used as a weak reference */
+extern void Dummy_Boot_Time_Func(uint32_t eccCycles, uint32_t bootCycles);
+void __attribute__((optimize("-O1"),long_call))Dummy_Boot_Time_Func(uint32_t eccCycles, uint32_t bootCycles)
+{
+    /* Do nothing */
+    (void)eccCycles;
+    (void)bootCycles;
+    return;
+}
+
 /**
  * \brief This is the code that gets called on processor reset.
  * To initialize the device, and call the main() routine.
@@ -240,6 +475,8 @@ void __attribute__((optimize("-O1"), section(".text.Reset_Handler"), long_call,
 #ifdef SCB_VTOR_TBLOFF_Msk
     uint32_t *pSrc;
 #endif
+    uint32_t resetType;
+    uint32_t eccCycles;
 
 #if defined (__REINIT_STACK_POINTER)
     /* Initialize SP from linker-defined _stack symbol. */
@@ -247,11 +484,17 @@ void __attribute__((optimize("-O1"), section(".text.Reset_Handler"), long_call,
 
 #ifdef SCB_VTOR_TBLOFF_Msk
     /* Buy stack for locals */
-    __asm__ volatile ("sub sp, sp, #8" : : : "sp");
+    __asm__ volatile ("sub sp, sp, #16" : : : "sp");
 #endif
     __asm__ volatile ("add r7, sp, #0" : : : "r7");
 #endif
 
+    /* Count the boot time with the DWT cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55U;
+    DWT->CYCCNT = 0U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     /* Call the optional application-provided _on_reset() function. */
     _on_reset();
 
@@ -264,8 +507,11 @@ void __attribute__((optimize("-O1"), section(".text.Reset_Handler"), long_call,
 #endif
 
     /* Do this after the fpu is enabled so we can use fp regs */
-    TCM_EccInitialize();
-    FlexRAM_EccInitialize();
+    resetType = (RSTC_REGS->RSTC_SR & RSTC_SR_RSTTYP_Msk) >> RSTC_SR_RSTTYP_Pos;
+    FlexRAM_EccInitializeStart(resetType);
+    TCM_EccInitialize(resetType);
+    FlexRAM_EccInitialize(resetType);
+    eccCycles = DWT->CYCCNT;
 
     /* Enable TCM   */
     TCM_Enable();
@@ -278,6 +524,18 @@ void __attribute__((optimize("-O1"), section(".text.Reset_Handler"), long_call,
 #  ifdef SCB_VTOR_TBLOFF_Msk
     /*  Set the vector-table base address in FLASH */
     pSrc = (uint32_t *) & __svectors;
+#    ifdef VECTORS_IN_ITCM
+    /*  Or in ITCM, enabled by TCM_Enable() */
+    if ( (uint32_t)pSrc >= (ITCM_ADDR + ITCM_SIZE) )
+    {
+        for (uint32_t i = 0U; i < VECTORS_ITCM_WORDS; i++)
+        {
+            vectorsItcm[i] = pSrc[i];
+        }
+        pSrc = vectorsItcm;
+        __DSB();
+    }
+#    endif /* VECTORS_IN_ITCM */
     SCB->VTOR = ((uint32_t) pSrc & SCB_VTOR_TBLOFF_Msk);
 #  endif /* SCB_VTOR_TBLOFF_Msk */
 
@@ -299,6 +557,9 @@ void __attribute__((optimize("-O1"), section(".text.Reset_Handler"), long_call,
     /* Reserved for use by MPLAB XC32. */
     __xc32_on_bootstrap();
 
+    /* Call the optional application-provided _on_boot_time() function. */
+    _on_boot_time(eccCycles, DWT->CYCCNT);
+
     /* Branch to application's main function */
     (void)main();
 
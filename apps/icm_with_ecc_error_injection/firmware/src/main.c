@@ -55,6 +55,10 @@
 #include "app_ecc_inject_tcm.h"
 #include "app_ecc_inject_flexram.h"
 #include "app_ecc_inject_ext_sdram.h"
+#include "app_icm_scrub.h"
+#include "app_ecc_scrub.h"
+#include "app_ecc_fault_map.h"
+#include "app_ecc_campaign.h"
 
 /*----------------------------------------------------------------------------
  *        Local definitions
@@ -78,8 +82,50 @@
 #define APP_ICM_ID_REGION3                 (0x08U)
 /* Define the ICM number of region used */
 #define APP_ICM_NUM_REGION                 (4U)
-/* Define the ICM hash size in words */
-#define APP_ICM_HASH_SIZE_WORD             (8U)
+/* Define the number of bytes hashed by the ICM in one scrub step */
+#define APP_ICM_SCRUB_CHUNK_SIZE           (1024UL)
+/* Define the maximum number of bytes read by the ICM in one time slice */
+#define APP_ICM_SCRUB_BUDGET_BYTES         (2048UL)
+/* Define the scrub time slice in CPU cycles : 1ms */
+#define APP_ICM_SCRUB_SLICE_PERIOD         (CPU_CLOCK_FREQUENCY / 1000UL)
+/* Define the size of the blocks located and repaired on digest mismatch */
+#define APP_ICM_SCRUB_GRANULARITY          (256UL)
+/* Define the number of chunk digests for all regions */
+#define APP_ICM_SCRUB_DIGEST_NUM           (APP_ICM_NUM_REGION * \
+                                            APP_ICM_SCRUB_DIGEST_COUNT(APP_BUFFER_LENGTH * 4UL, APP_ICM_SCRUB_CHUNK_SIZE))
+/* Define the number of block digests used to locate the corrupted blocks */
+#define APP_ICM_SCRUB_TREE_NUM             APP_ICM_SCRUB_TREE_COUNT(APP_ICM_SCRUB_DIGEST_NUM, \
+                                                                    APP_ICM_SCRUB_CHUNK_SIZE, APP_ICM_SCRUB_GRANULARITY)
+/* Define the number of bytes read by the ECC scrubber in one step */
+#define APP_ECC_SCRUB_CHUNK_SIZE           (512UL)
+/* Define the maximum number of bytes read by the ECC scrubber in one time slice */
+#define APP_ECC_SCRUB_BUDGET_BYTES         (1024UL)
+/* Define the ECC scrubber time slice in CPU cycles : 1ms */
+#define APP_ECC_SCRUB_SLICE_PERIOD         (CPU_CLOCK_FREQUENCY / 1000UL)
+/* Define the period of the ECC fault map snapshot printed when new faults occur */
+#define APP_ECC_FAULT_MAP_PERIOD_MS        (5000UL)
+/* Define the ECC campaign seed, the same seed gives the same injections */
+#ifndef APP_ECC_CAMPAIGN_SEED
+#define APP_ECC_CAMPAIGN_SEED              (0x5EEDECC1UL)
+#endif
+/* Define the number of errors injected by the ECC campaign */
+#define APP_ECC_CAMPAIGN_INJECTIONS        (4000UL)
+/* Define the percentage of not fixable errors injected by the ECC campaign */
+#define APP_ECC_CAMPAIGN_UNFIXABLE_PERCENT (10U)
+/* Define the minimum time between two ECC campaign injections in CPU cycles : 1ms */
+#define APP_ECC_CAMPAIGN_PERIOD            (CPU_CLOCK_FREQUENCY / 1000UL)
+/* Define the ECC campaign detection timeout in CPU cycles : 100ms */
+#define APP_ECC_CAMPAIGN_TIMEOUT           (CPU_CLOCK_FREQUENCY / 10UL)
+/* Define APP_ECC_CAMPAIGN to run an ECC fault injection campaign at startup */
+/* Define APP_ECC_GOLDEN_RELOAD to reload the initial data of the buffers on not fixable errors instead of 0xDEADDEAD */
+/* Define APP_ICM_PRINT_DIGESTS to print the chunk digests after the first sweep */
+/* Define APP_ICM_GOLDEN_DIGESTS to link the digests generated by tools/icm_digest and compare from boot */
+/* Define APP_ECC_PRINT_CHECK_BITS to print the check bits of walking one patterns, used to fit tools/ecc_model */
+
+#ifdef APP_ICM_GOLDEN_DIGESTS
+/* Reference digests generated on the host */
+extern const uint32_t icm_golden_digests[APP_ICM_SCRUB_DIGEST_NUM][ICM_HASH_REGION_SIZE / 4U];
+#endif
 
 /*----------------------------------------------------------------------------
  *        Local variables
@@ -91,7 +137,7 @@ static volatile uint8_t buttonStatus = 0;
 static app_memory_region_t g_selectedMemoryRegion;
 
 /* Buffer of data placed in ITCM memory were ECC error will be injected */
-static uint32_t __attribute__((section (".itcm_data"))) buffer_itcm[APP_BUFFER_LENGTH] = {0};
+static uint32_t __attribute__((section (".itcm_data"), aligned (8))) buffer_itcm[APP_BUFFER_LENGTH] = {0};
 
 /* Buffer of data placed in DTCM memory were ECC error will be injected */
 static uint32_t __attribute__((tcm)) buffer_dtcm[APP_BUFFER_LENGTH] = {0};
@@ -102,11 +148,23 @@ static uint32_t __attribute__((section (".ram_data"))) buffer_internal_sram[APP_
 /* Buffer of data placed in external RAM memory were ECC error will be injected */
 static uint32_t __attribute__((section (".ext_sdram"))) buffer_external_ram[APP_BUFFER_LENGTH];
 
-/* Hash Buffer were ICM will store the computed hash for each region */
-static uint32_t __attribute__((aligned (128))) bufferHash[APP_ICM_NUM_REGION][APP_ICM_HASH_SIZE_WORD] = {0};
+/* Digest Buffer were ICM will store the reference hash of each chunk of the regions */
+static app_icm_scrub_digest_t icmScrubDigests[APP_ICM_SCRUB_DIGEST_NUM];
 
-/* Variable containing the bitfield of the ICM region were hash completed event occurs */
-static volatile uint8_t regionHashCompleted;
+/* Digests of the blocks of each chunk, to locate a corruption */
+static uint32_t icmScrubTree[APP_ICM_SCRUB_TREE_NUM][ICM_HASH_REGION_SIZE / 4U];
+
+/* Memory areas checked by the ICM scrub scheduler, one per region */
+static app_icm_scrub_area_t icmScrubAreas[APP_ICM_NUM_REGION];
+
+/* ICM scrub scheduler configuration */
+static app_icm_scrub_config_t icmScrubConfig;
+
+/* Memory areas read by the ECC scrubber, one per region */
+static app_ecc_scrub_area_t eccScrubAreas[APP_MEMORY_REGION_NUM];
+
+/* ECC scrubber configuration */
+static app_ecc_scrub_config_t eccScrubConfig;
 
 /* Variable containing the bitfield of the ICM region were digest mismatch event occurs */
 static volatile uint8_t regionDigestMismatch;
@@ -117,6 +175,18 @@ static uint32_t g_eccErrorBufferPosition[APP_MEMORY_REGION_NUM] = {0};
 /* Table of ECC injection parameters for each region */
 static app_ecc_error_inject_t g_eccErrorInjectTable[APP_MEMORY_REGION_NUM] = {0};
 
+#ifdef APP_ECC_CAMPAIGN
+/* Buffers where the ECC campaign injects errors, one per region */
+static app_ecc_campaign_target_t eccCampaignTargets[APP_MEMORY_REGION_NUM];
+
+/* ECC campaign profile */
+static app_ecc_campaign_profile_t eccCampaignProfile;
+#endif
+
+/* Boot time reported by the startup code, in CPU cycles from reset */
+static uint32_t bootEccCycles;
+static uint32_t bootCycles;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Local functions
@@ -170,122 +240,219 @@ static void APP_ControlSwitch(PIO_PIN pin, uintptr_t context)
 }
 
 // *****************************************************************************
-/* void APP_ICM_Callback(uintptr_t context)
+/* Function:
+    void _on_boot_time(uint32_t eccCycles, uint32_t cycles)
+
+   Summary:
+    Boot time report of the startup code.
+
+   Description:
+    This function is called by the startup code before main with the time
+    spent in the TCM and FlexRAM ECC initialization and the time from reset.
+    Both are counted at the reset clock, before the clock configuration.
+
+   Parameters:
+    eccCycles - CPU cycles at the end of the ECC initialization.
+    cycles - CPU cycles when main is called.
+
+   Returns:
+    None.
+*/
+void _on_boot_time(uint32_t eccCycles, uint32_t cycles)
+{
+    bootEccCycles = eccCycles;
+    bootCycles = cycles;
+}
+
+// *****************************************************************************
+/* void APP_ICM_ScrubMismatch(uint32_t area, uint32_t address, uint32_t size, uintptr_t context)
 
   Summary:
-    Function called by ICM PLIB.
+    Function called by the ICM scrub scheduler.
 
   Description:
-    This function will be called by ICM PLIB when interrupt has occurred.
+    This function will be called by the ICM scrub scheduler with each
+    corrupted block located in a chunk whose digest does not match. Only
+    this block is set back to its initial data.
 
   Remarks:
     None.
 */
-static void APP_ICM_Callback(uintptr_t context)
+static void APP_ICM_ScrubMismatch(uint32_t area, uint32_t address, uint32_t size, uintptr_t context)
 {
-    ICM_INT_MSK status = (ICM_InterruptGet() & ICM_InterruptMasked());
+    (void)context;
 
-    /* Check Digest Mismatch interrupts */
-    if ( ( status & ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK ) != 0U )
+    if ( APP_ECC_CAMPAIGN_is_running() == false )
     {
-        regionDigestMismatch |= APP_ICM_ID_REGION0;
-        ICM_InterruptDisable(ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK);
+        printf("  ICM Digest mismatch in region %u block 0x%08x (%u bytes)\n\r",
+                (unsigned int)area, (unsigned int)address, (unsigned int)size);
     }
 
-    if ( ( status & ICM_INT_MSK_DIGEST_MISMATCH_R1_MASK ) != 0U )
+    memset((void *)address, (int)('a'), size);
+    if ( DATA_CACHE_IS_ENABLED() != 0U )
     {
-        regionDigestMismatch |= APP_ICM_ID_REGION1;
-        ICM_InterruptDisable(ICM_INT_MSK_DIGEST_MISMATCH_R1_MASK);
+        DCACHE_CLEAN_BY_ADDR((uint32_t *)address, (int32_t)size);
     }
+    regionDigestMismatch |= (uint8_t)(1U << area);
+}
 
-    if ( ( status & ICM_INT_MSK_DIGEST_MISMATCH_R2_MASK ) != 0U )
-    {
-        regionDigestMismatch |= APP_ICM_ID_REGION2;
-        ICM_InterruptDisable(ICM_INT_MSK_DIGEST_MISMATCH_R2_MASK);
-    }
+#ifdef APP_ECC_GOLDEN_RELOAD
+// *****************************************************************************
+/* Function:
+    static bool APP_ECC_GoldenData(app_memory_region_t region, uint32_t address,
+                                   uint32_t* data, uint32_t words, uintptr_t context)
 
-    if ( ( status & ICM_INT_MSK_DIGEST_MISMATCH_R3_MASK ) != 0U )
-    {
-        regionDigestMismatch |= APP_ICM_ID_REGION3;
-        ICM_InterruptDisable(ICM_INT_MSK_DIGEST_MISMATCH_R3_MASK);
-    }
+   Summary:
+    Golden source of the not fixable error repair.
 
-    /* Check Hash Complete interrupts */
-    if ( ( status & ICM_INT_MSK_HASH_R0_MASK ) != 0U )
-    {
-        regionHashCompleted |= APP_ICM_ID_REGION0;
-        ICM_InterruptDisable(ICM_INT_MSK_HASH_R0_MASK);
-    }
+   Description:
+    The memory buffers only hold their initial data, the words of a buffer
+    hit by a not fixable error are reloaded with it.
 
-    if ( ( status & ICM_INT_MSK_HASH_R1_MASK ) != 0U )
-    {
-        regionHashCompleted |= APP_ICM_ID_REGION1;
-        ICM_InterruptDisable(ICM_INT_MSK_HASH_R1_MASK);
-    }
+   Parameters:
+    region - memory region of the fault.
+    address - ECC word address.
+    data - filled with the words of initial data.
+    words - number of words of the ECC word.
+    context - not used.
 
-    if ( ( status & ICM_INT_MSK_HASH_R2_MASK ) != 0U )
+   Returns:
+    true when the address is in the buffer of the region.
+*/
+static bool APP_ECC_GoldenData(app_memory_region_t region, uint32_t address,
+                               uint32_t* data, uint32_t words, uintptr_t context)
+{
+    (void)context;
+
+    if ( ( address < icmScrubAreas[region].address ) ||
+         ( ( address - icmScrubAreas[region].address ) >= icmScrubAreas[region].size ) )
     {
-        regionHashCompleted |= APP_ICM_ID_REGION2;
-        ICM_InterruptDisable(ICM_INT_MSK_HASH_R2_MASK);
+        return false;
     }
 
-    if ( ( status & ICM_INT_MSK_HASH_R3_MASK ) != 0U )
+    while ( words > 0U )
     {
-        regionHashCompleted |= APP_ICM_ID_REGION3;
-        ICM_InterruptDisable(ICM_INT_MSK_HASH_R3_MASK);
+        words--;
+        data[words] = 0x61616161UL;
     }
+    return true;
 }
+#endif
 
+#ifdef APP_ECC_PRINT_CHECK_BITS
 // *****************************************************************************
 /* Function:
-    void APP_generate_ecc_error(PIO_PIN pin, uintptr_t context)
+    static void APP_print_check_bits(app_memory_region_t region, uint32_t* pBuffer)
 
    Summary:
-    Generate ECC error for the current selected memory region.
+    Print the check bits of walking one patterns in a memory region.
 
    Description:
-    This function call the function to initialize and generate a new ECC
-    error depending on the current memory region selected.
+    This function writes the initial data word and the words with one bit
+    flipped in the buffer, reads their check bits in test mode and prints one
+    "ECC_CB" line per word. ITCM check bits cover a 64-bit double word, the
+    other memories a 32-bit word. The lines are read by tools/ecc_model to
+    fit and check the ECC code of each memory.
 
    Parameters:
-    error_type - type or ECC error to inject (APP_ERROR_TYPE_FIXABLE or APP_ERROR_TYPE_UNFIXABLE).
+    region - memory region of the buffer.
+    pBuffer - pointer to data buffer, its first three words are overwritten.
 
    Returns:
     None.
 */
-static void APP_generate_ecc_error(app_error_type_t error_type)
+static void APP_print_check_bits(app_memory_region_t region, uint32_t* pBuffer)
 {
-    ICM_Disable();
+    static const char* const modelString[APP_MEMORY_REGION_NUM] = { "itcm", "dtcm", "flexram", "hemc" };
+    app_ecc_error_inject_t eccInject;
+    uint32_t index = 0U;
+    uint32_t dataBits = 32U;
+    uint32_t bit;
 
-    while ( (ICM_StatusGet() & ICM_STATUS_ENABLE) == ICM_STATUS_ENABLE )
+    if ( region == APP_MEMORY_REGION_ITCM )
     {
-        /* Wait current memory region is monitored */
+        /* Start on a double word boundary */
+        index = (((uint32_t)pBuffer & 0x4U) != 0U) ? 1U : 0U;
+        dataBits = 64U;
     }
 
-    if ( error_type == APP_ERROR_TYPE_FIXABLE )
-    {
-        printf("-> Generate fixable error on region %s at index : %u \n\r",
-                g_memoryRegionString[g_selectedMemoryRegion],
-                (unsigned int)g_eccErrorBufferPosition[g_selectedMemoryRegion]);
-    }
-    else if ( error_type == APP_ERROR_TYPE_UNFIXABLE )
-    {
-        printf("-> Generate not fixable error on region %s at index : %u \n\r",
-                g_memoryRegionString[g_selectedMemoryRegion],
-                (unsigned int)g_eccErrorBufferPosition[g_selectedMemoryRegion]);
-    }
-    else
+    for (bit = 0U; bit <= dataBits; bit++)
     {
-        /* Wrong error type value */
+        uint32_t flip = (bit == 0U) ? 0U : (1UL << ((bit - 1U) % 32U));
+
+        pBuffer[index] = 0x61616161UL ^ (((bit != 0U) && (bit <= 32U)) ? flip : 0U);
+        pBuffer[index + 1U] = 0x61616161UL ^ ((bit > 32U) ? flip : 0U);
+        if ( ( region >= APP_MEMORY_REGION_INTERNAL_SRAM ) && ( DATA_CACHE_IS_ENABLED() != 0U ) )
+        {
+            DCACHE_CLEAN_INVALIDATE_BY_ADDR(&pBuffer[index], (int32_t)(2U * sizeof(uint32_t)));
+        }
+        __DSB();
+
+        switch ( region )
+        {
+            case APP_MEMORY_REGION_ITCM:
+            case APP_MEMORY_REGION_DTCM:
+                APP_ECC_INJECT_TCM_initialize_error(&eccInject, pBuffer, index);
+                break;
+            case APP_MEMORY_REGION_INTERNAL_SRAM:
+                APP_ECC_INJECT_FLEXRAM_initialize_error(&eccInject, pBuffer, index);
+                break;
+            default:
+                APP_ECC_INJECT_EXT_SDRAM_initialize_error(&eccInject, pBuffer, index);
+                eccInject.ecc_tcb2 = 0U;
+                break;
+        }
+
+        if ( dataBits == 64U )
+        {
+            printf("ECC_CB %s 0x%08x 0x%08x%08x 0x%02x 0x%02x\n\r", modelString[region],
+                    (unsigned int)&pBuffer[index], (unsigned int)pBuffer[index + 1U],
+                    (unsigned int)pBuffer[index], (unsigned int)eccInject.ecc_tcb1, (unsigned int)eccInject.ecc_tcb2);
+        }
+        else
+        {
+            printf("ECC_CB %s 0x%08x 0x%08x 0x%02x 0x%02x\n\r", modelString[region],
+                    (unsigned int)&pBuffer[index], (unsigned int)eccInject.data,
+                    (unsigned int)eccInject.ecc_tcb1, (unsigned int)eccInject.ecc_tcb2);
+        }
     }
+}
+#endif
+
+// *****************************************************************************
+/* Function:
+    static void APP_inject_ecc_error(app_memory_region_t region, uint32_t index,
+                                     app_error_type_t error_type)
+
+   Summary:
+    Inject an ECC error in a memory region.
+
+   Description:
+    This function call the function to initialize and generate a new ECC
+    error at a word of the buffer of the region. The ICM and ECC scrubbers
+    are suspended during the test mode sequence. It is also the injection
+    function of the ECC campaign.
+
+   Parameters:
+    region - memory region.
+    index - index of the word in the buffer of the region.
+    error_type - type or ECC error to inject (APP_ERROR_TYPE_FIXABLE or APP_ERROR_TYPE_UNFIXABLE).
+
+   Returns:
+    None.
+*/
+static void APP_inject_ecc_error(app_memory_region_t region, uint32_t index, app_error_type_t error_type)
+{
+    APP_ICM_SCRUB_suspend();
+    APP_ECC_SCRUB_suspend();
 
-    switch ( g_selectedMemoryRegion )
+    switch ( region )
     {
         case APP_MEMORY_REGION_ITCM:
             APP_ECC_INJECT_TCM_initialize_error(
                 &(g_eccErrorInjectTable[APP_MEMORY_REGION_ITCM]),
                 &(buffer_itcm[0]),
-                g_eccErrorBufferPosition[APP_MEMORY_REGION_ITCM]);
+                index);
             APP_ECC_INJECT_TCM_generate_error(
                 &(g_eccErrorInjectTable[APP_MEMORY_REGION_ITCM]),
                 &(buffer_itcm[0]),
@@ -295,7 +462,7 @@ static void APP_generate_ecc_error(app_error_type_t error_type)
             APP_ECC_INJECT_TCM_initialize_error(
                 &(g_eccErrorInjectTable[APP_MEMORY_REGION_DTCM]),
                 &(buffer_dtcm[0]),
-                g_eccErrorBufferPosition[APP_MEMORY_REGION_DTCM]);
+                index);
             APP_ECC_INJECT_TCM_generate_error(
                 &(g_eccErrorInjectTable[APP_MEMORY_REGION_DTCM]),
                 &(buffer_dtcm[0]),
@@ -305,7 +472,7 @@ static void APP_generate_ecc_error(app_error_type_t error_type)
             APP_ECC_INJECT_FLEXRAM_initialize_error(
                 &(g_eccErrorInjectTable[APP_MEMORY_REGION_INTERNAL_SRAM]),
                 &(buffer_internal_sram[0]),
-                g_eccErrorBufferPosition[APP_MEMORY_REGION_INTERNAL_SRAM]);
+                index);
             APP_ECC_INJECT_FLEXRAM_generate_error(
                 &(g_eccErrorInjectTable[APP_MEMORY_REGION_INTERNAL_SRAM]),
                 &(buffer_internal_sram[0]),
@@ -315,7 +482,7 @@ static void APP_generate_ecc_error(app_error_type_t error_type)
             APP_ECC_INJECT_EXT_SDRAM_initialize_error(
                 &(g_eccErrorInjectTable[APP_MEMORY_REGION_EXTERNAL_RAM]),
                 &(buffer_external_ram[0]),
-                g_eccErrorBufferPosition[APP_MEMORY_REGION_EXTERNAL_RAM]);
+                index);
             APP_ECC_INJECT_EXT_SDRAM_generate_error(
                 &(g_eccErrorInjectTable[APP_MEMORY_REGION_EXTERNAL_RAM]),
                 &(buffer_external_ram[0]),
@@ -326,7 +493,47 @@ static void APP_generate_ecc_error(app_error_type_t error_type)
             break;
     }
 
-    ICM_Enable();
+    APP_ECC_SCRUB_resume();
+    APP_ICM_SCRUB_resume();
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_generate_ecc_error(PIO_PIN pin, uintptr_t context)
+
+   Summary:
+    Generate ECC error for the current selected memory region.
+
+   Description:
+    This function injects a new ECC error in the current memory region
+    selected, at the next injection position of the region.
+
+   Parameters:
+    error_type - type or ECC error to inject (APP_ERROR_TYPE_FIXABLE or APP_ERROR_TYPE_UNFIXABLE).
+
+   Returns:
+    None.
+*/
+static void APP_generate_ecc_error(app_error_type_t error_type)
+{
+    if ( error_type == APP_ERROR_TYPE_FIXABLE )
+    {
+        printf("-> Generate fixable error on region %s at index : %u \n\r",
+                g_memoryRegionString[g_selectedMemoryRegion],
+                (unsigned int)g_eccErrorBufferPosition[g_selectedMemoryRegion]);
+    }
+    else if ( error_type == APP_ERROR_TYPE_UNFIXABLE )
+    {
+        printf("-> Generate not fixable error on region %s at index : %u \n\r",
+                g_memoryRegionString[g_selectedMemoryRegion],
+                (unsigned int)g_eccErrorBufferPosition[g_selectedMemoryRegion]);
+    }
+    else
+    {
+        /* Wrong error type value */
+    }
+
+    APP_inject_ecc_error(g_selectedMemoryRegion, g_eccErrorBufferPosition[g_selectedMemoryRegion], error_type);
 
     /* Increment injection position in buffer */
     g_eccErrorBufferPosition[g_selectedMemoryRegion]++;
@@ -350,6 +557,10 @@ int main ( void )
     printf("\n\r-----------------------------------------------------------");
     printf("\n\r  ICM with ECC error injection example                     ");
     printf("\n\r-----------------------------------------------------------\n\r");
+    printf("Boot : ECC initialization %u cycles, main after %u cycles (reset cause %u)\n\r",
+            (unsigned int)bootEccCycles,
+            (unsigned int)bootCycles,
+            (unsigned int)((RSTC_REGS->RSTC_SR & RSTC_SR_RSTTYP_Msk) >> RSTC_SR_RSTTYP_Pos));
 
     PIO_PinInterruptCallbackRegister(SWITCH0_PIN, APP_ControlSwitch, (uintptr_t)NULL);
     PIO_PinInterruptCallbackRegister(SWITCH1_PIN, APP_ControlSwitch, (uintptr_t)NULL);
@@ -358,10 +569,18 @@ int main ( void )
     PIO_PinInterruptEnable(SWITCH1_PIN);
     PIO_PinInterruptEnable(SWITCH2_PIN);
 
+    APP_ECC_FAULT_MAP_init(APP_ECC_FAULT_MAP_PERIOD_MS);
     APP_ECC_INJECT_TCM_init();
     APP_ECC_INJECT_FLEXRAM_init();
     APP_ECC_INJECT_EXT_SDRAM_init();
 
+#ifdef APP_ECC_PRINT_CHECK_BITS
+    APP_print_check_bits(APP_MEMORY_REGION_ITCM, buffer_itcm);
+    APP_print_check_bits(APP_MEMORY_REGION_DTCM, buffer_dtcm);
+    APP_print_check_bits(APP_MEMORY_REGION_INTERNAL_SRAM, buffer_internal_sram);
+    APP_print_check_bits(APP_MEMORY_REGION_EXTERNAL_RAM, buffer_external_ram);
+#endif
+
     /* Set initial data in memory buffers */
     memset(buffer_itcm, (int)('a'), sizeof(buffer_itcm));
     memset(buffer_dtcm, (int)('a'), sizeof(buffer_dtcm));
@@ -376,44 +595,137 @@ int main ( void )
         DCACHE_CLEAN_INVALIDATE_BY_ADDR((uint32_t *)buffer_external_ram, (int32_t)(sizeof(buffer_external_ram)));
     }
 
-    /* Set ICM memory address for generated hash */
-    ICM_SetHashStartAddress((uint32_t)&bufferHash);
+    /* Configure ICM scrub scheduler on the memory buffers */
+    icmScrubAreas[APP_MEMORY_REGION_ITCM] = (app_icm_scrub_area_t){ (uint32_t)buffer_itcm, sizeof(buffer_itcm) };
+    icmScrubAreas[APP_MEMORY_REGION_DTCM] = (app_icm_scrub_area_t){ (uint32_t)buffer_dtcm, sizeof(buffer_dtcm) };
+    icmScrubAreas[APP_MEMORY_REGION_INTERNAL_SRAM] = (app_icm_scrub_area_t){ (uint32_t)buffer_internal_sram, sizeof(buffer_internal_sram) };
+    icmScrubAreas[APP_MEMORY_REGION_EXTERNAL_RAM] = (app_icm_scrub_area_t){ (uint32_t)buffer_external_ram, sizeof(buffer_external_ram) };
 
-    regionHashCompleted = 0;
-    regionDigestMismatch = 0;
+#ifdef APP_ECC_GOLDEN_RELOAD
+    /* Not fixable errors in the buffers are repaired with their initial data */
+    APP_ECC_ERROR_golden_register(APP_ECC_GoldenData, (uintptr_t)NULL);
+#endif
 
-    /* Register ICM Callback */
-    ICM_CallbackRegister(APP_ICM_Callback, (uintptr_t)NULL);
-
-    ICM_InterruptEnable(ICM_INT_MSK_HASH_R0_MASK | ICM_INT_MSK_HASH_R1_MASK |
-                        ICM_INT_MSK_HASH_R2_MASK | ICM_INT_MSK_HASH_R3_MASK);
-
-    /* Enable ICM to perform first hash of regions */
-    printf("Enable ICM region(0-3)...\n\r");
-    ICM_Enable();
+    icmScrubConfig = (app_icm_scrub_config_t)
+    {
+        .areas = icmScrubAreas,
+        .area_num = APP_ICM_NUM_REGION,
+        .digests = icmScrubDigests,
+        .digest_num = APP_ICM_SCRUB_DIGEST_NUM,
+#ifdef APP_ICM_GOLDEN_DIGESTS
+        .golden = icm_golden_digests,
+        .golden_num = APP_ICM_SCRUB_DIGEST_NUM,
+#else
+        .golden = NULL,
+        .golden_num = 0U,
+#endif
+        .granularity = APP_ICM_SCRUB_GRANULARITY,
+        .tree = icmScrubTree,
+        .tree_num = APP_ICM_SCRUB_TREE_NUM,
+        .chunk_size = APP_ICM_SCRUB_CHUNK_SIZE,
+        .budget_bytes = APP_ICM_SCRUB_BUDGET_BYTES,
+        .slice_period = APP_ICM_SCRUB_SLICE_PERIOD,
+        .algo = ICM_ALGO_SHA1,
+        .processing_delay = false,
+        .bus_burden = 0U,
+        .callback = APP_ICM_ScrubMismatch,
+        .context = (uintptr_t)NULL,
+    };
 
+    regionDigestMismatch = 0;
 
-    while ( regionHashCompleted != (APP_ICM_ID_REGION0 | APP_ICM_ID_REGION1 | APP_ICM_ID_REGION2 | APP_ICM_ID_REGION3) )
+    if ( APP_ICM_SCRUB_init(&icmScrubConfig) == false )
     {
-        /* Wait first hash is completed */
+        printf("ICM scrub configuration error\n\r");
+        while (true)
+        {
+            /* Configuration error */
+        }
     }
 
-    /* Disable ICM */
-    ICM_Disable();
-
-    /* Disable ICM Write back feature */
-    ICM_WriteBackDisable(true);
-
-    regionHashCompleted = 0;
-    regionDigestMismatch = 0;
+    /* First sweep stores the reference digest of each chunk, or compares with the golden ones */
+    printf("Enable ICM region(0-3)...\n\r");
+    app_icm_scrub_status_t scrubStatus;
+    do
+    {
+        APP_ICM_SCRUB_task();
+        APP_ICM_SCRUB_get_status(&scrubStatus);
+    } while ( scrubStatus.sweep_count == 0U );
+
+    printf("ICM scrub : %u chunks of %u bytes, %u bytes per %u us slice, full coverage in %u us (first sweep %u ms)\n\r",
+            (unsigned int)scrubStatus.chunk_count,
+            (unsigned int)APP_ICM_SCRUB_CHUNK_SIZE,
+            (unsigned int)APP_ICM_SCRUB_BUDGET_BYTES,
+            (unsigned int)(APP_ICM_SCRUB_SLICE_PERIOD / (CPU_CLOCK_FREQUENCY / 1000000UL)),
+            (unsigned int)(scrubStatus.coverage_slices * (APP_ICM_SCRUB_SLICE_PERIOD / (CPU_CLOCK_FREQUENCY / 1000000UL))),
+            (unsigned int)scrubStatus.last_sweep_ms);
+
+#ifdef APP_ICM_PRINT_DIGESTS
+    APP_ICM_SCRUB_print_digests();
+#endif
+
+    /* Configure ECC scrubber on the memory buffers : single errors are corrected by the fix callbacks */
+    eccScrubAreas[APP_MEMORY_REGION_ITCM] = (app_ecc_scrub_area_t){ (uint32_t)buffer_itcm, sizeof(buffer_itcm), false };
+    eccScrubAreas[APP_MEMORY_REGION_DTCM] = (app_ecc_scrub_area_t){ (uint32_t)buffer_dtcm, sizeof(buffer_dtcm), false };
+    eccScrubAreas[APP_MEMORY_REGION_INTERNAL_SRAM] = (app_ecc_scrub_area_t){ (uint32_t)buffer_internal_sram, sizeof(buffer_internal_sram), true };
+    eccScrubAreas[APP_MEMORY_REGION_EXTERNAL_RAM] = (app_ecc_scrub_area_t){ (uint32_t)buffer_external_ram, sizeof(buffer_external_ram), true };
+
+    eccScrubConfig = (app_ecc_scrub_config_t)
+    {
+        .areas = eccScrubAreas,
+        .area_num = APP_MEMORY_REGION_NUM,
+        .chunk_size = APP_ECC_SCRUB_CHUNK_SIZE,
+        .budget_bytes = APP_ECC_SCRUB_BUDGET_BYTES,
+        .slice_period = APP_ECC_SCRUB_SLICE_PERIOD,
+    };
+
+    if ( APP_ECC_SCRUB_init(&eccScrubConfig) == false )
+    {
+        printf("ECC scrub configuration error\n\r");
+        while (true)
+        {
+            /* Configuration error */
+        }
+    }
 
-    /* Enable ICM monitor mode */
-    ICM_MonitorEnable(ICM_REGION0_MASK | ICM_REGION1_MASK | ICM_REGION2_MASK | ICM_REGION3_MASK);
-    ICM_InterruptEnable(ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK |
-                        ICM_INT_MSK_DIGEST_MISMATCH_R1_MASK |
-                        ICM_INT_MSK_DIGEST_MISMATCH_R2_MASK |
-                        ICM_INT_MSK_DIGEST_MISMATCH_R3_MASK);
-    ICM_Enable();
+    app_ecc_scrub_status_t eccScrubStatus;
+    APP_ECC_SCRUB_get_status(&eccScrubStatus);
+    printf("ECC scrub : %u bytes, %u bytes per %u us slice, full sweep in %u ms\n\r",
+            (unsigned int)eccScrubStatus.sweep_bytes,
+            (unsigned int)APP_ECC_SCRUB_BUDGET_BYTES,
+            (unsigned int)(APP_ECC_SCRUB_SLICE_PERIOD / (CPU_CLOCK_FREQUENCY / 1000000UL)),
+            (unsigned int)eccScrubStatus.sweep_period_ms);
+
+#ifdef APP_ECC_CAMPAIGN
+    /* Start the ECC fault injection campaign on the memory buffers */
+    eccCampaignTargets[APP_MEMORY_REGION_ITCM] = (app_ecc_campaign_target_t){ buffer_itcm, APP_BUFFER_LENGTH };
+    eccCampaignTargets[APP_MEMORY_REGION_DTCM] = (app_ecc_campaign_target_t){ buffer_dtcm, APP_BUFFER_LENGTH };
+    eccCampaignTargets[APP_MEMORY_REGION_INTERNAL_SRAM] = (app_ecc_campaign_target_t){ buffer_internal_sram, APP_BUFFER_LENGTH };
+    eccCampaignTargets[APP_MEMORY_REGION_EXTERNAL_RAM] = (app_ecc_campaign_target_t){ buffer_external_ram, APP_BUFFER_LENGTH };
+
+    eccCampaignProfile = (app_ecc_campaign_profile_t)
+    {
+        .seed = APP_ECC_CAMPAIGN_SEED,
+        .injection_num = APP_ECC_CAMPAIGN_INJECTIONS,
+        .region_weight = { 1U, 1U, 1U, 1U },
+        .unfixable_percent = APP_ECC_CAMPAIGN_UNFIXABLE_PERCENT,
+        .address = APP_ECC_CAMPAIGN_ADDRESS_UNIFORM,
+        .hotspot_words = 0U,
+        .detect = APP_ECC_CAMPAIGN_DETECT_READ,
+        .period = APP_ECC_CAMPAIGN_PERIOD,
+        .timeout = APP_ECC_CAMPAIGN_TIMEOUT,
+    };
+
+    if ( APP_ECC_CAMPAIGN_start(&eccCampaignProfile, eccCampaignTargets, APP_inject_ecc_error) == false )
+    {
+        printf("ECC campaign configuration error\n\r");
+    }
+    else
+    {
+        printf("ECC campaign : %u injections, seed 0x%08x...\n\r",
+                (unsigned int)APP_ECC_CAMPAIGN_INJECTIONS, (unsigned int)APP_ECC_CAMPAIGN_SEED);
+    }
+#endif
 
     printf("ICM monitoring started for region (0-3)...\n\r");
     printf("Press [Push Button 0] to change ecc error injection memory target(ITCM, DTCM, FlexRAM, external RAM memory)\n\r");
@@ -424,63 +736,58 @@ int main ( void )
 
     while (1)
     {
-        /* Print ECC error counts */
-        APP_ECC_ERROR_print_interrupt_count();
-
-        /* Handle ICM mismatch event : set back initial data in buffers */
-        if ( regionDigestMismatch != 0U )
+        /* Print ECC error counts, the campaign prints its own report */
+        if ( APP_ECC_CAMPAIGN_is_running() == false )
         {
-            uint32_t mismatch = regionDigestMismatch;
-            ICM_Disable();
+            APP_ECC_ERROR_print_interrupt_count();
+        }
 
-            while ( (ICM_StatusGet() & ICM_STATUS_ENABLE) == ICM_STATUS_ENABLE )
-            {
-                /* Wait end of current memory region monitored */
-            }
+        /* Run ICM scrub scheduler */
+        APP_ICM_SCRUB_task();
 
-            /* Preform dummy read of status to clear pending interrupts */
-            ICM_INT_MSK dummy_status = ICM_InterruptGet();
-            (void)(dummy_status);
+        /* Run ECC scrubber */
+        APP_ECC_SCRUB_task();
 
-            if ( ( mismatch & APP_ICM_ID_REGION0 ) != 0U )
-            {
-                memset(buffer_itcm, (int)('a'), sizeof(buffer_itcm));
-                regionDigestMismatch &= ~(APP_ICM_ID_REGION0);
-                ICM_InterruptEnable(ICM_INT_MSK_DIGEST_MISMATCH_R0_MASK);
-            }
-            if ( ( mismatch & APP_ICM_ID_REGION1 ) != 0U )
-            {
-                memset(buffer_dtcm, (int)('a'), sizeof(buffer_dtcm));
-                regionDigestMismatch &= ~(APP_ICM_ID_REGION1);
-                ICM_InterruptEnable(ICM_INT_MSK_DIGEST_MISMATCH_R1_MASK);
-            }
-            if ( ( mismatch & APP_ICM_ID_REGION2 ) != 0U )
-            {
-                memset(buffer_internal_sram, (int)('a'), sizeof(buffer_internal_sram));
-                if ( DATA_CACHE_IS_ENABLED() )
-                {
-                    DCACHE_CLEAN_BY_ADDR((uint32_t *)buffer_internal_sram, (int32_t)(sizeof(buffer_internal_sram)));
-                }
-                regionDigestMismatch &= ~(APP_ICM_ID_REGION2);
-                ICM_InterruptEnable(ICM_INT_MSK_DIGEST_MISMATCH_R2_MASK);
-            }
-            if ( ( mismatch & APP_ICM_ID_REGION3 ) != 0U )
+        /* Print ECC fault map telemetry */
+        APP_ECC_FAULT_MAP_task();
+
+#ifdef APP_ECC_CAMPAIGN
+        /* Run ECC fault injection campaign and print its report when done */
+        if ( APP_ECC_CAMPAIGN_is_running() == true )
+        {
+            APP_ECC_CAMPAIGN_task();
+            if ( APP_ECC_CAMPAIGN_is_running() == false )
             {
-                memset(buffer_external_ram, (int)('a'), sizeof(buffer_external_ram));
-                if ( DATA_CACHE_IS_ENABLED() )
-                    DCACHE_CLEAN_BY_ADDR((uint32_t *)buffer_external_ram, (int32_t)(sizeof(buffer_external_ram)));
-                regionDigestMismatch &= ~(APP_ICM_ID_REGION3);
-                ICM_InterruptEnable(ICM_INT_MSK_DIGEST_MISMATCH_R3_MASK);
+                app_ecc_campaign_report_t eccCampaignReport;
+
+                APP_ECC_CAMPAIGN_get_report(&eccCampaignReport);
+                APP_ECC_CAMPAIGN_print_report(&eccCampaignReport);
             }
+        }
+#endif
 
-            ICM_Enable();
+        /* Handle ICM mismatch event : corrupted blocks are already repaired */
+        if ( regionDigestMismatch != 0U )
+        {
+            uint32_t mismatch = regionDigestMismatch;
+            regionDigestMismatch &= (uint8_t)~mismatch;
 
-            printf("  ICM Digest mismatch occurs @ region(s) 0x%x \n\r",
-                    (unsigned int) mismatch);
+            APP_ICM_SCRUB_get_status(&scrubStatus);
+            if ( APP_ECC_CAMPAIGN_is_running() == false )
+            {
+                printf("  ICM Digest mismatch occurs @ region(s) 0x%x : %u block(s) repaired (last sweep %u ms)\n\r",
+                        (unsigned int) mismatch,
+                        (unsigned int)scrubStatus.block_count,
+                        (unsigned int)scrubStatus.last_sweep_ms);
+            }
         }
 
-        /* Handle buttons events */
-        if ( buttonStatus != 0U )
+        /* Handle buttons events, the campaign owns the error injection while it runs */
+        if ( ( buttonStatus != 0U ) && ( APP_ECC_CAMPAIGN_is_running() == true ) )
+        {
+            buttonStatus = 0U;
+        }
+        else if ( buttonStatus != 0U )
         {
             uint8_t button = buttonStatus;
 
@@ -59,7 +59,7 @@
 // *****************************************************************************
 // *****************************************************************************
 
-static IP1553_OBJ ip1553Obj;
+static IP1553_TCM_DATA IP1553_OBJ ip1553Obj;
 
 // *****************************************************************************
 // *****************************************************************************
@@ -138,7 +138,7 @@ void IP1553_BuffersConfigSet(uint16_t* txBuffers, uint16_t* rxBuffers)
     Bitfield value that indicates for each of the 32 buffers if they are
     ready to be sent (1) or are empty (0).
 */
-uint32_t IP1553_GetTxBuffersStatus(void)
+IP1553_TCM_CODE uint32_t IP1553_GetTxBuffersStatus(void)
 {
     return IP1553_REGS->IP1553_TXBSR;
 }
@@ -160,7 +160,7 @@ uint32_t IP1553_GetTxBuffersStatus(void)
    Returns:
     None.
 */
-void IP1553_ResetTxBuffersStatus(uint32_t buffers)
+IP1553_TCM_CODE void IP1553_ResetTxBuffersStatus(uint32_t buffers)
 {
     IP1553_REGS->IP1553_TXBSR = buffers;
 }
@@ -182,7 +182,7 @@ void IP1553_ResetTxBuffersStatus(uint32_t buffers)
     Bitfield value that indicates for each of the 32 buffers if they are
     free to receive data or not : empty (1) or full(0).
 */
-uint32_t IP1553_GetRxBuffersStatus(void)
+IP1553_TCM_CODE uint32_t IP1553_GetRxBuffersStatus(void)
 {
     return IP1553_REGS->IP1553_RXBSR;
 }
@@ -204,7 +204,7 @@ uint32_t IP1553_GetRxBuffersStatus(void)
    Returns:
     None.
 */
-void IP1553_ResetRxBuffersStatus(uint32_t buffers)
+IP1553_TCM_CODE void IP1553_ResetRxBuffersStatus(uint32_t buffers)
 {
     IP1553_REGS->IP1553_RXBSR = buffers;
 }
@@ -225,7 +225,7 @@ void IP1553_ResetRxBuffersStatus(uint32_t buffers)
    Returns:
     Current status of instance.
 */
-IP1553_INT_MASK IP1553_IrqStatusGet( void )
+IP1553_TCM_CODE IP1553_INT_MASK IP1553_IrqStatusGet( void )
 {
     return (IP1553_INT_MASK)(IP1553_REGS->IP1553_ISR);
 }
@@ -346,7 +346,7 @@ void IP1553_BcModeCommandTransfer(uint8_t rtAddr, IP1553_MODE_CMD modeCommand, u
    Returns:
     Value of transfer first status word.
 */
-uint16_t IP1553_GetFirstStatusWord( void )
+IP1553_TCM_CODE uint16_t IP1553_GetFirstStatusWord( void )
 {
     return (uint16_t)( ( IP1553_REGS->IP1553_CTRL1 & IP1553_CTRL1_IP1553DATA1_Msk ) >> IP1553_CTRL1_IP1553DATA1_Pos );
 }
@@ -367,7 +367,7 @@ uint16_t IP1553_GetFirstStatusWord( void )
    Returns:
     Value of transfer second status word.
 */
-uint16_t IP1553_GetSecondStatusWord( void )
+IP1553_TCM_CODE uint16_t IP1553_GetSecondStatusWord( void )
 {
     return (uint16_t)( ( IP1553_REGS->IP1553_CTRL1 & IP1553_CTRL1_IP1553DATA2_Msk) >> IP1553_CTRL1_IP1553DATA2_Pos );
 }
@@ -442,7 +442,7 @@ void IP1553_CallbackRegister(IP1553_CALLBACK callback, uintptr_t contextHandle)
     instance interrupt is enabled. If peripheral instance's interrupt is not
     enabled user need to call it from the main while loop of the application.
 */
-void __attribute__((used)) IP1553_InterruptHandler(void)
+IP1553_TCM_CODE void __attribute__((used)) IP1553_InterruptHandler(void)
 {
 
     if (ip1553Obj.callback != NULL)
@@ -375,7 +375,7 @@ static void APP_IP1553_InitiateModeCommand(uint8_t rtAddress)
  Remarks:
  None.
  */
-static void APP_IP1553_Callback(uintptr_t context)
+static IP1553_TCM_CODE void APP_IP1553_Callback(uintptr_t context)
 {
     uint32_t readStatus = IP1553_IrqStatusGet();
 
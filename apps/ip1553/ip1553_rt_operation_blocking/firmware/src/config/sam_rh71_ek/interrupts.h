@@ -67,4 +67,13 @@ void PIOC_InterruptHandler (void);
 
 
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Startup Routines
+// *****************************************************************************
+// *****************************************************************************
+/* Initialize the ECC of the FlexRAM left by the startup code above
+   __ecc_flexram_used_end, defined in startup_xc32.c */
+void ECC_InitializeDeferred (void);
+
 #endif // INTERRUPTS_H
@@ -137,7 +137,7 @@ void IP1553_BuffersConfigSet(uint16_t* txBuffers, uint16_t* rxBuffers)
     Bitfield value that indicates for each of the 32 buffers if they are
     ready to be sent (1) or are empty (0).
 */
-uint32_t IP1553_GetTxBuffersStatus(void)
+IP1553_TCM_CODE uint32_t IP1553_GetTxBuffersStatus(void)
 {
     return IP1553_REGS->IP1553_TXBSR;
 }
@@ -159,7 +159,7 @@ uint32_t IP1553_GetTxBuffersStatus(void)
    Returns:
     None.
 */
-void IP1553_ResetTxBuffersStatus(uint32_t buffers)
+IP1553_TCM_CODE void IP1553_ResetTxBuffersStatus(uint32_t buffers)
 {
     IP1553_REGS->IP1553_TXBSR = buffers;
 }
@@ -181,7 +181,7 @@ void IP1553_ResetTxBuffersStatus(uint32_t buffers)
     Bitfield value that indicates for each of the 32 buffers if they are
     free to receive data or not : empty (1) or full(0).
 */
-uint32_t IP1553_GetRxBuffersStatus(void)
+IP1553_TCM_CODE uint32_t IP1553_GetRxBuffersStatus(void)
 {
     return IP1553_REGS->IP1553_RXBSR;
 }
@@ -203,7 +203,7 @@ uint32_t IP1553_GetRxBuffersStatus(void)
    Returns:
     None.
 */
-void IP1553_ResetRxBuffersStatus(uint32_t buffers)
+IP1553_TCM_CODE void IP1553_ResetRxBuffersStatus(uint32_t buffers)
 {
     IP1553_REGS->IP1553_RXBSR = buffers;
 }
@@ -224,7 +224,7 @@ void IP1553_ResetRxBuffersStatus(uint32_t buffers)
    Returns:
     Current status of instance.
 */
-IP1553_INT_MASK IP1553_IrqStatusGet( void )
+IP1553_TCM_CODE IP1553_INT_MASK IP1553_IrqStatusGet( void )
 {
     return (IP1553_INT_MASK)(IP1553_REGS->IP1553_ISR);
 }
@@ -245,7 +245,7 @@ IP1553_INT_MASK IP1553_IrqStatusGet( void )
    Returns:
     Value of transfer first status word.
 */
-uint16_t IP1553_GetFirstStatusWord( void )
+IP1553_TCM_CODE uint16_t IP1553_GetFirstStatusWord( void )
 {
     return (uint16_t)( ( IP1553_REGS->IP1553_CTRL1 & IP1553_CTRL1_IP1553DATA1_Msk ) >> IP1553_CTRL1_IP1553DATA1_Pos );
 }
@@ -66,6 +66,17 @@
 // Section: IP1553 defines
 // *****************************************************************************
 // *****************************************************************************
+/* Placement of the interrupt fast path: the interrupt handler, the buffer and
+   interrupt status functions and the driver object are placed in the TCM when
+   IP1553_TCM is defined in the project macros. */
+#ifdef IP1553_TCM
+#define IP1553_TCM_CODE                                  TCM_CODE
+#define IP1553_TCM_DATA                                  TCM_DATA
+#else
+#define IP1553_TCM_CODE
+#define IP1553_TCM_DATA
+#endif
+
 /* Number of IP1553 buffers */
 #define IP1553_BUFFERS_NUM                               (32UL)
 
@@ -293,7 +293,7 @@ static void APP_IP1553_PrintModeCommandInd(uint32_t status)
  Remarks:
  None.
  */
-static void APP_IP1553_Callback(uintptr_t context)
+static IP1553_TCM_CODE void APP_IP1553_Callback(uintptr_t context)
 {
     uint32_t readStatus = IP1553_IrqStatusGet();
     
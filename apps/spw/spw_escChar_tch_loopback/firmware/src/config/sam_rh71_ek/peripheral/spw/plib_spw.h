@@ -64,6 +64,16 @@
 // Section: SPW defines
 // *****************************************************************************
 // *****************************************************************************
+/* Placement of the interrupt fast path: the interrupt handler, the functions
+   called from the SPW callback and the driver object are placed in the TCM
+   when SPW_TCM is defined in the project macros. */
+#ifdef SPW_TCM
+#define SPW_TCM_CODE                    TCM_CODE
+#define SPW_TCM_DATA                    TCM_DATA
+#else
+#define SPW_TCM_CODE
+#define SPW_TCM_DATA
+#endif
 
 // *****************************************************************************
 // *****************************************************************************
@@ -49,6 +49,7 @@
 // *****************************************************************************
 
 #include "device.h"
+#include "plib_spw.h"
 #include "plib_spw_pktrx.h"
 
 // *****************************************************************************
@@ -122,7 +123,7 @@ void SPW_PKTRX_SetDiscard(bool discard)
    Returns:
     None.
 */
-void SPW_PKTRX_SetNextBuffer(
+SPW_TCM_CODE void SPW_PKTRX_SetNextBuffer(
     uint8_t* dataAddress,
     uint32_t dataLengthBytes,
     SPW_PKTRX_INFO* packetInfoAddress,
@@ -156,7 +157,7 @@ void SPW_PKTRX_SetNextBuffer(
    Returns:
     Current status of SPW packet RX module.
 */
-SPW_PKTRX_STATUS SPW_PKTRX_StatusGet(void)
+SPW_TCM_CODE SPW_PKTRX_STATUS SPW_PKTRX_StatusGet(void)
 {
     return (SPW_PKTRX_STATUS)(SPW_REGS->SPW_PKTRX1_STATUS);
 }
@@ -177,7 +178,7 @@ SPW_PKTRX_STATUS SPW_PKTRX_StatusGet(void)
    Returns:
     Current interrupt status of SPW packet RX module.
 */
-SPW_PKTRX_INT_MASK SPW_PKTRX_IrqStatusGetMaskedAndClear(void)
+SPW_TCM_CODE SPW_PKTRX_INT_MASK SPW_PKTRX_IrqStatusGetMaskedAndClear(void)
 {
     uint32_t pendingMaskedIrq = SPW_REGS->SPW_PKTRX1_PI_RM;
     SPW_REGS->SPW_PKTRX1_PI_C = pendingMaskedIrq;
@@ -264,7 +265,7 @@ void SPW_PKTRX_CurrentPacketAbort(void)
    Returns:
     None.
 */
-void SPW_PKTRX_CurrentPacketSplit(void)
+SPW_TCM_CODE void SPW_PKTRX_CurrentPacketSplit(void)
 {
     SPW_REGS->SPW_PKTRX1_CURBUFCFG = SPW_PKTRX1_CURBUFCFG_SPLIT_Msk;
 }
@@ -285,7 +286,7 @@ void SPW_PKTRX_CurrentPacketSplit(void)
    Returns:
     Current value of previous buffer status of SPW packet RX module.
 */
-SPW_PKTRX_PREV_STATUS SPW_PKTRX_GetPreviousBufferStatus(void)
+SPW_TCM_CODE SPW_PKTRX_PREV_STATUS SPW_PKTRX_GetPreviousBufferStatus(void)
 {
     return (SPW_PKTRX_PREV_STATUS)(SPW_REGS->SPW_PKTRX1_PREVBUFSTS);
 }
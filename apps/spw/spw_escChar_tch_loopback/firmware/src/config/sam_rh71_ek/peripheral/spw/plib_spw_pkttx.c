@@ -50,6 +50,7 @@
 
 #include <stddef.h>
 #include "device.h"
+#include "plib_spw.h"
 #include "plib_spw_pkttx.h"
 
 // *****************************************************************************
@@ -78,7 +79,7 @@
    Returns:
     Current status of SPW packet TX module.
 */
-SPW_PKTTX_STATUS SPW_PKTTX_StatusGet(void)
+SPW_TCM_CODE SPW_PKTTX_STATUS SPW_PKTTX_StatusGet(void)
 {
     return (SPW_PKTTX_STATUS)(SPW_REGS->SPW_PKTTX1_STATUS);
 }
@@ -99,7 +100,7 @@ SPW_PKTTX_STATUS SPW_PKTTX_StatusGet(void)
    Returns:
     Current interrupt status of SPW packet TX module.
 */
-SPW_PKTTX_INT_MASK SPW_PKTTX_IrqStatusGetMaskedAndClear(void)
+SPW_TCM_CODE SPW_PKTTX_INT_MASK SPW_PKTTX_IrqStatusGetMaskedAndClear(void)
 {
     uint32_t pendingMaskedIrq = SPW_REGS->SPW_PKTTX1_PI_RM;
     SPW_REGS->SPW_PKTTX1_PI_C = pendingMaskedIrq;
@@ -174,7 +175,7 @@ void SPW_PKTTX_InterruptDisable(SPW_PKTTX_INT_MASK interruptMask)
    Returns:
     None.
 */
-void SPW_PKTTX_SetNextSendList(uint8_t* routerBytesTable,
+SPW_TCM_CODE void SPW_PKTTX_SetNextSendList(uint8_t* routerBytesTable,
                                SPW_PKTTX_SEND_LIST_ENTRY* sendListAddress,
                                uint16_t length,
                                bool abortCurrent,
@@ -215,7 +216,7 @@ void SPW_PKTTX_SetNextSendList(uint8_t* routerBytesTable,
    Returns:
     None.
 */
-void SPW_PKTTX_UnlockStatus(void)
+SPW_TCM_CODE void SPW_PKTTX_UnlockStatus(void)
 {
     /* Perform dummy write to status to unlock previous buffer status */
     SPW_REGS->SPW_PKTTX1_STATUS = (0x01);
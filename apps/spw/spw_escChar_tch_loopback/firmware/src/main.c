@@ -203,7 +203,7 @@ static void APP_PckTxSendEscapeCharOnTimeCode(SPW_LINK link, uint8_t escChar, ui
   Remarks:
     None.
 */
-static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
+static SPW_TCM_CODE void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
 {
     uint32_t distStatus = 0UL;
     
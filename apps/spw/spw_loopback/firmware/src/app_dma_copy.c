@@ -0,0 +1,506 @@
+/*******************************************************************************
+  MPLAB Harmony Application DMA Copy Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_dma_copy.c
+
+  Summary:
+    Asynchronous memory copy and fill.
+
+  Description:
+    Each queue entry owns a view 3 XDMAC descriptor in non cached memory. The
+    requests queued while the channel is idle are linked and started as one
+    linked list. The requests queued while it runs wait for the end of this
+    list and are then started together. The XDMAC does not fetch the
+    descriptors of the waiting requests, so they are written without
+    stopping the channel.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include <stdio.h>
+#include "app_dma_pool.h"
+#include "app_dma_copy.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Channel settings common to copy and fill: memory to memory, bursts of 16,
+   through the bus interface 1 as the FlexRAM fill of the startup code */
+#define APP_DMA_COPY_CC                 (XDMAC_CC_TYPE_MEM_TRAN | XDMAC_CC_MBSIZE_SIXTEEN | XDMAC_CC_CSIZE_CHK_1 | \
+                                         XDMAC_CC_SIF_AHB_IF1 | XDMAC_CC_DIF_AHB_IF1 | XDMAC_CC_DAM_INCREMENTED_AM)
+
+/* Queued request */
+typedef struct
+{
+    app_dma_copy_callback_t callback;
+    uintptr_t context;
+    void* dst;
+    uint32_t size;
+} app_dma_copy_request_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Descriptors read by the XDMAC, one per queue entry */
+static XDMAC_DESCRIPTOR_VIEW_3 copyDescriptor[APP_DMA_COPY_QUEUE_SIZE] __attribute__ ((section (".ram_nocache"), aligned (4)));
+
+/* Queue entries, indexed by free running counters modulo the queue size:
+   [copyTail, copyRun[ run in the XDMAC, [copyRun, copyHead[ wait */
+static app_dma_copy_request_t copyRequest[APP_DMA_COPY_QUEUE_SIZE];
+static volatile uint32_t copyHead = 0U;
+static volatile uint32_t copyRun = 0U;
+static volatile uint32_t copyTail = 0U;
+static volatile bool copyBusy = false;
+
+static volatile app_dma_copy_stats_t copyStats;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static void APP_DMA_COPY_start(void)
+
+   Summary:
+    Start the waiting requests as one linked list.
+
+   Precondition:
+    Called with the interrupts masked or from the XDMAC interrupt, while the
+    channel is idle.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+static void APP_DMA_COPY_start(void)
+{
+    uint32_t first = copyRun;
+    uint32_t end = copyHead;
+    uint32_t entry;
+    XDMAC_DESCRIPTOR_CONTROL control;
+
+    if ( first == end )
+    {
+        copyBusy = false;
+        return;
+    }
+
+    /* Link the descriptors, the last one ends the list */
+    for (entry = first; entry != end; entry++)
+    {
+        XDMAC_DESCRIPTOR_VIEW_3* descriptor = &copyDescriptor[entry % APP_DMA_COPY_QUEUE_SIZE];
+
+        if ( (entry + 1U) != end )
+        {
+            descriptor->mbr_nda = (uint32_t)&copyDescriptor[(entry + 1U) % APP_DMA_COPY_QUEUE_SIZE] | XDMAC_CNDA_NDAIF(1U);
+            descriptor->mbr_ubc.ctrl.nde = 1U;
+        }
+        else
+        {
+            descriptor->mbr_nda = 0U;
+            descriptor->mbr_ubc.ctrl.nde = 0U;
+        }
+    }
+
+    copyRun = end;
+    copyBusy = true;
+    copyStats.batches++;
+
+    control.value = 0U;
+    control.ctrl.nde = 1U;
+    control.ctrl.nsen = 1U;
+    control.ctrl.nden = 1U;
+    control.ctrl.view = XDMAC_DESCRIPTOR_VIEW_TYPE_3;
+    (void)XDMAC_ChannelLinkedListTransfer(APP_DMA_COPY_CHANNEL, (uint32_t)&copyDescriptor[first % APP_DMA_COPY_QUEUE_SIZE], &control);
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_DMA_COPY_callback(XDMAC_TRANSFER_EVENT event, uintptr_t context)
+
+   Summary:
+    XDMAC callback at the end of a linked list.
+
+   Description:
+    This function completes the requests of the list in order and starts the
+    requests queued meanwhile. A bus error stops the list: all its requests
+    are reported failed.
+
+   Parameters:
+    event - end of list or error.
+    context - not used.
+
+   Returns:
+    None.
+*/
+static void APP_DMA_COPY_callback(XDMAC_TRANSFER_EVENT event, uintptr_t context)
+{
+    bool success = (event == XDMAC_TRANSFER_COMPLETE);
+    uint32_t end = copyRun;
+
+    (void)context;
+
+    if ( success == false )
+    {
+        XDMAC_ChannelDisable(APP_DMA_COPY_CHANNEL);
+    }
+
+    while ( copyTail != end )
+    {
+        app_dma_copy_request_t request = copyRequest[copyTail % APP_DMA_COPY_QUEUE_SIZE];
+
+        if ( success == true )
+        {
+            /* Drop the lines the CPU may have read before the end of the transfer */
+            APP_DMA_POOL_cache_invalidate(request.dst, request.size);
+        }
+        else
+        {
+            copyStats.errors++;
+        }
+
+        /* Free the entry before the callback, which may queue a new request */
+        copyTail++;
+        if ( request.callback != NULL )
+        {
+            request.callback(success, request.context);
+        }
+    }
+
+    APP_DMA_COPY_start();
+}
+
+// *****************************************************************************
+/* Function:
+    static bool APP_DMA_COPY_queue(void* dst, const void* src, uint32_t size, uint32_t pattern,
+                                   app_dma_copy_callback_t callback, uintptr_t context)
+
+   Summary:
+    Queue a copy, or a fill when src is NULL.
+
+   Description:
+    The data width is the largest of word, halfword and byte that divides
+    the addresses and the size. The source and the destination are cleaned
+    from the data cache before the request is queued.
+
+   Parameters:
+    dst - destination.
+    src - source, or NULL to fill the destination with pattern.
+    size - size in bytes.
+    pattern - fill value repeated on 32 bits.
+    callback - completion callback, or NULL.
+    context - value passed to the callback.
+
+   Returns:
+    true if the request is queued.
+*/
+static bool APP_DMA_COPY_queue(void* dst, const void* src, uint32_t size, uint32_t pattern,
+                               app_dma_copy_callback_t callback, uintptr_t context)
+{
+    uint32_t align = (uint32_t)dst | size | (uint32_t)src;
+    uint32_t config = APP_DMA_COPY_CC;
+    uint32_t shift;
+    bool interruptStatus;
+    bool queued = false;
+
+    if ( (align & 3U) == 0U )
+    {
+        config |= XDMAC_CC_DWIDTH_WORD;
+        shift = 2U;
+    }
+    else if ( (align & 1U) == 0U )
+    {
+        config |= XDMAC_CC_DWIDTH_HALFWORD;
+        shift = 1U;
+    }
+    else
+    {
+        config |= XDMAC_CC_DWIDTH_BYTE;
+        shift = 0U;
+    }
+
+    if ( (dst == NULL) || (size == 0U) || ((size >> shift) > XDMAC_CUBC_UBLEN_Msk) )
+    {
+        return false;
+    }
+
+    if ( src != NULL )
+    {
+        config |= XDMAC_CC_SAM_INCREMENTED_AM | XDMAC_CC_MEMSET_NORMAL_MODE;
+        APP_DMA_POOL_cache_clean(src, size);
+    }
+    else
+    {
+        config |= XDMAC_CC_SAM_FIXED_AM | XDMAC_CC_MEMSET_HW_MODE;
+    }
+
+    /* No dirty line of the destination is written back over the transfer */
+    APP_DMA_POOL_cache_clean(dst, size);
+
+    interruptStatus = NVIC_INT_Disable();
+
+    if ( (copyHead - copyTail) < APP_DMA_COPY_QUEUE_SIZE )
+    {
+        uint32_t index = copyHead % APP_DMA_COPY_QUEUE_SIZE;
+        XDMAC_DESCRIPTOR_VIEW_3* descriptor = &copyDescriptor[index];
+
+        descriptor->mbr_ubc.value = 0U;
+        descriptor->mbr_ubc.ctrl.ubLen = size >> shift;
+        descriptor->mbr_ubc.ctrl.nsen = 1U;
+        descriptor->mbr_ubc.ctrl.nden = 1U;
+        descriptor->mbr_ubc.ctrl.view = XDMAC_DESCRIPTOR_VIEW_TYPE_3;
+        descriptor->mbr_sa = (src != NULL) ? (uint32_t)src : (uint32_t)dst;
+        descriptor->mbr_da = (uint32_t)dst;
+        descriptor->mbr_cfg = config;
+        descriptor->mbr_bc = 0U;
+        descriptor->mbr_ds = pattern;
+        descriptor->mbr_sus = 0U;
+        descriptor->mbr_dus = 0U;
+
+        copyRequest[index].callback = callback;
+        copyRequest[index].context = context;
+        copyRequest[index].dst = dst;
+        copyRequest[index].size = size;
+
+        copyHead++;
+        copyStats.requests++;
+        copyStats.bytes += size;
+        queued = true;
+
+        if ( copyBusy == false )
+        {
+            APP_DMA_COPY_start();
+        }
+    }
+    else
+    {
+        copyStats.full++;
+    }
+
+    NVIC_INT_Restore(interruptStatus);
+
+    return queued;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_DMA_COPY_init(void)
+
+   Summary:
+    Initialize the copy service.
+
+   Description:
+    This function empties the queue, clears the statistics and registers the
+    callback of the XDMAC channel.
+
+   Precondition:
+    XDMAC_Initialize must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_DMA_COPY_init(void)
+{
+    copyHead = 0U;
+    copyRun = 0U;
+    copyTail = 0U;
+    copyBusy = false;
+
+    copyStats.requests = 0U;
+    copyStats.bytes = 0U;
+    copyStats.batches = 0U;
+    copyStats.errors = 0U;
+    copyStats.full = 0U;
+
+    XDMAC_ChannelCallbackRegister(APP_DMA_COPY_CHANNEL, APP_DMA_COPY_callback, 0U);
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_DMA_COPY_memcpy(void* dst, const void* src, uint32_t size, app_dma_copy_callback_t callback, uintptr_t context)
+
+   Summary:
+    Queue the copy of a buffer.
+
+   Description:
+    This function returns once the request is queued. The buffers must not
+    be accessed by the CPU until the callback is called. It may be called
+    from the main loop or from an interrupt.
+
+   Precondition:
+    APP_DMA_COPY_init must have been called.
+
+   Parameters:
+    dst - destination buffer.
+    src - source buffer, not overlapping the destination.
+    size - size in bytes.
+    callback - completion callback, or NULL.
+    context - value passed to the callback.
+
+   Returns:
+    true if the request is queued, false if the queue is full or the size is
+    not valid.
+
+   Remarks:
+    Buffers in cacheable memory must own their cache lines.
+*/
+bool APP_DMA_COPY_memcpy(void* dst, const void* src, uint32_t size, app_dma_copy_callback_t callback, uintptr_t context)
+{
+    if ( src == NULL )
+    {
+        return false;
+    }
+    return APP_DMA_COPY_queue(dst, src, size, 0U, callback, context);
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_DMA_COPY_memset(void* dst, uint8_t value, uint32_t size, app_dma_copy_callback_t callback, uintptr_t context)
+
+   Summary:
+    Queue the fill of a buffer.
+
+   Description:
+    This function returns once the request is queued. The XDMAC writes the
+    value with its memory set mode, without reading memory. The buffer must
+    not be accessed by the CPU until the callback is called. It may be called
+    from the main loop or from an interrupt.
+
+   Precondition:
+    APP_DMA_COPY_init must have been called.
+
+   Parameters:
+    dst - buffer to fill.
+    value - fill value.
+    size - size in bytes.
+    callback - completion callback, or NULL.
+    context - value passed to the callback.
+
+   Returns:
+    true if the request is queued, false if the queue is full or the size is
+    not valid.
+
+   Remarks:
+    A buffer in cacheable memory must own its cache lines.
+*/
+bool APP_DMA_COPY_memset(void* dst, uint8_t value, uint32_t size, app_dma_copy_callback_t callback, uintptr_t context)
+{
+    return APP_DMA_COPY_queue(dst, NULL, size, (uint32_t)value * 0x01010101U, callback, context);
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_DMA_COPY_is_idle(void)
+
+   Summary:
+    Check that all the requests are completed.
+
+   Parameters:
+    None.
+
+   Returns:
+    true if the queue is empty.
+*/
+bool APP_DMA_COPY_is_idle(void)
+{
+    return (copyHead == copyTail);
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_DMA_COPY_get_stats(app_dma_copy_stats_t* stats)
+
+   Summary:
+    Get the counters of the copy service.
+
+   Parameters:
+    stats - counters.
+
+   Returns:
+    None.
+*/
+void APP_DMA_COPY_get_stats(app_dma_copy_stats_t* stats)
+{
+    stats->requests = copyStats.requests;
+    stats->bytes = copyStats.bytes;
+    stats->batches = copyStats.batches;
+    stats->errors = copyStats.errors;
+    stats->full = copyStats.full;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_DMA_COPY_print_stats(void)
+
+   Summary:
+    Print the counters of the copy service on the console.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_DMA_COPY_print_stats(void)
+{
+    app_dma_copy_stats_t stats;
+
+    APP_DMA_COPY_get_stats(&stats);
+    printf("DMA copy : %u requests, %u bytes, %u lists, %u errors, %u queue full\r\n",
+            (unsigned int)stats.requests,
+            (unsigned int)stats.bytes,
+            (unsigned int)stats.batches,
+            (unsigned int)stats.errors,
+            (unsigned int)stats.full);
+}
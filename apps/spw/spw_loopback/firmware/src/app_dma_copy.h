@@ -0,0 +1,141 @@
+/*******************************************************************************
+  MPLAB Harmony Application DMA Copy Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_dma_copy.h
+
+  Summary:
+    Asynchronous memory copy and fill Prototypes and definitions file.
+
+  Description:
+    The copy service runs memcpy and memset requests on one XDMAC channel so
+    the CPU is free during bulk copies, such as the recycling of the receive
+    buffers. Requests are queued and run in order as linked lists of XDMAC
+    descriptors. The callback of each request is called from the XDMAC
+    interrupt when it is completed.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_DMA_COPY_H
+#define	APP_DMA_COPY_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* XDMAC channel of the copy service */
+#define APP_DMA_COPY_CHANNEL                                      (XDMAC_CHANNEL_0)
+
+/* Number of requests in the queue */
+#define APP_DMA_COPY_QUEUE_SIZE                                   (16U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application DMA copy callback
+
+   Summary:
+    Completion callback of a request.
+
+   Description:
+    success is false when the XDMAC reported a bus error. The callback is
+    called from the XDMAC interrupt, after the destination is invalidated in
+    the data cache.
+
+   Remarks:
+    None.
+*/
+typedef void (*app_dma_copy_callback_t)(bool success, uintptr_t context);
+
+// *****************************************************************************
+/* Application DMA copy statistics
+
+   Summary:
+    Counters of the copy service.
+
+   Description:
+    batches counts the linked lists started, several requests queued while
+    the channel is busy run in the same linked list. full counts the
+    requests rejected because the queue was full.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t requests;
+    uint32_t bytes;
+    uint32_t batches;
+    uint32_t errors;
+    uint32_t full;
+} app_dma_copy_stats_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_DMA_COPY_init(void);
+
+bool APP_DMA_COPY_memcpy(void* dst, const void* src, uint32_t size, app_dma_copy_callback_t callback, uintptr_t context);
+
+bool APP_DMA_COPY_memset(void* dst, uint8_t value, uint32_t size, app_dma_copy_callback_t callback, uintptr_t context);
+
+bool APP_DMA_COPY_is_idle(void);
+
+void APP_DMA_COPY_get_stats(app_dma_copy_stats_t* stats);
+
+void APP_DMA_COPY_print_stats(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_DMA_COPY_H */
@@ -0,0 +1,520 @@
+/*******************************************************************************
+  MPLAB Harmony Application DMA Buffer Pool Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_dma_pool.c
+
+  Summary:
+    DMA buffer pool.
+
+  Description:
+    The free blocks of each size class are linked in a list through their
+    first word. Allocation pops the head of the list and free pushes the block
+    back with LDREX/STREX: an interrupt taken between both instructions clears
+    the exclusive monitor, so the interrupted update is retried and the lists
+    stay consistent without masking the interrupts.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include "interrupts.h"                 // ECC_InitializeDeferred
+#include <stdio.h>
+#include "app_dma_pool.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Free block, linked through its first word */
+typedef struct app_dma_pool_block
+{
+    struct app_dma_pool_block* next;
+} app_dma_pool_block_t;
+
+/* Size class : address range of its blocks, free list and statistics */
+typedef struct
+{
+    uint32_t block_size;
+    uint32_t block_num;
+    uint32_t start;
+    uint32_t end;
+    app_dma_pool_block_t* volatile head;
+    volatile uint32_t used;
+    volatile uint32_t used_max;
+    volatile uint32_t fail;
+} app_dma_pool_class_obj_t;
+
+/* Pool area at the end of the non cached region, defined by the linker script */
+extern uint32_t _s_ram_nocache_pool;
+extern uint32_t _e_ram_nocache_pool;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Size classes */
+static app_dma_pool_class_obj_t poolClass[APP_DMA_POOL_CLASS_MAX];
+static uint32_t poolClassNum = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static app_dma_pool_block_t* APP_DMA_POOL_pop(app_dma_pool_class_obj_t* obj)
+
+   Summary:
+    Remove the first free block of a size class.
+
+   Parameters:
+    obj - size class.
+
+   Returns:
+    The block, or NULL when the class has no free block.
+*/
+static app_dma_pool_block_t* APP_DMA_POOL_pop(app_dma_pool_class_obj_t* obj)
+{
+    app_dma_pool_block_t* block;
+
+    do
+    {
+        block = (app_dma_pool_block_t*)__LDREXW((volatile uint32_t*)&obj->head);
+        if ( block == NULL )
+        {
+            __CLREX();
+            return NULL;
+        }
+    } while ( __STREXW((uint32_t)block->next, (volatile uint32_t*)&obj->head) != 0U );
+
+    return block;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_DMA_POOL_push(app_dma_pool_class_obj_t* obj, app_dma_pool_block_t* block)
+
+   Summary:
+    Put a block back in the free list of its size class.
+
+   Parameters:
+    obj - size class.
+    block - block to free.
+
+   Returns:
+    None.
+*/
+static void APP_DMA_POOL_push(app_dma_pool_class_obj_t* obj, app_dma_pool_block_t* block)
+{
+    do
+    {
+        block->next = (app_dma_pool_block_t*)__LDREXW((volatile uint32_t*)&obj->head);
+    } while ( __STREXW((uint32_t)block, (volatile uint32_t*)&obj->head) != 0U );
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_DMA_POOL_add(volatile uint32_t* value, uint32_t delta)
+
+   Summary:
+    Add atomically to a counter.
+
+   Parameters:
+    value - counter.
+    delta - value added, modulo 2^32.
+
+   Returns:
+    New value of the counter.
+*/
+static uint32_t APP_DMA_POOL_add(volatile uint32_t* value, uint32_t delta)
+{
+    uint32_t result;
+
+    do
+    {
+        result = __LDREXW(value) + delta;
+    } while ( __STREXW(result, value) != 0U );
+
+    return result;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_DMA_POOL_max(volatile uint32_t* value, uint32_t candidate)
+
+   Summary:
+    Raise atomically a high water mark.
+
+   Parameters:
+    value - high water mark.
+    candidate - new value, kept when greater.
+
+   Returns:
+    None.
+*/
+static void APP_DMA_POOL_max(volatile uint32_t* value, uint32_t candidate)
+{
+    do
+    {
+        if ( __LDREXW(value) >= candidate )
+        {
+            __CLREX();
+            return;
+        }
+    } while ( __STREXW(candidate, value) != 0U );
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Application Initialization and State Machine Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    bool APP_DMA_POOL_init(const app_dma_pool_class_t* classes, uint32_t class_num)
+
+   Summary:
+    Initialize the DMA buffer pool.
+
+   Description:
+    This function sets the check bits of the pool area, left to the
+    application by the startup code, and fills it with zeros. It then carves
+    the blocks of each size class one after the other from the start of the
+    area and links them in the free list of their class.
+
+   Precondition:
+    Called once, before any other pool function and before the interrupts
+    using the pool are enabled.
+
+   Parameters:
+    classes - size classes, in increasing block size order.
+    class_num - number of size classes, up to APP_DMA_POOL_CLASS_MAX.
+
+   Returns:
+    true if the pool is initialized, false if the classes are not valid or do
+    not fit in the pool area.
+*/
+bool APP_DMA_POOL_init(const app_dma_pool_class_t* classes, uint32_t class_num)
+{
+    uint32_t address = ((uint32_t)&_s_ram_nocache_pool + (APP_DMA_POOL_ALIGN - 1U)) & ~(APP_DMA_POOL_ALIGN - 1U);
+    uint32_t end = (uint32_t)&_e_ram_nocache_pool;
+    uint32_t index;
+    uint32_t block;
+
+    if ( ( classes == NULL ) || ( class_num == 0U ) || ( class_num > APP_DMA_POOL_CLASS_MAX ) )
+    {
+        return false;
+    }
+
+    for (index = 0U; index < class_num; index++)
+    {
+        uint32_t blockSize = (classes[index].block_size + (APP_DMA_POOL_ALIGN - 1U)) & ~(APP_DMA_POOL_ALIGN - 1U);
+
+        if ( ( blockSize == 0U ) || ( classes[index].block_num == 0U ) ||
+             ( ( index > 0U ) && ( blockSize <= poolClass[index - 1U].block_size ) ) ||
+             ( classes[index].block_num > ( ( end - address ) / blockSize ) ) )
+        {
+            poolClassNum = 0U;
+            return false;
+        }
+
+        poolClass[index].block_size = blockSize;
+        poolClass[index].block_num = classes[index].block_num;
+        poolClass[index].start = address;
+        address += blockSize * classes[index].block_num;
+        poolClass[index].end = address;
+    }
+
+    ECC_InitializeDeferred();
+
+    for (index = 0U; index < class_num; index++)
+    {
+        app_dma_pool_class_obj_t* obj = &poolClass[index];
+
+        /* Link the blocks in address order */
+        obj->head = NULL;
+        for (block = obj->end; block > obj->start; )
+        {
+            block -= obj->block_size;
+            ((app_dma_pool_block_t*)block)->next = obj->head;
+            obj->head = (app_dma_pool_block_t*)block;
+        }
+        obj->used = 0U;
+        obj->used_max = 0U;
+        obj->fail = 0U;
+    }
+    poolClassNum = class_num;
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    void* APP_DMA_POOL_alloc(uint32_t size)
+
+   Summary:
+    Allocate a DMA buffer.
+
+   Description:
+    This function returns a block of the smallest size class holding size
+    bytes. When this class has no free block, the next larger classes are
+    tried in turn. The content of the block is not initialized.
+
+   Precondition:
+    APP_DMA_POOL_init must have been called.
+
+   Parameters:
+    size - size of the buffer in bytes.
+
+   Returns:
+    Buffer aligned on APP_DMA_POOL_ALIGN in non cached memory, or NULL.
+*/
+void* APP_DMA_POOL_alloc(uint32_t size)
+{
+    uint32_t index;
+    uint32_t first = poolClassNum;
+
+    for (index = 0U; index < poolClassNum; index++)
+    {
+        app_dma_pool_class_obj_t* obj = &poolClass[index];
+        app_dma_pool_block_t* block;
+
+        if ( obj->block_size < size )
+        {
+            continue;
+        }
+        if ( first == poolClassNum )
+        {
+            first = index;
+        }
+
+        block = APP_DMA_POOL_pop(obj);
+        if ( block != NULL )
+        {
+            APP_DMA_POOL_max(&obj->used_max, APP_DMA_POOL_add(&obj->used, 1U));
+            return (void*)block;
+        }
+    }
+
+    if ( first < poolClassNum )
+    {
+        (void)APP_DMA_POOL_add(&poolClass[first].fail, 1U);
+    }
+    return NULL;
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_DMA_POOL_free(void* block)
+
+   Summary:
+    Free a DMA buffer.
+
+   Description:
+    This function puts the block back in the free list of the size class
+    whose area holds its address.
+
+   Precondition:
+    The DMA transfers using the block are over.
+
+   Parameters:
+    block - buffer returned by APP_DMA_POOL_alloc.
+
+   Returns:
+    true if the block is freed, false if it is not a block of the pool.
+*/
+bool APP_DMA_POOL_free(void* block)
+{
+    uint32_t address = (uint32_t)block;
+    uint32_t index;
+
+    for (index = 0U; index < poolClassNum; index++)
+    {
+        app_dma_pool_class_obj_t* obj = &poolClass[index];
+
+        if ( ( address >= obj->start ) && ( address < obj->end ) )
+        {
+            if ( ( ( address - obj->start ) % obj->block_size ) != 0U )
+            {
+                return false;
+            }
+            APP_DMA_POOL_push(obj, (app_dma_pool_block_t*)block);
+            (void)APP_DMA_POOL_add(&obj->used, (uint32_t)-1);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_DMA_POOL_get_stats(uint32_t class_index, app_dma_pool_stats_t* stats)
+
+   Summary:
+    Get the usage of a size class.
+
+   Precondition:
+    APP_DMA_POOL_init must have been called.
+
+   Parameters:
+    class_index - size class index, in the order given to APP_DMA_POOL_init.
+    stats - filled with the size class usage.
+
+   Returns:
+    true if the size class exists.
+*/
+bool APP_DMA_POOL_get_stats(uint32_t class_index, app_dma_pool_stats_t* stats)
+{
+    if ( ( class_index >= poolClassNum ) || ( stats == NULL ) )
+    {
+        return false;
+    }
+
+    stats->block_size = poolClass[class_index].block_size;
+    stats->block_num = poolClass[class_index].block_num;
+    stats->used = poolClass[class_index].used;
+    stats->used_max = poolClass[class_index].used_max;
+    stats->fail = poolClass[class_index].fail;
+
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_DMA_POOL_print_stats(void)
+
+   Summary:
+    Print the usage of all size classes.
+
+   Precondition:
+    APP_DMA_POOL_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_DMA_POOL_print_stats(void)
+{
+    app_dma_pool_stats_t stats;
+    uint32_t index;
+
+    for (index = 0U; index < poolClassNum; index++)
+    {
+        (void)APP_DMA_POOL_get_stats(index, &stats);
+        printf("DMA pool class %u : %u blocks of %u bytes, %u used, %u max, %u failed\r\n",
+                (unsigned int)index,
+                (unsigned int)stats.block_num,
+                (unsigned int)stats.block_size,
+                (unsigned int)stats.used,
+                (unsigned int)stats.used_max,
+                (unsigned int)stats.fail);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_DMA_POOL_cache_clean(const void* buffer, uint32_t size)
+
+   Summary:
+    Hand a cacheable buffer written by the CPU over to a DMA read.
+
+   Description:
+    This function writes back to memory the dirty data cache lines holding
+    the buffer, so the peripheral reads the data written by the CPU. The
+    range is extended to whole cache lines.
+
+   Precondition:
+    None.
+
+   Parameters:
+    buffer - buffer in cacheable memory.
+    size - size of the buffer in bytes.
+
+   Returns:
+    None.
+*/
+void APP_DMA_POOL_cache_clean(const void* buffer, uint32_t size)
+{
+    uint32_t start = (uint32_t)buffer & ~(APP_DMA_POOL_ALIGN - 1U);
+    uint32_t end = ((uint32_t)buffer + size + (APP_DMA_POOL_ALIGN - 1U)) & ~(APP_DMA_POOL_ALIGN - 1U);
+
+    if ( ( DATA_CACHE_IS_ENABLED() != 0U ) && ( size != 0U ) )
+    {
+        DCACHE_CLEAN_BY_ADDR((void*)start, (int32_t)(end - start));
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_DMA_POOL_cache_invalidate(void* buffer, uint32_t size)
+
+   Summary:
+    Hand a cacheable buffer written by a DMA over to the CPU.
+
+   Description:
+    This function discards the data cache lines holding the buffer, filled
+    before or during the DMA transfer, so the CPU reads the data written by
+    the peripheral. The range is extended to whole cache lines: the buffer
+    must own the cache lines it overlaps, as APP_DMA_POOL_ALIGN aligned
+    buffers whose size is a multiple of APP_DMA_POOL_ALIGN do.
+
+   Precondition:
+    The DMA transfer writing the buffer is over.
+
+   Parameters:
+    buffer - buffer in cacheable memory.
+    size - size of the buffer in bytes.
+
+   Returns:
+    None.
+*/
+void APP_DMA_POOL_cache_invalidate(void* buffer, uint32_t size)
+{
+    uint32_t start = (uint32_t)buffer & ~(APP_DMA_POOL_ALIGN - 1U);
+    uint32_t end = ((uint32_t)buffer + size + (APP_DMA_POOL_ALIGN - 1U)) & ~(APP_DMA_POOL_ALIGN - 1U);
+
+    if ( ( DATA_CACHE_IS_ENABLED() != 0U ) && ( size != 0U ) )
+    {
+        DCACHE_INVALIDATE_BY_ADDR((void*)start, (int32_t)(end - start));
+    }
+}
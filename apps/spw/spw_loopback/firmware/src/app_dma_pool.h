@@ -0,0 +1,149 @@
+/*******************************************************************************
+  MPLAB Harmony Application DMA Buffer Pool Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_dma_pool.h
+
+  Summary:
+    DMA buffer pool Prototypes and definitions file.
+
+  Description:
+    The pool owns the part of the non cached FlexRAM region (.ram_nocache)
+    not used by the application image. It is split in size classes of fixed
+    size blocks, aligned on a cache line, that the SpaceWire and 1553
+    peripherals use as DMA buffers, send lists and packet information tables.
+    Blocks are allocated and freed in constant time without lock, from the
+    main loop or from an interrupt. DMA buffers placed in cacheable memory
+    instead use the cache maintenance functions at each handover between the
+    CPU and the peripheral.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_DMA_POOL_H
+#define	APP_DMA_POOL_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Alignment of the blocks, one data cache line */
+#define APP_DMA_POOL_ALIGN                                        (32U)
+
+/* Maximum number of size classes */
+#define APP_DMA_POOL_CLASS_MAX                                    (8U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application DMA pool size class
+
+   Summary:
+    Size and number of the blocks of a size class.
+
+   Description:
+    block_size is rounded up to APP_DMA_POOL_ALIGN. The classes are given in
+    increasing block size order.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t block_size;
+    uint32_t block_num;
+} app_dma_pool_class_t;
+
+// *****************************************************************************
+/* Application DMA pool size class statistics
+
+   Summary:
+    Usage of the blocks of a size class.
+
+   Description:
+    used is the number of blocks allocated, used_max its high water mark
+    since the pool initialization. fail counts the allocations of a size of
+    this class that found no free block in this class nor in a larger one.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t block_size;
+    uint32_t block_num;
+    uint32_t used;
+    uint32_t used_max;
+    uint32_t fail;
+} app_dma_pool_stats_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+bool APP_DMA_POOL_init(const app_dma_pool_class_t* classes, uint32_t class_num);
+
+void* APP_DMA_POOL_alloc(uint32_t size);
+
+bool APP_DMA_POOL_free(void* block);
+
+bool APP_DMA_POOL_get_stats(uint32_t class_index, app_dma_pool_stats_t* stats);
+
+void APP_DMA_POOL_print_stats(void);
+
+void APP_DMA_POOL_cache_clean(const void* buffer, uint32_t size);
+
+void APP_DMA_POOL_cache_invalidate(void* buffer, uint32_t size);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_DMA_POOL_H */
@@ -0,0 +1,335 @@
+/*******************************************************************************
+  MPLAB Harmony Application Sampling Profiler Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_prof.c
+
+  Summary:
+    Sampling profiler.
+
+  Description:
+    The TC1 channel 0 interrupt entry reads the stack pointer of the
+    interrupted code from EXC_RETURN and passes its exception frame to the
+    sampling function, which takes the stacked PC and LR. The pair is counted
+    in an open addressed table: a few entries are tried from its hash, so the
+    time spent in the interrupt stays bounded. The period is dithered so the
+    samples do not lock on the period of the application loops.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include <stdio.h>
+#include <string.h>
+#include "app_prof.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Smallest sampling period in timer counts */
+#define APP_PROF_PERIOD_MIN             (32U)
+
+/* Sample count of a (PC, LR) pair */
+typedef struct
+{
+    uint32_t pc;
+    uint32_t lr;
+    uint32_t count;
+} app_prof_entry_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Sample table, an entry is free when its count is 0 */
+static app_prof_entry_t profTable[APP_PROF_TABLE_SIZE];
+
+static volatile uint32_t profSamples = 0U;
+static volatile uint32_t profDropped = 0U;
+static volatile uint32_t profEntries = 0U;
+
+/* Sampling period in timer counts and rate */
+static uint32_t profPeriod = 0U;
+static uint32_t profRate = 0U;
+
+/* Pseudo random sequence of the period dither */
+static uint32_t profDither = 1U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static void APP_PROF_sample(const uint32_t* frame)
+
+   Summary:
+    Count the interrupted PC and LR.
+
+   Description:
+    The exception frame holds R0-R3, R12, LR, PC and xPSR in this order. An
+    LR holding an EXC_RETURN value means the interrupted code is a handler
+    entered less than one call ago.
+
+   Parameters:
+    frame - exception frame of the interrupted code.
+
+   Returns:
+    None.
+*/
+static void __attribute__((used)) APP_PROF_sample(const uint32_t* frame)
+{
+    uint32_t pc = frame[6];
+    uint32_t lr = frame[5];
+    uint32_t hash = ((pc >> 1) * 0x9E3779B1U) ^ lr;
+    uint32_t index = (hash ^ (hash >> 16)) & (APP_PROF_TABLE_SIZE - 1U);
+    uint32_t probe;
+
+    /* Clear the period interrupt */
+    (void)TC1_REGS->TC_CHANNEL[0].TC_SR;
+
+    /* Next period dithered over 1/16 of the period, centered on it */
+    profDither = (profDither >> 1) ^ ((0U - (profDither & 1U)) & 0x80200003U);
+    TC1_CH0_TimerPeriodSet(profPeriod - (profPeriod >> 5) + (profDither % ((profPeriod >> 4) + 1U)));
+
+    profSamples++;
+
+    for (probe = 0U; probe < APP_PROF_PROBE_MAX; probe++)
+    {
+        app_prof_entry_t* entry = &profTable[index];
+
+        if ( entry->count == 0U )
+        {
+            entry->pc = pc;
+            entry->lr = lr;
+            entry->count = 1U;
+            profEntries++;
+            return;
+        }
+        if ( (entry->pc == pc) && (entry->lr == lr) )
+        {
+            entry->count++;
+            return;
+        }
+        index = (index + 1U) & (APP_PROF_TABLE_SIZE - 1U);
+    }
+
+    profDropped++;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_PROF_InterruptHandler(void)
+
+   Summary:
+    TC1 channel 0 interrupt entry.
+
+   Description:
+    Bit 2 of EXC_RETURN tells whether the interrupted code used the main or
+    the process stack. Nothing is pushed before its frame pointer is taken,
+    and APP_PROF_sample returns with EXC_RETURN still in LR.
+
+   Remarks:
+    Referenced by the vector table.
+*/
+void __attribute__((naked, used)) APP_PROF_InterruptHandler(void)
+{
+    __asm volatile (
+        "    tst     lr, #4              \n"
+        "    ite     eq                  \n"
+        "    mrseq   r0, msp             \n"
+        "    mrsne   r0, psp             \n"
+        "    b       APP_PROF_sample     \n"
+    );
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_PROF_start(uint32_t rate_hz)
+
+   Summary:
+    Start sampling.
+
+   Description:
+    The samples are added to the table content. The rate is rounded to a
+    whole number of timer counts.
+
+   Precondition:
+    TC1_CH0_TimerInitialize must have been called.
+
+   Parameters:
+    rate_hz - sampling rate in Hz, 0 for APP_PROF_RATE_HZ.
+
+   Returns:
+    None.
+*/
+void APP_PROF_start(uint32_t rate_hz)
+{
+    uint32_t frequency = TC1_CH0_TimerFrequencyGet();
+
+    if ( rate_hz == 0U )
+    {
+        rate_hz = APP_PROF_RATE_HZ;
+    }
+
+    profPeriod = frequency / rate_hz;
+    if ( profPeriod < APP_PROF_PERIOD_MIN )
+    {
+        profPeriod = APP_PROF_PERIOD_MIN;
+    }
+    profRate = frequency / profPeriod;
+
+    TC1_CH0_TimerPeriodSet(profPeriod);
+    TC1_CH0_TimerStart();
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_PROF_stop(void)
+
+   Summary:
+    Stop sampling, the table is kept.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_PROF_stop(void)
+{
+    TC1_CH0_TimerStop();
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_PROF_reset(void)
+
+   Summary:
+    Clear the sample table and the counters.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_PROF_reset(void)
+{
+    bool interruptStatus = NVIC_INT_SourceDisable(TC1_CH0_IRQn);
+
+    memset(profTable, 0, sizeof(profTable));
+    profSamples = 0U;
+    profDropped = 0U;
+    profEntries = 0U;
+
+    NVIC_INT_SourceRestore(TC1_CH0_IRQn, interruptStatus);
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_PROF_get_stats(app_prof_stats_t* stats)
+
+   Summary:
+    Get the sample counters.
+
+   Parameters:
+    stats - counters.
+
+   Returns:
+    None.
+*/
+void APP_PROF_get_stats(app_prof_stats_t* stats)
+{
+    stats->rate_hz = profRate;
+    stats->samples = profSamples;
+    stats->dropped = profDropped;
+    stats->entries = profEntries;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_PROF_dump(void)
+
+   Summary:
+    Print the sample table on the console.
+
+   Description:
+    This function stops sampling and prints one "PROF <pc> <lr> <count>"
+    line per table entry, in hexadecimal for the addresses, between a
+    "PROF BEGIN" line with the counters and a "PROF END" line. The console
+    log is the input of the tools/prof_symbolize host tool.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_PROF_dump(void)
+{
+    uint32_t index;
+
+    APP_PROF_stop();
+
+    printf("PROF BEGIN rate=%u samples=%u dropped=%u entries=%u\r\n",
+            (unsigned int)profRate,
+            (unsigned int)profSamples,
+            (unsigned int)profDropped,
+            (unsigned int)profEntries);
+
+    for (index = 0U; index < APP_PROF_TABLE_SIZE; index++)
+    {
+        if ( profTable[index].count != 0U )
+        {
+            printf("PROF %08x %08x %u\r\n",
+                    (unsigned int)profTable[index].pc,
+                    (unsigned int)profTable[index].lr,
+                    (unsigned int)profTable[index].count);
+        }
+    }
+
+    printf("PROF END\r\n");
+}
@@ -0,0 +1,132 @@
+/*******************************************************************************
+  MPLAB Harmony Application Sampling Profiler Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_prof.h
+
+  Summary:
+    Sampling profiler Prototypes and definitions file.
+
+  Description:
+    The profiler samples the interrupted program counter and link register
+    at a fixed rate from the TC1 channel 0 period interrupt, which runs above
+    all the other interrupts. The samples are counted in a RAM table by
+    (PC, LR) pair, then printed on the console with APP_PROF_dump. The
+    tools/prof_symbolize host tool reads this dump with the ELF file of the
+    application and prints the flat and call edge profiles.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_PROF_H
+#define	APP_PROF_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Default sampling rate in Hz */
+#ifndef APP_PROF_RATE_HZ
+#define APP_PROF_RATE_HZ                                          (10000U)
+#endif
+
+/* Number of (PC, LR) pairs of the sample table, a power of two */
+#ifndef APP_PROF_TABLE_SIZE
+#define APP_PROF_TABLE_SIZE                                       (2048U)
+#endif
+
+/* Table entries tried for a new pair before the sample is dropped */
+#define APP_PROF_PROBE_MAX                                        (8U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application profiler statistics
+
+   Summary:
+    Sample counters of the profiler.
+
+   Description:
+    samples counts all the samples taken, dropped the ones that found no
+    free table entry for their (PC, LR) pair. entries is the number of
+    pairs in the table.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t rate_hz;
+    uint32_t samples;
+    uint32_t dropped;
+    uint32_t entries;
+} app_prof_stats_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_PROF_start(uint32_t rate_hz);
+
+void APP_PROF_stop(void);
+
+void APP_PROF_reset(void);
+
+void APP_PROF_get_stats(app_prof_stats_t* stats);
+
+void APP_PROF_dump(void);
+
+void APP_PROF_InterruptHandler(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_PROF_H */
@@ -0,0 +1,319 @@
+/*******************************************************************************
+  MPLAB Harmony Application SpaceWire Rx Flush Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_rx_flush.c
+
+  Summary:
+    SpaceWire Rx flush.
+
+  Description:
+    The flush timer is started again on each packet. Bursts are delivered at
+    their end instead of being split after a fixed time, and sparse packets
+    are delivered after the efficiency bound instead of the latency bound.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include <stdio.h>
+#include <string.h>
+#include "app_timebase.h"
+#include "app_timer.h"
+#include "app_rx_flush.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Gains of the mean gap (1/8) and of the mean deviation (1/4), as shifts */
+#define APP_RX_FLUSH_GAP_SHIFT          (3U)
+#define APP_RX_FLUSH_DEV_SHIFT          (2U)
+
+/* Weight of the mean deviation in the wait for a next packet */
+#define APP_RX_FLUSH_DEV_WEIGHT         (4U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+static app_timer_t flushTimer;
+
+/* Bounds in timebase ticks */
+static uint64_t flushMin = 0U;
+static uint64_t flushMax = 0U;
+
+/* Mean gap scaled by 8 and mean deviation scaled by 4, in timebase ticks */
+static uint64_t flushGap = 0U;
+static uint64_t flushDev = 0U;
+
+/* Arrival of the last packet and of the first packet of the buffer */
+static uint64_t flushLast = 0U;
+static uint64_t flushFirst = 0U;
+static bool flushInBuffer = false;
+
+/* Wait for a next packet, and whether the pending flush is on the latency
+   bound */
+static uint64_t flushTimeout = 0U;
+static bool flushOnLatency = false;
+
+static app_rx_flush_stats_t flushStats = {0};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static void APP_RX_FLUSH_timeout(uintptr_t context)
+
+   Summary:
+    Flush timer expiry.
+
+   Description:
+    Packets were received but didn't fill the current buffer: deactivate it
+    (abort with split) so they are delivered.
+*/
+static void APP_RX_FLUSH_timeout(uintptr_t context)
+{
+    if ( flushOnLatency )
+    {
+        flushStats.flush_latency++;
+    }
+    else
+    {
+        flushStats.flush_idle++;
+    }
+
+    SPW_PKTRX_CurrentPacketSplit();
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_RX_FLUSH_update(uint64_t gap)
+
+   Summary:
+    Add a gap between two packets to the estimates.
+
+   Description:
+    The mean gap and its mean deviation are smoothed as a round trip time
+    estimator. The wait for a next packet is the mean gap plus four mean
+    deviations, within the bounds. When it would exceed the latency bound,
+    a next packet is not expected in time and the buffer is flushed after
+    the efficiency bound.
+*/
+static void APP_RX_FLUSH_update(uint64_t gap)
+{
+    uint64_t expected;
+
+    /* A long idle time counts as the latency bound */
+    if ( gap > flushMax )
+    {
+        gap = flushMax + 1U;
+    }
+
+    if ( flushGap == 0U )
+    {
+        flushGap = gap << APP_RX_FLUSH_GAP_SHIFT;
+        flushDev = (gap / 2U) << APP_RX_FLUSH_DEV_SHIFT;
+    }
+    else
+    {
+        uint64_t mean = flushGap >> APP_RX_FLUSH_GAP_SHIFT;
+        uint64_t error = (gap > mean) ? (gap - mean) : (mean - gap);
+
+        flushGap = flushGap - mean + gap;
+        flushDev = flushDev - (flushDev >> APP_RX_FLUSH_DEV_SHIFT) + error;
+    }
+
+    expected = (flushGap >> APP_RX_FLUSH_GAP_SHIFT) + (APP_RX_FLUSH_DEV_WEIGHT * (flushDev >> APP_RX_FLUSH_DEV_SHIFT));
+    if ( (expected > flushMax) || (expected < flushMin) )
+    {
+        expected = flushMin;
+    }
+    flushTimeout = expected;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_RX_FLUSH_init(uint32_t min_us, uint32_t max_us)
+
+   Summary:
+    Initialize the Rx flush with its bounds.
+
+   Precondition:
+    APP_TIMER_init must have been called.
+
+   Parameters:
+    min_us - efficiency bound, the shortest wait for a next packet.
+    max_us - latency bound, the longest time from the first packet of a
+    buffer to its flush.
+
+   Returns:
+    None.
+*/
+void APP_RX_FLUSH_init(uint32_t min_us, uint32_t max_us)
+{
+    flushMin = APP_TIMEBASE_us_to_ticks(min_us);
+    flushMax = APP_TIMEBASE_us_to_ticks(max_us);
+    flushGap = 0U;
+    flushDev = 0U;
+    flushInBuffer = false;
+    flushTimeout = flushMax;
+    memset(&flushStats, 0, sizeof(flushStats));
+
+    APP_TIMER_create(&flushTimer, APP_RX_FLUSH_timeout, (uintptr_t)NULL, 0U);
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_RX_FLUSH_packet(void)
+
+   Summary:
+    Packet received in the current buffer.
+
+   Description:
+    This function is called from the end of packet interrupt. The gap since
+    the previous packet updates the wait for a next packet, and the flush is
+    set after this wait but not later than the latency bound from the first
+    packet of the buffer.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_RX_FLUSH_packet(void)
+{
+    uint64_t now = APP_TIMEBASE_get();
+    uint64_t deadline;
+
+    if ( flushStats.packets != 0U )
+    {
+        APP_RX_FLUSH_update(now - flushLast);
+    }
+    flushLast = now;
+    flushStats.packets++;
+
+    if ( !flushInBuffer )
+    {
+        flushInBuffer = true;
+        flushFirst = now;
+    }
+
+    deadline = now + flushTimeout;
+    flushOnLatency = (deadline >= (flushFirst + flushMax));
+    if ( flushOnLatency )
+    {
+        deadline = flushFirst + flushMax;
+    }
+
+    APP_TIMER_start(&flushTimer, (uint32_t)APP_TIMEBASE_ticks_to_us(deadline - now));
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_RX_FLUSH_buffer_end(void)
+
+   Summary:
+    Current buffer deactivated.
+
+   Description:
+    This function is called from the deactivation interrupt, after a flush
+    or when the buffer is full.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_RX_FLUSH_buffer_end(void)
+{
+    if ( APP_TIMER_cancel(&flushTimer) )
+    {
+        flushStats.full++;
+    }
+    flushInBuffer = false;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_RX_FLUSH_get_stats(app_rx_flush_stats_t* stats)
+
+   Summary:
+    Get the counters and the current wait of the Rx flush.
+*/
+void APP_RX_FLUSH_get_stats(app_rx_flush_stats_t* stats)
+{
+    bool interruptStatus = NVIC_INT_Disable();
+
+    *stats = flushStats;
+    stats->gap_us = (uint32_t)APP_TIMEBASE_ticks_to_us(flushGap >> APP_RX_FLUSH_GAP_SHIFT);
+    stats->timeout_us = (uint32_t)APP_TIMEBASE_ticks_to_us(flushTimeout);
+
+    NVIC_INT_Restore(interruptStatus);
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_RX_FLUSH_print_stats(void)
+
+   Summary:
+    Print the counters of the Rx flush on the console.
+*/
+void APP_RX_FLUSH_print_stats(void)
+{
+    app_rx_flush_stats_t stats;
+
+    APP_RX_FLUSH_get_stats(&stats);
+    printf("Rx flush : %u packets, gap %u us, wait %u us, %u idle flushes, %u latency flushes, %u full\r\n",
+            (unsigned int)stats.packets,
+            (unsigned int)stats.gap_us,
+            (unsigned int)stats.timeout_us,
+            (unsigned int)stats.flush_idle,
+            (unsigned int)stats.flush_latency,
+            (unsigned int)stats.full);
+}
@@ -0,0 +1,129 @@
+/*******************************************************************************
+  MPLAB Harmony Application SpaceWire Rx Flush Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_rx_flush.h
+
+  Summary:
+    SpaceWire Rx flush Prototypes and definitions file.
+
+  Description:
+    A receive buffer is deactivated when full, or flushed by a split of the
+    current packet so a partially filled buffer is delivered. The flush
+    deadline adapts to the measured time between packets: the buffer waits
+    for a next packet while one is expected, between an efficiency bound
+    and a latency bound.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_RX_FLUSH_H
+#define	APP_RX_FLUSH_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Default efficiency bound: shortest wait for a next packet in us */
+#ifndef APP_RX_FLUSH_MIN_US
+#define APP_RX_FLUSH_MIN_US                                       (50U)
+#endif
+
+/* Default latency bound: longest time a packet waits in a buffer in us */
+#ifndef APP_RX_FLUSH_MAX_US
+#define APP_RX_FLUSH_MAX_US                                       (10000U)
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application Rx flush statistics
+
+   Summary:
+    Counters and current state of the Rx flush.
+
+   Description:
+    gap_us is the mean time between two packets and timeout_us the wait for
+    a next packet chosen from it. flush_idle counts the buffers flushed
+    because no packet came within this wait, flush_latency the ones flushed
+    on the latency bound and full the ones deactivated without flush.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t packets;
+    uint32_t gap_us;
+    uint32_t timeout_us;
+    uint32_t flush_idle;
+    uint32_t flush_latency;
+    uint32_t full;
+} app_rx_flush_stats_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_RX_FLUSH_init(uint32_t min_us, uint32_t max_us);
+
+void APP_RX_FLUSH_packet(void);
+
+void APP_RX_FLUSH_buffer_end(void);
+
+void APP_RX_FLUSH_get_stats(app_rx_flush_stats_t* stats);
+
+void APP_RX_FLUSH_print_stats(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_RX_FLUSH_H */
@@ -0,0 +1,790 @@
+/*******************************************************************************
+  MPLAB Harmony Application SpaceWire Rx Demultiplexer Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_spw_demux.c
+
+  Summary:
+    SpaceWire Rx demultiplexer.
+
+  Description:
+    The routes are two tables of 256 queue indexes, so a packet is
+    classified in constant time. Each queue is a ring with one producer, the
+    demultiplexer, and one consumer: each index is written by one side only
+    and needs no lock. The fragments of a split packet are gathered in a
+    scatter list, each fragment counted by its receive buffer until the
+    packet is released.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include <stdio.h>
+#include <string.h>
+#include "app_spw_demux.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Consumer queue, a single producer single consumer ring */
+typedef struct
+{
+    app_spw_demux_ref_t* storage;
+    uint32_t mask;
+    /* Written by the producer only */
+    volatile uint32_t head;
+    /* Written by the consumer only */
+    volatile uint32_t tail;
+    uint8_t priority;
+    APP_SPW_DEMUX_POLICY policy;
+    APP_SPW_DEMUX_HANDLER handler;
+    uintptr_t context;
+    /* Copy of the reassembled packets, packet_max bytes per ring entry */
+    uint8_t* copy;
+    uint32_t copy_max;
+    app_spw_demux_queue_stats_t stats;
+} app_spw_demux_queue_t;
+
+/* Reassembly state */
+typedef enum
+{
+    /* Next fragment starts a packet */
+    APP_SPW_DEMUX_ASSEMBLY_IDLE = 0,
+    /* Next fragment continues the packet */
+    APP_SPW_DEMUX_ASSEMBLY_ACTIVE,
+    /* The fragments up to the end of the packet are dropped */
+    APP_SPW_DEMUX_ASSEMBLY_DISCARD,
+    /* The packet is complete, not pushed yet */
+    APP_SPW_DEMUX_ASSEMBLY_COMPLETE,
+} app_spw_demux_assembly_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+static app_spw_demux_queue_t demuxQueues[APP_SPW_DEMUX_QUEUE_MAX];
+static uint8_t demuxQueueNum = 0U;
+
+/* Queue indexes by decreasing priority */
+static uint8_t demuxOrder[APP_SPW_DEMUX_QUEUE_MAX];
+
+/* Routes by logical address and by protocol identifier, and default route */
+static uint8_t demuxByAddress[256];
+static uint8_t demuxByProtocol[256];
+static uint8_t demuxDefault = APP_SPW_DEMUX_QUEUE_NONE;
+
+/* Fragments not released per receive buffer */
+static volatile uint32_t demuxRefs[APP_SPW_DEMUX_BUFFER_MAX];
+
+/* Buffer being demultiplexed and its next packet, when blocked */
+static uint16_t demuxBuffer = 0xFFFFU;
+static uint16_t demuxNext = 0U;
+
+/* Packet being reassembled, it may span several buffers */
+static app_spw_demux_ref_t demuxPacket;
+static app_spw_demux_assembly_t demuxAssembly = APP_SPW_DEMUX_ASSEMBLY_IDLE;
+
+static app_spw_demux_stats_t demuxStats;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static uint8_t APP_SPW_DEMUX_classify(const app_spw_demux_ref_t* packet)
+
+   Summary:
+    Get the queue of a packet from its first two bytes.
+*/
+static uint8_t APP_SPW_DEMUX_classify(const app_spw_demux_ref_t* packet)
+{
+    uint8_t header[2];
+    uint32_t size = APP_SPW_DEMUX_gather(packet, 0U, header, sizeof(header));
+    uint8_t queue = APP_SPW_DEMUX_QUEUE_NONE;
+
+    if ( size >= 1U )
+    {
+        queue = demuxByAddress[header[0]];
+    }
+    if ( (queue == APP_SPW_DEMUX_QUEUE_NONE) && (size >= 2U) )
+    {
+        queue = demuxByProtocol[header[1]];
+    }
+    if ( queue == APP_SPW_DEMUX_QUEUE_NONE )
+    {
+        queue = demuxDefault;
+    }
+    return queue;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_SPW_DEMUX_ref_add(uint16_t buffer_id, int32_t count)
+
+   Summary:
+    Update the fragments not released of a buffer.
+
+   Description:
+    The consumers may release packets from an interrupt.
+*/
+static void APP_SPW_DEMUX_ref_add(uint16_t buffer_id, int32_t count)
+{
+    bool interruptStatus = NVIC_INT_Disable();
+
+    demuxRefs[buffer_id] = (uint32_t)((int32_t)demuxRefs[buffer_id] + count);
+
+    NVIC_INT_Restore(interruptStatus);
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_SPW_DEMUX_lose(void)
+
+   Summary:
+    Drop the packet being reassembled.
+*/
+static void APP_SPW_DEMUX_lose(void)
+{
+    APP_SPW_DEMUX_release(&demuxPacket);
+    demuxPacket.frag_num = 0U;
+    demuxStats.lost++;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_SPW_DEMUX_fragment(uint16_t buffer_id, const SPW_PKTRX_INFO* info, uint16_t index)
+
+   Summary:
+    Add a packet information entry to the packet being reassembled.
+
+   Description:
+    An entry with Split set is followed by the entry of the rest of the
+    packet, with Cont set, in the same buffer or at the start of the next
+    one. The packet is complete at its entry without Split.
+*/
+static void APP_SPW_DEMUX_fragment(uint16_t buffer_id, const SPW_PKTRX_INFO* info, uint16_t index)
+{
+    bool cont = (info->Cont != 0U);
+    bool split = (info->Split != 0U);
+
+    if ( !cont )
+    {
+        /* A packet starts, the previous one misses its end */
+        if ( demuxAssembly == APP_SPW_DEMUX_ASSEMBLY_ACTIVE )
+        {
+            APP_SPW_DEMUX_lose();
+        }
+        demuxAssembly = APP_SPW_DEMUX_ASSEMBLY_IDLE;
+    }
+    else if ( demuxAssembly == APP_SPW_DEMUX_ASSEMBLY_IDLE )
+    {
+        /* The rest of a packet whose start is missing */
+        demuxStats.lost++;
+        demuxAssembly = APP_SPW_DEMUX_ASSEMBLY_DISCARD;
+    }
+    else
+    {
+        /* Continuation of the packet */
+    }
+
+    if ( demuxAssembly == APP_SPW_DEMUX_ASSEMBLY_DISCARD )
+    {
+        if ( !split )
+        {
+            demuxAssembly = APP_SPW_DEMUX_ASSEMBLY_IDLE;
+        }
+        return;
+    }
+
+    if ( demuxAssembly == APP_SPW_DEMUX_ASSEMBLY_IDLE )
+    {
+        demuxPacket.data = NULL;
+        demuxPacket.size = 0U;
+        demuxPacket.index = index;
+        demuxPacket.frag_num = 0U;
+    }
+    else if ( demuxPacket.frag_num >= APP_SPW_DEMUX_FRAG_MAX )
+    {
+        APP_SPW_DEMUX_lose();
+        demuxAssembly = split ? APP_SPW_DEMUX_ASSEMBLY_DISCARD : APP_SPW_DEMUX_ASSEMBLY_IDLE;
+        return;
+    }
+    else
+    {
+        /* Room for the fragment */
+    }
+
+    demuxPacket.frag[demuxPacket.frag_num].data = (const uint8_t*)info->DAddr;
+    demuxPacket.frag[demuxPacket.frag_num].size = info->DSize;
+    demuxPacket.frag[demuxPacket.frag_num].buffer_id = buffer_id;
+    demuxPacket.frag_num++;
+    demuxPacket.size += info->DSize;
+    APP_SPW_DEMUX_ref_add(buffer_id, 1);
+
+    if ( split )
+    {
+        demuxAssembly = APP_SPW_DEMUX_ASSEMBLY_ACTIVE;
+    }
+    else
+    {
+        demuxPacket.eep = (info->Eep != 0U);
+        demuxPacket.data = (demuxPacket.frag_num == 1U) ? demuxPacket.frag[0].data : NULL;
+        demuxAssembly = APP_SPW_DEMUX_ASSEMBLY_COMPLETE;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static bool APP_SPW_DEMUX_push(void)
+
+   Summary:
+    Push the reassembled packet to its queue.
+
+   Returns:
+    False if the packet waits for room in its queue.
+*/
+static bool APP_SPW_DEMUX_push(void)
+{
+    uint8_t index = APP_SPW_DEMUX_classify(&demuxPacket);
+    app_spw_demux_queue_t* queue;
+    app_spw_demux_ref_t* ref;
+    uint32_t head;
+    uint32_t depth;
+
+    if ( index == APP_SPW_DEMUX_QUEUE_NONE )
+    {
+        APP_SPW_DEMUX_release(&demuxPacket);
+        demuxStats.unrouted++;
+        return true;
+    }
+
+    queue = &demuxQueues[index];
+    head = queue->head;
+    depth = head - queue->tail;
+    if ( depth > queue->mask )
+    {
+        if ( queue->policy == APP_SPW_DEMUX_POLICY_BLOCK )
+        {
+            queue->stats.blocked++;
+            return false;
+        }
+        APP_SPW_DEMUX_release(&demuxPacket);
+        queue->stats.dropped++;
+        return true;
+    }
+
+    if ( demuxPacket.frag_num > 1U )
+    {
+        demuxStats.reassembled++;
+    }
+
+    ref = &queue->storage[head & queue->mask];
+    *ref = demuxPacket;
+    if ( (demuxPacket.frag_num > 1U) && (queue->copy != NULL) && (demuxPacket.size <= queue->copy_max) )
+    {
+        /* Small packet: copy it and give its fragments back at once */
+        uint8_t* copy = &queue->copy[(head & queue->mask) * queue->copy_max];
+
+        (void)APP_SPW_DEMUX_gather(&demuxPacket, 0U, copy, demuxPacket.size);
+        APP_SPW_DEMUX_release(&demuxPacket);
+        ref->data = copy;
+        ref->frag_num = 0U;
+        queue->stats.copied++;
+    }
+
+    /* Publish the reference before the new head */
+    __DMB();
+    queue->head = head + 1U;
+    queue->stats.pushed++;
+    if ( (depth + 1U) > queue->stats.depth_max )
+    {
+        queue->stats.depth_max = depth + 1U;
+    }
+    return true;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_DEMUX_init(void)
+
+   Summary:
+    Remove all the queues and the routes.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_SPW_DEMUX_init(void)
+{
+    memset(demuxQueues, 0, sizeof(demuxQueues));
+    memset(demuxByAddress, APP_SPW_DEMUX_QUEUE_NONE, sizeof(demuxByAddress));
+    memset(demuxByProtocol, APP_SPW_DEMUX_QUEUE_NONE, sizeof(demuxByProtocol));
+    memset((void*)demuxRefs, 0, sizeof(demuxRefs));
+    memset(&demuxStats, 0, sizeof(demuxStats));
+    demuxQueueNum = 0U;
+    demuxDefault = APP_SPW_DEMUX_QUEUE_NONE;
+    demuxBuffer = 0xFFFFU;
+    demuxNext = 0U;
+    demuxPacket.frag_num = 0U;
+    demuxAssembly = APP_SPW_DEMUX_ASSEMBLY_IDLE;
+}
+
+// *****************************************************************************
+/* Function:
+    uint8_t APP_SPW_DEMUX_queue_create(app_spw_demux_ref_t* storage, uint32_t size,
+                                       uint8_t priority, APP_SPW_DEMUX_POLICY policy,
+                                       APP_SPW_DEMUX_HANDLER handler, uintptr_t context)
+
+   Summary:
+    Create a consumer queue.
+
+   Parameters:
+    storage - packet references of the queue.
+    size - number of references, a power of two.
+    priority - 0 is served first by APP_SPW_DEMUX_task.
+    policy - policy for a packet when the queue is full.
+    handler - consumer of the packets, NULL to pop them with a custom task.
+    context - parameter of the handler.
+
+   Returns:
+    The queue index, APP_SPW_DEMUX_QUEUE_NONE on error.
+*/
+uint8_t APP_SPW_DEMUX_queue_create(app_spw_demux_ref_t* storage, uint32_t size, uint8_t priority,
+                                   APP_SPW_DEMUX_POLICY policy, APP_SPW_DEMUX_HANDLER handler, uintptr_t context)
+{
+    uint8_t queue = demuxQueueNum;
+    uint8_t pos;
+
+    if ( (queue >= APP_SPW_DEMUX_QUEUE_MAX) || (size == 0U) || ((size & (size - 1U)) != 0U) )
+    {
+        return APP_SPW_DEMUX_QUEUE_NONE;
+    }
+
+    demuxQueues[queue].storage = storage;
+    demuxQueues[queue].mask = size - 1U;
+    demuxQueues[queue].head = 0U;
+    demuxQueues[queue].tail = 0U;
+    demuxQueues[queue].priority = priority;
+    demuxQueues[queue].policy = policy;
+    demuxQueues[queue].handler = handler;
+    demuxQueues[queue].context = context;
+    demuxQueues[queue].copy = NULL;
+    demuxQueues[queue].copy_max = 0U;
+    demuxQueueNum++;
+
+    /* Insert in the service order, after the queues of same priority */
+    pos = queue;
+    while ( (pos > 0U) && (demuxQueues[demuxOrder[pos - 1U]].priority > priority) )
+    {
+        demuxOrder[pos] = demuxOrder[pos - 1U];
+        pos--;
+    }
+    demuxOrder[pos] = queue;
+
+    return queue;
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_SPW_DEMUX_queue_copy(uint8_t queue, uint8_t* storage, uint32_t packet_max)
+
+   Summary:
+    Copy the small reassembled packets of a queue.
+
+   Description:
+    A packet of several fragments up to packet_max bytes is copied in the
+    area of its queue entry and its fragments are released when it is
+    pushed, so its receive buffers are given back without waiting for the
+    consumer. The larger packets are passed as scatter lists.
+
+   Parameters:
+    queue - the queue index.
+    storage - copy area of packet_max bytes per queue entry.
+    packet_max - largest packet copied in bytes.
+
+   Returns:
+    False if the queue does not exist.
+*/
+bool APP_SPW_DEMUX_queue_copy(uint8_t queue, uint8_t* storage, uint32_t packet_max)
+{
+    if ( queue >= demuxQueueNum )
+    {
+        return false;
+    }
+
+    demuxQueues[queue].copy = storage;
+    demuxQueues[queue].copy_max = (storage != NULL) ? packet_max : 0U;
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_SPW_DEMUX_route_add(APP_SPW_DEMUX_MATCH match, uint8_t value, uint8_t queue)
+
+   Summary:
+    Route the packets of a logical address or of a protocol identifier to a
+    queue.
+
+   Parameters:
+    match - byte of the packet to match.
+    value - value of this byte.
+    queue - destination queue, APP_SPW_DEMUX_QUEUE_NONE to drop.
+
+   Returns:
+    False if the queue does not exist.
+*/
+bool APP_SPW_DEMUX_route_add(APP_SPW_DEMUX_MATCH match, uint8_t value, uint8_t queue)
+{
+    if ( (queue != APP_SPW_DEMUX_QUEUE_NONE) && (queue >= demuxQueueNum) )
+    {
+        return false;
+    }
+
+    if ( match == APP_SPW_DEMUX_MATCH_LOGICAL_ADDRESS )
+    {
+        demuxByAddress[value] = queue;
+    }
+    else
+    {
+        demuxByProtocol[value] = queue;
+    }
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_DEMUX_route_default(uint8_t queue)
+
+   Summary:
+    Set the queue of the packets matching no route,
+    APP_SPW_DEMUX_QUEUE_NONE to drop them.
+*/
+void APP_SPW_DEMUX_route_default(uint8_t queue)
+{
+    demuxDefault = queue;
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_SPW_DEMUX_buffer(uint16_t buffer_id, const SPW_PKTRX_INFO* info, uint16_t count)
+
+   Summary:
+    Push the packets of a receive buffer to their queues.
+
+   Description:
+    The fragments of each packet are reassembled, then the packet is
+    classified from its first bytes and a reference to it is pushed to its
+    queue, the data is not copied. A packet split at the end of the buffer
+    is completed by the next buffer, which must be passed before this
+    buffer is given back.
+
+    When a queue with the BLOCK policy is full, the function returns and is
+    called again with the same buffer to go on from the blocked packet.
+
+   Precondition:
+    The data of the buffer is visible to the CPU. The buffers are passed in
+    their reception order.
+
+   Parameters:
+    buffer_id - the ID of the receive buffer.
+    info - packet information list of the buffer.
+    count - number of received packet information entries.
+
+   Returns:
+    True when all the packets are pushed or dropped.
+*/
+bool APP_SPW_DEMUX_buffer(uint16_t buffer_id, const SPW_PKTRX_INFO* info, uint16_t count)
+{
+    if ( buffer_id >= APP_SPW_DEMUX_BUFFER_MAX )
+    {
+        return true;
+    }
+
+    if ( buffer_id != demuxBuffer )
+    {
+        demuxBuffer = buffer_id;
+        demuxNext = 0U;
+    }
+
+    while ( demuxNext < count )
+    {
+        if ( demuxAssembly != APP_SPW_DEMUX_ASSEMBLY_COMPLETE )
+        {
+            APP_SPW_DEMUX_fragment(buffer_id, &info[demuxNext], demuxNext);
+        }
+        if ( demuxAssembly == APP_SPW_DEMUX_ASSEMBLY_COMPLETE )
+        {
+            if ( !APP_SPW_DEMUX_push() )
+            {
+                return false;
+            }
+            demuxPacket.frag_num = 0U;
+            demuxAssembly = APP_SPW_DEMUX_ASSEMBLY_IDLE;
+        }
+        demuxNext++;
+    }
+
+    demuxBuffer = 0xFFFFU;
+    return true;
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t APP_SPW_DEMUX_buffer_refs(uint16_t buffer_id)
+
+   Summary:
+    Get the number of fragments of a buffer not released, the buffer can be
+    given back to the receiver at 0.
+*/
+uint32_t APP_SPW_DEMUX_buffer_refs(uint16_t buffer_id)
+{
+    return (buffer_id < APP_SPW_DEMUX_BUFFER_MAX) ? demuxRefs[buffer_id] : 0U;
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t APP_SPW_DEMUX_task(uint32_t budget)
+
+   Summary:
+    Pass the queued packets to their consumers, by priority.
+
+   Description:
+    The highest priority queue with a packet is served first, for each
+    packet, so a packet of a high priority queue waits for one packet of
+    a lower priority queue at most. The queue entry is freed when the
+    handler returns, which keeps the copy of a small packet in place until
+    then. A handler keeping a packet holds a copy of the entry.
+
+   Parameters:
+    budget - largest number of packets to pass.
+
+   Returns:
+    The number of packets passed.
+*/
+uint32_t APP_SPW_DEMUX_task(uint32_t budget)
+{
+    uint32_t done = 0U;
+
+    while ( done < budget )
+    {
+        app_spw_demux_queue_t* queue = NULL;
+        uint8_t pos;
+
+        for (pos = 0U; pos < demuxQueueNum; pos++)
+        {
+            app_spw_demux_queue_t* candidate = &demuxQueues[demuxOrder[pos]];
+
+            if ( (candidate->handler != NULL) && (candidate->tail != candidate->head) )
+            {
+                queue = candidate;
+                break;
+            }
+        }
+        if ( queue == NULL )
+        {
+            break;
+        }
+
+        {
+            uint32_t tail = queue->tail;
+            const app_spw_demux_ref_t* ref = &queue->storage[tail & queue->mask];
+
+            queue->stats.handled++;
+            if ( queue->handler(ref, queue->context) )
+            {
+                APP_SPW_DEMUX_release(ref);
+            }
+
+            /* Free the entry once handled */
+            __DMB();
+            queue->tail = tail + 1U;
+        }
+        done++;
+    }
+
+    return done;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_DEMUX_release(const app_spw_demux_ref_t* ref)
+
+   Summary:
+    Release the fragments of a packet kept by its consumer.
+
+   Parameters:
+    ref - the copy of the queue entry kept by the consumer.
+*/
+void APP_SPW_DEMUX_release(const app_spw_demux_ref_t* ref)
+{
+    uint8_t frag;
+
+    for (frag = 0U; frag < ref->frag_num; frag++)
+    {
+        APP_SPW_DEMUX_ref_add(ref->frag[frag].buffer_id, -1);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t APP_SPW_DEMUX_gather(const app_spw_demux_ref_t* ref, uint32_t offset,
+                                  uint8_t* dest, uint32_t size)
+
+   Summary:
+    Copy bytes of a packet, across its fragments.
+
+   Parameters:
+    ref - the packet.
+    offset - offset of the first byte in the packet.
+    dest - destination of the bytes.
+    size - number of bytes.
+
+   Returns:
+    The number of bytes copied, less than size at the end of the packet.
+*/
+uint32_t APP_SPW_DEMUX_gather(const app_spw_demux_ref_t* ref, uint32_t offset, uint8_t* dest, uint32_t size)
+{
+    uint32_t copied = 0U;
+    uint8_t frag;
+
+    if ( ref->frag_num == 0U )
+    {
+        /* Copied packet */
+        if ( offset < ref->size )
+        {
+            copied = ((ref->size - offset) < size) ? (ref->size - offset) : size;
+            memcpy(dest, &ref->data[offset], copied);
+        }
+        return copied;
+    }
+
+    for (frag = 0U; (frag < ref->frag_num) && (copied < size); frag++)
+    {
+        uint32_t frag_size = ref->frag[frag].size;
+
+        if ( offset >= frag_size )
+        {
+            offset -= frag_size;
+        }
+        else
+        {
+            uint32_t length = frag_size - offset;
+
+            if ( length > (size - copied) )
+            {
+                length = size - copied;
+            }
+            memcpy(&dest[copied], &ref->frag[frag].data[offset], length);
+            copied += length;
+            offset = 0U;
+        }
+    }
+    return copied;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_DEMUX_get_stats(app_spw_demux_stats_t* stats)
+
+   Summary:
+    Get the counters of the packets of all the queues.
+*/
+void APP_SPW_DEMUX_get_stats(app_spw_demux_stats_t* stats)
+{
+    *stats = demuxStats;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_DEMUX_get_queue_stats(uint8_t queue, app_spw_demux_queue_stats_t* stats)
+
+   Summary:
+    Get the counters of a queue.
+*/
+void APP_SPW_DEMUX_get_queue_stats(uint8_t queue, app_spw_demux_queue_stats_t* stats)
+{
+    if ( queue < demuxQueueNum )
+    {
+        *stats = demuxQueues[queue].stats;
+    }
+    else
+    {
+        memset(stats, 0, sizeof(app_spw_demux_queue_stats_t));
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_DEMUX_print_stats(void)
+
+   Summary:
+    Print the counters of the queues on the console.
+*/
+void APP_SPW_DEMUX_print_stats(void)
+{
+    uint8_t queue;
+
+    for (queue = 0U; queue < demuxQueueNum; queue++)
+    {
+        app_spw_demux_queue_stats_t stats;
+
+        APP_SPW_DEMUX_get_queue_stats(queue, &stats);
+        printf("Rx queue %u : %u pushed, %u handled, %u dropped, %u blocked, %u copied, depth %u\r\n",
+                (unsigned int)queue,
+                (unsigned int)stats.pushed,
+                (unsigned int)stats.handled,
+                (unsigned int)stats.dropped,
+                (unsigned int)stats.blocked,
+                (unsigned int)stats.copied,
+                (unsigned int)stats.depth_max);
+    }
+    printf("Rx packets : %u reassembled, %u lost, %u without route\r\n",
+            (unsigned int)demuxStats.reassembled,
+            (unsigned int)demuxStats.lost,
+            (unsigned int)demuxStats.unrouted);
+}
@@ -0,0 +1,254 @@
+/*******************************************************************************
+  MPLAB Harmony Application SpaceWire Rx Demultiplexer Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_spw_demux.h
+
+  Summary:
+    SpaceWire Rx demultiplexer Prototypes and definitions file.
+
+  Description:
+    The demultiplexer routes the packets of the receive buffers to consumer
+    queues by logical address or protocol identifier. The queues hold
+    references to the packets in place, each with its priority and its
+    policy when full, so a consumer such as the RMAP replies is served
+    before the backlog of a bulk data consumer. A packet split by the
+    receiver, at the end of a buffer or by SPW_PKTRX_CurrentPacketSplit, is
+    reassembled from its fragments in the following entries and buffers.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_SPW_DEMUX_H
+#define	APP_SPW_DEMUX_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+#include "definitions.h"                // SPW_PKTRX_INFO
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Number of consumer queues */
+#ifndef APP_SPW_DEMUX_QUEUE_MAX
+#define APP_SPW_DEMUX_QUEUE_MAX                                   (4U)
+#endif
+
+/* Number of receive buffers whose packets are referenced */
+#ifndef APP_SPW_DEMUX_BUFFER_MAX
+#define APP_SPW_DEMUX_BUFFER_MAX                                  (32U)
+#endif
+
+/* Largest number of fragments of a reassembled packet, below the number of
+   receive buffers so the receiver never waits for a packet it holds */
+#ifndef APP_SPW_DEMUX_FRAG_MAX
+#define APP_SPW_DEMUX_FRAG_MAX                                    (4U)
+#endif
+
+/* Queue of no route, the packets are dropped */
+#define APP_SPW_DEMUX_QUEUE_NONE                                  (0xFFU)
+
+// *****************************************************************************
+// *****************************************************************************
+// Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Demultiplexer route match
+
+   Summary:
+    Packet byte matched by a route.
+
+   Description:
+    The logical address is the first byte of the received packet, once the
+    path address bytes are removed by the router, and the protocol
+    identifier the second one. A logical address route is tried before a
+    protocol identifier route.
+*/
+typedef enum
+{
+    APP_SPW_DEMUX_MATCH_LOGICAL_ADDRESS = 0,
+    APP_SPW_DEMUX_MATCH_PROTOCOL_ID,
+} APP_SPW_DEMUX_MATCH;
+
+/* Demultiplexer queue full policy
+
+   Summary:
+    What to do with a packet for a full queue.
+
+   Description:
+    DROP drops the packet and counts it. BLOCK stops the demultiplexing of
+    the buffer until the consumer makes room, the following packets of all
+    the queues wait meanwhile.
+*/
+typedef enum
+{
+    APP_SPW_DEMUX_POLICY_DROP = 0,
+    APP_SPW_DEMUX_POLICY_BLOCK,
+} APP_SPW_DEMUX_POLICY;
+
+/* Demultiplexer packet fragment
+
+   Summary:
+    Part of a received packet in a receive buffer.
+*/
+typedef struct
+{
+    const uint8_t* data;
+    uint32_t size;
+    uint16_t buffer_id;
+} app_spw_demux_frag_t;
+
+/* Demultiplexer packet reference
+
+   Summary:
+    Received packet, in place in its receive buffers.
+
+   Description:
+    The packet is the scatter list of its frag_num fragments, and data is
+    its contiguous data when it has one fragment, NULL otherwise. A
+    reassembled packet copied by its queue has no fragment, data is then
+    the copy and stays valid until the handler returns. index is the entry
+    of the first fragment in its packet information list.
+
+    The fragments stay valid until the packet is released: a receive
+    buffer is not given back to the receiver before all its fragments are
+    released.
+*/
+typedef struct
+{
+    const uint8_t* data;
+    uint32_t size;
+    uint16_t index;
+    uint8_t frag_num;
+    bool eep;
+    app_spw_demux_frag_t frag[APP_SPW_DEMUX_FRAG_MAX];
+} app_spw_demux_ref_t;
+
+/* Demultiplexer consumer handler
+
+   Summary:
+    Called for each packet of a queue, by priority, from APP_SPW_DEMUX_task.
+
+   Description:
+    ref points to the queue entry, which is reused as soon as the handler
+    returns. A consumer keeping a packet copies *ref and releases the copy
+    later with APP_SPW_DEMUX_release. A copied packet, frag_num 0, cannot
+    be kept: its data is in the copy area of the entry.
+
+   Returns:
+    True when the packet is released on return, false when the consumer
+    keeps it and releases it later with APP_SPW_DEMUX_release.
+*/
+typedef bool (*APP_SPW_DEMUX_HANDLER)(const app_spw_demux_ref_t* ref, uintptr_t context);
+
+/* Demultiplexer queue statistics
+
+   Summary:
+    Counters of a consumer queue.
+*/
+typedef struct
+{
+    uint32_t pushed;
+    uint32_t handled;
+    uint32_t dropped;
+    uint32_t blocked;
+    uint32_t copied;
+    uint32_t depth_max;
+} app_spw_demux_queue_stats_t;
+
+/* Demultiplexer statistics
+
+   Summary:
+    Counters of the packets of all the queues.
+
+   Description:
+    reassembled counts the packets of several fragments, lost the packets
+    whose fragments could not be reassembled: missing start or end, or
+    more than APP_SPW_DEMUX_FRAG_MAX fragments.
+*/
+typedef struct
+{
+    uint32_t reassembled;
+    uint32_t lost;
+    uint32_t unrouted;
+} app_spw_demux_stats_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_SPW_DEMUX_init(void);
+
+uint8_t APP_SPW_DEMUX_queue_create(app_spw_demux_ref_t* storage, uint32_t size, uint8_t priority,
+                                   APP_SPW_DEMUX_POLICY policy, APP_SPW_DEMUX_HANDLER handler, uintptr_t context);
+
+bool APP_SPW_DEMUX_queue_copy(uint8_t queue, uint8_t* storage, uint32_t packet_max);
+
+bool APP_SPW_DEMUX_route_add(APP_SPW_DEMUX_MATCH match, uint8_t value, uint8_t queue);
+
+void APP_SPW_DEMUX_route_default(uint8_t queue);
+
+bool APP_SPW_DEMUX_buffer(uint16_t buffer_id, const SPW_PKTRX_INFO* info, uint16_t count);
+
+uint32_t APP_SPW_DEMUX_buffer_refs(uint16_t buffer_id);
+
+uint32_t APP_SPW_DEMUX_task(uint32_t budget);
+
+void APP_SPW_DEMUX_release(const app_spw_demux_ref_t* ref);
+
+uint32_t APP_SPW_DEMUX_gather(const app_spw_demux_ref_t* ref, uint32_t offset, uint8_t* dest, uint32_t size);
+
+void APP_SPW_DEMUX_get_stats(app_spw_demux_stats_t* stats);
+
+void APP_SPW_DEMUX_get_queue_stats(uint8_t queue, app_spw_demux_queue_stats_t* stats);
+
+void APP_SPW_DEMUX_print_stats(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_SPW_DEMUX_H */
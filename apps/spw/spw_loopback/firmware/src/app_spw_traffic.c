@@ -0,0 +1,442 @@
+/*******************************************************************************
+  MPLAB Harmony Application SpaceWire Traffic Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_spw_traffic.c
+
+  Summary:
+    SpaceWire traffic generator and verifier.
+
+  Description:
+    The PRBS-31 sequence, x^31 + x^28 + 1, is produced 32 bits at a time:
+    each bit depends on bits 28 and 31 positions before it, so a word is
+    computed from the previous one with shifts, its 4 highest bits then from
+    its own lowest bits. The verifier regenerates the payload of the
+    received sequence number and accumulates the difference of the words,
+    the bit errors are counted only for a packet with a difference.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdio.h>
+#include <string.h>
+#include "app_spw_traffic.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Largest number of words of a packet */
+#define APP_SPW_TRAFFIC_WORDS_MAX       (0x10000U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Number of words of the generated packets */
+static uint32_t trafficWords = 0U;
+
+/* Sequence number of the next generated packet */
+static uint32_t trafficTxSeq = 0U;
+
+/* Next expected sequence number and received ones before it, bit n for
+   trafficRxSeq - 1 - n */
+static uint32_t trafficRxSeq = 0U;
+static uint32_t trafficRxWindow = 0U;
+
+static app_spw_traffic_stats_t trafficStats;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_SPW_TRAFFIC_seed(uint32_t seq)
+
+   Summary:
+    Get the PRBS state before the payload of a sequence number.
+
+   Description:
+    Bits 1 to 31 of the state are the last 31 bits of the sequence, they
+    must not be all 0.
+*/
+static uint32_t APP_SPW_TRAFFIC_seed(uint32_t seq)
+{
+    uint32_t seed = (seq * 0x9E3779B1U) ^ 0x5A5A5A5AU;
+
+    if ( (seed >> 1) == 0U )
+    {
+        seed = 0x80000000U;
+    }
+    return seed;
+}
+
+// *****************************************************************************
+/* Function:
+    static inline uint32_t APP_SPW_TRAFFIC_prbs(uint32_t prev)
+
+   Summary:
+    Get the next 32 bits of the PRBS-31 sequence.
+
+   Description:
+    Bit i of a word is the bit n + i of the sequence, with
+    s(n) = s(n - 28) ^ s(n - 31). Bits 0 to 27 only depend on the previous
+    word, bits 28 to 31 also on bits 0 to 3 of the word.
+*/
+static inline uint32_t APP_SPW_TRAFFIC_prbs(uint32_t prev)
+{
+    uint32_t next = (prev >> 4) ^ (prev >> 1);
+
+    return next ^ (next << 28) ^ (next << 31);
+}
+
+// *****************************************************************************
+/* Function:
+    static uint32_t APP_SPW_TRAFFIC_read(const uint8_t* data)
+
+   Summary:
+    Read a little endian word at any alignment.
+*/
+static uint32_t APP_SPW_TRAFFIC_read(const uint8_t* data)
+{
+    uint32_t word;
+
+    memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_SPW_TRAFFIC_sequence(uint32_t seq)
+
+   Summary:
+    Count the lost, duplicated and reordered packets from a sequence number.
+*/
+static void APP_SPW_TRAFFIC_sequence(uint32_t seq)
+{
+    uint32_t ahead = seq - trafficRxSeq;
+
+    if ( ahead < 0x80000000U )
+    {
+        /* Expected or later packet, the skipped ones are lost */
+        trafficStats.lost += ahead;
+        if ( ahead >= (APP_SPW_TRAFFIC_WINDOW - 1U) )
+        {
+            trafficRxWindow = 1U;
+        }
+        else
+        {
+            trafficRxWindow = (trafficRxWindow << (ahead + 1U)) | 1U;
+        }
+        trafficRxSeq = seq + 1U;
+    }
+    else
+    {
+        /* Earlier packet */
+        uint32_t behind = trafficRxSeq - 1U - seq;
+
+        if ( behind >= APP_SPW_TRAFFIC_WINDOW )
+        {
+            trafficStats.reordered++;
+        }
+        else if ( (trafficRxWindow & (1UL << behind)) != 0U )
+        {
+            trafficStats.duplicated++;
+        }
+        else
+        {
+            trafficRxWindow |= (1UL << behind);
+            trafficStats.lost--;
+            trafficStats.reordered++;
+        }
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_TRAFFIC_init(uint32_t packet_words)
+
+   Summary:
+    Restart the sequence numbers and clear the counters.
+
+   Parameters:
+    packet_words - number of words of a packet, header included.
+
+   Returns:
+    None.
+*/
+void APP_SPW_TRAFFIC_init(uint32_t packet_words)
+{
+    if ( packet_words < APP_SPW_TRAFFIC_HEADER_WORDS )
+    {
+        packet_words = APP_SPW_TRAFFIC_HEADER_WORDS;
+    }
+    if ( packet_words > APP_SPW_TRAFFIC_WORDS_MAX )
+    {
+        packet_words = APP_SPW_TRAFFIC_WORDS_MAX;
+    }
+
+    trafficWords = packet_words;
+    trafficTxSeq = 0U;
+    trafficRxSeq = 0U;
+    trafficRxWindow = 0U;
+    memset(&trafficStats, 0, sizeof(trafficStats));
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t APP_SPW_TRAFFIC_generate(uint32_t* packet)
+
+   Summary:
+    Write the next packet.
+
+   Description:
+    The packet holds the sequence number, its complement, then the PRBS
+    words seeded from the sequence number, so each packet is verified
+    alone whatever the packets lost before it.
+
+   Parameters:
+    packet - the packet_words words of the packet.
+
+   Returns:
+    The sequence number of the packet.
+*/
+uint32_t APP_SPW_TRAFFIC_generate(uint32_t* packet)
+{
+    uint32_t seq = trafficTxSeq++;
+    uint32_t prbs = APP_SPW_TRAFFIC_seed(seq);
+    uint32_t i;
+
+    packet[0] = seq;
+    packet[1] = ~seq;
+    for (i = APP_SPW_TRAFFIC_HEADER_WORDS; i < trafficWords; i++)
+    {
+        prbs = APP_SPW_TRAFFIC_prbs(prbs);
+        packet[i] = prbs;
+    }
+    return seq;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_TRAFFIC_verify(const uint8_t* data, uint32_t size)
+
+   Summary:
+    Verify a received packet.
+
+   Description:
+    The differences with the expected words are OR-ed together, two words
+    per loop, and counted bit by bit only when not 0, so an error free
+    packet costs one PRBS step, two loads and two logic operations per
+    word.
+
+   Parameters:
+    data - the received packet.
+    size - its size in bytes.
+
+   Returns:
+    None.
+*/
+void APP_SPW_TRAFFIC_verify(const uint8_t* data, uint32_t size)
+{
+    uint32_t expected_size = trafficWords * 4U;
+    uint32_t seq;
+    uint32_t prbs;
+    uint32_t words;
+    uint32_t diff = 0U;
+    uint32_t i;
+
+    trafficStats.packets++;
+
+    if ( size != expected_size )
+    {
+        trafficStats.size_errors++;
+        if ( size > expected_size )
+        {
+            size = expected_size;
+        }
+    }
+
+    if ( size < (APP_SPW_TRAFFIC_HEADER_WORDS * 4U) )
+    {
+        trafficStats.header_errors++;
+        return;
+    }
+
+    seq = APP_SPW_TRAFFIC_read(data);
+    if ( (seq ^ APP_SPW_TRAFFIC_read(&data[4])) != 0xFFFFFFFFU )
+    {
+        trafficStats.header_errors++;
+        return;
+    }
+    APP_SPW_TRAFFIC_sequence(seq);
+
+    /* Whole words of the payload, two per loop */
+    prbs = APP_SPW_TRAFFIC_seed(seq);
+    words = size / 4U;
+    i = APP_SPW_TRAFFIC_HEADER_WORDS;
+    for (; (i + 1U) < words; i += 2U)
+    {
+        uint32_t first = APP_SPW_TRAFFIC_prbs(prbs);
+        prbs = APP_SPW_TRAFFIC_prbs(first);
+        diff |= (APP_SPW_TRAFFIC_read(&data[i * 4U]) ^ first) |
+                (APP_SPW_TRAFFIC_read(&data[(i + 1U) * 4U]) ^ prbs);
+    }
+    if ( i < words )
+    {
+        prbs = APP_SPW_TRAFFIC_prbs(prbs);
+        diff |= APP_SPW_TRAFFIC_read(&data[i * 4U]) ^ prbs;
+        i++;
+    }
+
+    /* Last bytes of a truncated packet */
+    if ( (size % 4U) != 0U )
+    {
+        uint32_t last = 0U;
+
+        prbs = APP_SPW_TRAFFIC_prbs(prbs);
+        memcpy(&last, &data[i * 4U], size % 4U);
+        diff |= (last ^ prbs) & ((1UL << ((size % 4U) * 8U)) - 1U);
+    }
+
+    trafficStats.bits += (uint64_t)(size - (APP_SPW_TRAFFIC_HEADER_WORDS * 4U)) * 8U;
+
+    if ( diff != 0U )
+    {
+        /* Count the bit errors */
+        uint32_t errors = 0U;
+
+        prbs = APP_SPW_TRAFFIC_seed(seq);
+        for (i = APP_SPW_TRAFFIC_HEADER_WORDS * 4U; i < size; i += 4U)
+        {
+            uint32_t word = 0U;
+            uint32_t length = ((size - i) < 4U) ? (size - i) : 4U;
+
+            prbs = APP_SPW_TRAFFIC_prbs(prbs);
+            memcpy(&word, &data[i], length);
+            word ^= prbs;
+            if ( length < 4U )
+            {
+                word &= (1UL << (length * 8U)) - 1U;
+            }
+            errors += (uint32_t)__builtin_popcount(word);
+        }
+        trafficStats.bit_errors += errors;
+        trafficStats.error_packets++;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_TRAFFIC_get_stats(app_spw_traffic_stats_t* stats)
+
+   Summary:
+    Get the counters of the verifier.
+
+   Parameters:
+    stats - counters.
+
+   Returns:
+    None.
+*/
+void APP_SPW_TRAFFIC_get_stats(app_spw_traffic_stats_t* stats)
+{
+    *stats = trafficStats;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_SPW_TRAFFIC_print_stats(void)
+
+   Summary:
+    Print the counters of the verifier on the console.
+
+   Description:
+    The bit error rate is printed as its mantissa and exponent, or as the
+    bound given by the verified bits when no error is seen.
+*/
+void APP_SPW_TRAFFIC_print_stats(void)
+{
+    uint64_t bits = trafficStats.bits;
+    uint64_t errors = trafficStats.bit_errors;
+    int32_t exponent = 0;
+
+    printf("Traffic : %u packets, %u lost, %u duplicated, %u reordered, %u header errors, %u size errors\r\n",
+            (unsigned int)trafficStats.packets,
+            (unsigned int)trafficStats.lost,
+            (unsigned int)trafficStats.duplicated,
+            (unsigned int)trafficStats.reordered,
+            (unsigned int)trafficStats.header_errors,
+            (unsigned int)trafficStats.size_errors);
+    printf("Traffic : %lu Mbit verified, %lu bit errors in %u packets\r\n",
+            (unsigned long)(bits / 1000000U),
+            (unsigned long)errors,
+            (unsigned int)trafficStats.error_packets);
+
+    if ( bits == 0U )
+    {
+        return;
+    }
+
+    if ( errors == 0U )
+    {
+        /* Bound 1 / bits */
+        errors = 1U;
+    }
+
+    /* errors / bits as m.mm * 10^exponent, errors is not above bits */
+    while ( errors < bits )
+    {
+        errors *= 10U;
+        exponent--;
+    }
+    errors = (errors * 100U) / bits;
+
+    printf("Traffic : bit error rate %s %u.%02u e%d\r\n",
+            (trafficStats.bit_errors == 0U) ? "<" : "=",
+            (unsigned int)(errors / 100U),
+            (unsigned int)(errors % 100U),
+            (int)exponent);
+}
@@ -0,0 +1,133 @@
+/*******************************************************************************
+  MPLAB Harmony Application SpaceWire Traffic Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_spw_traffic.h
+
+  Summary:
+    SpaceWire traffic generator and verifier Prototypes and definitions file.
+
+  Description:
+    The generator writes packets of a 32-bit sequence number, its complement
+    and a PRBS-31 payload seeded from the sequence number. The verifier
+    checks every byte of each received packet against the payload expected
+    from its sequence number, and counts the bit errors, the lost, the
+    duplicated and the reordered packets over a link soak test.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_SPW_TRAFFIC_H
+#define	APP_SPW_TRAFFIC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Header words of a packet: sequence number and its complement */
+#define APP_SPW_TRAFFIC_HEADER_WORDS                              (2U)
+
+/* Sequence numbers before the last received one that are told apart as
+   duplicated or reordered */
+#define APP_SPW_TRAFFIC_WINDOW                                    (32U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Application traffic statistics
+
+   Summary:
+    Counters of the traffic verifier.
+
+   Description:
+    bits counts the verified payload bits and bit_errors the ones that
+    differ from the expected payload, their ratio is the bit error rate.
+    A packet with a corrupted header has no trusted sequence number: it is
+    counted in header_errors and its payload is not verified. A packet
+    received after a later one is reordered when its sequence number was
+    counted lost, duplicated when it was already received. size_errors
+    counts the packets whose size is not the generated one, their common
+    part is verified.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t packets;
+    uint64_t bits;
+    uint64_t bit_errors;
+    uint32_t error_packets;
+    uint32_t lost;
+    uint32_t duplicated;
+    uint32_t reordered;
+    uint32_t header_errors;
+    uint32_t size_errors;
+} app_spw_traffic_stats_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_SPW_TRAFFIC_init(uint32_t packet_words);
+
+uint32_t APP_SPW_TRAFFIC_generate(uint32_t* packet);
+
+void APP_SPW_TRAFFIC_verify(const uint8_t* data, uint32_t size);
+
+void APP_SPW_TRAFFIC_get_stats(app_spw_traffic_stats_t* stats);
+
+void APP_SPW_TRAFFIC_print_stats(void);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_SPW_TRAFFIC_H */
@@ -0,0 +1,308 @@
+/*******************************************************************************
+  MPLAB Harmony Application Timebase Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_timebase.c
+
+  Summary:
+    64-bit timebase.
+
+  Description:
+    The count is read as high word, low word, high word, and read again until
+    both high words match: a wrap of the low word between the reads changes
+    the high word. The low word is also read again while it is 0, the time
+    for the TIOA1 edge to reach channel 2. The conversions are exact, with an
+    integer number of nanoseconds per tick when the frequency allows it.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include "app_timebase.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+#define APP_TIMEBASE_NS_PER_S           (1000000000ULL)
+#define APP_TIMEBASE_US_PER_S           (1000000ULL)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Tick frequency in Hz */
+static uint32_t timebaseFrequency = 0U;
+
+/* Nanoseconds per tick, 0 when the period is not a whole number of them */
+static uint32_t timebaseNsPerTick = 0U;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMEBASE_frequency_set(uint32_t frequency)
+
+   Summary:
+    Set the tick frequency used by the conversions.
+
+   Parameters:
+    frequency - tick frequency in Hz.
+
+   Returns:
+    None.
+*/
+static void APP_TIMEBASE_frequency_set(uint32_t frequency)
+{
+    timebaseFrequency = frequency;
+    timebaseNsPerTick = ((APP_TIMEBASE_NS_PER_S % frequency) == 0U) ?
+                        (uint32_t)(APP_TIMEBASE_NS_PER_S / frequency) : 0U;
+}
+
+// *****************************************************************************
+/* Function:
+    static uint64_t APP_TIMEBASE_scale(uint64_t value, uint64_t mul, uint64_t div)
+
+   Summary:
+    Compute value * mul / div without overflow of the product.
+
+   Parameters:
+    value - value to scale.
+    mul - multiplier, below 2^32.
+    div - divider, below 2^32.
+
+   Returns:
+    The scaled value, rounded down.
+*/
+static uint64_t APP_TIMEBASE_scale(uint64_t value, uint64_t mul, uint64_t div)
+{
+    return ((value / div) * mul) + (((value % div) * mul) / div);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_TIMEBASE_init(void)
+
+   Summary:
+    Start the timebase.
+
+   Description:
+    Channel 2 is started first so it counts the first wrap of channel 1.
+    The frequency is the nominal one of the TC plib until calibrated.
+
+   Precondition:
+    TC1_CH1_TimerInitialize and TC1_CH2_TimerInitialize must have been
+    called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_TIMEBASE_init(void)
+{
+    APP_TIMEBASE_frequency_set(TC1_CH1_TimerFrequencyGet());
+
+    TC1_CH2_TimerStart();
+    TC1_CH1_TimerStart();
+}
+
+// *****************************************************************************
+/* Function:
+    uint64_t APP_TIMEBASE_get(void)
+
+   Summary:
+    Get the tick count.
+
+   Description:
+    This function is lock free and can be called from any interrupt.
+
+   Precondition:
+    APP_TIMEBASE_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    Ticks since APP_TIMEBASE_init.
+*/
+uint64_t APP_TIMEBASE_get(void)
+{
+    uint32_t high;
+    uint32_t low;
+
+    do
+    {
+        high = TC1_CH2_TimerCounterGet();
+        low = TC1_CH1_TimerCounterGet();
+    } while ( (high != TC1_CH2_TimerCounterGet()) || (low == 0U) );
+
+    return (((uint64_t)high) << 32U) | low;
+}
+
+// *****************************************************************************
+/* Function:
+    uint32_t APP_TIMEBASE_frequency_get(void)
+
+   Summary:
+    Get the tick frequency in Hz.
+*/
+uint32_t APP_TIMEBASE_frequency_get(void)
+{
+    return timebaseFrequency;
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_TIMEBASE_calibrate(APP_TIMEBASE_COUNTER_GET counter_get,
+                                uint32_t reference_hz,
+                                uint32_t reference_ticks)
+
+   Summary:
+    Measure the tick frequency against a reference counter.
+
+   Description:
+    This function waits for the reference counter to advance by
+    reference_ticks and counts the timebase ticks meanwhile. When the
+    measured frequency is within APP_TIMEBASE_CALIBRATION_PPM of the nominal
+    one, both counters run from the same clock and the nominal frequency is
+    kept as it is exact. Otherwise the measured frequency is used by the
+    conversions, unless it is 0: the timebase does not count, and the
+    nominal frequency is kept so the conversions never divide by 0.
+
+    The ticks are read from channel 1 alone, so a timebase that does not
+    count is measured as 0 instead of stalling APP_TIMEBASE_get.
+
+   Precondition:
+    APP_TIMEBASE_init must have been called and the reference counter must be
+    counting up without reset for reference_ticks.
+
+   Parameters:
+    counter_get - read function of the reference counter.
+    reference_hz - frequency of the reference counter.
+    reference_ticks - measurement length in reference ticks, a few thousands
+    at least and less than 2^32 timebase ticks.
+
+   Returns:
+    True when the measurement matches the nominal frequency, false when the
+    measured frequency, or the nominal one after a failed measurement, is
+    used.
+*/
+bool APP_TIMEBASE_calibrate(APP_TIMEBASE_COUNTER_GET counter_get, uint32_t reference_hz, uint32_t reference_ticks)
+{
+    uint32_t nominal = TC1_CH1_TimerFrequencyGet();
+    uint32_t reference_start;
+    uint32_t reference_elapsed;
+    uint32_t start;
+    uint64_t measured;
+    uint64_t deviation;
+
+    reference_start = counter_get();
+    start = TC1_CH1_TimerCounterGet();
+    do
+    {
+        reference_elapsed = counter_get() - reference_start;
+    } while ( reference_elapsed < reference_ticks );
+    measured = APP_TIMEBASE_scale((uint32_t)(TC1_CH1_TimerCounterGet() - start), reference_hz, reference_elapsed);
+
+    if ( measured == 0U )
+    {
+        /* Timebase not clocked, keep the nominal frequency */
+        APP_TIMEBASE_frequency_set(nominal);
+        return false;
+    }
+
+    deviation = (measured > nominal) ? (measured - nominal) : (nominal - measured);
+    if ( (deviation * 1000000ULL) <= ((uint64_t)nominal * APP_TIMEBASE_CALIBRATION_PPM) )
+    {
+        APP_TIMEBASE_frequency_set(nominal);
+        return true;
+    }
+
+    APP_TIMEBASE_frequency_set((uint32_t)measured);
+    return false;
+}
+
+// *****************************************************************************
+/* Function:
+    uint64_t APP_TIMEBASE_ticks_to_ns(uint64_t ticks)
+
+   Summary:
+    Convert ticks to nanoseconds, rounded down.
+*/
+uint64_t APP_TIMEBASE_ticks_to_ns(uint64_t ticks)
+{
+    if ( timebaseNsPerTick != 0U )
+    {
+        return ticks * timebaseNsPerTick;
+    }
+    return APP_TIMEBASE_scale(ticks, APP_TIMEBASE_NS_PER_S, timebaseFrequency);
+}
+
+// *****************************************************************************
+/* Function:
+    uint64_t APP_TIMEBASE_ticks_to_us(uint64_t ticks)
+
+   Summary:
+    Convert ticks to microseconds, rounded down.
+*/
+uint64_t APP_TIMEBASE_ticks_to_us(uint64_t ticks)
+{
+    return APP_TIMEBASE_scale(ticks, APP_TIMEBASE_US_PER_S, timebaseFrequency);
+}
+
+// *****************************************************************************
+/* Function:
+    uint64_t APP_TIMEBASE_us_to_ticks(uint64_t us)
+
+   Summary:
+    Convert microseconds to ticks, rounded down.
+*/
+uint64_t APP_TIMEBASE_us_to_ticks(uint64_t us)
+{
+    return APP_TIMEBASE_scale(us, timebaseFrequency, APP_TIMEBASE_US_PER_S);
+}
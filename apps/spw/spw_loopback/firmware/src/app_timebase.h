@@ -0,0 +1,110 @@
+/*******************************************************************************
+  MPLAB Harmony Application Timebase Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_timebase.h
+
+  Summary:
+    64-bit timebase Prototypes and definitions file.
+
+  Description:
+    The timebase chains TC1 channels 1 and 2 into a 64-bit tick counter: the
+    TIOA1 output rises when channel 1 wraps and clocks channel 2. The count
+    never wraps in the life of the application and is read without lock nor
+    interrupt, so any context can take timestamps and measure latencies.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_TIMEBASE_H
+#define	APP_TIMEBASE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Largest deviation of a calibrated frequency from the nominal one, in parts
+   per million, accepted as the measurement error on a shared clock */
+#define APP_TIMEBASE_CALIBRATION_PPM                              (1000U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Reference counter
+
+   Summary:
+    Read function of a 32-bit reference counter for the calibration, like
+    TC0_CH0_TimerCounterGet.
+*/
+typedef uint32_t (*APP_TIMEBASE_COUNTER_GET)(void);
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_TIMEBASE_init(void);
+
+uint64_t APP_TIMEBASE_get(void);
+
+uint32_t APP_TIMEBASE_frequency_get(void);
+
+bool APP_TIMEBASE_calibrate(APP_TIMEBASE_COUNTER_GET counter_get, uint32_t reference_hz, uint32_t reference_ticks);
+
+uint64_t APP_TIMEBASE_ticks_to_ns(uint64_t ticks);
+
+uint64_t APP_TIMEBASE_ticks_to_us(uint64_t ticks);
+
+uint64_t APP_TIMEBASE_us_to_ticks(uint64_t us);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_TIMEBASE_H */
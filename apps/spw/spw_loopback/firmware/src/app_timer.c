@@ -0,0 +1,736 @@
+/*******************************************************************************
+  MPLAB Harmony Application Software Timers Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_timer.c
+
+  Summary:
+    Software timers.
+
+  Description:
+    Each level of the wheel has 32 slots of 32 times the span of the slots of
+    the level below. The next event, an expiry or a cascade to a lower
+    level, is found from the slot occupancy bitmaps, so the wheel jumps over
+    the empty ticks instead of stepping through them. The timers are linked
+    in both directions so a timer is removed from its slot at once.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "definitions.h"                // SYS function prototypes
+#include <string.h>
+#include "app_timebase.h"
+#include "app_timer.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Lists of a timer besides the wheel levels 0 to APP_TIMER_LEVELS - 1 */
+#define APP_TIMER_LIST_OVERFLOW         (APP_TIMER_LEVELS)
+#define APP_TIMER_LIST_EXPIRED          (APP_TIMER_LEVELS + 1U)
+#define APP_TIMER_LIST_NONE             (0xFFU)
+
+#define APP_TIMER_SLOT_MASK             (APP_TIMER_SLOTS - 1U)
+
+/* Timer ticks covered by the wheel levels, as a power of two */
+#define APP_TIMER_WHEEL_BITS            (APP_TIMER_LEVELS * APP_TIMER_SLOT_BITS)
+
+#define APP_TIMER_NEVER                 (UINT64_MAX)
+
+/* Largest distance of the compare to the counter, later expiries take an
+   intermediate compare */
+#define APP_TIMER_COMPARE_MAX           (0x80000000ULL)
+
+/* First distance of the compare to the counter when the expiry is already
+   reached, in timebase ticks */
+#define APP_TIMER_COMPARE_MARGIN        (16ULL)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Wheel slots and their occupancy per level */
+static app_timer_t* timerWheel[APP_TIMER_LEVELS][APP_TIMER_SLOTS];
+static uint32_t timerBitmap[APP_TIMER_LEVELS];
+
+/* Timers beyond the wheel and timers due */
+static app_timer_t* timerOverflow = NULL;
+static app_timer_t* timerExpired = NULL;
+
+/* Deferred callbacks, in expiry order */
+static app_timer_t* timerPendingHead = NULL;
+static app_timer_t* timerPendingTail = NULL;
+
+/* Last timer tick processed by the wheel */
+static uint64_t timerNow = 0U;
+
+/* Timer tick programmed on the compare */
+static uint64_t timerArmed = APP_TIMER_NEVER;
+
+static app_timer_stats_t timerStats = {0};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static app_timer_t** APP_TIMER_list_head(uint8_t list, uint8_t slot)
+
+   Summary:
+    Get the head of a timer list.
+*/
+static app_timer_t** APP_TIMER_list_head(uint8_t list, uint8_t slot)
+{
+    if ( list == APP_TIMER_LIST_OVERFLOW )
+    {
+        return &timerOverflow;
+    }
+    if ( list == APP_TIMER_LIST_EXPIRED )
+    {
+        return &timerExpired;
+    }
+    return &timerWheel[list][slot];
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_link(app_timer_t* timer, uint8_t list, uint8_t slot)
+
+   Summary:
+    Add a timer at the head of a list.
+*/
+static void APP_TIMER_link(app_timer_t* timer, uint8_t list, uint8_t slot)
+{
+    app_timer_t** head = APP_TIMER_list_head(list, slot);
+
+    timer->list = list;
+    timer->slot = slot;
+    timer->prev = NULL;
+    timer->next = *head;
+    if ( *head != NULL )
+    {
+        (*head)->prev = timer;
+    }
+    *head = timer;
+
+    if ( list < APP_TIMER_LEVELS )
+    {
+        timerBitmap[list] |= (1UL << slot);
+    }
+    timerStats.active++;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_unlink(app_timer_t* timer)
+
+   Summary:
+    Remove a timer from its list.
+*/
+static void APP_TIMER_unlink(app_timer_t* timer)
+{
+    app_timer_t** head = APP_TIMER_list_head(timer->list, timer->slot);
+
+    if ( timer->prev != NULL )
+    {
+        timer->prev->next = timer->next;
+    }
+    else
+    {
+        *head = timer->next;
+    }
+    if ( timer->next != NULL )
+    {
+        timer->next->prev = timer->prev;
+    }
+
+    if ( (timer->list < APP_TIMER_LEVELS) && (*head == NULL) )
+    {
+        timerBitmap[timer->list] &= ~(1UL << timer->slot);
+    }
+    timer->list = APP_TIMER_LIST_NONE;
+    timerStats.active--;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_insert(app_timer_t* timer)
+
+   Summary:
+    Add a timer to the wheel from its expiry.
+
+   Description:
+    The timer goes to the lowest level whose block of slots holds both the
+    current tick and the expiry, so its slot comes later in the level and is
+    reached without wrapping. It is cascaded to the lower levels when the
+    current tick reaches the start of its slot.
+*/
+static void APP_TIMER_insert(app_timer_t* timer)
+{
+    uint8_t level;
+
+    if ( timer->expiry <= timerNow )
+    {
+        APP_TIMER_link(timer, APP_TIMER_LIST_EXPIRED, 0U);
+        return;
+    }
+
+    for (level = 0U; level < APP_TIMER_LEVELS; level++)
+    {
+        uint32_t block = (level + 1U) * APP_TIMER_SLOT_BITS;
+
+        if ( (timer->expiry >> block) == (timerNow >> block) )
+        {
+            uint8_t slot = (uint8_t)((timer->expiry >> (level * APP_TIMER_SLOT_BITS)) & APP_TIMER_SLOT_MASK);
+            APP_TIMER_link(timer, level, slot);
+            return;
+        }
+    }
+
+    APP_TIMER_link(timer, APP_TIMER_LIST_OVERFLOW, 0U);
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_reinsert(app_timer_t** head)
+
+   Summary:
+    Insert again the timers of a list, after the current tick moved.
+*/
+static void APP_TIMER_reinsert(app_timer_t** head)
+{
+    while ( *head != NULL )
+    {
+        app_timer_t* timer = *head;
+        APP_TIMER_unlink(timer);
+        APP_TIMER_insert(timer);
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static uint64_t APP_TIMER_next_event(void)
+
+   Summary:
+    Get the next timer tick where the wheel has work.
+
+   Description:
+    The occupied slots of a level all come after its current slot, the first
+    one is found from the occupancy bitmap.
+
+   Returns:
+    The tick of the next expiry or cascade, APP_TIMER_NEVER without timer.
+*/
+static uint64_t APP_TIMER_next_event(void)
+{
+    uint64_t next = APP_TIMER_NEVER;
+    uint8_t level;
+
+    if ( timerExpired != NULL )
+    {
+        return timerNow;
+    }
+
+    for (level = 0U; level < APP_TIMER_LEVELS; level++)
+    {
+        uint32_t shift = level * APP_TIMER_SLOT_BITS;
+        uint32_t index = (uint32_t)(timerNow >> shift) & APP_TIMER_SLOT_MASK;
+        uint32_t later = timerBitmap[level] & ~((2UL << index) - 1UL);
+
+        if ( later != 0U )
+        {
+            uint64_t block = (timerNow >> (shift + APP_TIMER_SLOT_BITS)) << (shift + APP_TIMER_SLOT_BITS);
+            uint64_t event = block + ((uint64_t)__builtin_ctz(later) << shift);
+
+            if ( event < next )
+            {
+                next = event;
+            }
+        }
+    }
+
+    if ( timerOverflow != NULL )
+    {
+        uint64_t event = ((timerNow >> APP_TIMER_WHEEL_BITS) + 1U) << APP_TIMER_WHEEL_BITS;
+
+        if ( event < next )
+        {
+            next = event;
+        }
+    }
+
+    return next;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_step(uint64_t tick)
+
+   Summary:
+    Move the wheel to the tick of its next event.
+
+   Description:
+    The slots starting at this tick are cascaded from the highest level
+    down, then the level 0 slot of the tick holds the timers due.
+*/
+static void APP_TIMER_step(uint64_t tick)
+{
+    uint8_t level;
+
+    timerNow = tick;
+
+    if ( (tick & ((1ULL << APP_TIMER_WHEEL_BITS) - 1U)) == 0U )
+    {
+        APP_TIMER_reinsert(&timerOverflow);
+    }
+
+    for (level = APP_TIMER_LEVELS - 1U; level > 0U; level--)
+    {
+        uint32_t shift = level * APP_TIMER_SLOT_BITS;
+
+        if ( (tick & ((1ULL << shift) - 1U)) == 0U )
+        {
+            APP_TIMER_reinsert(&timerWheel[level][(tick >> shift) & APP_TIMER_SLOT_MASK]);
+        }
+    }
+
+    APP_TIMER_reinsert(&timerWheel[0][tick & APP_TIMER_SLOT_MASK]);
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_arm(void)
+
+   Summary:
+    Program the compare on the next event of the wheel.
+
+   Description:
+    An expiry already reached, or reached while the compare is written, is
+    moved a few timebase ticks ahead until the compare is ahead of the
+    counter, so the interrupt is never lost.
+*/
+static void APP_TIMER_arm(void)
+{
+    uint64_t next = APP_TIMER_next_event();
+    uint64_t margin = APP_TIMER_COMPARE_MARGIN;
+    uint64_t compare;
+    uint64_t now;
+
+    timerArmed = next;
+    if ( next == APP_TIMER_NEVER )
+    {
+        return;
+    }
+
+    now = APP_TIMEBASE_get();
+    compare = next << APP_TIMER_TICK_SHIFT;
+    if ( compare > (now + APP_TIMER_COMPARE_MAX) )
+    {
+        compare = now + APP_TIMER_COMPARE_MAX;
+    }
+
+    while ( true )
+    {
+        if ( compare < (now + margin) )
+        {
+            compare = now + margin;
+        }
+        TC1_CH1_CompareBSet((uint32_t)compare);
+
+        now = APP_TIMEBASE_get();
+        if ( now < compare )
+        {
+            break;
+        }
+        margin <<= 1U;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_expire(app_timer_t* timer, uint64_t tick)
+
+   Summary:
+    Handle the expiry of a timer.
+
+   Description:
+    A periodic timer is started again on its next period after the tick,
+    the skipped periods are counted as overruns. A deferred timer is added
+    to the pending list.
+
+   Returns:
+    None, the callback of an interrupt timer is called by the caller.
+*/
+static void APP_TIMER_expire(app_timer_t* timer, uint64_t tick)
+{
+    timerStats.fired++;
+
+    if ( (timer->flags & APP_TIMER_FLAG_PERIODIC) != 0U )
+    {
+        timer->expiry += timer->period;
+        if ( timer->expiry <= tick )
+        {
+            uint64_t missed = ((tick - timer->expiry) / timer->period) + 1U;
+            timer->expiry += missed * timer->period;
+            timerStats.overruns += (uint32_t)missed;
+        }
+        APP_TIMER_insert(timer);
+    }
+
+    if ( (timer->flags & APP_TIMER_FLAG_DEFERRED) != 0U )
+    {
+        if ( timer->pending != 0U )
+        {
+            timerStats.overruns++;
+            return;
+        }
+        timer->pending = 1U;
+        timer->pending_next = NULL;
+        timer->pending_prev = timerPendingTail;
+        if ( timerPendingTail != NULL )
+        {
+            timerPendingTail->pending_next = timer;
+        }
+        else
+        {
+            timerPendingHead = timer;
+        }
+        timerPendingTail = timer;
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_pending_remove(app_timer_t* timer)
+
+   Summary:
+    Remove a timer from the pending list.
+*/
+static void APP_TIMER_pending_remove(app_timer_t* timer)
+{
+    if ( timer->pending_prev != NULL )
+    {
+        timer->pending_prev->pending_next = timer->pending_next;
+    }
+    else
+    {
+        timerPendingHead = timer->pending_next;
+    }
+    if ( timer->pending_next != NULL )
+    {
+        timer->pending_next->pending_prev = timer->pending_prev;
+    }
+    else
+    {
+        timerPendingTail = timer->pending_prev;
+    }
+    timer->pending = 0U;
+}
+
+// *****************************************************************************
+/* Function:
+    static void APP_TIMER_CompareCallback(TC_COMPARE_STATUS status, uintptr_t context)
+
+   Summary:
+    Function called by TC PLIB on the RB compare of TC1 channel 1.
+
+   Description:
+    The wheel is moved up to the current tick and the due timers are
+    handled one at a time. The callbacks run with the interrupts enabled, so
+    they can start and cancel timers, and the current tick is read again
+    after them.
+*/
+static void APP_TIMER_CompareCallback(TC_COMPARE_STATUS status, uintptr_t context)
+{
+    bool interruptStatus = NVIC_INT_Disable();
+    uint64_t tick = APP_TIMEBASE_get() >> APP_TIMER_TICK_SHIFT;
+    uint64_t next;
+
+    while ( (next = APP_TIMER_next_event()) <= tick )
+    {
+        if ( next > timerNow )
+        {
+            APP_TIMER_step(next);
+        }
+
+        while ( timerExpired != NULL )
+        {
+            app_timer_t* timer = timerExpired;
+
+            APP_TIMER_unlink(timer);
+            APP_TIMER_expire(timer, tick);
+
+            if ( (timer->flags & APP_TIMER_FLAG_DEFERRED) == 0U )
+            {
+                NVIC_INT_Restore(interruptStatus);
+                timer->callback(timer->context);
+                interruptStatus = NVIC_INT_Disable();
+            }
+        }
+
+        tick = APP_TIMEBASE_get() >> APP_TIMER_TICK_SHIFT;
+    }
+
+    /* No event up to now: the wheel can skip the ticks */
+    timerNow = tick;
+
+    APP_TIMER_arm();
+
+    NVIC_INT_Restore(interruptStatus);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_TIMER_init(void)
+
+   Summary:
+    Initialize the software timers.
+
+   Precondition:
+    APP_TIMEBASE_init must have been called.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_TIMER_init(void)
+{
+    memset(timerWheel, 0, sizeof(timerWheel));
+    memset(timerBitmap, 0, sizeof(timerBitmap));
+    timerOverflow = NULL;
+    timerExpired = NULL;
+    timerPendingHead = NULL;
+    timerPendingTail = NULL;
+    timerArmed = APP_TIMER_NEVER;
+    memset(&timerStats, 0, sizeof(timerStats));
+    timerNow = APP_TIMEBASE_get() >> APP_TIMER_TICK_SHIFT;
+
+    TC1_CH1_CompareCallbackRegister(APP_TIMER_CompareCallback, (uintptr_t)NULL);
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_TIMER_create(app_timer_t* timer, APP_TIMER_CALLBACK callback,
+                          uintptr_t context, uint8_t flags)
+
+   Summary:
+    Initialize a timer, stopped.
+
+   Parameters:
+    timer - timer to initialize.
+    callback - function called on expiry.
+    context - parameter of the callback.
+    flags - APP_TIMER_FLAG_PERIODIC for a periodic timer,
+    APP_TIMER_FLAG_DEFERRED to call the callback from APP_TIMER_task instead
+    of the compare interrupt.
+
+   Returns:
+    None.
+*/
+void APP_TIMER_create(app_timer_t* timer, APP_TIMER_CALLBACK callback, uintptr_t context, uint8_t flags)
+{
+    memset(timer, 0, sizeof(app_timer_t));
+    timer->callback = callback;
+    timer->context = context;
+    timer->flags = flags;
+    timer->list = APP_TIMER_LIST_NONE;
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_TIMER_start(app_timer_t* timer, uint32_t timeout_us)
+
+   Summary:
+    Start a timer, or start it again if active.
+
+   Description:
+    The timer expires after at least timeout_us, then every timeout_us for a
+    periodic timer. The expiry is rounded up to the timer tick. This
+    function can be called from any interrupt.
+
+   Parameters:
+    timer - timer created by APP_TIMER_create.
+    timeout_us - timeout in microseconds.
+
+   Returns:
+    None.
+*/
+void APP_TIMER_start(app_timer_t* timer, uint32_t timeout_us)
+{
+    uint64_t ticks = APP_TIMEBASE_us_to_ticks(timeout_us);
+    uint64_t round = (1ULL << APP_TIMER_TICK_SHIFT) - 1U;
+    bool interruptStatus = NVIC_INT_Disable();
+    uint64_t now = APP_TIMEBASE_get();
+
+    (void)APP_TIMER_cancel(timer);
+
+    timer->expiry = (now + ticks + round) >> APP_TIMER_TICK_SHIFT;
+    timer->period = (uint32_t)((ticks + round) >> APP_TIMER_TICK_SHIFT);
+    if ( timer->period == 0U )
+    {
+        timer->period = 1U;
+    }
+
+    /* Move the wheel to the current tick when no event is skipped, so the
+       timer goes to the lowest level */
+    if ( APP_TIMER_next_event() > (now >> APP_TIMER_TICK_SHIFT) )
+    {
+        timerNow = now >> APP_TIMER_TICK_SHIFT;
+    }
+
+    APP_TIMER_insert(timer);
+
+    if ( APP_TIMER_next_event() < timerArmed )
+    {
+        APP_TIMER_arm();
+    }
+
+    NVIC_INT_Restore(interruptStatus);
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_TIMER_cancel(app_timer_t* timer)
+
+   Summary:
+    Stop a timer.
+
+   Description:
+    A deferred callback not run yet is dropped. The compare is left as is,
+    an interrupt without expiry only programs the next one. This function
+    can be called from any interrupt.
+
+   Parameters:
+    timer - timer created by APP_TIMER_create.
+
+   Returns:
+    True if the timer was active.
+*/
+bool APP_TIMER_cancel(app_timer_t* timer)
+{
+    bool interruptStatus = NVIC_INT_Disable();
+    bool active = (timer->list != APP_TIMER_LIST_NONE);
+
+    if ( active )
+    {
+        APP_TIMER_unlink(timer);
+    }
+    if ( timer->pending != 0U )
+    {
+        APP_TIMER_pending_remove(timer);
+    }
+
+    NVIC_INT_Restore(interruptStatus);
+
+    return active;
+}
+
+// *****************************************************************************
+/* Function:
+    bool APP_TIMER_is_active(const app_timer_t* timer)
+
+   Summary:
+    Check if a timer is started.
+*/
+bool APP_TIMER_is_active(const app_timer_t* timer)
+{
+    return (timer->list != APP_TIMER_LIST_NONE);
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_TIMER_task(void)
+
+   Summary:
+    Run the deferred callbacks of the expired timers.
+
+   Description:
+    This function is called from the main loop.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_TIMER_task(void)
+{
+    while ( timerPendingHead != NULL )
+    {
+        bool interruptStatus = NVIC_INT_Disable();
+        app_timer_t* timer = timerPendingHead;
+
+        if ( timer != NULL )
+        {
+            APP_TIMER_pending_remove(timer);
+        }
+
+        NVIC_INT_Restore(interruptStatus);
+
+        if ( timer != NULL )
+        {
+            timer->callback(timer->context);
+        }
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_TIMER_get_stats(app_timer_stats_t* stats)
+
+   Summary:
+    Get the counters of the software timers.
+*/
+void APP_TIMER_get_stats(app_timer_stats_t* stats)
+{
+    bool interruptStatus = NVIC_INT_Disable();
+
+    *stats = timerStats;
+
+    NVIC_INT_Restore(interruptStatus);
+}
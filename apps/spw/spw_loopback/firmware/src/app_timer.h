@@ -0,0 +1,174 @@
+/*******************************************************************************
+  MPLAB Harmony Application Software Timers Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_timer.h
+
+  Summary:
+    Software timers Prototypes and definitions file.
+
+  Description:
+    The software timers multiplex any number of timeouts on the RB compare
+    interrupt of TC1 channel 1, the low word of the timebase. They are kept
+    in a hierarchical timer wheel: start and cancel take a constant time and
+    the compare is programmed on the next expiry only, without periodic tick
+    interrupt. A timer is one-shot or periodic, and its callback is called
+    from the compare interrupt or deferred to APP_TIMER_task.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_TIMER_H
+#define	APP_TIMER_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Timer tick as a power of two of timebase ticks: 64 ticks of 160 ns */
+#ifndef APP_TIMER_TICK_SHIFT
+#define APP_TIMER_TICK_SHIFT                                      (6U)
+#endif
+
+/* Wheel levels and slots per level: the levels cover 2^25 timer ticks,
+   later timers wait in an overflow list */
+#define APP_TIMER_LEVELS                                          (5U)
+#define APP_TIMER_SLOT_BITS                                       (5U)
+#define APP_TIMER_SLOTS                                           (1U << APP_TIMER_SLOT_BITS)
+
+/* Timer flags */
+#define APP_TIMER_FLAG_PERIODIC                                   (0x01U)
+#define APP_TIMER_FLAG_DEFERRED                                   (0x02U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* Timer callback
+
+   Summary:
+    Called on the expiry of a timer, with the context given on creation.
+*/
+typedef void (*APP_TIMER_CALLBACK)(uintptr_t context);
+
+/* Application software timer
+
+   Summary:
+    Software timer, allocated by the user.
+
+   Description:
+    The fields are private to app_timer.c. A timer is initialized once with
+    APP_TIMER_create, then started and canceled any number of times.
+
+   Remarks:
+    None.
+*/
+typedef struct app_timer_s
+{
+    /* Links in the wheel slot, overflow or expired list */
+    struct app_timer_s* next;
+    struct app_timer_s* prev;
+    /* Links in the deferred callback list */
+    struct app_timer_s* pending_next;
+    struct app_timer_s* pending_prev;
+    /* Expiry and period in timer ticks */
+    uint64_t expiry;
+    uint32_t period;
+    APP_TIMER_CALLBACK callback;
+    uintptr_t context;
+    uint8_t flags;
+    /* List and slot holding the timer */
+    uint8_t list;
+    uint8_t slot;
+    uint8_t pending;
+} app_timer_t;
+
+/* Application software timers statistics
+
+   Summary:
+    Counters of the software timers.
+
+   Description:
+    active is the number of started timers, fired counts the expiries and
+    overruns the periods a periodic timer skipped, or the expiries of a
+    deferred timer whose previous callback was not run yet.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t active;
+    uint32_t fired;
+    uint32_t overruns;
+} app_timer_stats_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_TIMER_init(void);
+
+void APP_TIMER_create(app_timer_t* timer, APP_TIMER_CALLBACK callback, uintptr_t context, uint8_t flags);
+
+void APP_TIMER_start(app_timer_t* timer, uint32_t timeout_us);
+
+bool APP_TIMER_cancel(app_timer_t* timer);
+
+bool APP_TIMER_is_active(const app_timer_t* timer);
+
+void APP_TIMER_task(void);
+
+void APP_TIMER_get_stats(app_timer_stats_t* stats);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_TIMER_H */
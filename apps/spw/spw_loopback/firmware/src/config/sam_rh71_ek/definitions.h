@@ -61,6 +61,8 @@
 #include "peripheral/nvic/plib_nvic.h"
 #include "peripheral/mpu/plib_mpu.h"
 #include "peripheral/tc/plib_tc0.h"
+#include "peripheral/tc/plib_tc1.h"
+#include "peripheral/xdmac/plib_xdmac.h"
 #include "peripheral/flexcom/usart/plib_flexcom1_usart.h"
 
 // DOM-IGNORE-BEGIN
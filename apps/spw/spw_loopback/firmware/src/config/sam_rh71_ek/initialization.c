@@ -160,6 +160,10 @@ void SYS_Initialize ( void* data )
     TC0_CH0_TimerInitialize(); 
     TC0_CH1_TimerInitialize(); 
     TC0_CH2_TimerInitialize();
+    TC1_CH0_TimerInitialize();
+    TC1_CH1_TimerInitialize();
+    TC1_CH2_TimerInitialize();
+    XDMAC_Initialize();
     FLEXCOM1_USART_Initialize();
 
 
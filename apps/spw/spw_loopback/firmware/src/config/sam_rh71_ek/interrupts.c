@@ -108,8 +108,6 @@ extern void IXC_Handler                ( void ) __attribute__((weak, alias("Dumm
 extern void FLEXCOM5_Handler           ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void FLEXCOM6_Handler           ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void FLEXCOM7_Handler           ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
-extern void TC1_CH0_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
-extern void TC1_CH1_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void TC1_CH2_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void PWM0_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void PWM1_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
@@ -143,7 +141,6 @@ extern void HEMC_INTFIX_Handler        ( void ) __attribute__((weak, alias("Dumm
 extern void HEMC_INTNOFIX_Handler      ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void SFR_Handler                ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void TRNG_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
-extern void XDMAC_Handler              ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void IP1553_Handler             ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void GMAC_Handler               ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
 extern void GMAC_Q1_Handler            ( void ) __attribute__((weak, alias("Dummy_Handler"),noreturn));
@@ -203,8 +200,8 @@ const H3DeviceVectors exception_table=
     .pfnTC0_CH0_Handler            = TC0_CH0_InterruptHandler,
     .pfnTC0_CH1_Handler            = TC0_CH1_InterruptHandler,
     .pfnTC0_CH2_Handler            = TC0_CH2_InterruptHandler,
-    .pfnTC1_CH0_Handler            = TC1_CH0_Handler,
-    .pfnTC1_CH1_Handler            = TC1_CH1_Handler,
+    .pfnTC1_CH0_Handler            = APP_PROF_InterruptHandler,
+    .pfnTC1_CH1_Handler            = TC1_CH1_InterruptHandler,
     .pfnTC1_CH2_Handler            = TC1_CH2_Handler,
     .pfnPWM0_Handler               = PWM0_Handler,
     .pfnPWM1_Handler               = PWM1_Handler,
@@ -238,7 +235,7 @@ const H3DeviceVectors exception_table=
     .pfnHEMC_INTNOFIX_Handler      = HEMC_INTNOFIX_Handler,
     .pfnSFR_Handler                = SFR_Handler,
     .pfnTRNG_Handler               = TRNG_Handler,
-    .pfnXDMAC_Handler              = XDMAC_Handler,
+    .pfnXDMAC_Handler              = XDMAC_InterruptHandler,
     .pfnSPW_Handler                = SPW_InterruptHandler,
     .pfnIP1553_Handler             = IP1553_Handler,
     .pfnGMAC_Handler               = GMAC_Handler,
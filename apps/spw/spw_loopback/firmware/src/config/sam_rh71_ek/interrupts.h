@@ -66,8 +66,20 @@ void DebugMonitor_Handler (void);
 void TC0_CH0_InterruptHandler (void);
 void TC0_CH1_InterruptHandler (void);
 void TC0_CH2_InterruptHandler (void);
+void APP_PROF_InterruptHandler (void);
+void TC1_CH1_InterruptHandler (void);
+void XDMAC_InterruptHandler (void);
 void SPW_InterruptHandler (void);
 
 
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Startup Routines
+// *****************************************************************************
+// *****************************************************************************
+/* Initialize the ECC of the FlexRAM left by the startup code above
+   __ecc_flexram_used_end, defined in startup_xc32.c */
+void ECC_InitializeDeferred (void);
+
 #endif // INTERRUPTS_H
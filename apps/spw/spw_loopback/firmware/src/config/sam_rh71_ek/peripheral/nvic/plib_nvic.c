@@ -65,6 +65,13 @@ void NVIC_Initialize( void )
     NVIC_EnableIRQ(TC0_CH1_IRQn);
     NVIC_SetPriority(TC0_CH2_IRQn, 7);
     NVIC_EnableIRQ(TC0_CH2_IRQn);
+    /* Sampling profiler above the other interrupts, to sample their handlers */
+    NVIC_SetPriority(TC1_CH0_IRQn, 0);
+    NVIC_EnableIRQ(TC1_CH0_IRQn);
+    NVIC_SetPriority(TC1_CH1_IRQn, 7);
+    NVIC_EnableIRQ(TC1_CH1_IRQn);
+    NVIC_SetPriority(XDMAC_IRQn, 7);
+    NVIC_EnableIRQ(XDMAC_IRQn);
     NVIC_SetPriority(SPW_IRQn, 7);
     NVIC_EnableIRQ(SPW_IRQn);
 
@@ -49,6 +49,7 @@
 // *****************************************************************************
 
 #include "device.h"
+#include "plib_spw.h"
 #include "plib_spw_link.h"
 
 // *****************************************************************************
@@ -103,7 +104,7 @@ void SPW_LINK_Initialize(void)
    Returns:
     Current status of the selected SPW link.
 */
-SPW_LINK_STATUS SPW_LINK_StatusGet(SPW_LINK link)
+SPW_TCM_CODE SPW_LINK_STATUS SPW_LINK_StatusGet(SPW_LINK link)
 {
     uint32_t status = 0;
     if ( link == SPW_LINK_1 )
@@ -138,7 +139,7 @@ SPW_LINK_STATUS SPW_LINK_StatusGet(SPW_LINK link)
    Returns:
     Current interrupt status of the selected link.
 */
-SPW_LINK_INT_MASK SPW_LINK_IrqStatusGetMaskedAndClear(SPW_LINK link)
+SPW_TCM_CODE SPW_LINK_INT_MASK SPW_LINK_IrqStatusGetMaskedAndClear(SPW_LINK link)
 {
     uint32_t pendingMaskedIrq = 0;
     if (link == SPW_LINK_1)
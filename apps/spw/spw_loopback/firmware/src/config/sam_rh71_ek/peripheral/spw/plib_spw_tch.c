@@ -268,7 +268,7 @@ void SPW_TCH_LastTimeCodeSet(uint8_t timeCode, bool now)
    Returns:
     Last Time Code distributed.
 */
-uint8_t SPW_TCH_LastTimeCodeGet(void)
+SPW_TCM_CODE uint8_t SPW_TCH_LastTimeCodeGet(void)
 {
     return (uint8_t)( (SPW_REGS->SPW_TCH_LASTTIMECODE & SPW_TCH_LASTTIMECODE_VALUE_Msk) >> SPW_TCH_LASTTIMECODE_VALUE_Pos );
 }
@@ -289,7 +289,7 @@ uint8_t SPW_TCH_LastTimeCodeGet(void)
    Returns:
     Current SPW TCH interrupt status.
 */
-SPW_TCH_INT_MASK SPW_TCH_IrqStatusGetMaskedAndClear(void)
+SPW_TCM_CODE SPW_TCH_INT_MASK SPW_TCH_IrqStatusGetMaskedAndClear(void)
 {
     uint32_t pendingMaskedIrq = SPW_REGS->SPW_TCH_PI_RM;
     SPW_REGS->SPW_TCH_PI_C = pendingMaskedIrq;
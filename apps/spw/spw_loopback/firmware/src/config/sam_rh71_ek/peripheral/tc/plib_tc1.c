@@ -0,0 +1,224 @@
+/*******************************************************************************
+  TC Peripheral Library Interface Source File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_tc1.c
+
+  Summary
+    TC peripheral library source file.
+
+  Description
+    This file implements the interface to the TC peripheral library.  This
+    library provides access to and control of the associated peripheral
+    instance.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+/*  This section lists the other files that are included in this file.
+*/
+#include "device.h"
+#include "plib_tc1.h"
+#include "interrupts.h"
+
+ 
+ 
+
+ 
+
+
+/* Initialize channel in timer mode */
+void TC1_CH0_TimerInitialize (void)
+{
+    /* clock selection and waveform selection */
+    TC1_REGS->TC_CHANNEL[0].TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK2 | TC_CMR_WAVEFORM_WAVSEL_UP_RC | \
+                                                        TC_CMR_WAVE_Msk;
+
+    /* write period */
+    TC1_REGS->TC_CHANNEL[0].TC_RC = 625U;
+
+
+    /* enable interrupt */
+    TC1_REGS->TC_CHANNEL[0].TC_IER = TC_IER_CPCS_Msk;
+}
+
+/* Start the timer */
+void TC1_CH0_TimerStart (void)
+{
+    TC1_REGS->TC_CHANNEL[0].TC_CCR = (TC_CCR_CLKEN_Msk | TC_CCR_SWTRG_Msk);
+}
+
+/* Stop the timer */
+void TC1_CH0_TimerStop (void)
+{
+    TC1_REGS->TC_CHANNEL[0].TC_CCR = (TC_CCR_CLKDIS_Msk);
+}
+
+uint32_t TC1_CH0_TimerFrequencyGet( void )
+{
+    return (uint32_t)(6250000UL);
+}
+
+/* Configure timer period */
+void TC1_CH0_TimerPeriodSet (uint32_t period)
+{
+    TC1_REGS->TC_CHANNEL[0].TC_RC = period;
+}
+
+
+/* Read timer period */
+uint32_t TC1_CH0_TimerPeriodGet (void)
+{
+    return (uint32_t)TC1_REGS->TC_CHANNEL[0].TC_RC;
+}
+
+/* Read timer counter value */
+uint32_t TC1_CH0_TimerCounterGet (void)
+{
+    return (uint32_t)TC1_REGS->TC_CHANNEL[0].TC_CV;
+}
+
+
+/* Callback object for channel 1 */
+static volatile TC_COMPARE_CALLBACK_OBJECT TC1_CH1_CallbackObj;
+
+/* Initialize channel 1 as the low word of the timebase: TIOA1 rises when the
+   counter wraps to 0 and clocks channel 2. RB is free for the compare
+   interrupt */
+void TC1_CH1_TimerInitialize (void)
+{
+    /* clock selection and waveform selection, no trigger on RC, TIOB not
+       used as external event so RB compare is available */
+    TC1_REGS->TC_CHANNEL[1].TC_CMR = TC_CMR_TCCLKS_TIMER_CLOCK2 | TC_CMR_WAVEFORM_WAVSEL_UP | \
+                                                        TC_CMR_WAVE_Msk | TC_CMR_WAVEFORM_ACPA_CLEAR | \
+                                                        TC_CMR_WAVEFORM_ACPC_SET | TC_CMR_WAVEFORM_ASWTRG_CLEAR | \
+                                                        TC_CMR_WAVEFORM_EEVT_XC0;
+
+    /* TIOA1 falls half way and rises on the wrap */
+    TC1_REGS->TC_CHANNEL[1].TC_RA = 0x80000000U;
+    TC1_REGS->TC_CHANNEL[1].TC_RC = 0U;
+
+    /* enable interrupt */
+    TC1_REGS->TC_CHANNEL[1].TC_IER = TC_IER_CPBS_Msk;
+    TC1_CH1_CallbackObj.callback_fn = NULL;
+}
+
+/* Start the timer */
+void TC1_CH1_TimerStart (void)
+{
+    TC1_REGS->TC_CHANNEL[1].TC_CCR = (TC_CCR_CLKEN_Msk | TC_CCR_SWTRG_Msk);
+}
+
+/* Stop the timer */
+void TC1_CH1_TimerStop (void)
+{
+    TC1_REGS->TC_CHANNEL[1].TC_CCR = (TC_CCR_CLKDIS_Msk);
+}
+
+uint32_t TC1_CH1_TimerFrequencyGet( void )
+{
+    return (uint32_t)(6250000UL);
+}
+
+/* Read timer counter value */
+uint32_t TC1_CH1_TimerCounterGet (void)
+{
+    return (uint32_t)TC1_REGS->TC_CHANNEL[1].TC_CV;
+}
+
+/* Configure the compare value of the RB compare interrupt */
+void TC1_CH1_CompareBSet (uint32_t value)
+{
+    TC1_REGS->TC_CHANNEL[1].TC_RB = value;
+}
+
+/* Register callback for compare interrupt */
+void TC1_CH1_CompareCallbackRegister(TC_COMPARE_CALLBACK callback, uintptr_t context)
+{
+    TC1_CH1_CallbackObj.callback_fn = callback;
+    TC1_CH1_CallbackObj.context = context;
+}
+
+/* Interrupt handler for Channel 1 */
+void __attribute__((used)) TC1_CH1_InterruptHandler(void)
+{
+    TC_COMPARE_STATUS compare_status = (TC_COMPARE_STATUS)(TC1_REGS->TC_CHANNEL[1].TC_SR & TC_COMPARE_STATUS_MSK);
+
+    /* Additional temporary variable used to prevent MISRA violations (Rule 13.x) */
+    uintptr_t context = TC1_CH1_CallbackObj.context;
+
+    /* Call registered callback function */
+    if ((TC1_CH1_CallbackObj.callback_fn != NULL) && (TC_COMPARE_NONE != compare_status))
+    {
+        TC1_CH1_CallbackObj.callback_fn(compare_status, context);
+    }
+}
+
+/* Initialize channel 2 as the high word of the timebase, counting the wraps
+   of channel 1 */
+void TC1_CH2_TimerInitialize (void)
+{
+    /* TIOA1 on XC2 */
+    TC1_REGS->TC_BMR = (TC1_REGS->TC_BMR & ~TC_BMR_TC2XC2S_Msk) | TC_BMR_TC2XC2S_TIOA1;
+
+    /* clock selection and waveform selection, no trigger on RC */
+    TC1_REGS->TC_CHANNEL[2].TC_CMR = TC_CMR_TCCLKS_XC2 | TC_CMR_WAVEFORM_WAVSEL_UP | \
+                                                        TC_CMR_WAVE_Msk;
+}
+
+/* Start the timer */
+void TC1_CH2_TimerStart (void)
+{
+    TC1_REGS->TC_CHANNEL[2].TC_CCR = (TC_CCR_CLKEN_Msk | TC_CCR_SWTRG_Msk);
+}
+
+/* Stop the timer */
+void TC1_CH2_TimerStop (void)
+{
+    TC1_REGS->TC_CHANNEL[2].TC_CCR = (TC_CCR_CLKDIS_Msk);
+}
+
+/* Read timer counter value */
+uint32_t TC1_CH2_TimerCounterGet (void)
+{
+    return (uint32_t)TC1_REGS->TC_CHANNEL[2].TC_CV;
+}
+
+ 
+/**
+ End of File
+*/
@@ -0,0 +1,148 @@
+/*******************************************************************************
+  TC Peripheral Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_tc1.h
+
+  Summary
+    TC peripheral library interface.
+
+  Description
+    This file defines the interface to the TC peripheral library.  This
+    library provides access to and control of the associated peripheral
+    instance.
+
+******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef PLIB_TC1_H    // Guards against multiple inclusion
+#define PLIB_TC1_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+/*  This section lists the other files that are included in this file.
+*/
+
+
+#include "plib_tc_common.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+/*  The following data type definitions are used by the functions in this
+    interface and should be considered part it.
+*/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+/* The following functions make up the methods (set of possible operations) of
+   this interface.
+*/
+
+// *****************************************************************************
+
+  
+
+
+ 
+
+
+
+/* TC1 channel 0 is the sampling timer of the profiler, which serves its
+   period interrupt */
+void TC1_CH0_TimerInitialize (void);
+
+void TC1_CH0_TimerStart (void);
+
+void TC1_CH0_TimerStop (void);
+
+void TC1_CH0_TimerPeriodSet (uint32_t period);
+
+
+uint32_t TC1_CH0_TimerFrequencyGet (void);
+
+uint32_t TC1_CH0_TimerPeriodGet (void);
+
+uint32_t TC1_CH0_TimerCounterGet (void);
+
+/* TC1 channels 1 and 2 are chained into the 64-bit timebase: channel 2
+   counts the wraps of channel 1. The RB compare interrupt of channel 1
+   drives the software timers */
+void TC1_CH1_TimerInitialize (void);
+
+void TC1_CH1_TimerStart (void);
+
+void TC1_CH1_TimerStop (void);
+
+uint32_t TC1_CH1_TimerFrequencyGet (void);
+
+uint32_t TC1_CH1_TimerCounterGet (void);
+
+void TC1_CH1_CompareBSet (uint32_t value);
+
+void TC1_CH1_CompareCallbackRegister(TC_COMPARE_CALLBACK callback, uintptr_t context);
+
+void TC1_CH2_TimerInitialize (void);
+
+void TC1_CH2_TimerStart (void);
+
+void TC1_CH2_TimerStop (void);
+
+uint32_t TC1_CH2_TimerCounterGet (void);
+
+
+
+
+#ifdef __cplusplus // Provide C++ Compatibility
+}
+#endif
+
+#endif //PLIB_TC1_H
+
+/* End of File */
\ No newline at end of file
@@ -0,0 +1,272 @@
+/*******************************************************************************
+  XDMAC Peripheral Library Interface Source File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_xdmac.c
+
+  Summary
+    XDMAC peripheral library source file.
+
+  Description
+    This file implements the interface to the XDMAC peripheral library. This
+    library provides access to and control of the channels of the extensible
+    DMA controller, for single block and linked list transfers.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+/*  This section lists the other files that are included in this file.
+*/
+#include "device.h"
+#include "plib_xdmac.h"
+#include "interrupts.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Errors reported by the channel interrupt status */
+#define XDMAC_CIS_ERROR_Msk             (XDMAC_CIS_RBEIS_Msk | XDMAC_CIS_WBEIS_Msk | XDMAC_CIS_ROIS_Msk)
+
+/* Error interrupts, enabled with the end of transfer interrupt */
+#define XDMAC_CIE_ERROR_Msk             (XDMAC_CIE_RBIE_Msk | XDMAC_CIE_WBIE_Msk | XDMAC_CIE_ROIE_Msk)
+
+/* Channel objects */
+static XDMAC_CH_OBJECT xdmacChannelObj[XDMAC_ACTIVE_CHANNELS_MAX];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: XDMAC Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void XDMAC_Initialize( void )
+{
+    uint32_t channel;
+
+    for (channel = 0U; channel < XDMAC_ACTIVE_CHANNELS_MAX; channel++)
+    {
+        /* Disable the channel and its interrupts */
+        XDMAC_REGS->XDMAC_GD = (1UL << channel);
+        while ((XDMAC_REGS->XDMAC_GS & (1UL << channel)) != 0U)
+        {
+            /* Wait the end of a transfer started before */
+        }
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CID = XDMAC_CID_Msk;
+        XDMAC_REGS->XDMAC_GID = (1UL << channel);
+        (void)XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CIS;
+
+        xdmacChannelObj[channel].callback = NULL;
+        xdmacChannelObj[channel].context = 0U;
+        xdmacChannelObj[channel].busyStatus = false;
+    }
+
+    /* Channel 0: memory to memory, words, bursts of 16, through the bus interface 1 */
+    XDMAC_REGS->XDMAC_CHID[XDMAC_CHANNEL_0].XDMAC_CC = XDMAC_CC_TYPE_MEM_TRAN | XDMAC_CC_MBSIZE_SIXTEEN |
+                                                       XDMAC_CC_DWIDTH_WORD | XDMAC_CC_CSIZE_CHK_1 |
+                                                       XDMAC_CC_SIF_AHB_IF1 | XDMAC_CC_DIF_AHB_IF1 |
+                                                       XDMAC_CC_SAM_INCREMENTED_AM | XDMAC_CC_DAM_INCREMENTED_AM;
+    XDMAC_REGS->XDMAC_CHID[XDMAC_CHANNEL_0].XDMAC_CDS_MSP = 0U;
+    XDMAC_REGS->XDMAC_CHID[XDMAC_CHANNEL_0].XDMAC_CSUS = 0U;
+    XDMAC_REGS->XDMAC_CHID[XDMAC_CHANNEL_0].XDMAC_CDUS = 0U;
+}
+
+void XDMAC_ChannelCallbackRegister( XDMAC_CHANNEL channel, const XDMAC_CHANNEL_CALLBACK eventHandler, const uintptr_t contextHandle )
+{
+    xdmacChannelObj[channel].callback = eventHandler;
+    xdmacChannelObj[channel].context = contextHandle;
+}
+
+bool XDMAC_ChannelTransfer( XDMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize )
+{
+    bool returnStatus = false;
+
+    if (xdmacChannelObj[channel].busyStatus == false)
+    {
+        xdmacChannelObj[channel].busyStatus = true;
+
+        /* Clear the pending status of the previous transfer */
+        (void)XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CIS;
+
+        /* Single microblock of blockSize data, no descriptor fetch */
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CSA = (uint32_t)srcAddr;
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CDA = (uint32_t)destAddr;
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CUBC = XDMAC_CUBC_UBLEN(blockSize);
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CBC = 0U;
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CNDC = 0U;
+
+        /* End of block and error interrupts */
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CID = XDMAC_CID_Msk;
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CIE = XDMAC_CIE_BIE_Msk | XDMAC_CIE_ERROR_Msk;
+        XDMAC_REGS->XDMAC_GIE = (1UL << channel);
+
+        /* The register writes complete before the channel starts */
+        __DMB();
+        XDMAC_REGS->XDMAC_GE = (1UL << channel);
+
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+bool XDMAC_ChannelLinkedListTransfer( XDMAC_CHANNEL channel, uint32_t firstDescriptorAddress, XDMAC_DESCRIPTOR_CONTROL* firstDescriptorControl )
+{
+    bool returnStatus = false;
+
+    if (xdmacChannelObj[channel].busyStatus == false)
+    {
+        xdmacChannelObj[channel].busyStatus = true;
+
+        /* Clear the pending status of the previous transfer */
+        (void)XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CIS;
+
+        /* First descriptor, fetched through the bus interface 1 */
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CNDA = (firstDescriptorAddress & XDMAC_CNDA_NDA_Msk) | XDMAC_CNDA_NDAIF(1U);
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CNDC = XDMAC_CNDC_NDE(firstDescriptorControl->ctrl.nde) |
+                                                     XDMAC_CNDC_NDSUP(firstDescriptorControl->ctrl.nsen) |
+                                                     XDMAC_CNDC_NDDUP(firstDescriptorControl->ctrl.nden) |
+                                                     XDMAC_CNDC_NDVIEW(firstDescriptorControl->ctrl.view);
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CUBC = 0U;
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CBC = 0U;
+
+        /* End of linked list and error interrupts */
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CID = XDMAC_CID_Msk;
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CIE = XDMAC_CIE_LIE_Msk | XDMAC_CIE_ERROR_Msk;
+        XDMAC_REGS->XDMAC_GIE = (1UL << channel);
+
+        /* The descriptors and the register writes complete before the channel starts */
+        __DMB();
+        XDMAC_REGS->XDMAC_GE = (1UL << channel);
+
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+bool XDMAC_ChannelIsBusy( XDMAC_CHANNEL channel )
+{
+    return xdmacChannelObj[channel].busyStatus;
+}
+
+void XDMAC_ChannelDisable( XDMAC_CHANNEL channel )
+{
+    XDMAC_REGS->XDMAC_GD = (1UL << channel);
+    while ((XDMAC_REGS->XDMAC_GS & (1UL << channel)) != 0U)
+    {
+        /* Wait the end of the current burst */
+    }
+
+    XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CID = XDMAC_CID_Msk;
+    (void)XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CIS;
+    xdmacChannelObj[channel].busyStatus = false;
+}
+
+XDMAC_CHANNEL_CONFIG XDMAC_ChannelSettingsGet( XDMAC_CHANNEL channel )
+{
+    return (XDMAC_CHANNEL_CONFIG)XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CC;
+}
+
+bool XDMAC_ChannelSettingsSet( XDMAC_CHANNEL channel, XDMAC_CHANNEL_CONFIG setting )
+{
+    bool returnStatus = false;
+
+    if (xdmacChannelObj[channel].busyStatus == false)
+    {
+        XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CC = setting;
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
+void XDMAC_ChannelSuspend( XDMAC_CHANNEL channel )
+{
+    XDMAC_REGS->XDMAC_GRWS = (1UL << channel);
+}
+
+void XDMAC_ChannelResume( XDMAC_CHANNEL channel )
+{
+    XDMAC_REGS->XDMAC_GRWR = (1UL << channel);
+}
+
+void __attribute__((used)) XDMAC_InterruptHandler( void )
+{
+    uint32_t channel;
+    uint32_t pending = XDMAC_REGS->XDMAC_GIS;
+
+    for (channel = 0U; channel < XDMAC_ACTIVE_CHANNELS_MAX; channel++)
+    {
+        if ((pending & (1UL << channel)) != 0U)
+        {
+            /* Reading the status clears it */
+            uint32_t status = XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CIS;
+            status &= XDMAC_REGS->XDMAC_CHID[channel].XDMAC_CIM;
+            XDMAC_TRANSFER_EVENT event = XDMAC_TRANSFER_NONE;
+
+            if ((status & XDMAC_CIS_ERROR_Msk) != 0U)
+            {
+                /* The channel is disabled by the error */
+                event = XDMAC_TRANSFER_ERROR;
+            }
+            else if ((status & (XDMAC_CIS_BIS_Msk | XDMAC_CIS_LIS_Msk)) != 0U)
+            {
+                event = XDMAC_TRANSFER_COMPLETE;
+            }
+            else
+            {
+                /* Nothing to report */
+            }
+
+            if (event != XDMAC_TRANSFER_NONE)
+            {
+                /* Additional temporary variable used to prevent MISRA violations (Rule 13.x) */
+                uintptr_t context = xdmacChannelObj[channel].context;
+
+                xdmacChannelObj[channel].busyStatus = false;
+
+                if (xdmacChannelObj[channel].callback != NULL)
+                {
+                    xdmacChannelObj[channel].callback(event, context);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,297 @@
+/*******************************************************************************
+  XDMAC Peripheral Library Interface Header File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_xdmac.h
+
+  Summary
+    XDMAC peripheral library interface.
+
+  Description
+    This file defines the interface to the XDMAC peripheral library. This
+    library provides access to and control of the channels of the extensible
+    DMA controller, for single block and linked list transfers.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#ifndef PLIB_XDMAC_H    // Guards against multiple inclusion
+#define PLIB_XDMAC_H
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+/*  This section lists the other files that are included in this file.
+*/
+#include <stddef.h>
+#include <stdbool.h>
+#include "device.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: XDMAC defines
+// *****************************************************************************
+// *****************************************************************************
+/* Number of channels configured in XDMAC_Initialize() */
+#define XDMAC_ACTIVE_CHANNELS_MAX                                 (1U)
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+/*  The following data type definitions are used by the functions in this
+    interface and should be considered part it.
+*/
+
+// *****************************************************************************
+/* XDMAC Channels
+
+   Summary:
+    Identifies the XDMAC channels.
+
+   Description:
+    Channel 0 is configured for memory to memory transfers.
+
+   Remarks:
+    None.
+*/
+typedef enum
+{
+    XDMAC_CHANNEL_0 = 0,
+} XDMAC_CHANNEL;
+
+// *****************************************************************************
+/* XDMAC Transfer Events
+
+   Summary:
+    Identifies the events reported to the channel callback.
+
+   Description:
+    XDMAC_TRANSFER_COMPLETE is reported at the end of a single block transfer
+    or of a linked list, XDMAC_TRANSFER_ERROR on a read or write bus error or
+    a request overflow.
+
+   Remarks:
+    None.
+*/
+typedef enum
+{
+    XDMAC_TRANSFER_NONE = 0,
+    XDMAC_TRANSFER_COMPLETE = 1,
+    XDMAC_TRANSFER_ERROR = 2,
+} XDMAC_TRANSFER_EVENT;
+
+// *****************************************************************************
+/* XDMAC Channel Settings
+
+   Summary:
+    Value of the XDMAC_CC register of a channel.
+
+   Description:
+    Built with the XDMAC_CC_ field macros of the device pack.
+
+   Remarks:
+    None.
+*/
+typedef uint32_t XDMAC_CHANNEL_CONFIG;
+
+// *****************************************************************************
+/* XDMAC Descriptor Control
+
+   Summary:
+    Microblock control word of a linked list descriptor.
+
+   Description:
+    ubLen is the number of data of the microblock. The next descriptor fields
+    give its view and whether it is fetched and updates the source and
+    destination parameters.
+
+   Remarks:
+    Same layout as the XDMAC_CNDC and XDMAC_CUBC registers.
+*/
+typedef union
+{
+    struct
+    {
+        uint32_t ubLen:24;
+        uint32_t nde:1;
+        uint32_t nsen:1;
+        uint32_t nden:1;
+        uint32_t view:2;
+        uint32_t :3;
+    } ctrl;
+    uint32_t value;
+} XDMAC_DESCRIPTOR_CONTROL;
+
+#define XDMAC_DESCRIPTOR_VIEW_TYPE_0                              (0U)
+#define XDMAC_DESCRIPTOR_VIEW_TYPE_1                              (1U)
+#define XDMAC_DESCRIPTOR_VIEW_TYPE_2                              (2U)
+#define XDMAC_DESCRIPTOR_VIEW_TYPE_3                              (3U)
+
+// *****************************************************************************
+/* XDMAC Linked List Descriptors
+
+   Summary:
+    Linked list descriptors of the four views.
+
+   Description:
+    mbr_nda is the address of the next descriptor. The view 2 also loads the
+    channel settings, the view 3 the block length, the data stride or memory
+    set pattern and the microblock strides.
+
+   Remarks:
+    Descriptors are read by the XDMAC: they are placed in non cached memory,
+    or cleaned from the data cache before the transfer is started.
+*/
+typedef struct
+{
+    uint32_t mbr_nda;
+    XDMAC_DESCRIPTOR_CONTROL mbr_ubc;
+    uint32_t mbr_ta;
+} XDMAC_DESCRIPTOR_VIEW_0;
+
+typedef struct
+{
+    uint32_t mbr_nda;
+    XDMAC_DESCRIPTOR_CONTROL mbr_ubc;
+    uint32_t mbr_sa;
+    uint32_t mbr_da;
+} XDMAC_DESCRIPTOR_VIEW_1;
+
+typedef struct
+{
+    uint32_t mbr_nda;
+    XDMAC_DESCRIPTOR_CONTROL mbr_ubc;
+    uint32_t mbr_sa;
+    uint32_t mbr_da;
+    uint32_t mbr_cfg;
+} XDMAC_DESCRIPTOR_VIEW_2;
+
+typedef struct
+{
+    uint32_t mbr_nda;
+    XDMAC_DESCRIPTOR_CONTROL mbr_ubc;
+    uint32_t mbr_sa;
+    uint32_t mbr_da;
+    uint32_t mbr_cfg;
+    uint32_t mbr_bc;
+    uint32_t mbr_ds;
+    uint32_t mbr_sus;
+    uint32_t mbr_dus;
+} XDMAC_DESCRIPTOR_VIEW_3;
+
+// *****************************************************************************
+/* XDMAC Callback
+
+   Summary:
+    XDMAC Callback Function Pointer.
+
+   Description:
+    Called from the XDMAC interrupt at the end of a transfer of the channel.
+
+   Remarks:
+    None.
+*/
+typedef void (*XDMAC_CHANNEL_CALLBACK) (XDMAC_TRANSFER_EVENT event, uintptr_t contextHandle);
+
+// *****************************************************************************
+/* XDMAC Channel Object
+
+   Summary:
+    Callback and state of a channel.
+
+   Description:
+    This data type is used by the XDMAC PLIB and should not be accessed by the
+    application.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    XDMAC_CHANNEL_CALLBACK callback;
+    uintptr_t context;
+    volatile bool busyStatus;
+} XDMAC_CH_OBJECT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+/* The following functions make up the methods (set of possible operations) of
+   this interface.
+*/
+
+void XDMAC_Initialize( void );
+
+void XDMAC_ChannelCallbackRegister( XDMAC_CHANNEL channel, const XDMAC_CHANNEL_CALLBACK eventHandler, const uintptr_t contextHandle );
+
+bool XDMAC_ChannelTransfer( XDMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize );
+
+bool XDMAC_ChannelLinkedListTransfer( XDMAC_CHANNEL channel, uint32_t firstDescriptorAddress, XDMAC_DESCRIPTOR_CONTROL* firstDescriptorControl );
+
+bool XDMAC_ChannelIsBusy( XDMAC_CHANNEL channel );
+
+void XDMAC_ChannelDisable( XDMAC_CHANNEL channel );
+
+XDMAC_CHANNEL_CONFIG XDMAC_ChannelSettingsGet( XDMAC_CHANNEL channel );
+
+bool XDMAC_ChannelSettingsSet( XDMAC_CHANNEL channel, XDMAC_CHANNEL_CONFIG setting );
+
+void XDMAC_ChannelSuspend( XDMAC_CHANNEL channel );
+
+void XDMAC_ChannelResume( XDMAC_CHANNEL channel );
+
+void XDMAC_InterruptHandler( void );
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+}
+
+#endif
+
+// DOM-IGNORE-END
+#endif // PLIB_XDMAC_H
@@ -43,6 +43,12 @@ extern "C" {
 #define NO_INIT        __attribute__((section(".no_init")))
 #define SECTION(a)     __attribute__((__section__(a)))
 
+/* Placement in the tightly coupled memories: functions in ITCM and variables
+ * in DTCM. The drivers place their interrupt fast path with them when
+ * <DRIVER>_TCM is defined in the project macros. */
+#define TCM_CODE       __attribute__((tcm, noinline))
+#define TCM_DATA       __attribute__((tcm))
+
 #define CACHE_LINE_SIZE    (32u)
 #define CACHE_ALIGN        __ALIGNED(CACHE_LINE_SIZE)
 
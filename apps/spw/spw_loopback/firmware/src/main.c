@@ -49,6 +49,14 @@
 #include <stdlib.h>                     // Defines EXIT_FAILURE
 #include <string.h>                     // Defines memset
 #include "definitions.h"                // SYS function prototypes
+#include "app_dma_pool.h"
+#include "app_dma_copy.h"
+#include "app_prof.h"
+#include "app_timebase.h"
+#include "app_timer.h"
+#include "app_rx_flush.h"
+#include "app_spw_demux.h"
+#include "app_spw_traffic.h"
 
 /*----------------------------------------------------------------------------
  *        Types
@@ -71,6 +79,26 @@ typedef struct
     uint8_t full;
 } app_spw_rx_buffer_list_desc;
 
+/* Application receive buffer clear state
+
+   Summary:
+    State of the clear of the receive buffer at the tail of the list.
+
+   Description:
+    The buffer goes back to the receiver once its clear is done. An XDMAC
+    clear that failed is done again by the CPU.
+
+   Remarks:
+    None.
+*/
+typedef enum
+{
+    APP_RX_CLEAR_IDLE = 0,
+    APP_RX_CLEAR_BUSY,
+    APP_RX_CLEAR_DONE,
+    APP_RX_CLEAR_FAILED,
+} app_rx_clear_state_t;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Defines
@@ -98,32 +126,81 @@ typedef struct
 /* Number of Tx packets in transmitter list */
 #define APP_TX_NUM_PACKET               (APP_TX_PACKET_PER_SEND)
 
+/* Number of packet references of the Rx data queue, a power of two */
+#define APP_RX_DATA_QUEUE_SIZE          (128U)
+
+/* Size of DMA pool blocks for send lists, Tx data and Rx packet information lists */
+#define APP_DMA_POOL_LIST_SIZE_BYTES    (2048U)
+
+/* Number of DMA pool blocks for send lists, Tx data and Rx packet information lists */
+#define APP_DMA_POOL_LIST_NUM           (APP_RX_RECV_LIST + 4U)
+
+/* Define APP_DMA_CACHED to place the Tx data and the Rx buffers in cacheable
+   memory, maintained by cache line at each handover with the SPW DMA */
+
+/* Define APP_DMA_CACHE_BENCHMARK to compare at startup the reads of non cached
+   buffers with the reads of cached buffers after their invalidation */
+
+/* Define APP_DMA_COPY to clear the Rx buffers with the XDMAC copy service
+   instead of the CPU, which goes on with the main loop meanwhile */
+
+/* Define APP_PROF to profile the transfer with the sampling profiler, the
+   samples are printed at the end of the transfer */
+
+/* Smallest and largest buffer sizes of the cache benchmark in bytes */
+#define APP_DMA_CACHE_BENCHMARK_MIN     (32U)
+#define APP_DMA_CACHE_BENCHMARK_MAX     (8192U)
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Variables
 // *****************************************************************************
 // *****************************************************************************
 
-/* Tx buffer of data */
-static uint32_t __attribute__((aligned (32)))__attribute__((section (".ram_nocache"))) app_tx_data[APP_TX_NUM_PACKET][APP_DATA_SIZE_WORDS] = {0};
-
-/* Tx send list */
-static SPW_PKTTX_SEND_LIST_ENTRY __attribute__((aligned (32)))__attribute__((section (".ram_nocache"))) app_tx_packet_send_list[APP_TX_NUM_PACKET] = {0};
+/* DMA pool size classes */
+static const app_dma_pool_class_t app_dma_pool_classes[] =
+{
+    { APP_DMA_POOL_LIST_SIZE_BYTES, APP_DMA_POOL_LIST_NUM },
+#ifndef APP_DMA_CACHED
+    { APP_RX_PACKET_SIZE_BYTES, APP_RX_RECV_LIST },
+#endif
+};
+
+#ifdef APP_DMA_CACHED
+/* Tx data and Rx buffers in cacheable memory, each buffer owns its cache lines */
+static uint32_t app_tx_data_cached[APP_TX_NUM_PACKET][APP_DATA_SIZE_WORDS] __attribute__ ((aligned (APP_DMA_POOL_ALIGN)));
+static uint8_t app_rx_buffer_data_cached[APP_RX_RECV_LIST][APP_RX_PACKET_SIZE_BYTES] __attribute__ ((aligned (APP_DMA_POOL_ALIGN)));
+#endif
+
+#ifdef APP_DMA_CACHE_BENCHMARK
+/* Cache benchmark buffers, non cached and cacheable */
+static uint32_t app_bench_nocache[APP_DMA_CACHE_BENCHMARK_MAX / 4U] __attribute__ ((section (".ram_nocache"), aligned (APP_DMA_POOL_ALIGN)));
+static uint32_t app_bench_cached[APP_DMA_CACHE_BENCHMARK_MAX / 4U] __attribute__ ((aligned (APP_DMA_POOL_ALIGN)));
+#endif
+
+/* Tx buffer of data, allocated in DMA pool */
+static uint32_t (*app_tx_data)[APP_DATA_SIZE_WORDS] = NULL;
+
+/* Tx send list, allocated in DMA pool */
+static SPW_PKTTX_SEND_LIST_ENTRY* app_tx_packet_send_list = NULL;
 
 /* Store information if the TX sequence is ended */
 static bool app_tx_is_end = false;
 
-/* Counter time value at end of TX sequence */
-static uint32_t app_tx_time_elapsed = 0;
+/* Timebase value at start of TX sequence */
+static uint64_t app_tx_time_start = 0;
+
+/* Timebase ticks of the TX sequence */
+static uint64_t app_tx_time_elapsed = 0;
 
 /* Number of TX send sequences complete */
 static uint32_t app_tx_num_sent = 0;
 
-/* Rx buffer of data */
-static uint8_t __attribute__((aligned (32)))__attribute__((section (".ram_nocache"))) app_rx_buffer_data[APP_RX_RECV_LIST][APP_RX_PACKET_SIZE_BYTES] = {0};
+/* Rx buffers of data, allocated in DMA pool */
+static uint8_t* app_rx_buffer_data[APP_RX_RECV_LIST] = {NULL};
 
-/* Rx packet information list */
-static SPW_PKTRX_INFO __attribute__((aligned (32)))__attribute__((section (".ram_nocache"))) app_rx_packet_info[APP_RX_RECV_LIST][APP_RX_PACKET_NUM] = {0};
+/* Rx packet information lists, allocated in DMA pool */
+static SPW_PKTRX_INFO* app_rx_packet_info[APP_RX_RECV_LIST] = {NULL};
 
 /* Rx packet status */
 static SPW_PKTRX_PREV_STATUS app_rx_packet_status[APP_RX_RECV_LIST] = {0};
@@ -131,26 +208,30 @@ static SPW_PKTRX_PREV_STATUS app_rx_packet_status[APP_RX_RECV_LIST] = {0};
 /* Store the current state of receive buffer list */
 static volatile app_spw_rx_buffer_list_desc app_rx_buff_list = {0};
 
-/* Global variable to store if there is at least one packet in current receive buffer */
-static bool app_rx_packet_in_current = false;
-
 /* Store the current average of process time */
 static float app_rx_average_process_time = 0.0f;
 
 /* Store the number of values in the average of process time */
 static uint32_t app_rx_average_process_time_values = 0;
 
-/* Number of received packets */
-static uint32_t app_rx_num_packets = 0;
-
-/* Expected index for next received packet */
-static uint32_t app_rx_next_index_expected = 0;
-
 /* Store information if all expected packets have been received */
 static bool app_rx_is_all_data_received = false;
 
-/* Number of receive index sequence error */
-static uint32_t app_rx_seq_error = 0;
+/* Clear state of the Rx buffer at the tail of the list */
+static volatile app_rx_clear_state_t app_rx_clear_state = APP_RX_CLEAR_IDLE;
+
+/* Number of Rx buffers from the tail of the list pushed to the consumer
+   queues, they are cleared in order once their packets are released */
+static uint16_t app_rx_demux_count = 0U;
+
+/* Rx buffer after them is partly pushed, a full queue blocks it */
+static bool app_rx_demux_busy = false;
+
+/* Timebase value at start of each Rx buffer process */
+static uint64_t app_rx_process_start[APP_RX_RECV_LIST] = {0};
+
+/* Packet references of the Rx data queue */
+static app_spw_demux_ref_t app_rx_data_queue[APP_RX_DATA_QUEUE_SIZE];
 
 // *****************************************************************************
 // *****************************************************************************
@@ -261,6 +342,142 @@ static void APP_SPW_SetNextReceiveBuffer(uint16_t bufferId, SPW_PKTRX_NXTBUF_STA
         0);
 }
 
+/* static bool APP_AllocateBuffers(void)
+
+   Summary:
+    Allocate the SPW DMA buffers in the DMA pool.
+
+   Description:
+    This function initialize the DMA pool in the non cached memory and
+    allocate the TX data and send list and the RX buffers and packet
+    information lists. The pool blocks are zeroed by the pool initialization.
+    With APP_DMA_CACHED, the TX data and the RX buffers are the cacheable
+    buffers, cleaned so no dirty line is written back over the received data.
+
+   Remarks:
+    None.
+*/
+static bool APP_AllocateBuffers(void)
+{
+    if ( APP_DMA_POOL_init(app_dma_pool_classes, sizeof(app_dma_pool_classes) / sizeof(app_dma_pool_classes[0])) == false )
+    {
+        return false;
+    }
+
+#ifdef APP_DMA_CACHED
+    app_tx_data = app_tx_data_cached;
+    APP_DMA_POOL_cache_clean(app_rx_buffer_data_cached, sizeof(app_rx_buffer_data_cached));
+#else
+    app_tx_data = APP_DMA_POOL_alloc(sizeof(uint32_t) * APP_DATA_SIZE_WORDS * APP_TX_NUM_PACKET);
+#endif
+    app_tx_packet_send_list = APP_DMA_POOL_alloc(sizeof(SPW_PKTTX_SEND_LIST_ENTRY) * APP_TX_NUM_PACKET);
+    if ( (app_tx_data == NULL) || (app_tx_packet_send_list == NULL) )
+    {
+        return false;
+    }
+
+    for (uint32_t bufferId = 0U; bufferId < APP_RX_RECV_LIST; bufferId++)
+    {
+#ifdef APP_DMA_CACHED
+        app_rx_buffer_data[bufferId] = &(app_rx_buffer_data_cached[bufferId][0]);
+#else
+        app_rx_buffer_data[bufferId] = APP_DMA_POOL_alloc(APP_RX_PACKET_SIZE_BYTES);
+#endif
+        app_rx_packet_info[bufferId] = APP_DMA_POOL_alloc(sizeof(SPW_PKTRX_INFO) * APP_RX_PACKET_NUM);
+        if ( (app_rx_buffer_data[bufferId] == NULL) || (app_rx_packet_info[bufferId] == NULL) )
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+#ifdef APP_DMA_CACHE_BENCHMARK
+/* static uint32_t APP_DMA_CacheBenchmarkRead(const volatile uint32_t* buffer, uint32_t size, uint32_t* sum)
+
+   Summary:
+    Read a buffer as the RX data check does.
+
+   Description:
+    This function reads all the words of the buffer and returns the number
+    of CPU cycles spent.
+
+   Remarks:
+    None.
+*/
+static uint32_t APP_DMA_CacheBenchmarkRead(const volatile uint32_t* buffer, uint32_t size, uint32_t* sum)
+{
+    uint32_t start = DWT->CYCCNT;
+
+    for (uint32_t i = 0U; i < (size / 4U); i++)
+    {
+        *sum += buffer[i];
+    }
+
+    return DWT->CYCCNT - start;
+}
+
+/* static void APP_DMA_CacheBenchmark(void)
+
+   Summary:
+    Compare the non cached and the cached DMA buffer modes.
+
+   Description:
+    For each buffer size, this function measures the CPU cycles to read a
+    non cached buffer, and to invalidate a cached buffer and read it once
+    (first pass, lines filled from memory) and twice (second pass in cache).
+    A received buffer is read once when it is checked, so the cached mode is
+    faster only above the size where the invalidation and the line fills cost
+    less than the non cached reads, printed as the crossover.
+
+   Remarks:
+    None.
+*/
+static void APP_DMA_CacheBenchmark(void)
+{
+    uint32_t sum = 0U;
+    uint32_t crossover = 0U;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    APP_DMA_POOL_cache_clean(app_bench_cached, sizeof(app_bench_cached));
+
+    printf("Cache benchmark (CPU cycles): size, non cached, invalidate, first pass, second pass\r\n");
+    for (uint32_t size = APP_DMA_CACHE_BENCHMARK_MIN; size <= APP_DMA_CACHE_BENCHMARK_MAX; size *= 2U)
+    {
+        uint32_t nocache = APP_DMA_CacheBenchmarkRead(app_bench_nocache, size, &sum);
+
+        uint32_t start = DWT->CYCCNT;
+        APP_DMA_POOL_cache_invalidate(app_bench_cached, size);
+        uint32_t invalidate = DWT->CYCCNT - start;
+        uint32_t first = APP_DMA_CacheBenchmarkRead(app_bench_cached, size, &sum);
+        uint32_t second = APP_DMA_CacheBenchmarkRead(app_bench_cached, size, &sum);
+
+        printf("  %5u  %7u  %7u  %7u  %7u\r\n", (unsigned int)size, (unsigned int)nocache,
+               (unsigned int)invalidate, (unsigned int)first, (unsigned int)second);
+
+        if ( (crossover == 0U) && ((invalidate + first) < nocache) )
+        {
+            crossover = size;
+        }
+    }
+
+    if (crossover != 0U)
+    {
+        printf("Cached buffers read once are faster from %u bytes (checksum 0x%x)\r\n",
+               (unsigned int)crossover, (unsigned int)sum);
+    }
+    else
+    {
+        printf("Cached buffers read once are not faster up to %u bytes (checksum 0x%x)\r\n",
+               (unsigned int)APP_DMA_CACHE_BENCHMARK_MAX, (unsigned int)sum);
+    }
+}
+#endif
+
 /* static void APP_SPW_InitRx(void)
 
    Summary:
@@ -298,9 +515,6 @@ static void APP_SPW_InitRx(void)
     next_buffer = (app_rx_buff_list.head + 1U);
     APP_SPW_SetNextReceiveBuffer(next_buffer, SPW_PKTRX_NXTBUF_START_LATER);
 
-    /* Start timer for RX process time calculation */
-    TC0_CH2_TimerStart();
-
     /* Enable packet RX interrupts */
     SPW_PKTRX_InterruptEnable(SPW_PKTRX_INT_MASK_DEACT | SPW_PKTRX_INT_MASK_EOP);
 }
@@ -321,26 +535,11 @@ static void APP_SPW_InitTx(void)
 {
     app_tx_num_sent = 0U;
 
-    /* Build buffer of data to be transmitted */
+    /* Build buffer of data to be transmitted: sequence numbers and PRBS */
+    APP_SPW_TRAFFIC_init(APP_DATA_SIZE_WORDS);
     for (uint32_t pck = 0U; pck < APP_TX_PACKET_PER_SEND; pck++)
     {
-        for (uint32_t i = 0U; i < APP_DATA_SIZE_WORDS; i++)
-        {
-            if (i == 0U)
-            {
-                app_tx_data[pck][i] = (((i * 4U) + 3U) << 24U) + \
-                                      (((i * 4U) + 2U) << 16U) + \
-                                      (((i * 4U) + 1U) << 8U)  + \
-                                      pck;
-            }
-            else
-            {
-                app_tx_data[pck][i] = (((i * 4U) + 3U) << 24U) + \
-                                      (((i * 4U) + 2U) << 16U) + \
-                                      (((i * 4U) + 1U) << 8U)  + \
-                                      (i * 4U);
-            }
-        }
+        (void)APP_SPW_TRAFFIC_generate(&app_tx_data[pck][0]);
 
         // Prepare send list
         memset( &app_tx_packet_send_list[pck], 0, sizeof(SPW_PKTTX_SEND_LIST_ENTRY));
@@ -355,8 +554,13 @@ static void APP_SPW_InitTx(void)
         app_tx_packet_send_list[pck].DAddr = (unsigned int) &(app_tx_data[pck][0]);
     }
 
-    /* Start timer for TX time calculation */
-    TC0_CH1_TimerStart();
+#ifdef APP_DMA_CACHED
+    /* Write the TX data to memory before the DMA reads it */
+    APP_DMA_POOL_cache_clean(app_tx_data, sizeof(uint32_t) * APP_DATA_SIZE_WORDS * APP_TX_NUM_PACKET);
+#endif
+
+    /* Get timebase start value for TX time calculation */
+    app_tx_time_start = APP_TIMEBASE_get();
     app_tx_is_end = false;
 
     /* Enable packet RX interrupts */
@@ -366,81 +570,236 @@ static void APP_SPW_InitTx(void)
     APP_SPW_StartSendList();
 }
 
-/* static void APP_SPW_CheckData(uint32_t buffer_id)
+/* static bool APP_SPW_CheckPacket(const app_spw_demux_ref_t* ref, uintptr_t context)
 
    Summary:
-    Check the content of the received data buffer.
+    Check the content of a received data packet.
 
    Description:
-    This function check the status and the content of the received buffer.
-    It check the number of packets and the correct index order of received packets.
+    This function is the handler of the Rx data queue. It verifies the
+    sequence number and every byte of the received packets with the traffic
+    verifier, a packet split by the receiver comes reassembled.
 
    Parameters:
-    bufferId - the ID of the receive buffer to check.
+    ref - the received packet.
+    context - not used.
+
+   Returns:
+    True, the packet is released on return.
 
    Remarks:
     None.
 */
-static int8_t APP_SPW_CheckData(uint32_t buffer_id)
+static bool APP_SPW_CheckPacket(const app_spw_demux_ref_t* ref, uintptr_t context)
 {
-    int8_t res = 0;
-    uint16_t packet, num_packet = 0U;
+    app_spw_traffic_stats_t stats;
+
+    (void)context;
+
+    if (ref->data != NULL)
+    {
+        APP_SPW_TRAFFIC_verify(ref->data, ref->size);
+    }
+    else
+    {
+        // Gather the fragments, one more word shows a too long packet
+        uint32_t packet[APP_DATA_SIZE_WORDS + 1U];
+        uint32_t size = APP_SPW_DEMUX_gather(ref, 0U, (uint8_t*)packet, sizeof(packet));
+        APP_SPW_TRAFFIC_verify((const uint8_t*)packet, size);
+    }
+
+    APP_SPW_TRAFFIC_get_stats(&stats);
+    if ((stats.packets + stats.lost) >= (APP_TX_NUM_SEND * APP_TX_PACKET_PER_SEND))
+    {
+        app_rx_is_all_data_received = true;
+    }
+
+    return true;
+}
+
+/* static bool APP_SPW_DemuxRxBuffer(uint32_t buffer_id)
+
+   Summary:
+    Push the received packets of a buffer to their consumer queues.
+
+   Description:
+    This function checks the status of the received buffer and passes its
+    packets to the demultiplexer, which reassembles the split packets and
+    queues references to them without copy. The buffer must not be cleared
+    before all its packets are released, a packet split at its end is
+    released once the next buffer completes it.
+
+   Parameters:
+    bufferId - the ID of the receive buffer.
+
+   Returns:
+    False if a full queue blocks the buffer, the function is called again.
+
+   Remarks:
+    None.
+*/
+static bool APP_SPW_DemuxRxBuffer(uint32_t buffer_id)
+{
+    uint16_t num_packet = 0U;
     SPW_PKTRX_PREV_STATUS status = app_rx_packet_status[buffer_id];
 
     // If status lock : previous status is updated
-    if ( (status & SPW_PKTRX_PREV_STATUS_LOCKED) != 0U )
+    if ( (status & SPW_PKTRX_PREV_STATUS_LOCKED) == 0U )
     {
-        // Get number of received messages
-        num_packet = SPW_PKTRX_PREV_STATUS_GET_COUNT(status);
-        if (num_packet > 0U)
+        printf("ERROR: No lock in status : 0x%x\r\n", (unsigned int)status);
+        return true;
+    }
+
+    // Get number of received messages
+    num_packet = SPW_PKTRX_PREV_STATUS_GET_COUNT(status);
+    if (num_packet == 0U)
+    {
+        return true;
+    }
+
+#ifdef APP_DMA_CACHED
+    // Discard the cache lines of the buffer up to the end of the last packet,
+    // once before its first packet is pushed
+    if (app_rx_demux_busy == false)
+    {
+        uint32_t rx_size = (app_rx_packet_info[buffer_id][num_packet - 1U].DAddr +
+                            app_rx_packet_info[buffer_id][num_packet - 1U].DSize) -
+                           (uint32_t)app_rx_buffer_data[buffer_id];
+        if (rx_size > APP_RX_PACKET_SIZE_BYTES)
         {
-            for (packet = 0U; packet < num_packet; packet++)
-            {
-                // Check received packet is not split
-                if ( (app_rx_packet_info[buffer_id][packet].Split) != 0U )
-                {
-                    printf("INFO : Packet %u split\r\n", (unsigned int) packet);
-                    res = -1;
-                }
+            rx_size = APP_RX_PACKET_SIZE_BYTES;
+        }
+        APP_DMA_POOL_cache_invalidate(app_rx_buffer_data[buffer_id], rx_size);
+    }
+#endif
 
-                uint8_t* packet_buffer = (uint8_t*)(app_rx_packet_info[buffer_id][packet].DAddr);
-                app_rx_num_packets++;
+    return APP_SPW_DEMUX_buffer((uint16_t)buffer_id, app_rx_packet_info[buffer_id], num_packet);
+}
 
-                if (packet_buffer[0] != app_rx_next_index_expected)
-                {
-                    if (packet_buffer[0] > app_rx_next_index_expected)
-                    {
-                        app_rx_seq_error += (packet_buffer[0] - app_rx_next_index_expected);
-                    }
-                    else
-                    {
-                        app_rx_seq_error += (app_rx_next_index_expected - packet_buffer[0]);
-                    }
-                    app_rx_next_index_expected = ((uint32_t)packet_buffer[0] + 1U);
-                }
-                else
-                {
-                    app_rx_next_index_expected++;
-                }
+#ifdef APP_DMA_COPY
+/* static void APP_SPW_ClearRxBufferCallback(bool success, uintptr_t context)
 
-                if (app_rx_next_index_expected > 0xFFU)
-                {
-                    app_rx_next_index_expected = 0U;
-                }
+  Summary:
+    Function called by the DMA copy service.
 
-                if ((app_rx_num_packets + app_rx_seq_error) >= (APP_TX_NUM_SEND * APP_TX_PACKET_PER_SEND))
-                {
-                    app_rx_is_all_data_received = true;
-                }
-            }
+  Description:
+    This function is called from the XDMAC interrupt at the end of the clear
+    of the Rx buffer.
+
+  Remarks:
+    None.
+*/
+static void APP_SPW_ClearRxBufferCallback(bool success, uintptr_t context)
+{
+    (void)context;
+    app_rx_clear_state = (success == true) ? APP_RX_CLEAR_DONE : APP_RX_CLEAR_FAILED;
+}
+#endif
+
+/* static void APP_SPW_ClearRxBuffer(uint16_t buffer_id, bool cpu)
+
+  Summary:
+    Clear a received data buffer and its packet information list.
+
+  Description:
+    With APP_DMA_COPY, the clear is queued to the XDMAC and
+    app_rx_clear_state becomes APP_RX_CLEAR_DONE at its end, unless cpu is
+    true or the queue is full. Otherwise the CPU clears the buffer.
+
+  Parameters:
+    buffer_id - the ID of the receive buffer to clear.
+    cpu - clear with the CPU.
+
+  Remarks:
+    None.
+*/
+static void APP_SPW_ClearRxBuffer(uint16_t buffer_id, bool cpu)
+{
+#ifdef APP_DMA_COPY
+    if (cpu == false)
+    {
+        bool queued = true;
+
+        app_rx_clear_state = APP_RX_CLEAR_BUSY;
+#ifndef APP_DMA_CACHED
+        queued = APP_DMA_COPY_memset(&(app_rx_buffer_data[buffer_id][0]), 0U, APP_RX_PACKET_SIZE_BYTES, NULL, 0U);
+#endif
+        if (queued)
+        {
+            /* Requests run in order, the end of the last one ends the clear */
+            queued = APP_DMA_COPY_memset(&(app_rx_packet_info[buffer_id][0]), 0U, sizeof(SPW_PKTRX_INFO) * APP_RX_PACKET_NUM,
+                                         APP_SPW_ClearRxBufferCallback, 0U);
+        }
+        if (queued)
+        {
+            return;
+        }
+
+        /* Queue full: let the queued requests end and clear with the CPU */
+        while (APP_DMA_COPY_is_idle() == false)
+        {
+            /* Wait the end of the queued requests */
         }
     }
-    else
+#else
+    (void)cpu;
+#endif
+
+#ifndef APP_DMA_CACHED
+    // A cached buffer is not written by the CPU, its dirty lines would overwrite the next received data
+    memset(&(app_rx_buffer_data[buffer_id][0]), 0, APP_RX_PACKET_SIZE_BYTES);
+#endif
+    memset(&(app_rx_packet_info[buffer_id][0]), 0, sizeof(SPW_PKTRX_INFO) * APP_RX_PACKET_NUM);
+    app_rx_clear_state = APP_RX_CLEAR_DONE;
+}
+
+/* static void APP_SPW_ReleaseRxBuffer(void)
+
+  Summary:
+    Give the cleared buffer at the tail of the receive list back.
+
+  Description:
+    This function moves the tail of the receive list. When the list was
+    full, the next receive buffer is set.
+
+  Remarks:
+    None.
+*/
+static void APP_SPW_ReleaseRxBuffer(void)
+{
+    // Snapshot the list state, the completed buffer is the one at head before increment
+    app_spw_rx_buffer_list_desc rx_buff_list = app_rx_buff_list;
+    uint16_t prev_head = rx_buff_list.head;
+
+    app_rx_buff_list.tail = (app_rx_buff_list.tail + 1U) % APP_RX_RECV_LIST;
+
+    // Set next buffer if none was set on last interrupt
+    if (rx_buff_list.full != 0U)
     {
-        printf("ERROR: No lock in status : 0x%x\r\n", (unsigned int)status);
-    }
+        app_rx_buff_list.full = 0U;
+        // Increment head
+        app_rx_buff_list.head = ((prev_head + 1U) % APP_RX_RECV_LIST);
+        // Set nex buffer
+        uint16_t next_buffer = ((app_rx_buff_list.head + 1U) % APP_RX_RECV_LIST);
 
-    return res;
+        if ( APP_RX_RECV_LIST > 2U)
+        {
+            APP_SPW_SetNextReceiveBuffer(next_buffer, SPW_PKTRX_NXTBUF_START_LATER);
+            // Get Status to unlock previous buffer
+            app_rx_packet_status[prev_head] = SPW_PKTRX_GetPreviousBufferStatus();
+        }
+        else
+        {
+            SPW_PKTRX_NXTBUF_START next_start_condition = SPW_PKTRX_NXTBUF_START_LATER;
+            SPW_PKTRX_STATUS rx_status = SPW_PKTRX_StatusGet();
+            if ( (rx_status & SPW_PKTRX_STATUS_LOCKED) != 0U )
+            {
+                app_rx_buff_list.full = 1U;
+                next_start_condition = SPW_PKTRX_NXTBUF_START_NOW;
+            }
+            APP_SPW_SetNextReceiveBuffer(next_buffer, next_start_condition);
+        }
+    }
 }
 
 /* static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
@@ -454,7 +813,7 @@ static int8_t APP_SPW_CheckData(uint32_t buffer_id)
   Remarks:
     None.
 */
-static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
+static SPW_TCM_CODE void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
 {
     if ( (irqStatus & SPW_INT_MASK_PKTTX1) != 0U )
     {
@@ -462,14 +821,16 @@ static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
 
         if ( (status & SPW_PKTTX_INT_MASK_DEACT) != 0U )
         {
-            // List deactivate, update pack index and reload list
+            // List deactivate, generate the next packets and reload list
             if ((++app_tx_num_sent) < APP_TX_NUM_SEND)
             {
                 for (uint32_t pck = 0UL; pck < APP_TX_PACKET_PER_SEND; pck++)
                 {
-                    uint8_t* tx_buff = (uint8_t*) (&app_tx_data[pck][0]);
-                    tx_buff[0] = (uint8_t)(((APP_TX_PACKET_PER_SEND * app_tx_num_sent) + pck) & 0xFFU);
+                    (void)APP_SPW_TRAFFIC_generate(&app_tx_data[pck][0]);
                 }
+#ifdef APP_DMA_CACHED
+                APP_DMA_POOL_cache_clean(app_tx_data, sizeof(uint32_t) * APP_DATA_SIZE_WORDS * APP_TX_NUM_PACKET);
+#endif
 
                 // Unlock previous buffer status
                 SPW_PKTTX_UnlockStatus();
@@ -480,9 +841,8 @@ static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
             {
                 /* End of send */
                 app_tx_is_end = true;
-                /* Stop send timer for TX time calculation */
-                app_tx_time_elapsed = TC0_CH1_TimerCounterGet();
-                TC0_CH1_TimerStop();
+                /* Compute timebase ticks for TX time calculation */
+                app_tx_time_elapsed = APP_TIMEBASE_get() - app_tx_time_start;
             }
         }
     }
@@ -493,25 +853,16 @@ static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
 
         if ( (status & SPW_PKTRX_INT_MASK_EOP) != 0U )
         {
-            if (!app_rx_packet_in_current)
-            {
-                app_rx_packet_in_current = true;
-
-                /* Start timer for Rx flush if number of received packet is less
-                 than number of packets in active list */
-                TC0_CH0_TimerStart();
-            }
+            /* Each packet moves the Rx flush deadline, from the measured
+               packet gap and bounded by the latency from the first packet */
+            APP_RX_FLUSH_packet();
         }
 
         if ( (status & SPW_PKTRX_INT_MASK_DEACT) != 0U )
         {
-            if (app_rx_packet_in_current)
-            {
-                /* Stop Rx flush Timer */
-                TC0_CH0_TimerStop();
+            /* Stop Rx flush */
+            APP_RX_FLUSH_buffer_end();
 
-                app_rx_packet_in_current = false;
-            }
             uint16_t next_buffer = ((app_rx_buff_list.head + 2U) % APP_RX_RECV_LIST);
             if (next_buffer == app_rx_buff_list.tail)
             {
@@ -548,59 +899,6 @@ static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
     }
 }
 
-/* static void TC0_CH0_Callback(TC_TIMER_STATUS status, uintptr_t context)
-
-  Summary:
-    Function called by TC PLIB.
-
-  Description:
-    This function will be called by TC PLIB when interrupt has occurred for
-    channel 0.
-
-  Remarks:
-    None.
-*/
-static void TC0_CH0_Callback(TC_TIMER_STATUS status, uintptr_t context)
-{
-    /* Packets were receive but didn't reach the count of current buffer number
-       of packets : Deactivate current buffer (Abort with split) */
-    SPW_PKTRX_CurrentPacketSplit();
-}
-
-/* static void TC0_CH1_Callback(TC_TIMER_STATUS status, uintptr_t context)
-
-  Summary:
-    Function called by TC PLIB.
-
-  Description:
-    This function will be called by TC PLIB when interrupt has occurred for
-    channel 1.
-
-  Remarks:
-    None.
-*/
-static void TC0_CH1_Callback(TC_TIMER_STATUS status, uintptr_t context)
-{
-    printf("ERROR : Timer should not trigger interrupt during test.\r\n");
-}
-
-/* static void TC0_CH2_Callback(TC_TIMER_STATUS status, uintptr_t context)
-
-  Summary:
-    Function called by TC PLIB.
-
-  Description:
-    This function will be called by TC PLIB when interrupt has occurred for
-    channel 2.
-
-  Remarks:
-    None.
-*/
-static void TC0_CH2_Callback(TC_TIMER_STATUS status, uintptr_t context)
-{
-    printf("ERROR : Timer should not trigger interrupt during test.\r\n");
-}
-
 // *****************************************************************************
 // *****************************************************************************
 // Section: Main Entry Point
@@ -618,13 +916,30 @@ int main ( void )
     printf("\n\r  SPW loopback example                                     ");
     printf("\n\r-----------------------------------------------------------\n\r");
 
+    /* Start the timebase and check it against TC0 channel 0 over half of its
+       period */
+    APP_TIMEBASE_init();
+    TC0_CH0_TimerStart();
+    if (!APP_TIMEBASE_calibrate(TC0_CH0_TimerCounterGet, TC0_CH0_TimerFrequencyGet(), TC0_CH0_TimerPeriodGet() / 2U))
+    {
+        printf("WARNING: timebase calibration mismatch, using %u Hz\r\n", (unsigned int)APP_TIMEBASE_frequency_get());
+    }
+    TC0_CH0_TimerStop();
+
     /* Add SPW interrupt callback */
     SPW_CallbackRegister(APP_SPW_Callback, (uintptr_t)NULL);
 
-    /* Register callback function for timer counters interrupt */
-    TC0_CH0_TimerCallbackRegister(TC0_CH0_Callback, (uintptr_t)NULL);
-    TC0_CH1_TimerCallbackRegister(TC0_CH1_Callback, (uintptr_t)NULL);
-    TC0_CH2_TimerCallbackRegister(TC0_CH2_Callback, (uintptr_t)NULL);
+    /* Start the software timers and the Rx flush */
+    APP_TIMER_init();
+    APP_RX_FLUSH_init(APP_RX_FLUSH_MIN_US, APP_RX_FLUSH_MAX_US);
+
+    /* Route all the received packets to the data queue. The second byte of
+       the loopback data is a byte of its sequence number, which takes the
+       value of any protocol identifier, so no protocol identifier route is
+       added here */
+    APP_SPW_DEMUX_init();
+    APP_SPW_DEMUX_route_default(APP_SPW_DEMUX_queue_create(app_rx_data_queue, APP_RX_DATA_QUEUE_SIZE, 1U,
+                                                           APP_SPW_DEMUX_POLICY_BLOCK, APP_SPW_CheckPacket, (uintptr_t)NULL));
 
     /* Enable SPW Link interrupts */
     SPW_LINK_InterruptEnable(SPW_LINK_1 , SPW_LINK_INT_MASK_DISERR |
@@ -659,6 +974,31 @@ int main ( void )
 
     printf("SPW Link in Run state\r\n");
 
+    /* Allocate DMA buffers */
+    if ( APP_AllocateBuffers() == false )
+    {
+        printf("ERROR : DMA pool allocation failed.\r\n");
+        APP_DMA_POOL_print_stats();
+        while (true)
+        {
+            /* Configuration error */
+        }
+    }
+    APP_DMA_POOL_print_stats();
+
+#ifdef APP_DMA_COPY
+    APP_DMA_COPY_init();
+#endif
+
+#ifdef APP_DMA_CACHE_BENCHMARK
+    APP_DMA_CacheBenchmark();
+#endif
+
+#ifdef APP_PROF
+    APP_PROF_reset();
+    APP_PROF_start(APP_PROF_RATE_HZ);
+#endif
+
     /* Prepare RX packet reception */
     APP_SPW_InitRx();
 
@@ -667,24 +1007,44 @@ int main ( void )
 
     while (true)
     {
+        /* Run the deferred timer callbacks */
+        APP_TIMER_task();
+
         app_spw_rx_buffer_list_desc rx_buff_list = app_rx_buff_list;
-        if ((rx_buff_list.tail != rx_buff_list.head) || (rx_buff_list.full != 0U))
+        uint16_t rx_filled = ((rx_buff_list.head + APP_RX_RECV_LIST - rx_buff_list.tail) % APP_RX_RECV_LIST) + rx_buff_list.full;
+        if (app_rx_demux_count < rx_filled)
         {
-            // If number of list buffer is 2, first unlock previous buffer
-            if ( APP_RX_RECV_LIST == 2U)
+            uint16_t rx_buffer = (rx_buff_list.tail + app_rx_demux_count) % APP_RX_RECV_LIST;
+
+            if (app_rx_demux_busy == false)
+            {
+                // If number of list buffer is 2, first unlock previous buffer
+                if ( APP_RX_RECV_LIST == 2U)
+                {
+                    app_rx_packet_status[rx_buff_list.head] = SPW_PKTRX_GetPreviousBufferStatus();
+                }
+
+                /* Get timebase start value for RX process time calculation */
+                app_rx_process_start[rx_buffer] = APP_TIMEBASE_get();
+            }
+
+            /* Push the packets of the received buffer to their queues */
+            app_rx_demux_busy = !APP_SPW_DemuxRxBuffer(rx_buffer);
+            if (app_rx_demux_busy == false)
             {
-                app_rx_packet_status[rx_buff_list.head] = SPW_PKTRX_GetPreviousBufferStatus();
+                app_rx_demux_count++;
             }
+        }
 
-            /* Get timer start value for RX process time calculation */
-            uint32_t start_process = TC0_CH2_TimerCounterGet();
+        /* Pass the queued packets to their consumers, by priority */
+        APP_SPW_DEMUX_task(APP_RX_PACKET_NUM);
 
-            /* Treat received buffer to check status and received data */
-            APP_SPW_CheckData(rx_buff_list.tail);
+        if ( (app_rx_clear_state == APP_RX_CLEAR_IDLE) && (app_rx_demux_count > 0U) &&
+             (APP_SPW_DEMUX_buffer_refs(rx_buff_list.tail) == 0U) )
+        {
+            /* Compute timebase ticks for RX process time calculation */
+            uint64_t elapsed_time = APP_TIMEBASE_get() - app_rx_process_start[rx_buff_list.tail];
 
-            /* Compute timer time for RX process time calculation */
-            uint32_t elapsed_time = TC0_CH2_TimerCounterGet() - start_process;
-            
             if (app_rx_average_process_time_values == 0U)
             {
                 app_rx_average_process_time = (float)elapsed_time;
@@ -698,47 +1058,28 @@ int main ( void )
 
             // Clear buffer
             app_rx_packet_status[rx_buff_list.tail] = 0U;
-            memset(&(app_rx_buffer_data[rx_buff_list.tail][0]), 0, APP_RX_PACKET_SIZE_BYTES);
-            memset(&(app_rx_packet_info[rx_buff_list.tail][0]), 0, sizeof(SPW_PKTRX_INFO) * APP_RX_PACKET_NUM);
-
-            app_rx_buff_list.tail = (app_rx_buff_list.tail + 1U) % APP_RX_RECV_LIST;
+            APP_SPW_ClearRxBuffer(rx_buff_list.tail, false);
+        }
 
-            // Set next buffer if none was set on last interrupt
-            if (rx_buff_list.full != 0U)
-            {
-                app_rx_buff_list.full = 0U;
-                // Increment head
-                app_rx_buff_list.head = ((app_rx_buff_list.head + 1U) % APP_RX_RECV_LIST);
-                // Set nex buffer
-                uint16_t next_buffer = ((app_rx_buff_list.head + 1U) % APP_RX_RECV_LIST);
+        if (app_rx_clear_state == APP_RX_CLEAR_FAILED)
+        {
+            printf("ERROR: XDMAC clear of Rx buffer %u failed\r\n", (unsigned int)app_rx_buff_list.tail);
+            APP_SPW_ClearRxBuffer(app_rx_buff_list.tail, true);
+        }
 
-                if ( APP_RX_RECV_LIST > 2U)
-                {
-                    APP_SPW_SetNextReceiveBuffer(next_buffer, SPW_PKTRX_NXTBUF_START_LATER);
-                    // Get Status to unlock previous buffer
-                    app_rx_packet_status[rx_buff_list.head] = SPW_PKTRX_GetPreviousBufferStatus();
-                }
-                else
-                {
-                    SPW_PKTRX_NXTBUF_START next_start_condition = SPW_PKTRX_NXTBUF_START_LATER;
-                    SPW_PKTRX_STATUS rx_status = SPW_PKTRX_StatusGet();
-                    if ( (rx_status & SPW_PKTRX_STATUS_LOCKED) != 0U )
-                    {
-                        app_rx_buff_list.full = 1U;
-                        next_start_condition = SPW_PKTRX_NXTBUF_START_NOW;
-                    }
-                    APP_SPW_SetNextReceiveBuffer(next_buffer, next_start_condition);
-                }
-            }
+        if (app_rx_clear_state == APP_RX_CLEAR_DONE)
+        {
+            app_rx_clear_state = APP_RX_CLEAR_IDLE;
+            app_rx_demux_count--;
+            APP_SPW_ReleaseRxBuffer();
         }
 
         if (app_rx_is_all_data_received)
         {
-            rx_time_us = ((float) app_rx_average_process_time / (float)(TC0_CH2_TimerFrequencyGet() / (float)1000000.0f));
+            rx_time_us = ((float) app_rx_average_process_time / (float)(APP_TIMEBASE_frequency_get() / (float)1000000.0f));
             if (rx_time_us > 0.0f)
             {
                 printf("Average RX process time = %lu us\r\n", (unsigned long) rx_time_us);
-                printf("Rx sequence errors = %u\r\n", (unsigned int)app_rx_seq_error); 
             }
             else
             {
@@ -746,19 +1087,22 @@ int main ( void )
             }
 
             app_rx_is_all_data_received = false;
-            app_rx_seq_error = 0U;
-            app_rx_next_index_expected = 0U;
-            app_rx_num_packets = 0U;
             printf("End of transfer\r\n");
-            TC0_CH0_TimerStop();
-            TC0_CH1_TimerStop();
-            TC0_CH2_TimerStop();
+            APP_SPW_TRAFFIC_print_stats();
+            APP_RX_FLUSH_print_stats();
+            APP_SPW_DEMUX_print_stats();
+#ifdef APP_DMA_COPY
+            APP_DMA_COPY_print_stats();
+#endif
+#ifdef APP_PROF
+            APP_PROF_dump();
+#endif
         }
 
         if (app_tx_is_end)
         {
             app_tx_is_end = false;
-            tx_time_us = ((float) app_tx_time_elapsed / (float)(TC0_CH1_TimerFrequencyGet() / (float)1000000.0f));
+            tx_time_us = ((float) APP_TIMEBASE_ticks_to_ns(app_tx_time_elapsed) / 1000.0f);
             uint32_t bytes = APP_TX_NUM_SEND * APP_TX_NUM_PACKET * APP_DATA_SIZE_WORDS * 4U;
             printf("TX time=%lu us, for %u bytes\r\n", (unsigned long) tx_time_us, (unsigned int)bytes);
             float rate = ((float) bytes * 8.0f) / (float) tx_time_us;
@@ -0,0 +1,527 @@
+/*******************************************************************************
+  MPLAB Harmony Application CRC Source File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_crc.c
+
+  Summary:
+    CRC-8 of RMAP and CRC-16 of CCSDS.
+
+  Description:
+    The slice-by-N variants look up N bytes per step in N tables, the table
+    k giving the CRC of a byte followed by k zero bytes. The lookups of a
+    step are independent, so they overlap in the pipeline where the table
+    variant waits for each lookup before the next one. The tables are
+    computed at initialization from the bitwise variant.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include "app_crc.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local definitions
+// *****************************************************************************
+// *****************************************************************************
+/* RMAP CRC-8 polynomial, bit reversed for the least significant bit first
+   processing */
+#define APP_CRC8_POLY_REVERSED          (0xE0U)
+
+/* CRC-16-CCITT polynomial */
+#define APP_CRC16_POLY                  (0x1021U)
+
+/* Number of slice tables */
+#define APP_CRC_SLICE_MAX               (8U)
+
+/* Runs of each variant in the benchmark, the shortest one is kept */
+#define APP_CRC_BENCH_RUNS              (4U)
+
+typedef uint8_t (*APP_CRC8_FUNC)(uint8_t crc, const uint8_t* data, size_t size);
+typedef uint16_t (*APP_CRC16_FUNC)(uint16_t crc, const uint8_t* data, size_t size);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Globals
+// *****************************************************************************
+// *****************************************************************************
+/* Slice tables: table k gives the CRC of a byte followed by k zero bytes */
+static uint8_t crc8Table[APP_CRC_SLICE_MAX][256];
+static uint16_t crc16Table[APP_CRC_SLICE_MAX][256];
+
+/* Variants used by APP_CRC8_update and APP_CRC16_update */
+static APP_CRC8_FUNC crc8Update = NULL;
+static APP_CRC16_FUNC crc16Update = NULL;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    static uint8_t APP_CRC8_bitwise(uint8_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    RMAP CRC-8, one bit per step.
+*/
+static uint8_t APP_CRC8_bitwise(uint8_t crc, const uint8_t* data, size_t size)
+{
+    while ( size-- != 0U )
+    {
+        uint32_t bit;
+
+        crc ^= *data++;
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = (uint8_t)((crc >> 1) ^ ((0U - (crc & 1U)) & APP_CRC8_POLY_REVERSED));
+        }
+    }
+    return crc;
+}
+
+// *****************************************************************************
+/* Function:
+    static uint8_t APP_CRC8_table(uint8_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    RMAP CRC-8, one byte per step.
+*/
+static uint8_t APP_CRC8_table(uint8_t crc, const uint8_t* data, size_t size)
+{
+    while ( size-- != 0U )
+    {
+        crc = crc8Table[0][crc ^ *data++];
+    }
+    return crc;
+}
+
+// *****************************************************************************
+/* Function:
+    static uint8_t APP_CRC8_slice4(uint8_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    RMAP CRC-8, four bytes per step.
+
+   Description:
+    The CRC only changes the first byte of a slice, each byte of the slice
+    is then looked up independently with the table of its distance to the
+    end of the slice.
+*/
+static uint8_t APP_CRC8_slice4(uint8_t crc, const uint8_t* data, size_t size)
+{
+    while ( size >= 4U )
+    {
+        crc = crc8Table[3][crc ^ data[0]] ^ crc8Table[2][data[1]] ^
+              crc8Table[1][data[2]] ^ crc8Table[0][data[3]];
+        data += 4;
+        size -= 4U;
+    }
+    return APP_CRC8_table(crc, data, size);
+}
+
+// *****************************************************************************
+/* Function:
+    static uint8_t APP_CRC8_slice8(uint8_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    RMAP CRC-8, eight bytes per step.
+*/
+static uint8_t APP_CRC8_slice8(uint8_t crc, const uint8_t* data, size_t size)
+{
+    while ( size >= 8U )
+    {
+        crc = crc8Table[7][crc ^ data[0]] ^ crc8Table[6][data[1]] ^
+              crc8Table[5][data[2]] ^ crc8Table[4][data[3]] ^
+              crc8Table[3][data[4]] ^ crc8Table[2][data[5]] ^
+              crc8Table[1][data[6]] ^ crc8Table[0][data[7]];
+        data += 8;
+        size -= 8U;
+    }
+    return APP_CRC8_table(crc, data, size);
+}
+
+// *****************************************************************************
+/* Function:
+    static uint16_t APP_CRC16_bitwise(uint16_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    CRC-16-CCITT, one bit per step.
+*/
+static uint16_t APP_CRC16_bitwise(uint16_t crc, const uint8_t* data, size_t size)
+{
+    while ( size-- != 0U )
+    {
+        uint32_t bit;
+
+        crc ^= (uint16_t)((uint16_t)*data++ << 8);
+        for (bit = 0U; bit < 8U; bit++)
+        {
+            crc = (uint16_t)((crc << 1) ^ ((0U - (uint32_t)(crc >> 15)) & APP_CRC16_POLY));
+        }
+    }
+    return crc;
+}
+
+// *****************************************************************************
+/* Function:
+    static uint16_t APP_CRC16_table(uint16_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    CRC-16-CCITT, one byte per step.
+*/
+static uint16_t APP_CRC16_table(uint16_t crc, const uint8_t* data, size_t size)
+{
+    while ( size-- != 0U )
+    {
+        crc = (uint16_t)(crc << 8) ^ crc16Table[0][(crc >> 8) ^ *data++];
+    }
+    return crc;
+}
+
+// *****************************************************************************
+/* Function:
+    static uint16_t APP_CRC16_slice4(uint16_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    CRC-16-CCITT, four bytes per step.
+
+   Description:
+    The CRC changes the first two bytes of a slice.
+*/
+static uint16_t APP_CRC16_slice4(uint16_t crc, const uint8_t* data, size_t size)
+{
+    while ( size >= 4U )
+    {
+        crc ^= (uint16_t)(((uint16_t)data[0] << 8) | data[1]);
+        crc = crc16Table[3][crc >> 8] ^ crc16Table[2][crc & 0xFFU] ^
+              crc16Table[1][data[2]] ^ crc16Table[0][data[3]];
+        data += 4;
+        size -= 4U;
+    }
+    return APP_CRC16_table(crc, data, size);
+}
+
+// *****************************************************************************
+/* Function:
+    static uint16_t APP_CRC16_slice8(uint16_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    CRC-16-CCITT, eight bytes per step.
+*/
+static uint16_t APP_CRC16_slice8(uint16_t crc, const uint8_t* data, size_t size)
+{
+    while ( size >= 8U )
+    {
+        crc ^= (uint16_t)(((uint16_t)data[0] << 8) | data[1]);
+        crc = crc16Table[7][crc >> 8] ^ crc16Table[6][crc & 0xFFU] ^
+              crc16Table[5][data[2]] ^ crc16Table[4][data[3]] ^
+              crc16Table[3][data[4]] ^ crc16Table[2][data[5]] ^
+              crc16Table[1][data[6]] ^ crc16Table[0][data[7]];
+        data += 8;
+        size -= 8U;
+    }
+    return APP_CRC16_table(crc, data, size);
+}
+
+static const APP_CRC8_FUNC crc8Variants[APP_CRC_VARIANT_NUM] =
+{
+    APP_CRC8_bitwise,
+    APP_CRC8_table,
+    APP_CRC8_slice4,
+    APP_CRC8_slice8,
+};
+
+static const APP_CRC16_FUNC crc16Variants[APP_CRC_VARIANT_NUM] =
+{
+    APP_CRC16_bitwise,
+    APP_CRC16_table,
+    APP_CRC16_slice4,
+    APP_CRC16_slice8,
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    void APP_CRC_init(void)
+
+   Summary:
+    Compute the tables and select the table variants.
+
+   Description:
+    The tables are computed in RAM, 6 KB, rather than read from constant
+    data, so they can be placed in the TCM with the RAM variables.
+
+   Parameters:
+    None.
+
+   Returns:
+    None.
+*/
+void APP_CRC_init(void)
+{
+    uint32_t index;
+    uint32_t slice;
+
+    for (index = 0U; index < 256U; index++)
+    {
+        uint8_t byte = (uint8_t)index;
+
+        crc8Table[0][index] = APP_CRC8_bitwise(0U, &byte, 1U);
+        crc16Table[0][index] = APP_CRC16_bitwise(0U, &byte, 1U);
+    }
+
+    /* One more zero byte after each entry of the previous table */
+    for (slice = 1U; slice < APP_CRC_SLICE_MAX; slice++)
+    {
+        for (index = 0U; index < 256U; index++)
+        {
+            uint16_t crc16 = crc16Table[slice - 1U][index];
+
+            crc8Table[slice][index] = crc8Table[0][crc8Table[slice - 1U][index]];
+            crc16Table[slice][index] = (uint16_t)(crc16 << 8) ^ crc16Table[0][crc16 >> 8];
+        }
+    }
+
+    APP_CRC_select(APP_CRC_VARIANT_TABLE, APP_CRC_VARIANT_TABLE);
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_CRC_select(APP_CRC_VARIANT crc8, APP_CRC_VARIANT crc16)
+
+   Summary:
+    Select the variants of APP_CRC8_update and APP_CRC16_update.
+
+   Precondition:
+    APP_CRC_init must have been called.
+
+   Parameters:
+    crc8 - variant of the CRC-8.
+    crc16 - variant of the CRC-16.
+
+   Returns:
+    None.
+*/
+void APP_CRC_select(APP_CRC_VARIANT crc8, APP_CRC_VARIANT crc16)
+{
+    if ( crc8 < APP_CRC_VARIANT_NUM )
+    {
+        crc8Update = crc8Variants[crc8];
+    }
+    if ( crc16 < APP_CRC_VARIANT_NUM )
+    {
+        crc16Update = crc16Variants[crc16];
+    }
+}
+
+// *****************************************************************************
+/* Function:
+    void APP_CRC_benchmark(APP_CRC_CLOCK clock, const uint8_t* buffer, size_t size,
+                           app_crc_bench_t* result)
+
+   Summary:
+    Time the variants and select the fastest ones.
+
+   Description:
+    Each variant computes the CRC of the buffer several times, its shortest
+    run is kept, the first one warming the caches. The variants which give
+    a CRC different from the bitwise one are not selected.
+
+   Precondition:
+    APP_CRC_init must have been called.
+
+   Parameters:
+    clock - free running counter, CPU cycles on the target.
+    buffer - data of the benchmark, the size of the usual packets.
+    size - size of the buffer in bytes.
+    result - clock counts of the variants and selected variants.
+
+   Returns:
+    None.
+*/
+void APP_CRC_benchmark(APP_CRC_CLOCK clock, const uint8_t* buffer, size_t size, app_crc_bench_t* result)
+{
+    uint8_t crc8_ref = APP_CRC8_bitwise(APP_CRC8_INIT, buffer, size);
+    uint16_t crc16_ref = APP_CRC16_bitwise(APP_CRC16_INIT, buffer, size);
+    uint32_t variant;
+
+    result->crc8_selected = APP_CRC_VARIANT_BITWISE;
+    result->crc16_selected = APP_CRC_VARIANT_BITWISE;
+
+    for (variant = 0U; variant < (uint32_t)APP_CRC_VARIANT_NUM; variant++)
+    {
+        uint32_t best8 = UINT32_MAX;
+        uint32_t best16 = UINT32_MAX;
+        uint32_t run;
+        uint8_t crc8 = 0U;
+        uint16_t crc16 = 0U;
+
+        for (run = 0U; run < APP_CRC_BENCH_RUNS; run++)
+        {
+            uint32_t start = clock();
+            uint32_t elapsed;
+
+            crc8 = crc8Variants[variant](APP_CRC8_INIT, buffer, size);
+            elapsed = clock() - start;
+            if ( elapsed < best8 )
+            {
+                best8 = elapsed;
+            }
+
+            start = clock();
+            crc16 = crc16Variants[variant](APP_CRC16_INIT, buffer, size);
+            elapsed = clock() - start;
+            if ( elapsed < best16 )
+            {
+                best16 = elapsed;
+            }
+        }
+
+        result->crc8[variant] = best8;
+        result->crc16[variant] = best16;
+        if ( (crc8 == crc8_ref) && (best8 < result->crc8[result->crc8_selected]) )
+        {
+            result->crc8_selected = (APP_CRC_VARIANT)variant;
+        }
+        if ( (crc16 == crc16_ref) && (best16 < result->crc16[result->crc16_selected]) )
+        {
+            result->crc16_selected = (APP_CRC_VARIANT)variant;
+        }
+    }
+
+    APP_CRC_select(result->crc8_selected, result->crc16_selected);
+}
+
+// *****************************************************************************
+/* Function:
+    uint8_t APP_CRC8_update(uint8_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    Update a RMAP CRC-8 with data, using the selected variant.
+
+   Description:
+    The CRC of a buffer is APP_CRC8_update(APP_CRC8_INIT, buffer, size),
+    the CRC of data in several parts is updated part after part. The CRC
+    of the data followed by its CRC is 0.
+
+   Precondition:
+    APP_CRC_init must have been called.
+
+   Parameters:
+    crc - CRC of the previous data, APP_CRC8_INIT at the start.
+    data - data.
+    size - size of the data in bytes.
+
+   Returns:
+    The CRC of the previous data and this data.
+*/
+uint8_t APP_CRC8_update(uint8_t crc, const uint8_t* data, size_t size)
+{
+    return crc8Update(crc, data, size);
+}
+
+// *****************************************************************************
+/* Function:
+    uint8_t APP_CRC8_update_variant(APP_CRC_VARIANT variant, uint8_t crc,
+                                    const uint8_t* data, size_t size)
+
+   Summary:
+    Update a RMAP CRC-8 with data, using the given variant.
+*/
+uint8_t APP_CRC8_update_variant(APP_CRC_VARIANT variant, uint8_t crc, const uint8_t* data, size_t size)
+{
+    return crc8Variants[(variant < APP_CRC_VARIANT_NUM) ? variant : APP_CRC_VARIANT_BITWISE](crc, data, size);
+}
+
+// *****************************************************************************
+/* Function:
+    uint16_t APP_CRC16_update(uint16_t crc, const uint8_t* data, size_t size)
+
+   Summary:
+    Update a CRC-16-CCITT with data, using the selected variant.
+
+   Description:
+    The CRC of a buffer is APP_CRC16_update(APP_CRC16_INIT, buffer, size),
+    the CRC of data in several parts is updated part after part. The CRC
+    of the data followed by its CRC, most significant byte first, is 0.
+
+   Precondition:
+    APP_CRC_init must have been called.
+
+   Parameters:
+    crc - CRC of the previous data, APP_CRC16_INIT at the start.
+    data - data.
+    size - size of the data in bytes.
+
+   Returns:
+    The CRC of the previous data and this data.
+*/
+uint16_t APP_CRC16_update(uint16_t crc, const uint8_t* data, size_t size)
+{
+    return crc16Update(crc, data, size);
+}
+
+// *****************************************************************************
+/* Function:
+    uint16_t APP_CRC16_update_variant(APP_CRC_VARIANT variant, uint16_t crc,
+                                      const uint8_t* data, size_t size)
+
+   Summary:
+    Update a CRC-16-CCITT with data, using the given variant.
+*/
+uint16_t APP_CRC16_update_variant(APP_CRC_VARIANT variant, uint16_t crc, const uint8_t* data, size_t size)
+{
+    return crc16Variants[(variant < APP_CRC_VARIANT_NUM) ? variant : APP_CRC_VARIANT_BITWISE](crc, data, size);
+}
+
+// *****************************************************************************
+/* Function:
+    const char* APP_CRC_variant_name(APP_CRC_VARIANT variant)
+
+   Summary:
+    Get the name of a variant.
+*/
+const char* APP_CRC_variant_name(APP_CRC_VARIANT variant)
+{
+    static const char* const names[APP_CRC_VARIANT_NUM] = { "bitwise", "table", "slice-by-4", "slice-by-8" };
+
+    return (variant < APP_CRC_VARIANT_NUM) ? names[variant] : "unknown";
+}
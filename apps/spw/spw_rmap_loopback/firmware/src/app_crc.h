@@ -0,0 +1,151 @@
+/*******************************************************************************
+  MPLAB Harmony Application CRC Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    app_crc.h
+
+  Summary:
+    CRC-8 of RMAP and CRC-16 of CCSDS Prototypes and definitions file.
+
+  Description:
+    The CRC-8 of RMAP (ECSS-E-ST-50-52C) and the CRC-16-CCITT of the CCSDS
+    frames, in bitwise, table, slice-by-4 and slice-by-8 variants. The
+    library has no dependency on the target headers, the tools/crc_bench
+    host tool builds the same source on Linux. APP_CRC_benchmark times the
+    variants with a clock of the platform and selects the fastest one for
+    APP_CRC8_update and APP_CRC16_update.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef APP_CRC_H
+#define	APP_CRC_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+#include <stddef.h>
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Macros Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* RMAP CRC-8: x^8 + x^2 + x + 1, bits processed least significant first,
+   initial value 0 */
+#define APP_CRC8_INIT                                             (0x00U)
+
+/* CCSDS CRC-16-CCITT: x^16 + x^12 + x^5 + 1, bits processed most
+   significant first, initial value 0xFFFF */
+#define APP_CRC16_INIT                                            (0xFFFFU)
+
+// *****************************************************************************
+// *****************************************************************************
+// Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+/* CRC variant
+
+   Summary:
+    Implementation of a CRC.
+
+   Description:
+    BITWISE processes one bit per step and needs no table. TABLE processes
+    one byte per step with a 256 entries table. SLICE4 and SLICE8 process 4
+    and 8 bytes per step with 4 and 8 tables, and fewer dependent loads.
+
+   Remarks:
+    None.
+*/
+typedef enum
+{
+    APP_CRC_VARIANT_BITWISE = 0,
+    APP_CRC_VARIANT_TABLE,
+    APP_CRC_VARIANT_SLICE4,
+    APP_CRC_VARIANT_SLICE8,
+    APP_CRC_VARIANT_NUM,
+} APP_CRC_VARIANT;
+
+/* Clock of the benchmark, a free running counter */
+typedef uint32_t (*APP_CRC_CLOCK)(void);
+
+/* CRC benchmark result
+
+   Summary:
+    Clock counts of each variant over the benchmark buffer.
+
+   Remarks:
+    None.
+*/
+typedef struct
+{
+    uint32_t crc8[APP_CRC_VARIANT_NUM];
+    uint32_t crc16[APP_CRC_VARIANT_NUM];
+    APP_CRC_VARIANT crc8_selected;
+    APP_CRC_VARIANT crc16_selected;
+} app_crc_bench_t;
+
+// *****************************************************************************
+// *****************************************************************************
+// Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CRC_init(void);
+
+void APP_CRC_select(APP_CRC_VARIANT crc8, APP_CRC_VARIANT crc16);
+
+void APP_CRC_benchmark(APP_CRC_CLOCK clock, const uint8_t* buffer, size_t size, app_crc_bench_t* result);
+
+uint8_t APP_CRC8_update(uint8_t crc, const uint8_t* data, size_t size);
+
+uint8_t APP_CRC8_update_variant(APP_CRC_VARIANT variant, uint8_t crc, const uint8_t* data, size_t size);
+
+uint16_t APP_CRC16_update(uint16_t crc, const uint8_t* data, size_t size);
+
+uint16_t APP_CRC16_update_variant(APP_CRC_VARIANT variant, uint16_t crc, const uint8_t* data, size_t size);
+
+const char* APP_CRC_variant_name(APP_CRC_VARIANT variant);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif	/* APP_CRC_H */
@@ -45,6 +45,7 @@
 // *****************************************************************************
 #include <stdio.h>
 #include "app_rmap.h"
+#include "app_crc.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -238,3 +239,51 @@ APP_RMAP_COMMAND_CODE APP_RMAP_CommandCodeGet(uint8_t instuctionByte)
     return (APP_RMAP_COMMAND_CODE)(uint8_t)((instuctionByte & 0x3CU) >> 2U);
 }
 
+// *****************************************************************************
+/* Function:
+    bool APP_RMAP_ReplyCrcCheck(const uint8_t* reply, uint32_t size)
+
+   Summary:
+    Check the CRCs of a received RMAP reply.
+
+   Description:
+    This function checks the header CRC of a write or read reply, and the
+    data CRC of a read reply. A CRC is checked over its bytes and the CRC
+    byte, which gives 0 when they are received without error.
+
+   Precondition:
+    APP_CRC_init must have been called.
+
+   Parameters:
+    reply - received reply, from the initiator logical address.
+    size - size of the reply in bytes.
+
+   Returns:
+    True if the reply has all its bytes and its CRCs are correct.
+*/
+bool APP_RMAP_ReplyCrcCheck(const uint8_t* reply, uint32_t size)
+{
+    uint32_t header_size = APP_RMAP_WRITE_REPLY_HEADER_SIZE;
+
+    if (size < APP_RMAP_WRITE_REPLY_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    // Command code write bit clear : read reply with data length and data
+    if ( ((uint8_t)APP_RMAP_CommandCodeGet(reply[2]) & APP_RMAP_COMMAND_CODE_WRITE_MASK) == 0U )
+    {
+        header_size = APP_RMAP_READ_REPLY_HEADER_SIZE;
+        if (size < (header_size + 1U))
+        {
+            return false;
+        }
+        if (APP_CRC8_update(APP_CRC8_INIT, &reply[header_size], size - header_size) != 0U)
+        {
+            return false;
+        }
+    }
+
+    return (APP_CRC8_update(APP_CRC8_INIT, reply, header_size) == 0U);
+}
+
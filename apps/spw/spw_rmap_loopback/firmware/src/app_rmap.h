@@ -48,6 +48,7 @@
 // *****************************************************************************
 // *****************************************************************************
 #include <stdint.h>
+#include <stdbool.h>
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus // Provide C++ Compatibility
@@ -63,6 +64,15 @@
 /* RMAP Protocol ID */
 #define APP_RMAP_PROTOCOL_ID                                      (0x01)
 
+/* Write bit of the RMAP command code */
+#define APP_RMAP_COMMAND_CODE_WRITE_MASK                          (0x08U)
+
+/* RMAP write reply header size in bytes, header CRC included */
+#define APP_RMAP_WRITE_REPLY_HEADER_SIZE                          (8U)
+
+/* RMAP read reply header size in bytes, header CRC included */
+#define APP_RMAP_READ_REPLY_HEADER_SIZE                           (12U)
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Type Definitions
@@ -130,6 +140,8 @@ APP_RMAP_PCK_TYPE APP_RMAP_PackeTypeGet(uint8_t instuctionByte);
 
 APP_RMAP_COMMAND_CODE APP_RMAP_CommandCodeGet(uint8_t instuctionByte);
 
+bool APP_RMAP_ReplyCrcCheck(const uint8_t* reply, uint32_t size);
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
 }
@@ -64,7 +64,7 @@
 // *****************************************************************************
 // *****************************************************************************
 
-static SPW_OBJ spwObj;
+static SPW_TCM_DATA SPW_OBJ spwObj;
 
 // *****************************************************************************
 // *****************************************************************************
@@ -166,7 +166,7 @@ void SPW_CallbackRegister(SPW_CALLBACK callback, uintptr_t contextHandle)
     instance interrupt is enabled. If peripheral instance's interrupt is not
     enabled user need to call it from the main while loop of the application.
 */
-void __attribute__((used)) SPW_InterruptHandler(void)
+SPW_TCM_CODE void __attribute__((used)) SPW_InterruptHandler(void)
 {
     SPW_INT_MASK status = SPW_INT_MASK_NONE;
 
@@ -50,6 +50,7 @@
 #include <string.h>                     // Defines memset
 #include "definitions.h"                // SYS function prototypes
 #include "app_rmap.h"
+#include "app_crc.h"
 
 // *****************************************************************************
 // *****************************************************************************
@@ -394,6 +395,12 @@ static int8_t APP_SPW_WaitAndCheckRmapReply(uint32_t expectedSize)
             res = -1;
         }
 
+        if ( (res == 0) && (APP_RMAP_ReplyCrcCheck(rx_buffer_reply, app_rx_packet_info[0].DSize) == false) )
+        {
+            printf("CRC ERROR\r\n");
+            res = -1;
+        }
+
         if (res == 0)
         {
             uint16_t transaction_id = ((uint16_t)(rx_buffer_reply[5]) << 8) + rx_buffer_reply[6];
@@ -432,6 +439,57 @@ static int8_t APP_SPW_WaitAndCheckRmapReply(uint32_t expectedSize)
     return res;
 }
 
+// *****************************************************************************
+/* static uint32_t APP_CRC_CyclesGet(void)
+
+  Summary:
+    Clock of the CRC benchmark.
+
+  Description:
+    Return the CPU cycle counter of the DWT.
+
+  Remarks:
+    None.
+*/
+static uint32_t APP_CRC_CyclesGet(void)
+{
+    return DWT->CYCCNT;
+}
+
+// *****************************************************************************
+/* static void APP_CRC_Benchmark(void)
+
+  Summary:
+    Select the fastest CRC variants of this target.
+
+  Description:
+    Time the CRC variants over a packet of data and print the CPU cycles of
+    each one. The fastest variants are used to check the RMAP replies.
+
+  Remarks:
+    None.
+*/
+static void APP_CRC_Benchmark(void)
+{
+    app_crc_bench_t result;
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55U;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    APP_CRC_init();
+    APP_CRC_benchmark(APP_CRC_CyclesGet, (const uint8_t*)app_tx_data, sizeof(app_tx_data), &result);
+
+    printf("CRC benchmark (CPU cycles for %u bytes): variant, CRC-8, CRC-16\r\n", (unsigned int)sizeof(app_tx_data));
+    for (uint32_t variant = 0U; variant < (uint32_t)APP_CRC_VARIANT_NUM; variant++)
+    {
+        printf("  %-10s  %6u  %6u\r\n", APP_CRC_variant_name((APP_CRC_VARIANT)variant),
+               (unsigned int)result.crc8[variant], (unsigned int)result.crc16[variant]);
+    }
+    printf("  Selected CRC-8 %s, CRC-16 %s\r\n", APP_CRC_variant_name(result.crc8_selected),
+           APP_CRC_variant_name(result.crc16_selected));
+}
+
 // *****************************************************************************
 /* static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
 
@@ -444,7 +502,7 @@ static int8_t APP_SPW_WaitAndCheckRmapReply(uint32_t expectedSize)
   Remarks:
     None.
 */
-static void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
+static SPW_TCM_CODE void APP_SPW_Callback(SPW_INT_MASK irqStatus, uintptr_t context)
 {
     if ( (irqStatus & SPW_INT_MASK_PKTTX1) != 0U )
     {
@@ -497,6 +555,9 @@ int main ( void )
     printf("\n\r  SPW RMAP loopback example                                ");
     printf("\n\r-----------------------------------------------------------\n\r");
 
+    /* Select the CRC variants used to check the RMAP replies */
+    APP_CRC_Benchmark();
+
     /* Add SPW interrupt callback */
     SPW_CallbackRegister(APP_SPW_Callback, (uintptr_t)NULL);
 
@@ -0,0 +1,267 @@
+/*******************************************************************************
+  CRC library check and benchmark
+
+  File Name:
+    crc_bench.c
+
+  Summary:
+    Host build of the RMAP CRC-8 and CCSDS CRC-16 library.
+
+  Description:
+    Builds the app_crc library of the spw_rmap_loopback application on the
+    host. Checks every variant against the published RMAP table and CRC-16
+    check value and against the bitwise variant, incremental updates
+    included, then times the variants and prints the fastest ones. Also
+    prints the CRCs of a file, to pre-stage packets.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "app_crc.h"
+
+/* Default size of the benchmark buffer, the size of a large RMAP packet */
+#define BENCH_SIZE_DEFAULT  (1024U)
+
+/* Largest size of a checked file */
+#define FILE_SIZE_MAX       (16U * 1024U * 1024U)
+
+static void fatal(const char* format, const char* arg)
+{
+    fprintf(stderr, "crc_bench: error: ");
+    fprintf(stderr, format, arg);
+    fprintf(stderr, "\n");
+    exit(EXIT_FAILURE);
+}
+
+static uint32_t clock_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)((uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec);
+}
+
+/* Pseudo random test data, same on every run */
+static void fill(uint8_t* buffer, size_t size)
+{
+    uint32_t state = 0x12345678U;
+    size_t index;
+
+    for (index = 0U; index < size; index++)
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        buffer[index] = (uint8_t)state;
+    }
+}
+
+/* Check the variants against the published values and against each other */
+static int self_check(void)
+{
+    static const uint8_t check[] = "123456789";
+    /* First entries of the RMAP CRC table of ECSS-E-ST-50-52C */
+    static const uint8_t rmap_table[] = { 0x00U, 0x91U, 0xE3U, 0x72U, 0x07U, 0x96U, 0xE4U, 0x75U };
+    uint8_t buffer[256];
+    int errors = 0;
+    unsigned int variant;
+    size_t size;
+    size_t split;
+    uint8_t index;
+
+    for (index = 0U; index < sizeof(rmap_table); index++)
+    {
+        if ( APP_CRC8_update_variant(APP_CRC_VARIANT_BITWISE, APP_CRC8_INIT, &index, 1U) != rmap_table[index] )
+        {
+            fprintf(stderr, "CRC-8 table entry %u differs from the RMAP table\n", (unsigned int)index);
+            errors++;
+        }
+    }
+
+    fill(buffer, sizeof(buffer));
+    for (variant = 0U; variant < (unsigned int)APP_CRC_VARIANT_NUM; variant++)
+    {
+        uint16_t crc16 = APP_CRC16_update_variant((APP_CRC_VARIANT)variant, APP_CRC16_INIT, check, 9U);
+
+        if ( crc16 != 0x29B1U )
+        {
+            fprintf(stderr, "%s CRC-16 of \"123456789\" is 0x%04X, expected 0x29B1\n",
+                    APP_CRC_variant_name((APP_CRC_VARIANT)variant), (unsigned int)crc16);
+            errors++;
+        }
+
+        for (size = 0U; size <= sizeof(buffer); size++)
+        {
+            uint8_t crc8_ref = APP_CRC8_update_variant(APP_CRC_VARIANT_BITWISE, APP_CRC8_INIT, buffer, size);
+            uint16_t crc16_ref = APP_CRC16_update_variant(APP_CRC_VARIANT_BITWISE, APP_CRC16_INIT, buffer, size);
+            uint8_t trailer[2];
+
+            /* Incremental update, in two parts */
+            for (split = 0U; split <= size; split += 7U)
+            {
+                uint8_t crc8 = APP_CRC8_update_variant((APP_CRC_VARIANT)variant, APP_CRC8_INIT, buffer, split);
+                uint16_t crc16_part = APP_CRC16_update_variant((APP_CRC_VARIANT)variant, APP_CRC16_INIT, buffer, split);
+
+                crc8 = APP_CRC8_update_variant((APP_CRC_VARIANT)variant, crc8, &buffer[split], size - split);
+                crc16_part = APP_CRC16_update_variant((APP_CRC_VARIANT)variant, crc16_part, &buffer[split], size - split);
+                if ( (crc8 != crc8_ref) || (crc16_part != crc16_ref) )
+                {
+                    fprintf(stderr, "%s differs from bitwise on %u bytes split at %u\n",
+                            APP_CRC_variant_name((APP_CRC_VARIANT)variant), (unsigned int)size, (unsigned int)split);
+                    errors++;
+                    break;
+                }
+            }
+
+            /* The CRC of the data followed by its CRC is 0 */
+            trailer[0] = (uint8_t)(crc16_ref >> 8);
+            trailer[1] = (uint8_t)crc16_ref;
+            if ( (APP_CRC8_update_variant((APP_CRC_VARIANT)variant, crc8_ref, &crc8_ref, 1U) != 0U) ||
+                 (APP_CRC16_update_variant((APP_CRC_VARIANT)variant, crc16_ref, trailer, 2U) != 0U) )
+            {
+                fprintf(stderr, "%s: CRC of data and CRC is not 0 on %u bytes\n",
+                        APP_CRC_variant_name((APP_CRC_VARIANT)variant), (unsigned int)size);
+                errors++;
+            }
+        }
+    }
+
+    return errors;
+}
+
+static void check_file(const char* path)
+{
+    FILE* file = fopen(path, "rb");
+    uint8_t* buffer;
+    size_t size;
+
+    if ( file == NULL )
+    {
+        fatal("cannot open %s", path);
+    }
+    buffer = malloc(FILE_SIZE_MAX);
+    if ( buffer == NULL )
+    {
+        fatal("%s", "out of memory");
+    }
+    size = fread(buffer, 1U, FILE_SIZE_MAX, file);
+    if ( ferror(file) || !feof(file) )
+    {
+        fatal("cannot read %s, or larger than 16 MB", path);
+    }
+    fclose(file);
+
+    printf("%s: %u bytes, CRC-8 0x%02X, CRC-16 0x%04X\n", path, (unsigned int)size,
+           (unsigned int)APP_CRC8_update(APP_CRC8_INIT, buffer, size),
+           (unsigned int)APP_CRC16_update(APP_CRC16_INIT, buffer, size));
+    free(buffer);
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+        "usage: crc_bench [options]\n"
+        "  -s SIZE              benchmark buffer size in bytes (default 1024)\n"
+        "  -f FILE              print the CRC-8 and CRC-16 of FILE\n"
+        "Without -f, the variants are checked, then timed.\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char* argv[])
+{
+    size_t size = BENCH_SIZE_DEFAULT;
+    const char* path = NULL;
+    app_crc_bench_t result;
+    uint8_t* buffer;
+    unsigned int variant;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        const char* option = argv[arg];
+
+        if ( (option[0] != '-') || (option[1] == '\0') || (option[2] != '\0') || ((arg + 1) >= argc) )
+        {
+            usage();
+        }
+        switch ( option[1] )
+        {
+            case 's':
+                size = (size_t)strtoul(argv[++arg], NULL, 0);
+                if ( size == 0U )
+                {
+                    fatal("invalid size %s", argv[arg]);
+                }
+                break;
+            case 'f':
+                path = argv[++arg];
+                break;
+            default:
+                usage();
+                break;
+        }
+    }
+
+    APP_CRC_init();
+
+    if ( self_check() != 0 )
+    {
+        fatal("%s", "self check failed");
+    }
+
+    buffer = malloc(size);
+    if ( buffer == NULL )
+    {
+        fatal("%s", "out of memory");
+    }
+    fill(buffer, size);
+    APP_CRC_benchmark(clock_ns, buffer, size, &result);
+    free(buffer);
+
+    if ( path != NULL )
+    {
+        check_file(path);
+        return EXIT_SUCCESS;
+    }
+
+    printf("Self check passed\n");
+    printf("%-12s %12s %12s   (ns for %u bytes)\n", "variant", "CRC-8", "CRC-16", (unsigned int)size);
+    for (variant = 0U; variant < (unsigned int)APP_CRC_VARIANT_NUM; variant++)
+    {
+        printf("%-12s %12u %12u\n", APP_CRC_variant_name((APP_CRC_VARIANT)variant),
+               (unsigned int)result.crc8[variant], (unsigned int)result.crc16[variant]);
+    }
+    printf("Selected: CRC-8 %s, CRC-16 %s\n",
+           APP_CRC_variant_name(result.crc8_selected), APP_CRC_variant_name(result.crc16_selected));
+
+    return EXIT_SUCCESS;
+}
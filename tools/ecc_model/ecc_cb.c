@@ -0,0 +1,527 @@
+/*******************************************************************************
+  ECC check bit calculator
+
+  File Name:
+    ecc_cb.c
+
+  Summary:
+    Check bits and injection outcomes of the TCM, FlexRAM and HEMC ECC.
+
+  Description:
+    Computes offline the check bits the ECC controllers store for a data word,
+    the content written by a test mode injection of a data and check bit flip
+    pattern and the status reported when it is read back. The codes are
+    fitted and checked on the check bits printed by the target, and exported
+    as a C header so the target can compute check bits without a test mode
+    read.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ecc_model.h"
+
+#define MAX_LINE            (256U)
+
+static const char* const statusNames[] =
+{
+    "ok", "fix-data", "fix-check", "nofix"
+};
+
+static void fatal(const char* format, const char* arg)
+{
+    fprintf(stderr, "ecc_cb: ");
+    fprintf(stderr, format, arg);
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+static uint64_t parse_number(const char* text, const char** end)
+{
+    char* stop;
+    unsigned long long value;
+
+    errno = 0;
+    value = strtoull(text, &stop, 0);
+    if ( ( stop == text ) || ( errno != 0 ) || ( ( end == NULL ) && ( *stop != '\0' ) ) )
+    {
+        fatal("invalid number '%s'", text);
+    }
+    if ( end != NULL )
+    {
+        *end = stop;
+    }
+    return (uint64_t)value;
+}
+
+static FILE* open_file(const char* name, const char* mode)
+{
+    FILE* file = fopen(name, mode);
+
+    if ( file == NULL )
+    {
+        fatal("cannot open '%s'", name);
+    }
+    return file;
+}
+
+/* Matrix file: "model", "data_bits", "check_bits", "constant" and one "column" line per data bit */
+static void load_matrix(ecc_model_t* model, ecc_model_id_t* id, const char* name)
+{
+    FILE* file = open_file(name, "r");
+    uint8_t column[ECC_MODEL_MAX_DATA_BITS] = { 0 };
+    unsigned int dataBits = 0U, checkBits = 0U, constant = 0U;
+    char line[MAX_LINE];
+
+    while ( fgets(line, sizeof(line), file) != NULL )
+    {
+        char key[32], value[32];
+        unsigned int bit, check;
+
+        if ( ( line[0] == '#' ) || ( sscanf(line, "%31s %31s", key, value) != 2 ) )
+        {
+            continue;
+        }
+        if ( strcmp(key, "model") == 0 )
+        {
+            *id = ecc_model_lookup(value);
+        }
+        else if ( strcmp(key, "data_bits") == 0 )
+        {
+            dataBits = (unsigned int)parse_number(value, NULL);
+        }
+        else if ( strcmp(key, "check_bits") == 0 )
+        {
+            checkBits = (unsigned int)parse_number(value, NULL);
+        }
+        else if ( strcmp(key, "constant") == 0 )
+        {
+            constant = (unsigned int)parse_number(value, NULL);
+        }
+        else if ( ( strcmp(key, "column") == 0 ) && ( sscanf(line, "%*s %u %i", &bit, &check) == 2 ) &&
+                  ( bit < ECC_MODEL_MAX_DATA_BITS ) )
+        {
+            column[bit] = (uint8_t)check;
+        }
+    }
+    fclose(file);
+
+    if ( ( *id == ECC_MODEL_NUM ) ||
+         ( ecc_model_init(model, dataBits, checkBits, column, (uint8_t)constant) < 0 ) )
+    {
+        fatal("invalid matrix file '%s'", name);
+    }
+}
+
+static void write_matrix(const ecc_model_t* model, ecc_model_id_t id, const char* name)
+{
+    FILE* file = open_file(name, "w");
+    unsigned int bit;
+
+    fprintf(file, "# ecc_cb check bit matrix\n");
+    fprintf(file, "model %s\n", ecc_model_name(id));
+    fprintf(file, "data_bits %u\n", model->data_bits);
+    fprintf(file, "check_bits %u\n", model->check_bits);
+    fprintf(file, "constant 0x%02x\n", model->constant);
+    for (bit = 0U; bit < model->data_bits; bit++)
+    {
+        fprintf(file, "column %u 0x%02x\n", bit, model->column[bit]);
+    }
+    fclose(file);
+}
+
+static void print_matrix(const ecc_model_t* model, ecc_model_id_t id)
+{
+    unsigned int bit;
+
+    printf("%s: %u data bits, %u check bits, constant 0x%02x\n",
+           ecc_model_name(id), model->data_bits, model->check_bits, model->constant);
+    for (bit = 0U; bit < model->data_bits; bit++)
+    {
+        printf("%s0x%02x", ((bit % 16U) == 0U) ? "  " : " ", model->column[bit]);
+        if ( ( (bit % 16U) == 15U ) || ( (bit + 1U) == model->data_bits ) )
+        {
+            printf("\n");
+        }
+    }
+}
+
+/*
+ * Read the "ECC_CB <model> <address> <data> <tcb1> <tcb2>" lines of a target
+ * log. DTCM words of bank 1 (address bit 2 set) are checked by TCB2.
+ */
+static size_t read_samples(const char* name, ecc_model_id_t id, uint64_t** data, uint8_t** check)
+{
+    FILE* file = open_file(name, "r");
+    size_t count = 0U, size = 0U;
+    char line[MAX_LINE];
+
+    *data = NULL;
+    *check = NULL;
+    while ( fgets(line, sizeof(line), file) != NULL )
+    {
+        const char* start = strstr(line, "ECC_CB ");
+        char model[16];
+        unsigned long long address, value;
+        unsigned int tcb1, tcb2;
+
+        if ( ( start == NULL ) ||
+             ( sscanf(start, "ECC_CB %15s %llx %llx %x %x", model, &address, &value, &tcb1, &tcb2) != 5 ) ||
+             ( ecc_model_lookup(model) != id ) )
+        {
+            continue;
+        }
+        if ( count == size )
+        {
+            size = (size == 0U) ? 256U : (size * 2U);
+            *data = realloc(*data, size * sizeof(uint64_t));
+            *check = realloc(*check, size);
+            if ( ( *data == NULL ) || ( *check == NULL ) )
+            {
+                fatal("%s", "out of memory");
+            }
+        }
+        (*data)[count] = (uint64_t)value;
+        (*check)[count] = (uint8_t)(( ( id == ECC_MODEL_DTCM ) && ( (address & 0x4U) != 0U ) ) ? tcb2 : tcb1);
+        count++;
+    }
+    fclose(file);
+    return count;
+}
+
+/* Check the current model on the target samples, then replace it by the code fitted on them */
+static void fit_samples(ecc_model_t* model, ecc_model_id_t id, const char* name)
+{
+    uint64_t* data;
+    uint8_t* check;
+    size_t count = read_samples(name, id, &data, &check);
+    size_t index, mismatch = 0U;
+    ecc_model_t fitted;
+    int secDed = 1;
+    int result;
+
+    for (index = 0U; index < count; index++)
+    {
+        if ( ecc_model_encode(model, data[index]) != check[index] )
+        {
+            mismatch++;
+        }
+    }
+    printf("%s: %zu samples, %zu mismatch with the current model\n", ecc_model_name(id), count, mismatch);
+
+    result = ecc_model_fit(&fitted, model->data_bits, model->check_bits, data, check, count, &secDed);
+    free(data);
+    free(check);
+    if ( result == -1 )
+    {
+        fatal("%s samples do not determine the code, walk a one over all data bits", ecc_model_name(id));
+    }
+    if ( result == -2 )
+    {
+        fatal("%s samples do not match any affine code of this geometry", ecc_model_name(id));
+    }
+    printf("%s: fitted code is %s\n", ecc_model_name(id), (secDed == 0) ? "SEC-DED" : "not SEC-DED");
+    *model = fitted;
+}
+
+static void write_header(const ecc_model_t* model, const char* name, FILE* file)
+{
+    const char* type = (model->data_bits > 32U) ? "uint64_t" : "uint32_t";
+    char upper[64];
+    unsigned int i, j;
+
+    for (i = 0U; ( name[i] != '\0' ) && ( i < (sizeof(upper) - 1U) ); i++)
+    {
+        upper[i] = (char)toupper((unsigned char)name[i]);
+    }
+    upper[i] = '\0';
+
+    fprintf(file, "/* Generated by ecc_cb, do not edit */\n\n");
+    fprintf(file, "#ifndef %s_H\n#define %s_H\n\n#include <stdint.h>\n\n", upper, upper);
+    fprintf(file, "#define %s_DATA_BITS (%uU)\n", upper, model->data_bits);
+    fprintf(file, "#define %s_CHECK_BITS (%uU)\n\n", upper, model->check_bits);
+    fprintf(file, "/* Check bits of each value of each data byte */\n");
+    fprintf(file, "static const uint8_t %s_table[%u][256] =\n{\n", name, model->data_bits / 8U);
+    for (i = 0U; i < (model->data_bits / 8U); i++)
+    {
+        fprintf(file, "    {");
+        for (j = 0U; j < 256U; j++)
+        {
+            fprintf(file, "%s0x%02x%s", ((j % 16U) == 0U) ? "\n        " : " ",
+                    model->table[i][j], (j == 255U) ? "" : ",");
+        }
+        fprintf(file, "\n    },\n");
+    }
+    fprintf(file, "};\n\n");
+    fprintf(file, "/* Check bits stored by the controller for a data word */\n");
+    fprintf(file, "static inline uint8_t %s_encode(%s data)\n{\n", name, type);
+    fprintf(file, "    uint8_t check = 0U;\n    unsigned int i;\n\n");
+    fprintf(file, "    for (i = 0U; i < (%s_DATA_BITS / 8U); i++)\n    {\n", upper);
+    fprintf(file, "        check ^= %s_table[i][(data >> (i * 8U)) & 0xFFU];\n    }\n", name);
+    fprintf(file, "    return check;\n}\n\n#endif /* %s_H */\n", upper);
+}
+
+/* Print the content stored by a test mode injection and the status reported on read */
+static void inject(const ecc_model_t* model, const char* arg)
+{
+    const char* end;
+    uint64_t data = parse_number(arg, &end);
+    uint64_t dataFlip = 0U;
+    uint8_t checkFlip = 0U;
+    uint64_t storedData;
+    uint8_t storedCheck;
+    ecc_model_status_t status;
+
+    if ( *end == ':' )
+    {
+        dataFlip = parse_number(end + 1, &end);
+        if ( *end == ':' )
+        {
+            checkFlip = (uint8_t)parse_number(end + 1, &end);
+        }
+    }
+    if ( *end != '\0' )
+    {
+        fatal("invalid injection '%s', expected DATA[:DATA_FLIP[:CHECK_FLIP]]", arg);
+    }
+
+    status = ecc_model_flip(model, data, dataFlip, checkFlip, &storedData, &storedCheck);
+    printf("data 0x%0*llx check 0x%02x -> stored 0x%0*llx check 0x%02x : %s\n",
+           (int)(model->data_bits / 4U), (unsigned long long)data, ecc_model_encode(model, data),
+           (int)(model->data_bits / 4U), (unsigned long long)storedData, storedCheck, statusNames[status]);
+}
+
+static void inject_file(const ecc_model_t* model, const char* name)
+{
+    FILE* file = open_file(name, "r");
+    char line[MAX_LINE];
+
+    while ( fgets(line, sizeof(line), file) != NULL )
+    {
+        char arg[MAX_LINE];
+        unsigned long long data, dataFlip = 0U, checkFlip = 0U;
+        int fields = sscanf(line, "%lli %lli %lli", &data, &dataFlip, &checkFlip);
+
+        if ( ( line[0] == '#' ) || ( fields <= 0 ) )
+        {
+            continue;
+        }
+        snprintf(arg, sizeof(arg), "0x%llx:0x%llx:0x%llx", data, dataFlip, checkFlip);
+        inject(model, arg);
+    }
+    fclose(file);
+}
+
+/* Cross-check the batch encoder with the table encoder and time both */
+static void benchmark(const ecc_model_t* model, size_t count)
+{
+    uint64_t* data = malloc(count * sizeof(uint64_t));
+    uint8_t* check = malloc(count);
+    uint64_t mask = (model->data_bits >= 64U) ? ~0ULL : ((1ULL << model->data_bits) - 1U);
+    uint64_t seed = 0x9E3779B97F4A7C15ULL;
+    volatile uint8_t sink = 0U;
+    clock_t start;
+    double batchTime, tableTime;
+    size_t index;
+
+    if ( ( data == NULL ) || ( check == NULL ) )
+    {
+        fatal("%s", "out of memory");
+    }
+    for (index = 0U; index < count; index++)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        data[index] = seed & mask;
+    }
+
+    start = clock();
+    ecc_model_encode_batch(model, data, check, count);
+    batchTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    for (index = 0U; index < count; index++)
+    {
+        uint8_t value = ecc_model_encode(model, data[index]);
+
+        if ( value != check[index] )
+        {
+            fatal("batch encoder mismatch on word %s", "");
+        }
+        sink ^= value;
+    }
+    tableTime = (double)(clock() - start) / CLOCKS_PER_SEC;
+    (void)sink;
+
+    printf("%zu words: batch (%s) %.1f Mword/s, table %.1f Mword/s\n", count, ecc_model_engine(),
+           (batchTime > 0.0) ? ((double)count / batchTime / 1e6) : 0.0,
+           (tableTime > 0.0) ? ((double)count / tableTime / 1e6) : 0.0);
+    free(data);
+    free(check);
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: ecc_cb [options] [DATA[:DATA_FLIP[:CHECK_FLIP]] ...]\n"
+            "  -m MODEL   itcm, dtcm, flexram (default) or hemc\n"
+            "  -l FILE    load the code of the model from a matrix file\n"
+            "  -k FILE    check the model on the ECC_CB lines of a target log, then fit it on them\n"
+            "  -w FILE    write the code of the model to a matrix file\n"
+            "  -t NAME    write a C header with the encoding tables of the model\n"
+            "  -o FILE    output file of -t (default stdout)\n"
+            "  -c FILE    injections listed as 'DATA DATA_FLIP CHECK_FLIP' lines\n"
+            "  -b COUNT   check and time the batch encoder on COUNT random words\n"
+            "  -p         print the parity check matrix of the model\n"
+            "  -P         use the portable batch encoder\n");
+    exit(2);
+}
+
+int main(int argc, char* argv[])
+{
+    ecc_model_id_t id = ECC_MODEL_FLEXRAM;
+    ecc_model_t model;
+    const char* matrix = NULL;
+    const char* samples = NULL;
+    const char* write = NULL;
+    const char* header = NULL;
+    const char* output = NULL;
+    const char* campaign = NULL;
+    size_t benchCount = 0U;
+    int print = 0;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        const char* option = argv[arg];
+        const char* value;
+
+        if ( ( option[0] != '-' ) || ( option[1] == '\0' ) || ( option[2] != '\0' ) )
+        {
+            break;
+        }
+        if ( option[1] == 'p' )
+        {
+            print = 1;
+            continue;
+        }
+        if ( option[1] == 'P' )
+        {
+            ecc_model_force_portable(1);
+            continue;
+        }
+        if ( (arg + 1) >= argc )
+        {
+            usage();
+        }
+        value = argv[++arg];
+
+        switch ( option[1] )
+        {
+            case 'm':
+                id = ecc_model_lookup(value);
+                if ( id == ECC_MODEL_NUM )
+                {
+                    fatal("unknown model '%s'", value);
+                }
+                break;
+            case 'l':
+                matrix = value;
+                break;
+            case 'k':
+                samples = value;
+                break;
+            case 'w':
+                write = value;
+                break;
+            case 't':
+                header = value;
+                break;
+            case 'o':
+                output = value;
+                break;
+            case 'c':
+                campaign = value;
+                break;
+            case 'b':
+                benchCount = (size_t)parse_number(value, NULL);
+                break;
+            default:
+                usage();
+                break;
+        }
+    }
+
+    if ( matrix != NULL )
+    {
+        load_matrix(&model, &id, matrix);
+    }
+    else
+    {
+        ecc_model_init_default(&model, id);
+    }
+    if ( samples != NULL )
+    {
+        fit_samples(&model, id, samples);
+    }
+    if ( print != 0 )
+    {
+        print_matrix(&model, id);
+    }
+    if ( write != NULL )
+    {
+        write_matrix(&model, id, write);
+    }
+    if ( header != NULL )
+    {
+        FILE* file = (output != NULL) ? open_file(output, "w") : stdout;
+
+        write_header(&model, header, file);
+        if ( file != stdout )
+        {
+            fclose(file);
+        }
+    }
+    if ( campaign != NULL )
+    {
+        inject_file(&model, campaign);
+    }
+    for (; arg < argc; arg++)
+    {
+        inject(&model, argv[arg]);
+    }
+    if ( benchCount != 0U )
+    {
+        benchmark(&model, benchCount);
+    }
+    return 0;
+}
@@ -0,0 +1,588 @@
+/*******************************************************************************
+  SEC-DED ECC check bit model
+
+  File Name:
+    ecc_model.c
+
+  Summary:
+    Check bits of the TCM, FlexRAM and HEMC ECC controllers.
+
+  Description:
+    Encoding is table driven, one lookup per data byte. On x86 hosts
+    supporting AVX2, selected at run time, the batch encoder byte slices 32
+    data words in registers and looks up the check bits of 32 nibbles per
+    shuffle instruction.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#include <stdlib.h>
+#include <string.h>
+#include "ecc_model.h"
+
+#if ( defined(__x86_64__) || defined(__i386__) ) && ( defined(__GNUC__) || defined(__clang__) )
+#define ECC_MODEL_X86_AVX2 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+typedef struct
+{
+    const char* name;
+    unsigned int data_bits;
+    unsigned int check_bits;
+} ecc_model_geometry_t;
+
+static const ecc_model_geometry_t geometries[ECC_MODEL_NUM] =
+{
+    [ECC_MODEL_ITCM]    = { "itcm",    64U, 8U },
+    [ECC_MODEL_DTCM]    = { "dtcm",    32U, 7U },
+    [ECC_MODEL_FLEXRAM] = { "flexram", 32U, 7U },
+    [ECC_MODEL_HEMC]    = { "hemc",    32U, 7U },
+};
+
+/* Fit equation: data word and constant term, check bits */
+typedef struct
+{
+    uint64_t data;
+    uint8_t one;
+    uint8_t check;
+} ecc_model_row_t;
+
+static int forcePortable;
+
+static inline uint64_t data_mask(unsigned int data_bits)
+{
+    return (data_bits >= 64U) ? ~0ULL : ((1ULL << data_bits) - 1U);
+}
+
+static inline unsigned int weight(uint32_t value)
+{
+    unsigned int count = 0U;
+
+    while ( value != 0U )
+    {
+        value &= value - 1U;
+        count++;
+    }
+    return count;
+}
+
+const char* ecc_model_name(ecc_model_id_t id)
+{
+    return ((unsigned int)id < (unsigned int)ECC_MODEL_NUM) ? geometries[id].name : "unknown";
+}
+
+ecc_model_id_t ecc_model_lookup(const char* name)
+{
+    unsigned int id;
+
+    for (id = 0U; id < (unsigned int)ECC_MODEL_NUM; id++)
+    {
+        if ( strcmp(name, geometries[id].name) == 0 )
+        {
+            break;
+        }
+    }
+    return (ecc_model_id_t)id;
+}
+
+int ecc_model_init(ecc_model_t* model, unsigned int data_bits, unsigned int check_bits,
+                   const uint8_t* column, uint8_t constant)
+{
+    uint8_t set[ECC_MODEL_MAX_DATA_BITS + ECC_MODEL_MAX_CHECK_BITS];
+    uint8_t checkMask;
+    unsigned int setNum = 0U;
+    unsigned int i, j;
+    int secDed = 0;
+
+    if ( ( data_bits == 0U ) || ( data_bits > ECC_MODEL_MAX_DATA_BITS ) || ( (data_bits % 8U) != 0U ) ||
+         ( check_bits == 0U ) || ( check_bits > ECC_MODEL_MAX_CHECK_BITS ) )
+    {
+        return -1;
+    }
+    checkMask = (uint8_t)((1U << check_bits) - 1U);
+
+    memset(model, 0, sizeof(*model));
+    model->data_bits = data_bits;
+    model->check_bits = check_bits;
+    model->constant = constant & checkMask;
+    for (i = 0U; i < data_bits; i++)
+    {
+        model->column[i] = column[i] & checkMask;
+    }
+
+    for (i = 0U; i < (data_bits / 8U); i++)
+    {
+        for (j = 0U; j < 256U; j++)
+        {
+            uint8_t check = (i == 0U) ? model->constant : 0U;
+            unsigned int bit;
+
+            for (bit = 0U; bit < 8U; bit++)
+            {
+                if ( (j & (1U << bit)) != 0U )
+                {
+                    check ^= model->column[(i * 8U) + bit];
+                }
+            }
+            model->table[i][j] = check;
+        }
+    }
+
+    for (i = 0U; i < (data_bits / 4U); i++)
+    {
+        for (j = 0U; j < 16U; j++)
+        {
+            uint8_t check = (i == 0U) ? model->constant : 0U;
+            unsigned int bit;
+
+            for (bit = 0U; bit < 4U; bit++)
+            {
+                if ( (j & (1U << bit)) != 0U )
+                {
+                    check ^= model->column[(i * 4U) + bit];
+                }
+            }
+            model->nibble[i][j] = check;
+        }
+    }
+
+    /* Single error syndromes: a syndrome shared by two bits cannot be corrected */
+    memset(model->syndrome, ECC_MODEL_SYNDROME_NOFIX, sizeof(model->syndrome));
+    for (i = 0U; i < (data_bits + check_bits); i++)
+    {
+        uint8_t syndrome = (i < data_bits) ? model->column[i] : (uint8_t)(1U << (i - data_bits));
+
+        for (j = 0U; j < setNum; j++)
+        {
+            if ( set[j] == syndrome )
+            {
+                break;
+            }
+        }
+        if ( ( syndrome == 0U ) || ( j < setNum ) )
+        {
+            if ( syndrome != 0U )
+            {
+                model->syndrome[syndrome] = ECC_MODEL_SYNDROME_NOFIX;
+            }
+            secDed = 1;
+            continue;
+        }
+        set[setNum++] = syndrome;
+        model->syndrome[syndrome] = (uint8_t)((i < data_bits) ? i : (ECC_MODEL_MAX_DATA_BITS + (i - data_bits)));
+    }
+
+    /* Double errors must not alias a single error or no error */
+    for (i = 0U; ( i < setNum ) && ( secDed == 0 ); i++)
+    {
+        for (j = i + 1U; j < setNum; j++)
+        {
+            if ( model->syndrome[set[i] ^ set[j]] != ECC_MODEL_SYNDROME_NOFIX )
+            {
+                secDed = 1;
+                break;
+            }
+        }
+    }
+    return secDed;
+}
+
+void ecc_model_init_default(ecc_model_t* model, ecc_model_id_t id)
+{
+    uint8_t column[ECC_MODEL_MAX_DATA_BITS];
+    unsigned int hammingBits;
+    unsigned int position = 3U;
+    unsigned int i;
+
+    if ( (unsigned int)id >= (unsigned int)ECC_MODEL_NUM )
+    {
+        id = ECC_MODEL_FLEXRAM;
+    }
+    hammingBits = geometries[id].check_bits - 1U;
+
+    for (i = 0U; i < geometries[id].data_bits; i++, position++)
+    {
+        while ( (position & (position - 1U)) == 0U )
+        {
+            position++;
+        }
+        /* The overall parity covers the data bit and the Hamming bits it feeds */
+        column[i] = (uint8_t)(position & ((1U << hammingBits) - 1U));
+        if ( (weight(position) & 1U) == 0U )
+        {
+            column[i] |= (uint8_t)(1U << hammingBits);
+        }
+    }
+    (void)ecc_model_init(model, geometries[id].data_bits, geometries[id].check_bits, column, 0U);
+}
+
+uint8_t ecc_model_encode(const ecc_model_t* model, uint64_t data)
+{
+    uint8_t check = 0U;
+    unsigned int i;
+
+    for (i = 0U; i < (model->data_bits / 8U); i++)
+    {
+        check ^= model->table[i][(data >> (i * 8U)) & 0xFFU];
+    }
+    return check;
+}
+
+#ifdef ECC_MODEL_X86_AVX2
+
+/*
+ * Byte slice 32 words: after the in lane byte shuffle and three unpack
+ * stages, register p holds byte p of the 32 words, in the order returned in
+ * order[] by a first call on the word indexes.
+ */
+__attribute__((target("avx2")))
+static void byte_slice_avx2(const uint64_t* data, __m256i slice[8])
+{
+    const __m256i pairs = _mm256_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15,
+                                           0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+    __m256i r[8], t[8];
+    unsigned int i;
+
+    /* Each lane of r[i] holds the 16-bit pairs of byte 0 to 7 of two words */
+    for (i = 0U; i < 8U; i++)
+    {
+        r[i] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)&data[i * 4U]), pairs);
+    }
+    /* 8 x 8 transpose of the 16-bit pairs in each lane */
+    for (i = 0U; i < 8U; i += 2U)
+    {
+        t[i] = _mm256_unpacklo_epi16(r[i], r[i + 1U]);
+        t[i + 1U] = _mm256_unpackhi_epi16(r[i], r[i + 1U]);
+    }
+    for (i = 0U; i < 8U; i += 4U)
+    {
+        r[i] = _mm256_unpacklo_epi32(t[i], t[i + 2U]);
+        r[i + 1U] = _mm256_unpackhi_epi32(t[i], t[i + 2U]);
+        r[i + 2U] = _mm256_unpacklo_epi32(t[i + 1U], t[i + 3U]);
+        r[i + 3U] = _mm256_unpackhi_epi32(t[i + 1U], t[i + 3U]);
+    }
+    for (i = 0U; i < 4U; i++)
+    {
+        __m256i lo = _mm256_unpacklo_epi64(r[i], r[i + 4U]);
+        __m256i hi = _mm256_unpackhi_epi64(r[i], r[i + 4U]);
+
+        slice[i * 2U] = lo;
+        slice[(i * 2U) + 1U] = hi;
+    }
+}
+
+__attribute__((target("avx2")))
+static void encode_batch_avx2(const ecc_model_t* model, const uint64_t* data, uint8_t* check, size_t count)
+{
+    static uint8_t order[32];
+    static int orderReady;
+    const __m256i low = _mm256_set1_epi8(0x0F);
+    __m256i nibble[ECC_MODEL_MAX_DATA_BITS / 4U];
+    unsigned int bytes = model->data_bits / 8U;
+    unsigned int i;
+
+    if ( orderReady == 0 )
+    {
+        uint64_t index[32];
+        __m256i slice[8];
+
+        for (i = 0U; i < 32U; i++)
+        {
+            index[i] = i;
+        }
+        byte_slice_avx2(index, slice);
+        _mm256_storeu_si256((__m256i*)order, slice[0]);
+        orderReady = 1;
+    }
+    for (i = 0U; i < (bytes * 2U); i++)
+    {
+        nibble[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)model->nibble[i]));
+    }
+
+    while ( count >= 32U )
+    {
+        uint8_t out[32];
+        __m256i slice[8];
+        __m256i acc = _mm256_setzero_si256();
+
+        byte_slice_avx2(data, slice);
+        for (i = 0U; i < bytes; i++)
+        {
+            __m256i lo = _mm256_and_si256(slice[i], low);
+            __m256i hi = _mm256_and_si256(_mm256_srli_epi16(slice[i], 4), low);
+
+            acc = _mm256_xor_si256(acc, _mm256_shuffle_epi8(nibble[i * 2U], lo));
+            acc = _mm256_xor_si256(acc, _mm256_shuffle_epi8(nibble[(i * 2U) + 1U], hi));
+        }
+        _mm256_storeu_si256((__m256i*)out, acc);
+        for (i = 0U; i < 32U; i++)
+        {
+            check[order[i]] = out[i];
+        }
+
+        data += 32U;
+        check += 32U;
+        count -= 32U;
+    }
+
+    while ( count-- != 0U )
+    {
+        *check++ = ecc_model_encode(model, *data++);
+    }
+}
+
+static int avx2_supported(void)
+{
+    static int supported = -1;
+
+    if ( supported < 0 )
+    {
+        unsigned int eax, ebx, ecx, edx;
+
+        supported = 0;
+        if ( ( __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 ) && ( (ecx & bit_OSXSAVE) != 0U ) &&
+             ( __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0 ) && ( (ebx & bit_AVX2) != 0U ) )
+        {
+            supported = 1;
+        }
+    }
+    return supported;
+}
+
+#endif /* ECC_MODEL_X86_AVX2 */
+
+const char* ecc_model_engine(void)
+{
+#ifdef ECC_MODEL_X86_AVX2
+    if ( ( forcePortable == 0 ) && ( avx2_supported() != 0 ) )
+    {
+        return "avx2";
+    }
+#endif
+    return "portable";
+}
+
+void ecc_model_force_portable(int force)
+{
+    forcePortable = force;
+}
+
+void ecc_model_encode_batch(const ecc_model_t* model, const uint64_t* data, uint8_t* check, size_t count)
+{
+#ifdef ECC_MODEL_X86_AVX2
+    if ( ( forcePortable == 0 ) && ( avx2_supported() != 0 ) )
+    {
+        encode_batch_avx2(model, data, check, count);
+        return;
+    }
+#endif
+
+    /* Four independent words per iteration to overlap the table loads */
+    while ( count >= 4U )
+    {
+        uint8_t c0 = 0U, c1 = 0U, c2 = 0U, c3 = 0U;
+        unsigned int i;
+
+        for (i = 0U; i < (model->data_bits / 8U); i++)
+        {
+            const uint8_t* table = model->table[i];
+            unsigned int shift = i * 8U;
+
+            c0 ^= table[(data[0] >> shift) & 0xFFU];
+            c1 ^= table[(data[1] >> shift) & 0xFFU];
+            c2 ^= table[(data[2] >> shift) & 0xFFU];
+            c3 ^= table[(data[3] >> shift) & 0xFFU];
+        }
+        check[0] = c0;
+        check[1] = c1;
+        check[2] = c2;
+        check[3] = c3;
+
+        data += 4U;
+        check += 4U;
+        count -= 4U;
+    }
+
+    while ( count-- != 0U )
+    {
+        *check++ = ecc_model_encode(model, *data++);
+    }
+}
+
+ecc_model_status_t ecc_model_decode(const ecc_model_t* model, uint64_t data, uint8_t check,
+                                    uint64_t* corrected, int* bit)
+{
+    uint8_t syndrome = ecc_model_encode(model, data) ^ (check & (uint8_t)((1U << model->check_bits) - 1U));
+    ecc_model_status_t status = ECC_MODEL_STATUS_OK;
+    int index = -1;
+
+    if ( syndrome != 0U )
+    {
+        uint8_t position = model->syndrome[syndrome];
+
+        if ( position == ECC_MODEL_SYNDROME_NOFIX )
+        {
+            status = ECC_MODEL_STATUS_NOFIX;
+        }
+        else if ( position < ECC_MODEL_MAX_DATA_BITS )
+        {
+            status = ECC_MODEL_STATUS_FIX_DATA;
+            data ^= 1ULL << position;
+            index = (int)position;
+        }
+        else
+        {
+            status = ECC_MODEL_STATUS_FIX_CHECK;
+            index = (int)position;
+        }
+    }
+
+    if ( corrected != NULL )
+    {
+        *corrected = data;
+    }
+    if ( bit != NULL )
+    {
+        *bit = index;
+    }
+    return status;
+}
+
+ecc_model_status_t ecc_model_flip(const ecc_model_t* model, uint64_t data, uint64_t data_flip,
+                                  uint8_t check_flip, uint64_t* stored_data, uint8_t* stored_check)
+{
+    uint64_t mask = data_mask(model->data_bits);
+    uint64_t storedData = (data ^ data_flip) & mask;
+    uint8_t storedCheck = (ecc_model_encode(model, data & mask) ^ check_flip) &
+                          (uint8_t)((1U << model->check_bits) - 1U);
+
+    if ( stored_data != NULL )
+    {
+        *stored_data = storedData;
+    }
+    if ( stored_check != NULL )
+    {
+        *stored_check = storedCheck;
+    }
+    return ecc_model_decode(model, storedData, storedCheck, NULL, NULL);
+}
+
+int ecc_model_fit(ecc_model_t* model, unsigned int data_bits, unsigned int check_bits,
+                  const uint64_t* data, const uint8_t* check, size_t count, int* sec_ded)
+{
+    uint8_t column[ECC_MODEL_MAX_DATA_BITS];
+    uint8_t constant = 0U;
+    ecc_model_row_t* rows;
+    uint64_t mask = data_mask(data_bits);
+    size_t rank = 0U;
+    size_t r, s;
+    unsigned int c;
+    int result = 0;
+    int init;
+
+    if ( ( data_bits == 0U ) || ( data_bits > ECC_MODEL_MAX_DATA_BITS ) ||
+         ( check_bits == 0U ) || ( check_bits > ECC_MODEL_MAX_CHECK_BITS ) )
+    {
+        return -1;
+    }
+    if ( count < (size_t)(data_bits + 1U) )
+    {
+        return -1;
+    }
+    rows = malloc(count * sizeof(*rows));
+    if ( rows == NULL )
+    {
+        return -1;
+    }
+    for (r = 0U; r < count; r++)
+    {
+        rows[r].data = data[r] & mask;
+        rows[r].one = 1U;
+        rows[r].check = check[r] & (uint8_t)((1U << check_bits) - 1U);
+    }
+
+    /* Gauss-Jordan elimination over GF(2), unknowns are the data bit columns and the constant */
+    for (c = 0U; ( c <= data_bits ) && ( result == 0 ); c++)
+    {
+        for (r = rank; r < count; r++)
+        {
+            if ( ( (c < data_bits) ? ((rows[r].data >> c) & 1U) : rows[r].one ) != 0U )
+            {
+                break;
+            }
+        }
+        if ( r == count )
+        {
+            result = -1;
+            break;
+        }
+        if ( r != rank )
+        {
+            ecc_model_row_t tmp = rows[r];
+
+            rows[r] = rows[rank];
+            rows[rank] = tmp;
+        }
+        for (s = 0U; s < count; s++)
+        {
+            if ( ( s != rank ) &&
+                 ( ( (c < data_bits) ? ((rows[s].data >> c) & 1U) : rows[s].one ) != 0U ) )
+            {
+                rows[s].data ^= rows[rank].data;
+                rows[s].one ^= rows[rank].one;
+                rows[s].check ^= rows[rank].check;
+            }
+        }
+        rank++;
+    }
+
+    /* Remaining equations read 0 = check: any check bit set is a sample no code explains */
+    for (r = rank; ( r < count ) && ( result == 0 ); r++)
+    {
+        if ( rows[r].check != 0U )
+        {
+            result = -2;
+        }
+    }
+
+    if ( result == 0 )
+    {
+        for (c = 0U; c < data_bits; c++)
+        {
+            column[c] = rows[c].check;
+        }
+        constant = rows[data_bits].check;
+        init = ecc_model_init(model, data_bits, check_bits, column, constant);
+        if ( sec_ded != NULL )
+        {
+            *sec_ded = init;
+        }
+    }
+    free(rows);
+    return result;
+}
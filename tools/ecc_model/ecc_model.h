@@ -0,0 +1,165 @@
+/*******************************************************************************
+  SEC-DED ECC check bit model
+
+  File Name:
+    ecc_model.h
+
+  Summary:
+    Check bits of the TCM, FlexRAM and HEMC ECC controllers.
+
+  Description:
+    Portable C model of the Hamming SEC-DED codes of the ECC controllers. A
+    code is described by the check bits of each data bit (the columns of the
+    parity check matrix) and by the check bits of the all zero data word. The
+    model encodes single words and word arrays, with a vectorized batch
+    encoder on x86 hosts, classifies data and check bit flip patterns as the
+    controller does and fits a code on check bits read on the target. The
+    library has no dependency on the target headers.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef ECC_MODEL_H
+#define ECC_MODEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Maximum number of data bits of a code word */
+#define ECC_MODEL_MAX_DATA_BITS         (64U)
+
+/* Maximum number of check bits of a code word, the width of the TESTCB fields */
+#define ECC_MODEL_MAX_CHECK_BITS        (8U)
+
+/* ECC controllers with a check bit test mode */
+typedef enum
+{
+    ECC_MODEL_ITCM = 0,     /* TCMECC, 64-bit ITCM words, TCB1 */
+    ECC_MODEL_DTCM,         /* TCMECC, 32-bit DTCM words, TCB1 for bank 0 and TCB2 for bank 1 */
+    ECC_MODEL_FLEXRAM,      /* FLEXRAMECC, 32-bit words, TCB1 */
+    ECC_MODEL_HEMC,         /* HEMC Hamming code, 32-bit HSDRAMC words, TCB1 */
+    ECC_MODEL_NUM
+} ecc_model_id_t;
+
+/* Outcome of a read of a data word with its check bits */
+typedef enum
+{
+    ECC_MODEL_STATUS_OK = 0,        /* No error */
+    ECC_MODEL_STATUS_FIX_DATA,      /* Single error on a data bit, corrected */
+    ECC_MODEL_STATUS_FIX_CHECK,     /* Single error on a check bit, data is correct */
+    ECC_MODEL_STATUS_NOFIX          /* Uncorrectable error */
+} ecc_model_status_t;
+
+/* Code description and encoding tables */
+typedef struct
+{
+    unsigned int data_bits;
+    unsigned int check_bits;
+    /* Check bits of the data word with only bit i set, zero data word excluded */
+    uint8_t column[ECC_MODEL_MAX_DATA_BITS];
+    /* Check bits of the zero data word, non zero for codes with inverted check bits */
+    uint8_t constant;
+    /* Check bits of each value of each data byte, constant folded in byte 0 */
+    uint8_t table[ECC_MODEL_MAX_DATA_BITS / 8U][256];
+    /* Check bits of each value of each data nibble, constant folded in nibble 0 */
+    uint8_t nibble[ECC_MODEL_MAX_DATA_BITS / 4U][16];
+    /* Syndrome decoding: data bit index, ECC_MODEL_MAX_DATA_BITS + check bit index or ECC_MODEL_SYNDROME_NOFIX */
+    uint8_t syndrome[1U << ECC_MODEL_MAX_CHECK_BITS];
+} ecc_model_t;
+
+/* Syndrome table value of the uncorrectable syndromes */
+#define ECC_MODEL_SYNDROME_NOFIX        (0xFFU)
+
+/* Name of a controller model ("itcm", "dtcm", "flexram", "hemc") */
+const char* ecc_model_name(ecc_model_id_t id);
+
+/* Controller model of a name, ECC_MODEL_NUM if the name is unknown */
+ecc_model_id_t ecc_model_lookup(const char* name);
+
+/*
+ * Initialize a model from the columns of its parity check matrix. Return 0
+ * when the code is SEC-DED (distinct columns of odd weight greater than one),
+ * 1 when the code is only usable for encoding, -1 on wrong sizes.
+ */
+int ecc_model_init(ecc_model_t* model, unsigned int data_bits, unsigned int check_bits,
+                   const uint8_t* column, uint8_t constant);
+
+/*
+ * Initialize a model with the canonical extended Hamming code of the data
+ * and check widths of a controller: Hamming positions skipping the powers of
+ * two, overall parity in the most significant check bit. It is the reference
+ * until a code fitted on the target with ecc_model_fit() replaces it.
+ */
+void ecc_model_init_default(ecc_model_t* model, ecc_model_id_t id);
+
+/* Check bits of a data word */
+uint8_t ecc_model_encode(const ecc_model_t* model, uint64_t data);
+
+/* Name of the batch encoder in use: "avx2" or "portable" */
+const char* ecc_model_engine(void);
+
+/* Force the portable batch encoder, used to cross-check the accelerated one */
+void ecc_model_force_portable(int force);
+
+/* Check bits of an array of data words */
+void ecc_model_encode_batch(const ecc_model_t* model, const uint64_t* data, uint8_t* check, size_t count);
+
+/*
+ * Decode a data word read with its check bits. The corrected data and the
+ * index of the faulty bit (data bit, or ECC_MODEL_MAX_DATA_BITS + check bit)
+ * are returned when not NULL, the bit is -1 when there is no single error.
+ */
+ecc_model_status_t ecc_model_decode(const ecc_model_t* model, uint64_t data, uint8_t check,
+                                    uint64_t* corrected, int* bit);
+
+/*
+ * Content stored by a test mode write of a data word with a flip pattern:
+ * the data word with the data flips and its check bits with the check flips,
+ * as APP_ECC_INJECT_*_generate_error() does with the check bits read in test
+ * mode. Return the status the controller reports on the next read.
+ */
+ecc_model_status_t ecc_model_flip(const ecc_model_t* model, uint64_t data, uint64_t data_flip,
+                                  uint8_t check_flip, uint64_t* stored_data, uint8_t* stored_check);
+
+/*
+ * Fit the code of a controller on data words and check bits read on the
+ * target. Return 0 when the samples determine the code, -1 when they are not
+ * enough (fewer than data_bits + 1 independent words), -2 when no affine code
+ * matches them all. On success the model is initialized with the fitted code
+ * and the ecc_model_init() result is returned in sec_ded when not NULL.
+ */
+int ecc_model_fit(ecc_model_t* model, unsigned int data_bits, unsigned int check_bits,
+                  const uint64_t* data, const uint8_t* check, size_t count, int* sec_ded);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ECC_MODEL_H */
@@ -0,0 +1,586 @@
+/*******************************************************************************
+  ICM golden digest generator
+
+  File Name:
+    icm_digest.c
+
+  Summary:
+    Reference digests of memory areas in the ICM hash area layout.
+
+  Description:
+    Builds the memory content seen by the ICM from ELF files, binary images
+    and fill patterns, splits the monitored areas in chunks as the ICM scrub
+    scheduler does and computes the digest of each chunk. The digests are
+    written as a C table that can be linked in the application to start the
+    ICM in compare mode, or checked against the digests printed by the
+    target.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "icm_sha.h"
+
+#define MAX_AREAS           (64U)
+#define MAX_SEGMENTS        (256U)
+
+/* ELF32 definitions used by the loader */
+#define EI_NIDENT           (16U)
+#define ELFCLASS32          (1U)
+#define ELFDATA2LSB         (1U)
+#define SHT_PROGBITS        (1U)
+#define SHT_NOBITS          (8U)
+#define SHF_ALLOC           (0x2U)
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+    uint8_t* data;
+    const char* origin;
+} segment_t;
+
+typedef struct
+{
+    uint32_t address;
+    uint32_t size;
+} area_t;
+
+static segment_t segments[MAX_SEGMENTS];
+static unsigned int segmentNum;
+static area_t areas[MAX_AREAS];
+static unsigned int areaNum;
+
+static void fatal(const char* format, const char* arg)
+{
+    fprintf(stderr, "icm_digest: ");
+    fprintf(stderr, format, arg);
+    fprintf(stderr, "\n");
+    exit(EXIT_FAILURE);
+}
+
+static uint32_t parse_number(const char* text, const char** end)
+{
+    char* stop;
+    unsigned long value;
+
+    errno = 0;
+    value = strtoul(text, &stop, 0);
+    if ( ( stop == text ) || ( errno != 0 ) || ( value > 0xFFFFFFFFUL ) )
+    {
+        fatal("invalid number in '%s'", text);
+    }
+    if ( end != NULL )
+    {
+        *end = stop;
+    }
+    else if ( *stop != '\0' )
+    {
+        fatal("invalid number '%s'", text);
+    }
+    return (uint32_t)value;
+}
+
+static void segment_add(uint32_t address, uint32_t size, uint8_t* data, const char* origin)
+{
+    if ( segmentNum >= MAX_SEGMENTS )
+    {
+        fatal("too many memory segments (%s)", origin);
+    }
+    segments[segmentNum].address = address;
+    segments[segmentNum].size = size;
+    segments[segmentNum].data = data;
+    segments[segmentNum].origin = origin;
+    segmentNum++;
+}
+
+static uint8_t* read_file(const char* name, size_t* size)
+{
+    FILE* file = fopen(name, "rb");
+    uint8_t* data;
+    long length;
+
+    if ( file == NULL )
+    {
+        fatal("cannot open '%s'", name);
+    }
+    if ( ( fseek(file, 0, SEEK_END) != 0 ) || ( (length = ftell(file)) < 0 ) || ( fseek(file, 0, SEEK_SET) != 0 ) )
+    {
+        fatal("cannot read '%s'", name);
+    }
+    data = malloc((size_t)length + 1U);
+    if ( ( data == NULL ) || ( fread(data, 1U, (size_t)length, file) != (size_t)length ) )
+    {
+        fatal("cannot read '%s'", name);
+    }
+    fclose(file);
+    *size = (size_t)length;
+    return data;
+}
+
+static uint32_t le16(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t le32(const uint8_t* p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/* Load the allocated sections of an ELF32 little endian file at their run address */
+static void load_elf(const char* name)
+{
+    size_t size;
+    uint8_t* file = read_file(name, &size);
+    uint32_t shoff, shentsize, shnum, index;
+
+    if ( ( size < 52U ) || ( memcmp(file, "\177ELF", 4U) != 0 ) ||
+         ( file[4] != ELFCLASS32 ) || ( file[5] != ELFDATA2LSB ) )
+    {
+        fatal("'%s' is not an ELF32 little endian file", name);
+    }
+
+    shoff = le32(&file[32]);
+    shentsize = le16(&file[46]);
+    shnum = le16(&file[48]);
+    if ( ( shentsize < 40U ) || ( ((uint64_t)shoff + (uint64_t)shnum * shentsize) > size ) )
+    {
+        fatal("invalid section table in '%s'", name);
+    }
+
+    for (index = 0U; index < shnum; index++)
+    {
+        const uint8_t* sh = &file[shoff + index * shentsize];
+        uint32_t type = le32(&sh[4]);
+        uint32_t flags = le32(&sh[8]);
+        uint32_t address = le32(&sh[12]);
+        uint32_t offset = le32(&sh[16]);
+        uint32_t length = le32(&sh[20]);
+
+        if ( ( (flags & SHF_ALLOC) == 0U ) || ( length == 0U ) )
+        {
+            continue;
+        }
+        if ( type == SHT_PROGBITS )
+        {
+            if ( ((uint64_t)offset + length) > size )
+            {
+                fatal("section out of file in '%s'", name);
+            }
+            segment_add(address, length, &file[offset], name);
+        }
+        else if ( type == SHT_NOBITS )
+        {
+            /* Zero initialized by the startup code */
+            uint8_t* zero = calloc(length, 1U);
+
+            if ( zero == NULL )
+            {
+                fatal("out of memory loading '%s'", name);
+            }
+            segment_add(address, length, zero, name);
+        }
+        else
+        {
+            /* Not loaded in memory */
+        }
+    }
+}
+
+/* FILE@ADDRESS */
+static void load_binary(const char* arg)
+{
+    const char* at = strrchr(arg, '@');
+    char* name;
+    size_t size;
+    uint8_t* data;
+
+    if ( at == NULL )
+    {
+        fatal("binary image must be given as FILE@ADDRESS, not '%s'", arg);
+    }
+    name = malloc((size_t)(at - arg) + 1U);
+    if ( name == NULL )
+    {
+        fatal("out of memory loading '%s'", arg);
+    }
+    memcpy(name, arg, (size_t)(at - arg));
+    name[at - arg] = '\0';
+    data = read_file(name, &size);
+    if ( size > 0xFFFFFFFFUL )
+    {
+        fatal("'%s' is too large", name);
+    }
+    segment_add(parse_number(at + 1, NULL), (uint32_t)size, data, name);
+}
+
+/* ADDRESS:SIZE[:BYTE] */
+static void parse_range(const char* arg, uint32_t* address, uint32_t* size, int* byte)
+{
+    const char* p;
+
+    *address = parse_number(arg, &p);
+    if ( *p != ':' )
+    {
+        fatal("range must be given as ADDRESS:SIZE, not '%s'", arg);
+    }
+    *size = parse_number(p + 1, &p);
+    if ( byte != NULL )
+    {
+        if ( *p != ':' )
+        {
+            fatal("fill must be given as ADDRESS:SIZE:BYTE, not '%s'", arg);
+        }
+        *byte = (int)parse_number(p + 1, NULL);
+        if ( *byte > 0xFF )
+        {
+            fatal("invalid fill byte in '%s'", arg);
+        }
+    }
+    else if ( *p != '\0' )
+    {
+        fatal("range must be given as ADDRESS:SIZE, not '%s'", arg);
+    }
+}
+
+/* Build the memory content of [address, address + size), the last loaded segment wins */
+static void memory_read(uint32_t address, uint32_t size, uint8_t* out)
+{
+    static uint8_t* covered;
+    static size_t coveredSize;
+    unsigned int index;
+    uint32_t offset;
+
+    if ( coveredSize < size )
+    {
+        free(covered);
+        covered = malloc(size);
+        coveredSize = size;
+        if ( covered == NULL )
+        {
+            fatal("%s", "out of memory");
+        }
+    }
+    memset(covered, 0, size);
+
+    for (index = 0U; index < segmentNum; index++)
+    {
+        const segment_t* seg = &segments[index];
+        uint64_t start = (seg->address > address) ? seg->address : address;
+        uint64_t end = (uint64_t)seg->address + seg->size;
+
+        if ( end > ((uint64_t)address + size) )
+        {
+            end = (uint64_t)address + size;
+        }
+        if ( start < end )
+        {
+            memcpy(&out[start - address], &seg->data[start - seg->address], (size_t)(end - start));
+            memset(&covered[start - address], 1, (size_t)(end - start));
+        }
+    }
+
+    for (offset = 0U; offset < size; offset++)
+    {
+        if ( covered[offset] == 0U )
+        {
+            char text[32];
+
+            snprintf(text, sizeof(text), "0x%08lx", (unsigned long)(address + offset));
+            fatal("no content for address %s, add an image or a fill", text);
+        }
+    }
+}
+
+static icm_sha_algo_t parse_algo(const char* name)
+{
+    if ( strcmp(name, "sha1") == 0 )
+    {
+        return ICM_SHA_ALGO_SHA1;
+    }
+    if ( strcmp(name, "sha224") == 0 )
+    {
+        return ICM_SHA_ALGO_SHA224;
+    }
+    if ( strcmp(name, "sha256") == 0 )
+    {
+        return ICM_SHA_ALGO_SHA256;
+    }
+    fatal("unknown algorithm '%s'", name);
+    return ICM_SHA_ALGO_SHA1;
+}
+
+static void usage(void)
+{
+    fprintf(stderr,
+        "usage: icm_digest [options] -r ADDRESS:SIZE [-r ADDRESS:SIZE ...]\n"
+        "  -a ALGO              sha1 (default), sha224 or sha256\n"
+        "  -c SIZE              chunk size, multiple of 64 (default: one digest per area)\n"
+        "  -e FILE              load the allocated sections of an ELF32 file\n"
+        "  -b FILE@ADDRESS      load a binary image at ADDRESS\n"
+        "  -f ADDRESS:SIZE:BYTE fill memory with BYTE, as done at run time\n"
+        "  -r ADDRESS:SIZE      memory area monitored by the ICM, in scrub order\n"
+        "  -n NAME              table name (default icm_golden_digests)\n"
+        "  -o FILE              output C file (default stdout)\n"
+        "  -k FILE              check the ICM_DIGEST lines of a target log instead\n"
+        "  -p                   use the portable SHA implementation\n"
+        "Later images and fills override earlier ones.\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char* argv[])
+{
+    icm_sha_algo_t algo = ICM_SHA_ALGO_SHA1;
+    uint32_t chunkSize = 0U;
+    const char* name = "icm_golden_digests";
+    const char* output = NULL;
+    const char* check = NULL;
+    uint32_t (*table)[ICM_SHA_HASH_AREA_WORDS];
+    uint32_t* chunkAddress;
+    uint32_t* chunkBytes;
+    uint32_t chunkNum = 0U;
+    uint32_t index;
+    uint8_t* buffer;
+    uint32_t bufferSize = 0U;
+    int arg;
+
+    for (arg = 1; arg < argc; arg++)
+    {
+        const char* option = argv[arg];
+        const char* value;
+
+        if ( strcmp(option, "-p") == 0 )
+        {
+            icm_sha_force_portable(1);
+            continue;
+        }
+        if ( ( option[0] != '-' ) || ( option[1] == '\0' ) || ( option[2] != '\0' ) || ( (arg + 1) >= argc ) )
+        {
+            usage();
+        }
+        value = argv[++arg];
+
+        switch ( option[1] )
+        {
+            case 'a':
+                algo = parse_algo(value);
+                break;
+            case 'c':
+                chunkSize = parse_number(value, NULL);
+                if ( ( chunkSize == 0U ) || ( (chunkSize % ICM_SHA_BLOCK_SIZE) != 0U ) )
+                {
+                    fatal("chunk size '%s' is not a multiple of 64", value);
+                }
+                break;
+            case 'e':
+                load_elf(value);
+                break;
+            case 'b':
+                load_binary(value);
+                break;
+            case 'f':
+            {
+                uint32_t address, size;
+                int byte;
+                uint8_t* data;
+
+                parse_range(value, &address, &size, &byte);
+                data = malloc(size);
+                if ( data == NULL )
+                {
+                    fatal("out of memory for fill '%s'", value);
+                }
+                memset(data, byte, size);
+                segment_add(address, size, data, "fill");
+                break;
+            }
+            case 'r':
+                if ( areaNum >= MAX_AREAS )
+                {
+                    fatal("too many areas (%s)", value);
+                }
+                parse_range(value, &areas[areaNum].address, &areas[areaNum].size, NULL);
+                if ( ( areas[areaNum].size == 0U ) || ( (areas[areaNum].size % ICM_SHA_BLOCK_SIZE) != 0U ) ||
+                     ( (areas[areaNum].address & 0x3U) != 0U ) )
+                {
+                    fatal("area '%s' must be word aligned and a multiple of 64 bytes", value);
+                }
+                areaNum++;
+                break;
+            case 'n':
+                name = value;
+                break;
+            case 'o':
+                output = value;
+                break;
+            case 'k':
+                check = value;
+                break;
+            default:
+                usage();
+                break;
+        }
+    }
+
+    if ( areaNum == 0U )
+    {
+        usage();
+    }
+
+    /* Split the areas in chunks as APP_ICM_SCRUB does */
+    for (index = 0U; index < areaNum; index++)
+    {
+        uint32_t size = (chunkSize == 0U) ? areas[index].size : chunkSize;
+
+        chunkNum += (areas[index].size + size - 1U) / size;
+        if ( size > bufferSize )
+        {
+            bufferSize = size;
+        }
+    }
+    table = calloc(chunkNum, sizeof(*table));
+    chunkAddress = calloc(chunkNum, sizeof(uint32_t));
+    chunkBytes = calloc(chunkNum, sizeof(uint32_t));
+    buffer = malloc(bufferSize);
+    if ( ( table == NULL ) || ( chunkAddress == NULL ) || ( chunkBytes == NULL ) || ( buffer == NULL ) )
+    {
+        fatal("%s", "out of memory");
+    }
+
+    chunkNum = 0U;
+    for (index = 0U; index < areaNum; index++)
+    {
+        uint32_t offset;
+
+        for (offset = 0U; offset < areas[index].size; )
+        {
+            uint32_t size = areas[index].size - offset;
+            uint8_t digest[ICM_SHA_HASH_AREA_SIZE];
+            size_t digestSize;
+
+            if ( ( chunkSize != 0U ) && ( size > chunkSize ) )
+            {
+                size = chunkSize;
+            }
+            memory_read(areas[index].address + offset, size, buffer);
+            /* The ICM does not pad the chunk, its hash area gets the chaining state */
+            digestSize = icm_sha_raw(algo, buffer, size, digest);
+            icm_sha_to_hash_area(digest, digestSize, table[chunkNum]);
+            chunkAddress[chunkNum] = areas[index].address + offset;
+            chunkBytes[chunkNum] = size;
+            chunkNum++;
+            offset += size;
+        }
+    }
+
+    if ( check != NULL )
+    {
+        /* Compare with the "ICM_DIGEST <index> <address> <size>: <8 words>" lines of the target */
+        FILE* file = fopen(check, "r");
+        char line[512];
+        uint32_t checked = 0U;
+        uint32_t failed = 0U;
+
+        if ( file == NULL )
+        {
+            fatal("cannot open '%s'", check);
+        }
+        while ( fgets(line, sizeof(line), file) != NULL )
+        {
+            const char* p = strstr(line, "ICM_DIGEST");
+            unsigned long chunk, address, size, w[ICM_SHA_HASH_AREA_WORDS];
+
+            if ( p == NULL )
+            {
+                continue;
+            }
+            if ( sscanf(p, "ICM_DIGEST %lu %lx %lu: %lx %lx %lx %lx %lx %lx %lx %lx", &chunk, &address, &size,
+                        &w[0], &w[1], &w[2], &w[3], &w[4], &w[5], &w[6], &w[7]) != 11 )
+            {
+                fatal("malformed line '%s'", line);
+            }
+            if ( ( chunk >= chunkNum ) || ( address != chunkAddress[chunk] ) || ( size != chunkBytes[chunk] ) )
+            {
+                fprintf(stderr, "chunk %lu: 0x%08lx %lu bytes does not match the area configuration\n", chunk, address, size);
+                failed++;
+                continue;
+            }
+            for (index = 0U; index < ICM_SHA_HASH_AREA_WORDS; index++)
+            {
+                if ( w[index] != table[chunk][index] )
+                {
+                    break;
+                }
+            }
+            if ( index != ICM_SHA_HASH_AREA_WORDS )
+            {
+                fprintf(stderr, "chunk %lu: 0x%08lx %lu bytes digest mismatch\n", chunk, address, size);
+                failed++;
+            }
+            checked++;
+        }
+        fclose(file);
+        printf("%u digests checked, %u failed (%s)\n", (unsigned int)checked, (unsigned int)failed, icm_sha_engine());
+        return ( (failed == 0U) && (checked != 0U) ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    else
+    {
+        FILE* file = (output != NULL) ? fopen(output, "w") : stdout;
+        const char* algoName = (algo == ICM_SHA_ALGO_SHA1) ? "SHA1" : (algo == ICM_SHA_ALGO_SHA224) ? "SHA224" : "SHA256";
+
+        if ( file == NULL )
+        {
+            fatal("cannot create '%s'", output);
+        }
+        fprintf(file, "/* Generated by tools/icm_digest, do not edit.\n");
+        fprintf(file, " * ICM %s reference digests, in the hash area layout, one per chunk in scrub order.\n */\n\n", algoName);
+        fprintf(file, "#include <stdint.h>\n\n");
+        fprintf(file, "const uint32_t %s_count = %uU;\n\n", name, (unsigned int)chunkNum);
+        fprintf(file, "const uint32_t %s[%u][%u] =\n{\n", name, (unsigned int)chunkNum, ICM_SHA_HASH_AREA_WORDS);
+        for (index = 0U; index < chunkNum; index++)
+        {
+            unsigned int word;
+
+            fprintf(file, "    /* 0x%08lx, %lu bytes */\n    {", (unsigned long)chunkAddress[index], (unsigned long)chunkBytes[index]);
+            for (word = 0U; word < ICM_SHA_HASH_AREA_WORDS; word++)
+            {
+                fprintf(file, " 0x%08lxUL%s", (unsigned long)table[index][word], (word + 1U < ICM_SHA_HASH_AREA_WORDS) ? "," : " ");
+            }
+            fprintf(file, "},\n");
+        }
+        fprintf(file, "};\n");
+        if ( file != stdout )
+        {
+            fclose(file);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
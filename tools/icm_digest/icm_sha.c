@@ -0,0 +1,534 @@
+/*******************************************************************************
+  ICM reference SHA library
+
+  File Name:
+    icm_sha.c
+
+  Summary:
+    SHA-1, SHA-224 and SHA-256 implementation.
+
+  Description:
+    Portable C implementation of the hash algorithms of the ICM. On x86 hosts
+    supporting the SHA extensions, the block functions use them, selected at
+    run time. The library has no dependency on the target headers.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#include <string.h>
+#include "icm_sha.h"
+
+#if ( defined(__x86_64__) || defined(__i386__) ) && ( defined(__GNUC__) || defined(__clang__) )
+#define ICM_SHA_X86_SHANI 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+typedef void (*icm_sha_blocks_t)(uint32_t state[8], const uint8_t* data, size_t blocks);
+
+static const uint32_t sha1Init[5] =
+{
+    0x67452301UL, 0xEFCDAB89UL, 0x98BADCFEUL, 0x10325476UL, 0xC3D2E1F0UL
+};
+
+static const uint32_t sha224Init[8] =
+{
+    0xC1059ED8UL, 0x367CD507UL, 0x3070DD17UL, 0xF70E5939UL,
+    0xFFC00B31UL, 0x68581511UL, 0x64F98FA7UL, 0xBEFA4FA4UL
+};
+
+static const uint32_t sha256Init[8] =
+{
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+static const uint32_t sha256K[64] =
+{
+    0x428A2F98UL, 0x71374491UL, 0xB5C0FBCFUL, 0xE9B5DBA5UL, 0x3956C25BUL, 0x59F111F1UL, 0x923F82A4UL, 0xAB1C5ED5UL,
+    0xD807AA98UL, 0x12835B01UL, 0x243185BEUL, 0x550C7DC3UL, 0x72BE5D74UL, 0x80DEB1FEUL, 0x9BDC06A7UL, 0xC19BF174UL,
+    0xE49B69C1UL, 0xEFBE4786UL, 0x0FC19DC6UL, 0x240CA1CCUL, 0x2DE92C6FUL, 0x4A7484AAUL, 0x5CB0A9DCUL, 0x76F988DAUL,
+    0x983E5152UL, 0xA831C66DUL, 0xB00327C8UL, 0xBF597FC7UL, 0xC6E00BF3UL, 0xD5A79147UL, 0x06CA6351UL, 0x14292967UL,
+    0x27B70A85UL, 0x2E1B2138UL, 0x4D2C6DFCUL, 0x53380D13UL, 0x650A7354UL, 0x766A0ABBUL, 0x81C2C92EUL, 0x92722C85UL,
+    0xA2BFE8A1UL, 0xA81A664BUL, 0xC24B8B70UL, 0xC76C51A3UL, 0xD192E819UL, 0xD6990624UL, 0xF40E3585UL, 0x106AA070UL,
+    0x19A4C116UL, 0x1E376C08UL, 0x2748774CUL, 0x34B0BCB5UL, 0x391C0CB3UL, 0x4ED8AA4AUL, 0x5B9CCA4FUL, 0x682E6FF3UL,
+    0x748F82EEUL, 0x78A5636FUL, 0x84C87814UL, 0x8CC70208UL, 0x90BEFFFAUL, 0xA4506CEBUL, 0xBEF9A3F7UL, 0xC67178F2UL
+};
+
+static int forcePortable;
+
+static inline uint32_t rotl32(uint32_t x, unsigned int n)
+{
+    return (x << n) | (x >> (32U - n));
+}
+
+static inline uint32_t rotr32(uint32_t x, unsigned int n)
+{
+    return (x >> n) | (x << (32U - n));
+}
+
+static inline uint32_t load_be32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void store_be32(uint8_t* p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+/* Portable block functions */
+
+static void sha1_blocks_portable(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+    uint32_t w[80];
+
+    while ( blocks-- != 0U )
+    {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        unsigned int t;
+
+        for (t = 0U; t < 16U; t++)
+        {
+            w[t] = load_be32(&data[t * 4U]);
+        }
+        for (t = 16U; t < 80U; t++)
+        {
+            w[t] = rotl32(w[t - 3U] ^ w[t - 8U] ^ w[t - 14U] ^ w[t - 16U], 1U);
+        }
+
+#define SHA1_ROUND(f, k)                                                  \
+        do                                                                    \
+        {                                                                     \
+            uint32_t tmp = rotl32(a, 5U) + (f) + e + (k) + w[t];              \
+            e = d;                                                            \
+            d = c;                                                            \
+            c = rotl32(b, 30U);                                               \
+            b = a;                                                            \
+            a = tmp;                                                          \
+        } while (0)
+
+        for (t = 0U; t < 20U; t++)
+        {
+            SHA1_ROUND((b & c) | (~b & d), 0x5A827999U);
+        }
+        for (; t < 40U; t++)
+        {
+            SHA1_ROUND(b ^ c ^ d, 0x6ED9EBA1U);
+        }
+        for (; t < 60U; t++)
+        {
+            SHA1_ROUND((b & c) | (b & d) | (c & d), 0x8F1BBCDCU);
+        }
+        for (; t < 80U; t++)
+        {
+            SHA1_ROUND(b ^ c ^ d, 0xCA62C1D6U);
+        }
+#undef SHA1_ROUND
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        data += ICM_SHA_BLOCK_SIZE;
+    }
+}
+
+static void sha256_blocks_portable(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+    uint32_t w[64];
+
+    while ( blocks-- != 0U )
+    {
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        unsigned int t;
+
+        for (t = 0U; t < 16U; t++)
+        {
+            w[t] = load_be32(&data[t * 4U]);
+        }
+        for (t = 16U; t < 64U; t++)
+        {
+            uint32_t s0 = rotr32(w[t - 15U], 7U) ^ rotr32(w[t - 15U], 18U) ^ (w[t - 15U] >> 3);
+            uint32_t s1 = rotr32(w[t - 2U], 17U) ^ rotr32(w[t - 2U], 19U) ^ (w[t - 2U] >> 10);
+            w[t] = w[t - 16U] + s0 + w[t - 7U] + s1;
+        }
+
+        for (t = 0U; t < 64U; t++)
+        {
+            uint32_t s1 = rotr32(e, 6U) ^ rotr32(e, 11U) ^ rotr32(e, 25U);
+            uint32_t ch = (e & f) ^ (~e & g);
+            uint32_t t1 = h + s1 + ch + sha256K[t] + w[t];
+            uint32_t s0 = rotr32(a, 2U) ^ rotr32(a, 13U) ^ rotr32(a, 22U);
+            uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+            uint32_t t2 = s0 + maj;
+
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+        data += ICM_SHA_BLOCK_SIZE;
+    }
+}
+
+#ifdef ICM_SHA_X86_SHANI
+
+/* x86 SHA extensions block functions */
+
+#define ICM_SHA_TARGET __attribute__((target("sha,sse4.1,ssse3")))
+
+/* Four SHA-1 rounds of group g, message schedule interleaved with the rounds */
+#define SHA1_GROUP(g)                                                         \
+    do                                                                        \
+    {                                                                         \
+        if ( (g) == 0 )                                                       \
+        {                                                                     \
+            e[0] = _mm_add_epi32(e[0], msg[0]);                               \
+        }                                                                     \
+        else                                                                  \
+        {                                                                     \
+            e[(g) & 1] = _mm_sha1nexte_epu32(e[(g) & 1], msg[(g) & 3]);       \
+        }                                                                     \
+        e[((g) + 1) & 1] = abcd;                                              \
+        if ( ( (g) >= 3 ) && ( (g) <= 18 ) )                                  \
+        {                                                                     \
+            msg[((g) + 1) & 3] = _mm_sha1msg2_epu32(msg[((g) + 1) & 3], msg[(g) & 3]); \
+        }                                                                     \
+        abcd = _mm_sha1rnds4_epu32(abcd, e[(g) & 1], (g) / 5);                \
+        if ( ( (g) >= 1 ) && ( (g) <= 16 ) )                                  \
+        {                                                                     \
+            msg[((g) + 3) & 3] = _mm_sha1msg1_epu32(msg[((g) + 3) & 3], msg[(g) & 3]); \
+        }                                                                     \
+        if ( ( (g) >= 2 ) && ( (g) <= 17 ) )                                  \
+        {                                                                     \
+            msg[((g) + 2) & 3] = _mm_xor_si128(msg[((g) + 2) & 3], msg[(g) & 3]); \
+        }                                                                     \
+    } while (0)
+
+ICM_SHA_TARGET
+static void sha1_blocks_shani(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607LL, 0x08090a0b0c0d0e0fLL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0x1B);
+    __m128i e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+
+    while ( blocks-- != 0U )
+    {
+        __m128i abcdSave = abcd;
+        __m128i e0Save = e0;
+        __m128i e[2];
+        __m128i msg[4];
+        unsigned int i;
+
+        for (i = 0U; i < 4U; i++)
+        {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&data[i * 16U]), mask);
+        }
+        e[0] = e0;
+        e[1] = e0;
+
+        SHA1_GROUP(0);  SHA1_GROUP(1);  SHA1_GROUP(2);  SHA1_GROUP(3);
+        SHA1_GROUP(4);  SHA1_GROUP(5);  SHA1_GROUP(6);  SHA1_GROUP(7);
+        SHA1_GROUP(8);  SHA1_GROUP(9);  SHA1_GROUP(10); SHA1_GROUP(11);
+        SHA1_GROUP(12); SHA1_GROUP(13); SHA1_GROUP(14); SHA1_GROUP(15);
+        SHA1_GROUP(16); SHA1_GROUP(17); SHA1_GROUP(18); SHA1_GROUP(19);
+
+        e0 = _mm_sha1nexte_epu32(e[0], e0Save);
+        abcd = _mm_add_epi32(abcd, abcdSave);
+        data += ICM_SHA_BLOCK_SIZE;
+    }
+
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+ICM_SHA_TARGET
+static void sha256_blocks_shani(uint32_t state[8], const uint8_t* data, size_t blocks)
+{
+    const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bLL, 0x0405060700010203LL);
+    __m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[0]), 0xB1);
+    __m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state[4]), 0x1B);
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);
+
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    while ( blocks-- != 0U )
+    {
+        __m128i abefSave = state0;
+        __m128i cdghSave = state1;
+        __m128i msg[4];
+        unsigned int g;
+
+        for (g = 0U; g < 16U; g++)
+        {
+            __m128i wk;
+
+            if ( g < 4U )
+            {
+                msg[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&data[g * 16U]), mask);
+            }
+            else
+            {
+                tmp = _mm_add_epi32(_mm_sha256msg1_epu32(msg[g & 3U], msg[(g + 1U) & 3U]),
+                                    _mm_alignr_epi8(msg[(g + 3U) & 3U], msg[(g + 2U) & 3U], 4));
+                msg[g & 3U] = _mm_sha256msg2_epu32(tmp, msg[(g + 3U) & 3U]);
+            }
+
+            wk = _mm_add_epi32(msg[g & 3U], _mm_loadu_si128((const __m128i*)&sha256K[g * 4U]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, wk);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(wk, 0x0E));
+        }
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+        data += ICM_SHA_BLOCK_SIZE;
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128((__m128i*)&state[0], _mm_blend_epi16(tmp, state1, 0xF0));
+    _mm_storeu_si128((__m128i*)&state[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+static int shani_supported(void)
+{
+    static int supported = -1;
+
+    if ( supported < 0 )
+    {
+        unsigned int eax, ebx, ecx, edx;
+
+        supported = 0;
+        if ( ( __get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0 ) &&
+             ( (ecx & bit_SSSE3) != 0U ) && ( (ecx & bit_SSE4_1) != 0U ) &&
+             ( __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) != 0 ) &&
+             ( (ebx & bit_SHA) != 0U ) )
+        {
+            supported = 1;
+        }
+    }
+    return supported;
+}
+
+#endif /* ICM_SHA_X86_SHANI */
+
+static icm_sha_blocks_t blocks_function(icm_sha_algo_t algo)
+{
+#ifdef ICM_SHA_X86_SHANI
+    if ( ( forcePortable == 0 ) && ( shani_supported() != 0 ) )
+    {
+        return (algo == ICM_SHA_ALGO_SHA1) ? sha1_blocks_shani : sha256_blocks_shani;
+    }
+#endif
+    return (algo == ICM_SHA_ALGO_SHA1) ? sha1_blocks_portable : sha256_blocks_portable;
+}
+
+size_t icm_sha_digest_size(icm_sha_algo_t algo)
+{
+    switch ( algo )
+    {
+        case ICM_SHA_ALGO_SHA1:
+            return 20U;
+        case ICM_SHA_ALGO_SHA224:
+            return 28U;
+        case ICM_SHA_ALGO_SHA256:
+            return 32U;
+        default:
+            return 0U;
+    }
+}
+
+const char* icm_sha_engine(void)
+{
+#ifdef ICM_SHA_X86_SHANI
+    if ( ( forcePortable == 0 ) && ( shani_supported() != 0 ) )
+    {
+        return "sha-ni";
+    }
+#endif
+    return "portable";
+}
+
+void icm_sha_force_portable(int force)
+{
+    forcePortable = force;
+}
+
+void icm_sha_init(icm_sha_ctx_t* ctx, icm_sha_algo_t algo)
+{
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->algo = algo;
+
+    if ( algo == ICM_SHA_ALGO_SHA1 )
+    {
+        memcpy(ctx->state, sha1Init, sizeof(sha1Init));
+    }
+    else if ( algo == ICM_SHA_ALGO_SHA224 )
+    {
+        memcpy(ctx->state, sha224Init, sizeof(sha224Init));
+    }
+    else
+    {
+        memcpy(ctx->state, sha256Init, sizeof(sha256Init));
+    }
+}
+
+void icm_sha_update(icm_sha_ctx_t* ctx, const void* data, size_t size)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    icm_sha_blocks_t blocks = blocks_function(ctx->algo);
+
+    ctx->length += size;
+
+    if ( ctx->fill != 0U )
+    {
+        size_t n = ICM_SHA_BLOCK_SIZE - ctx->fill;
+
+        if ( n > size )
+        {
+            n = size;
+        }
+        memcpy(&ctx->block[ctx->fill], p, n);
+        ctx->fill += n;
+        p += n;
+        size -= n;
+        if ( ctx->fill < ICM_SHA_BLOCK_SIZE )
+        {
+            return;
+        }
+        blocks(ctx->state, ctx->block, 1U);
+        ctx->fill = 0U;
+    }
+
+    if ( size >= ICM_SHA_BLOCK_SIZE )
+    {
+        size_t n = size / ICM_SHA_BLOCK_SIZE;
+
+        blocks(ctx->state, p, n);
+        p += n * ICM_SHA_BLOCK_SIZE;
+        size -= n * ICM_SHA_BLOCK_SIZE;
+    }
+
+    memcpy(ctx->block, p, size);
+    ctx->fill = size;
+}
+
+size_t icm_sha_final(icm_sha_ctx_t* ctx, uint8_t digest[ICM_SHA_HASH_AREA_SIZE])
+{
+    icm_sha_blocks_t blocks = blocks_function(ctx->algo);
+    uint64_t bits = ctx->length * 8U;
+    size_t size = icm_sha_digest_size(ctx->algo);
+    size_t i;
+
+    ctx->block[ctx->fill++] = 0x80U;
+    if ( ctx->fill > (ICM_SHA_BLOCK_SIZE - 8U) )
+    {
+        memset(&ctx->block[ctx->fill], 0, ICM_SHA_BLOCK_SIZE - ctx->fill);
+        blocks(ctx->state, ctx->block, 1U);
+        ctx->fill = 0U;
+    }
+    memset(&ctx->block[ctx->fill], 0, (ICM_SHA_BLOCK_SIZE - 8U) - ctx->fill);
+    store_be32(&ctx->block[56], (uint32_t)(bits >> 32));
+    store_be32(&ctx->block[60], (uint32_t)bits);
+    blocks(ctx->state, ctx->block, 1U);
+
+    memset(digest, 0, ICM_SHA_HASH_AREA_SIZE);
+    for (i = 0U; i < (size / 4U); i++)
+    {
+        store_be32(&digest[i * 4U], ctx->state[i]);
+    }
+    return size;
+}
+
+size_t icm_sha(icm_sha_algo_t algo, const void* data, size_t size, uint8_t digest[ICM_SHA_HASH_AREA_SIZE])
+{
+    icm_sha_ctx_t ctx;
+
+    icm_sha_init(&ctx, algo);
+    icm_sha_update(&ctx, data, size);
+    return icm_sha_final(&ctx, digest);
+}
+
+size_t icm_sha_state(const icm_sha_ctx_t* ctx, uint8_t digest[ICM_SHA_HASH_AREA_SIZE])
+{
+    size_t size = icm_sha_digest_size(ctx->algo);
+    size_t i;
+
+    if ( ctx->fill != 0U )
+    {
+        return 0U;
+    }
+
+    memset(digest, 0, ICM_SHA_HASH_AREA_SIZE);
+    for (i = 0U; i < (size / 4U); i++)
+    {
+        store_be32(&digest[i * 4U], ctx->state[i]);
+    }
+    return size;
+}
+
+size_t icm_sha_raw(icm_sha_algo_t algo, const void* data, size_t size, uint8_t digest[ICM_SHA_HASH_AREA_SIZE])
+{
+    icm_sha_ctx_t ctx;
+
+    icm_sha_init(&ctx, algo);
+    icm_sha_update(&ctx, data, size);
+    return icm_sha_state(&ctx, digest);
+}
+
+void icm_sha_to_hash_area(const uint8_t digest[ICM_SHA_HASH_AREA_SIZE], size_t size,
+                          uint32_t words[ICM_SHA_HASH_AREA_WORDS])
+{
+    size_t i;
+
+    for (i = 0U; i < ICM_SHA_HASH_AREA_WORDS; i++)
+    {
+        const uint8_t* p = &digest[i * 4U];
+
+        words[i] = ((i * 4U) < size) ?
+                   (((uint32_t)p[3] << 24) | ((uint32_t)p[2] << 16) | ((uint32_t)p[1] << 8) | (uint32_t)p[0]) :
+                   0U;
+    }
+}
@@ -0,0 +1,122 @@
+/*******************************************************************************
+  ICM reference SHA library
+
+  File Name:
+    icm_sha.h
+
+  Summary:
+    SHA-1, SHA-224 and SHA-256 digests in the ICM hash area layout.
+
+  Description:
+    Portable C implementation of the hash algorithms of the ICM. On x86 hosts
+    supporting the SHA extensions, the block functions use them, selected at
+    run time. The library has no dependency on the target headers.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#ifndef ICM_SHA_H
+#define ICM_SHA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Size in bytes of the hash area of one ICM region */
+#define ICM_SHA_HASH_AREA_SIZE          (32U)
+
+/* Number of words of the hash area of one ICM region */
+#define ICM_SHA_HASH_AREA_WORDS         (ICM_SHA_HASH_AREA_SIZE / 4U)
+
+/* SHA block size in bytes, also the ICM transfer block size */
+#define ICM_SHA_BLOCK_SIZE              (64U)
+
+/* Hash algorithms, values of the ALGO field of ICM_RCFG */
+typedef enum
+{
+    ICM_SHA_ALGO_SHA1 = 0,
+    ICM_SHA_ALGO_SHA256 = 1,
+    ICM_SHA_ALGO_SHA224 = 4
+} icm_sha_algo_t;
+
+/* Hash computation context */
+typedef struct
+{
+    icm_sha_algo_t algo;
+    uint32_t state[8];
+    uint64_t length;
+    uint8_t block[ICM_SHA_BLOCK_SIZE];
+    size_t fill;
+} icm_sha_ctx_t;
+
+/* Size in bytes of the digest of an algorithm, 0 if the algorithm is unknown */
+size_t icm_sha_digest_size(icm_sha_algo_t algo);
+
+/* Name of the block implementation in use: "sha-ni" or "portable" */
+const char* icm_sha_engine(void);
+
+/* Force the portable implementation, used to cross-check the accelerated one */
+void icm_sha_force_portable(int force);
+
+void icm_sha_init(icm_sha_ctx_t* ctx, icm_sha_algo_t algo);
+
+void icm_sha_update(icm_sha_ctx_t* ctx, const void* data, size_t size);
+
+/* Write the digest in standard byte order, return its size */
+size_t icm_sha_final(icm_sha_ctx_t* ctx, uint8_t digest[ICM_SHA_HASH_AREA_SIZE]);
+
+/* One call digest */
+size_t icm_sha(icm_sha_algo_t algo, const void* data, size_t size, uint8_t digest[ICM_SHA_HASH_AREA_SIZE]);
+
+/*
+ * Write the chaining state after the last block in standard byte order,
+ * without padding, return its size. This is what the ICM writes for a
+ * region: it does not pad the data, a region holding its own padding gives
+ * the standard digest. Returns 0 when the data is not a whole number of
+ * blocks.
+ */
+size_t icm_sha_state(const icm_sha_ctx_t* ctx, uint8_t digest[ICM_SHA_HASH_AREA_SIZE]);
+
+/* One call chaining state, as computed by the ICM */
+size_t icm_sha_raw(icm_sha_algo_t algo, const void* data, size_t size, uint8_t digest[ICM_SHA_HASH_AREA_SIZE]);
+
+/*
+ * Convert a digest or a chaining state to the words the ICM writes in the
+ * hash area of a region, as read by the little endian Cortex-M7: the bytes
+ * are stored in standard order and the rest of the 32 bytes area is left to
+ * zero.
+ */
+void icm_sha_to_hash_area(const uint8_t digest[ICM_SHA_HASH_AREA_SIZE], size_t size,
+                          uint32_t words[ICM_SHA_HASH_AREA_WORDS]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ICM_SHA_H */
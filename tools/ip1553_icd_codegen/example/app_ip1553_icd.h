@@ -0,0 +1,300 @@
+/*******************************************************************************
+  IP1553 Interface Control Description codec
+
+  File Name:
+    app_ip1553_icd.h
+
+  Summary:
+    Message structures, pack/unpack and range check functions.
+
+  Description:
+    This file is generated by tools/ip1553_icd_codegen from icd_example.csv.
+    Do not edit it by hand, update the ICD and regenerate it instead.
+*******************************************************************************/
+
+#ifndef APP_IP1553_ICD_H
+#define APP_IP1553_ICD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus // Provide C++ Compatibility
+    extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: ICD defines
+// *****************************************************************************
+// *****************************************************************************
+/* Number of sub-address buffers, must match IP1553_BUFFERS_NUM */
+#define APP_IP1553_ICD_BUFFERS_NUM                (32U)
+
+/* Number of 16 bit words in one buffer, must match IP1553_BUFFERS_SIZE */
+#define APP_IP1553_ICD_BUFFERS_SIZE               (32U)
+
+#if defined(IP1553_BUFFERS_NUM) && defined(IP1553_BUFFERS_SIZE)
+#if (IP1553_BUFFERS_NUM != APP_IP1553_ICD_BUFFERS_NUM) || (IP1553_BUFFERS_SIZE != APP_IP1553_ICD_BUFFERS_SIZE)
+#error "ICD buffer geometry does not match the IP1553 PLIB"
+#endif
+#endif
+
+/* Sign extend the 'width' low bits of 'raw' */
+#define APP_IP1553_ICD_SIGN_EXTEND(raw, width)    ((int32_t)(((uint32_t)(raw) ^ (1UL << ((width) - 1U))) - (1UL << ((width) - 1U))))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Message ATTITUDE_CMD (RT01 SA1 BC to RT, 4 words)
+// *****************************************************************************
+// *****************************************************************************
+#define APP_IP1553_ICD_ATTITUDE_CMD_RT                      (1U)
+#define APP_IP1553_ICD_ATTITUDE_CMD_SA                      (1U)
+#define APP_IP1553_ICD_ATTITUDE_CMD_WORD_COUNT              (4U)
+#define APP_IP1553_ICD_ATTITUDE_CMD_IS_RT_TX                (false)
+
+/* ATTITUDE_CMD raw field values */
+typedef struct
+{
+    /* word 0, bits 15..0, LSB = 0.01 deg, offset = 0 */
+    int16_t roll;
+    /* word 1, bits 15..0, LSB = 0.01 deg, offset = 0 */
+    int16_t pitch;
+    /* word 2, bits 15..0, LSB = 0.01 deg, offset = 0 */
+    int16_t yaw;
+    /* word 3, bit 15 */
+    uint8_t valid;
+    /* word 3, bits 11..8 */
+    uint8_t mode;
+    /* word 3, bits 7..0 */
+    uint8_t sequence;
+} APP_IP1553_ICD_ATTITUDE_CMD_T;
+
+/* Pack ATTITUDE_CMD into its sub-address buffer (4 words written) */
+static inline void APP_IP1553_ICD_ATTITUDE_CMD_Pack(const APP_IP1553_ICD_ATTITUDE_CMD_T* msg, uint16_t* buffer)
+{
+    buffer[0] = (uint16_t)(((uint32_t)msg->roll & 0xFFFFUL));
+    buffer[1] = (uint16_t)(((uint32_t)msg->pitch & 0xFFFFUL));
+    buffer[2] = (uint16_t)(((uint32_t)msg->yaw & 0xFFFFUL));
+    buffer[3] = (uint16_t)((((uint32_t)msg->valid & 0x1UL) << 15U) |
+                            (((uint32_t)msg->mode & 0xFUL) << 8U) |
+                            ((uint32_t)msg->sequence & 0xFFUL));
+}
+
+/* Unpack ATTITUDE_CMD from its sub-address buffer */
+static inline void APP_IP1553_ICD_ATTITUDE_CMD_Unpack(const uint16_t* buffer, APP_IP1553_ICD_ATTITUDE_CMD_T* msg)
+{
+    msg->roll = (int16_t)((uint32_t)buffer[0]);
+    msg->pitch = (int16_t)((uint32_t)buffer[1]);
+    msg->yaw = (int16_t)((uint32_t)buffer[2]);
+    msg->valid = (uint8_t)((((uint32_t)buffer[3] >> 15U) & 0x1UL));
+    msg->mode = (uint8_t)((((uint32_t)buffer[3] >> 8U) & 0xFUL));
+    msg->sequence = (uint8_t)(((uint32_t)buffer[3] & 0xFFUL));
+}
+
+/* Pack ATTITUDE_CMD in the 32 x 32 IP1553 buffers at its sub-address */
+static inline void APP_IP1553_ICD_ATTITUDE_CMD_PackSA(const APP_IP1553_ICD_ATTITUDE_CMD_T* msg, uint16_t buffers[][APP_IP1553_ICD_BUFFERS_SIZE])
+{
+    APP_IP1553_ICD_ATTITUDE_CMD_Pack(msg, &buffers[APP_IP1553_ICD_ATTITUDE_CMD_SA][0]);
+}
+
+/* Unpack ATTITUDE_CMD from the 32 x 32 IP1553 buffers at its sub-address */
+static inline void APP_IP1553_ICD_ATTITUDE_CMD_UnpackSA(const uint16_t buffers[][APP_IP1553_ICD_BUFFERS_SIZE], APP_IP1553_ICD_ATTITUDE_CMD_T* msg)
+{
+    APP_IP1553_ICD_ATTITUDE_CMD_Unpack(&buffers[APP_IP1553_ICD_ATTITUDE_CMD_SA][0], msg);
+}
+
+/* Check that every ATTITUDE_CMD field lies in its ICD range */
+static inline bool APP_IP1553_ICD_ATTITUDE_CMD_Check(const APP_IP1553_ICD_ATTITUDE_CMD_T* msg)
+{
+    return ( (msg->roll >= (-18000)) &&
+             (msg->roll <= 18000) &&
+             (msg->pitch >= (-9000)) &&
+             (msg->pitch <= 9000) &&
+             (msg->yaw >= (-18000)) &&
+             (msg->yaw <= 18000) &&
+             (msg->valid <= 1U) &&
+             (msg->mode <= 9U) );
+}
+
+/* ATTITUDE_CMD.roll conversion between raw value and deg */
+static inline float APP_IP1553_ICD_ATTITUDE_CMD_ROLL_ToEng(int16_t raw)
+{
+    return (float)raw * 0.01f;
+}
+
+static inline int16_t APP_IP1553_ICD_ATTITUDE_CMD_ROLL_FromEng(float value)
+{
+    float raw = value * 100.0f;
+    raw = (raw < 0.0f) ? (raw - 0.5f) : (raw + 0.5f);
+    if ( raw < -18000.0f )
+    {
+        raw = -18000.0f;
+    }
+    if ( raw > 18000.0f )
+    {
+        raw = 18000.0f;
+    }
+    return (int16_t)raw;
+}
+
+/* ATTITUDE_CMD.pitch conversion between raw value and deg */
+static inline float APP_IP1553_ICD_ATTITUDE_CMD_PITCH_ToEng(int16_t raw)
+{
+    return (float)raw * 0.01f;
+}
+
+static inline int16_t APP_IP1553_ICD_ATTITUDE_CMD_PITCH_FromEng(float value)
+{
+    float raw = value * 100.0f;
+    raw = (raw < 0.0f) ? (raw - 0.5f) : (raw + 0.5f);
+    if ( raw < -9000.0f )
+    {
+        raw = -9000.0f;
+    }
+    if ( raw > 9000.0f )
+    {
+        raw = 9000.0f;
+    }
+    return (int16_t)raw;
+}
+
+/* ATTITUDE_CMD.yaw conversion between raw value and deg */
+static inline float APP_IP1553_ICD_ATTITUDE_CMD_YAW_ToEng(int16_t raw)
+{
+    return (float)raw * 0.01f;
+}
+
+static inline int16_t APP_IP1553_ICD_ATTITUDE_CMD_YAW_FromEng(float value)
+{
+    float raw = value * 100.0f;
+    raw = (raw < 0.0f) ? (raw - 0.5f) : (raw + 0.5f);
+    if ( raw < -18000.0f )
+    {
+        raw = -18000.0f;
+    }
+    if ( raw > 18000.0f )
+    {
+        raw = 18000.0f;
+    }
+    return (int16_t)raw;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Message HOUSEKEEPING (RT01 SA3 RT to BC, 5 words)
+// *****************************************************************************
+// *****************************************************************************
+#define APP_IP1553_ICD_HOUSEKEEPING_RT                      (1U)
+#define APP_IP1553_ICD_HOUSEKEEPING_SA                      (3U)
+#define APP_IP1553_ICD_HOUSEKEEPING_WORD_COUNT              (5U)
+#define APP_IP1553_ICD_HOUSEKEEPING_IS_RT_TX                (true)
+
+/* HOUSEKEEPING raw field values */
+typedef struct
+{
+    /* word 0, bits 11..0, LSB = 0.125 degC, offset = 0 */
+    int16_t temperature;
+    /* word 0, bits 15..12 */
+    uint8_t status;
+    /* word 1, bits 15..0, LSB = 0.001 V, offset = 0 */
+    uint16_t bus_voltage;
+    /* words 2-3, s */
+    uint32_t uptime;
+    /* word 4, bits 9..0 */
+    uint16_t error_count;
+} APP_IP1553_ICD_HOUSEKEEPING_T;
+
+/* Pack HOUSEKEEPING into its sub-address buffer (5 words written) */
+static inline void APP_IP1553_ICD_HOUSEKEEPING_Pack(const APP_IP1553_ICD_HOUSEKEEPING_T* msg, uint16_t* buffer)
+{
+    buffer[0] = (uint16_t)(((uint32_t)msg->temperature & 0xFFFUL) |
+                            (((uint32_t)msg->status & 0xFUL) << 12U));
+    buffer[1] = (uint16_t)(((uint32_t)msg->bus_voltage & 0xFFFFUL));
+    buffer[2] = (uint16_t)((((uint32_t)msg->uptime >> 16U) & 0xFFFFUL));
+    buffer[3] = (uint16_t)(((uint32_t)msg->uptime & 0xFFFFUL));
+    buffer[4] = (uint16_t)(((uint32_t)msg->error_count & 0x3FFUL));
+}
+
+/* Unpack HOUSEKEEPING from its sub-address buffer */
+static inline void APP_IP1553_ICD_HOUSEKEEPING_Unpack(const uint16_t* buffer, APP_IP1553_ICD_HOUSEKEEPING_T* msg)
+{
+    msg->temperature = (int16_t)APP_IP1553_ICD_SIGN_EXTEND(((uint32_t)buffer[0] & 0xFFFUL), 12U);
+    msg->status = (uint8_t)((((uint32_t)buffer[0] >> 12U) & 0xFUL));
+    msg->bus_voltage = (uint16_t)((uint32_t)buffer[1]);
+    msg->uptime = (uint32_t)(((uint32_t)buffer[2] << 16U) | (uint32_t)buffer[3]);
+    msg->error_count = (uint16_t)(((uint32_t)buffer[4] & 0x3FFUL));
+}
+
+/* Pack HOUSEKEEPING in the 32 x 32 IP1553 buffers at its sub-address */
+static inline void APP_IP1553_ICD_HOUSEKEEPING_PackSA(const APP_IP1553_ICD_HOUSEKEEPING_T* msg, uint16_t buffers[][APP_IP1553_ICD_BUFFERS_SIZE])
+{
+    APP_IP1553_ICD_HOUSEKEEPING_Pack(msg, &buffers[APP_IP1553_ICD_HOUSEKEEPING_SA][0]);
+}
+
+/* Unpack HOUSEKEEPING from the 32 x 32 IP1553 buffers at its sub-address */
+static inline void APP_IP1553_ICD_HOUSEKEEPING_UnpackSA(const uint16_t buffers[][APP_IP1553_ICD_BUFFERS_SIZE], APP_IP1553_ICD_HOUSEKEEPING_T* msg)
+{
+    APP_IP1553_ICD_HOUSEKEEPING_Unpack(&buffers[APP_IP1553_ICD_HOUSEKEEPING_SA][0], msg);
+}
+
+/* Check that every HOUSEKEEPING field lies in its ICD range */
+static inline bool APP_IP1553_ICD_HOUSEKEEPING_Check(const APP_IP1553_ICD_HOUSEKEEPING_T* msg)
+{
+    return ( (msg->temperature >= (-440)) &&
+             (msg->temperature <= 1000) &&
+             (msg->status <= 15U) &&
+             (msg->bus_voltage <= 50000U) &&
+             (msg->error_count <= 1000U) );
+}
+
+/* HOUSEKEEPING.temperature conversion between raw value and degC */
+static inline float APP_IP1553_ICD_HOUSEKEEPING_TEMPERATURE_ToEng(int16_t raw)
+{
+    return (float)raw * 0.125f;
+}
+
+static inline int16_t APP_IP1553_ICD_HOUSEKEEPING_TEMPERATURE_FromEng(float value)
+{
+    float raw = value * 8.0f;
+    raw = (raw < 0.0f) ? (raw - 0.5f) : (raw + 0.5f);
+    if ( raw < -440.0f )
+    {
+        raw = -440.0f;
+    }
+    if ( raw > 1000.0f )
+    {
+        raw = 1000.0f;
+    }
+    return (int16_t)raw;
+}
+
+/* HOUSEKEEPING.bus_voltage conversion between raw value and V */
+static inline float APP_IP1553_ICD_HOUSEKEEPING_BUS_VOLTAGE_ToEng(uint16_t raw)
+{
+    return (float)raw * 0.001f;
+}
+
+static inline uint16_t APP_IP1553_ICD_HOUSEKEEPING_BUS_VOLTAGE_FromEng(float value)
+{
+    float raw = value * 1000.0f;
+    raw = (raw < 0.0f) ? (raw - 0.5f) : (raw + 0.5f);
+    if ( raw < 0.0f )
+    {
+        raw = 0.0f;
+    }
+    if ( raw > 50000.0f )
+    {
+        raw = 50000.0f;
+    }
+    return (uint16_t)raw;
+}
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+}
+#endif
+// DOM-IGNORE-END
+
+#endif /* APP_IP1553_ICD_H */
@@ -0,0 +1,513 @@
+#!/usr/bin/env python3
+"""
+IP1553 ICD codec generator.
+
+Reads an interface control description (CSV or YAML) describing the MIL-1553
+messages handled by a terminal and emits a self-contained C header with:
+ - one C structure per message holding the raw field values, one naturally
+   aligned member per field (the structure is not the bus layout, the pack
+   and unpack functions convert between both),
+ - a compile time constant descriptor (RT, sub-address, direction, word count),
+ - static inline pack/unpack functions working on the 32 x 32 uint16_t buffer
+   layout given to IP1553_BuffersConfigSet(),
+ - static inline range check functions,
+ - engineering unit conversion helpers for scaled fields.
+
+The generated header only depends on <stdint.h> and <stdbool.h> so that it
+can be used both on the target and in Linux host unit tests.
+
+Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+
+Subject to your compliance with these terms, you may use Microchip software
+and any derivatives exclusively with Microchip products. It is your
+responsibility to comply with third party license terms applicable to your
+use of third party software (including open source software) that may
+accompany Microchip software.
+
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+PARTICULAR PURPOSE.
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+"""
+
+import argparse
+import csv
+import math
+import os
+import re
+import sys
+
+# IP1553 buffer geometry (IP1553_BUFFERS_NUM x IP1553_BUFFERS_SIZE)
+BUFFERS_NUM = 32
+BUFFERS_SIZE = 32
+
+# Field widths above one word must be word aligned and span two words, most
+# significant word first as usual on MIL-1553 buses.
+MAX_FIELD_WIDTH = 32
+
+class IcdError(Exception):
+    pass
+
+
+class Field(object):
+    def __init__(self, name, word, lsb, width, signed, scale, offset,
+                 eng_min, eng_max, units):
+        self.name = name
+        self.word = word
+        self.lsb = lsb
+        self.width = width
+        self.signed = signed
+        self.scale = scale
+        self.offset = offset
+        self.eng_min = eng_min
+        self.eng_max = eng_max
+        self.units = units
+
+    @property
+    def c_type(self):
+        bits = 16 if self.width <= 16 else 32
+        if self.width <= 8:
+            bits = 8
+        return ("int%d_t" if self.signed else "uint%d_t") % bits
+
+    @property
+    def scaled(self):
+        return (self.scale != 1.0) or (self.offset != 0.0)
+
+    def raw_limits(self):
+        """Raw range allowed by the field width."""
+        if self.signed:
+            return (-(1 << (self.width - 1)), (1 << (self.width - 1)) - 1)
+        return (0, (1 << self.width) - 1)
+
+    def raw_check_limits(self):
+        """Raw range allowed by the ICD min/max, clipped to the field width."""
+        lo, hi = self.raw_limits()
+        if self.eng_min is not None:
+            lo = max(lo, int(math.ceil((self.eng_min - self.offset) / self.scale - 1e-9)))
+        if self.eng_max is not None:
+            hi = min(hi, int(math.floor((self.eng_max - self.offset) / self.scale + 1e-9)))
+        if lo > hi:
+            raise IcdError("field %s: empty range [%s, %s]" % (self.name, self.eng_min, self.eng_max))
+        return (lo, hi)
+
+    def parts(self):
+        """
+        List of (word, shift, mask, value_shift) tuples describing where the
+        field bits are stored: bits [value_shift, value_shift + popcount(mask))
+        of the raw value go at 'shift' in buffer word 'word'.
+        """
+        if self.width <= 16:
+            return [(self.word, self.lsb, (1 << self.width) - 1, 0)]
+        low_width = self.width - 16
+        return [(self.word, 0, 0xFFFF, low_width),
+                (self.word + 1, 0, (1 << low_width) - 1, 0)]
+
+
+class Message(object):
+    def __init__(self, name, rt, sa, direction):
+        self.name = name
+        self.rt = rt
+        self.sa = sa
+        self.direction = direction
+        self.fields = []
+
+    @property
+    def word_count(self):
+        last = 0
+        for field in self.fields:
+            last = max(last, max(p[0] for p in field.parts()) + 1)
+        return last
+
+
+def _c_ident(name, what):
+    ident = re.sub(r"[^0-9A-Za-z_]", "_", name.strip())
+    if not ident or ident[0].isdigit():
+        raise IcdError("invalid %s name '%s'" % (what, name))
+    return ident
+
+
+def _to_int(value, what):
+    try:
+        return int(str(value).strip(), 0)
+    except ValueError:
+        raise IcdError("invalid %s '%s'" % (what, value))
+
+
+def _to_float(value, default, what):
+    if value is None or str(value).strip() == "":
+        return default
+    try:
+        return float(str(value).strip())
+    except ValueError:
+        raise IcdError("invalid %s '%s'" % (what, value))
+
+
+def _to_bool(value):
+    return str(value).strip().lower() in ("1", "y", "yes", "true", "s", "signed")
+
+
+def _add_row(messages, row):
+    msg_name = _c_ident(row["message"], "message")
+    rt = _to_int(row["rt"], "RT address")
+    sa = _to_int(row["sa"], "sub-address")
+    direction = str(row["direction"]).strip().lower()
+    if direction not in ("rx", "tx"):
+        raise IcdError("message %s: direction must be 'rx' or 'tx'" % msg_name)
+    if not 0 <= rt <= 31:
+        raise IcdError("message %s: RT address %d out of range" % (msg_name, rt))
+    if not 1 <= sa <= 30:
+        raise IcdError("message %s: sub-address %d is not a data sub-address" % (msg_name, sa))
+
+    msg = messages.get(msg_name)
+    if msg is None:
+        msg = Message(msg_name, rt, sa, direction)
+        messages[msg_name] = msg
+    elif (msg.rt, msg.sa, msg.direction) != (rt, sa, direction):
+        raise IcdError("message %s: inconsistent RT/SA/direction" % msg_name)
+
+    units = row.get("units") or ""
+    field = Field(_c_ident(row["field"], "field"),
+                  _to_int(row["word"], "word index"),
+                  _to_int(row.get("lsb") or 0, "lsb"),
+                  _to_int(row["width"], "width"),
+                  _to_bool(row.get("signed") or "0"),
+                  _to_float(row.get("scale"), 1.0, "scale"),
+                  _to_float(row.get("offset"), 0.0, "offset"),
+                  _to_float(row.get("min"), None, "min"),
+                  _to_float(row.get("max"), None, "max"),
+                  str(units).strip())
+    if field.scale == 0.0:
+        raise IcdError("field %s.%s: scale cannot be 0" % (msg_name, field.name))
+    if not 1 <= field.width <= MAX_FIELD_WIDTH:
+        raise IcdError("field %s.%s: width %d not supported" % (msg_name, field.name, field.width))
+    if field.width <= 16 and field.lsb + field.width > 16:
+        raise IcdError("field %s.%s: crosses a word boundary" % (msg_name, field.name))
+    if field.width > 16 and field.lsb != 0:
+        raise IcdError("field %s.%s: multi-word fields must start at bit 0" % (msg_name, field.name))
+    msg.fields.append(field)
+
+
+def load_icd(path):
+    messages = {}
+    if path.endswith((".yml", ".yaml")):
+        try:
+            import yaml
+        except ImportError:
+            raise IcdError("PyYAML is required to read %s" % path)
+        with open(path) as f:
+            doc = yaml.safe_load(f)
+        for m in doc.get("messages", []):
+            for fd in m.get("fields", []):
+                row = dict(fd)
+                row.update({"message": m["name"], "rt": m["rt"], "sa": m["sa"],
+                            "direction": m["direction"]})
+                try:
+                    _add_row(messages, row)
+                except IcdError as err:
+                    raise IcdError("%s: message %s, field %s: %s" % (path, m["name"], fd.get("field"), err))
+    else:
+        with open(path) as f:
+            # Keep the file line number of each non comment line for the errors
+            lines = [(number, text) for number, text in enumerate(f, 1)
+                     if not text.lstrip().startswith("#")]
+        rows = csv.DictReader(text for _, text in lines)
+        missing = [c for c in ("message", "rt", "sa", "direction", "word", "width", "field")
+                   if c not in (rows.fieldnames or [])]
+        if missing:
+            raise IcdError("%s: missing CSV column(s): %s" % (path, ", ".join(missing)))
+        for row in rows:
+            try:
+                _add_row(messages, row)
+            except IcdError as err:
+                raise IcdError("%s:%d: %s" % (path, lines[rows.line_num - 1][0], err))
+
+    for msg in messages.values():
+        if msg.word_count > BUFFERS_SIZE:
+            raise IcdError("message %s: %d words exceed the buffer size" % (msg.name, msg.word_count))
+        used = {}
+        for field in msg.fields:
+            for word, shift, mask, _ in field.parts():
+                bits = mask << shift
+                if used.get(word, 0) & bits:
+                    raise IcdError("message %s: field %s overlaps another field" % (msg.name, field.name))
+                used[word] = used.get(word, 0) | bits
+
+    keys = {}
+    for msg in messages.values():
+        key = (msg.rt, msg.sa, msg.direction)
+        if key in keys:
+            raise IcdError("messages %s and %s use the same RT/SA/direction" % (keys[key], msg.name))
+        keys[key] = msg.name
+
+    return sorted(messages.values(), key=lambda m: (m.rt, m.sa, m.direction))
+
+
+def _hex(value):
+    return "0x%XUL" % value
+
+
+def _c_float(value):
+    text = repr(float(value))
+    if ("." not in text) and ("e" not in text):
+        text += ".0"
+    return text + "f"
+
+
+def _c_int(value, signed):
+    if value < 0:
+        return "(%d)" % value
+    return ("%d" if signed else "%dU") % value
+
+
+def generate(messages, prefix, filename, source):
+    out = []
+    w = out.append
+    pfx = prefix.upper()
+    guard = _c_ident(os.path.splitext(filename)[0], "output").upper() + "_H"
+
+    w("/*******************************************************************************")
+    w("  IP1553 Interface Control Description codec")
+    w("")
+    w("  File Name:")
+    w("    %s" % filename)
+    w("")
+    w("  Summary:")
+    w("    Message structures, pack/unpack and range check functions.")
+    w("")
+    w("  Description:")
+    w("    This file is generated by tools/ip1553_icd_codegen from %s." % os.path.basename(source))
+    w("    Do not edit it by hand, update the ICD and regenerate it instead.")
+    w("*******************************************************************************/")
+    w("")
+    w("#ifndef %s" % guard)
+    w("#define %s" % guard)
+    w("")
+    w("#include <stdint.h>")
+    w("#include <stdbool.h>")
+    w("")
+    w("// DOM-IGNORE-BEGIN")
+    w("#ifdef __cplusplus // Provide C++ Compatibility")
+    w("    extern \"C\" {")
+    w("#endif")
+    w("// DOM-IGNORE-END")
+    w("")
+    w("// *****************************************************************************")
+    w("// *****************************************************************************")
+    w("// Section: ICD defines")
+    w("// *****************************************************************************")
+    w("// *****************************************************************************")
+    w("/* Number of sub-address buffers, must match IP1553_BUFFERS_NUM */")
+    w("#define %s_BUFFERS_NUM                (%dU)" % (pfx, BUFFERS_NUM))
+    w("")
+    w("/* Number of 16 bit words in one buffer, must match IP1553_BUFFERS_SIZE */")
+    w("#define %s_BUFFERS_SIZE               (%dU)" % (pfx, BUFFERS_SIZE))
+    w("")
+    w("#if defined(IP1553_BUFFERS_NUM) && defined(IP1553_BUFFERS_SIZE)")
+    w("#if (IP1553_BUFFERS_NUM != %s_BUFFERS_NUM) || (IP1553_BUFFERS_SIZE != %s_BUFFERS_SIZE)" % (pfx, pfx))
+    w("#error \"ICD buffer geometry does not match the IP1553 PLIB\"")
+    w("#endif")
+    w("#endif")
+    w("")
+    w("/* Sign extend the 'width' low bits of 'raw' */")
+    w("#define %s_SIGN_EXTEND(raw, width)    ((int32_t)(((uint32_t)(raw) ^ (1UL << ((width) - 1U))) - (1UL << ((width) - 1U))))" % pfx)
+    w("")
+
+    for msg in messages:
+        mp = "%s_%s" % (pfx, msg.name.upper())
+        w("// *****************************************************************************")
+        w("// *****************************************************************************")
+        w("// Section: Message %s (RT%02u SA%u %s, %u words)" % (msg.name, msg.rt, msg.sa,
+                                                                "BC to RT" if msg.direction == "rx" else "RT to BC",
+                                                                msg.word_count))
+        w("// *****************************************************************************")
+        w("// *****************************************************************************")
+        w("#define %s_RT                      (%uU)" % (mp, msg.rt))
+        w("#define %s_SA                      (%uU)" % (mp, msg.sa))
+        w("#define %s_WORD_COUNT              (%uU)" % (mp, msg.word_count))
+        w("#define %s_IS_RT_TX                (%s)" % (mp, "true" if msg.direction == "tx" else "false"))
+        w("")
+        w("/* %s raw field values */" % msg.name)
+        w("typedef struct")
+        w("{")
+        for f in msg.fields:
+            info = "word %u" % f.word if f.width <= 16 else "words %u-%u" % (f.word, f.word + 1)
+            if f.width == 1:
+                info += ", bit %u" % f.lsb
+            elif f.width <= 16:
+                info += ", bits %u..%u" % (f.lsb + f.width - 1, f.lsb)
+            if f.scaled:
+                info += ", LSB = %g %s, offset = %g" % (f.scale, f.units, f.offset)
+            elif f.units:
+                info += ", %s" % f.units
+            w("    /* %s */" % info)
+            w("    %s %s;" % (f.c_type, f.name))
+        w("} %s_T;" % mp)
+        w("")
+
+        w("/* Pack %s into its sub-address buffer (%u words written) */" % (msg.name, msg.word_count))
+        w("static inline void %s_Pack(const %s_T* msg, uint16_t* buffer)" % (mp, mp))
+        w("{")
+        for word in range(msg.word_count):
+            terms = []
+            for f in msg.fields:
+                for pw, shift, mask, vshift in f.parts():
+                    if pw != word:
+                        continue
+                    val = "(uint32_t)msg->%s" % f.name
+                    if vshift:
+                        val = "(%s >> %uU)" % (val, vshift)
+                    term = "(%s & %s)" % (val, _hex(mask))
+                    if shift:
+                        term = "(%s << %uU)" % (term, shift)
+                    terms.append(term)
+            if terms:
+                w("    buffer[%u] = (uint16_t)(%s);" % (word, " |\n                            ".join(terms)))
+            else:
+                w("    buffer[%u] = 0U;" % word)
+        w("}")
+        w("")
+
+        w("/* Unpack %s from its sub-address buffer */" % msg.name)
+        w("static inline void %s_Unpack(const uint16_t* buffer, %s_T* msg)" % (mp, mp))
+        w("{")
+        for f in msg.fields:
+            terms = []
+            for pw, shift, mask, vshift in f.parts():
+                term = "(uint32_t)buffer[%u]" % pw
+                if shift:
+                    term = "(%s >> %uU)" % (term, shift)
+                if mask != 0xFFFF or shift:
+                    term = "(%s & %s)" % (term, _hex(mask))
+                if vshift:
+                    term = "(%s << %uU)" % (term, vshift)
+                terms.append(term)
+            raw = " | ".join(terms)
+            if f.signed and f.width not in (8, 16, 32):
+                w("    msg->%s = (%s)%s_SIGN_EXTEND(%s, %uU);" % (f.name, f.c_type, pfx, raw, f.width))
+            else:
+                w("    msg->%s = (%s)(%s);" % (f.name, f.c_type, raw))
+        w("}")
+        w("")
+
+        w("/* Pack %s in the 32 x 32 IP1553 buffers at its sub-address */" % msg.name)
+        w("static inline void %s_PackSA(const %s_T* msg, uint16_t buffers[][%s_BUFFERS_SIZE])" % (mp, mp, pfx))
+        w("{")
+        w("    %s_Pack(msg, &buffers[%s_SA][0]);" % (mp, mp))
+        w("}")
+        w("")
+        w("/* Unpack %s from the 32 x 32 IP1553 buffers at its sub-address */" % msg.name)
+        w("static inline void %s_UnpackSA(const uint16_t buffers[][%s_BUFFERS_SIZE], %s_T* msg)" % (mp, pfx, mp))
+        w("{")
+        w("    %s_Unpack(&buffers[%s_SA][0], msg);" % (mp, mp))
+        w("}")
+        w("")
+
+        w("/* Check that every %s field lies in its ICD range */" % msg.name)
+        w("static inline bool %s_Check(const %s_T* msg)" % (mp, mp))
+        w("{")
+        conds = []
+        for f in msg.fields:
+            # Only emit the comparisons the C type of the member can violate
+            lo, hi = f.raw_check_limits()
+            if f.signed:
+                if lo > -(1 << (_type_bits(f) - 1)):
+                    conds.append("(msg->%s >= %s)" % (f.name, _c_int(lo, f.signed)))
+                if hi < (1 << (_type_bits(f) - 1)) - 1:
+                    conds.append("(msg->%s <= %s)" % (f.name, _c_int(hi, f.signed)))
+            else:
+                if lo > 0:
+                    conds.append("(msg->%s >= %s)" % (f.name, _c_int(lo, f.signed)))
+                if hi < (1 << _type_bits(f)) - 1:
+                    conds.append("(msg->%s <= %s)" % (f.name, _c_int(hi, f.signed)))
+        if conds:
+            w("    return ( %s );" % (" &&\n             ".join(conds)))
+        else:
+            w("    (void)msg;")
+            w("    return true;")
+        w("}")
+        w("")
+
+        for f in msg.fields:
+            if not f.scaled:
+                continue
+            fp = "%s_%s" % (mp, f.name.upper())
+            lo, hi = f.raw_check_limits()
+            w("/* %s.%s conversion between raw value and %s */" % (msg.name, f.name, f.units or "engineering units"))
+            w("static inline float %s_ToEng(%s raw)" % (fp, f.c_type))
+            w("{")
+            if f.offset != 0.0:
+                w("    return ((float)raw * %s) + %s;" % (_c_float(f.scale), _c_float(f.offset)))
+            else:
+                w("    return (float)raw * %s;" % _c_float(f.scale))
+            w("}")
+            w("")
+            w("static inline %s %s_FromEng(float value)" % (f.c_type, fp))
+            w("{")
+            if f.offset != 0.0:
+                w("    float raw = (value - %s) * %s;" % (_c_float(f.offset), _c_float(1.0 / f.scale)))
+            else:
+                w("    float raw = value * %s;" % _c_float(1.0 / f.scale))
+            w("    raw = (raw < 0.0f) ? (raw - 0.5f) : (raw + 0.5f);")
+            w("    if ( raw < %s )" % _c_float(lo))
+            w("    {")
+            w("        raw = %s;" % _c_float(lo))
+            w("    }")
+            w("    if ( raw > %s )" % _c_float(hi))
+            w("    {")
+            w("        raw = %s;" % _c_float(hi))
+            w("    }")
+            w("    return (%s)raw;" % f.c_type)
+            w("}")
+            w("")
+
+    w("// DOM-IGNORE-BEGIN")
+    w("#ifdef __cplusplus  // Provide C++ Compatibility")
+    w("}")
+    w("#endif")
+    w("// DOM-IGNORE-END")
+    w("")
+    w("#endif /* %s */" % guard)
+    return "\n".join(out) + "\n"
+
+
+def _type_bits(field):
+    return int(re.search(r"\d+", field.c_type).group(0))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Generate IP1553 message codec from an ICD file")
+    parser.add_argument("icd", help="ICD description (.csv, .yml or .yaml)")
+    parser.add_argument("-o", "--output", help="generated header (default: stdout)")
+    parser.add_argument("-p", "--prefix", default="APP_IP1553_ICD",
+                        help="prefix of generated symbols (default: APP_IP1553_ICD)")
+    args = parser.parse_args(argv)
+
+    try:
+        messages = load_icd(args.icd)
+        if not messages:
+            raise IcdError("no message found in %s" % args.icd)
+        name = os.path.basename(args.output) if args.output else "%s.h" % args.prefix.lower()
+        text = generate(messages, args.prefix, name, args.icd)
+    except (IcdError, KeyError, OSError) as err:
+        sys.stderr.write("ip1553_icd_codegen: error: %s\n" % err)
+        return 1
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
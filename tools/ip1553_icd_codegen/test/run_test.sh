@@ -0,0 +1,27 @@
+#!/bin/sh
+# Host test of the IP1553 ICD codec generator: generates the codec of the
+# example ICD, builds the round trip test with the native compiler and runs
+# it, then checks that an invalid ICD value is reported with its line.
+set -e
+
+HERE=$(cd "$(dirname "$0")" && pwd)
+TOOL="$HERE/../ip1553_icd_codegen.py"
+OUT=$(mktemp -d)
+trap 'rm -rf "$OUT"' EXIT
+CC=${CC:-gcc}
+
+python3 "$TOOL" "$HERE/../example/icd_example.csv" -o "$OUT/app_ip1553_icd.h"
+$CC -std=c99 -Wall -Wextra -Werror -I"$OUT" -o "$OUT/test_icd_codec" "$HERE/test_icd_codec.c"
+"$OUT/test_icd_codec"
+
+sed 's/^HOUSEKEEPING,1,3,tx,1,0,16,bus_voltage,0,0.001,/HOUSEKEEPING,1,3,tx,1,0,16,bus_voltage,0,0.001V,/' \
+    "$HERE/../example/icd_example.csv" > "$OUT/bad.csv"
+if python3 "$TOOL" "$OUT/bad.csv" -o "$OUT/bad.h" 2> "$OUT/bad.log"; then
+    echo "FAIL: invalid scale accepted"
+    exit 1
+fi
+if ! grep -q "bad.csv:14: invalid scale '0.001V'" "$OUT/bad.log"; then
+    echo "FAIL: unexpected error: $(cat "$OUT/bad.log")"
+    exit 1
+fi
+echo "PASS: invalid scale reported"
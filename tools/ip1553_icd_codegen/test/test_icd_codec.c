@@ -0,0 +1,147 @@
+/*******************************************************************************
+  IP1553 ICD codec host test
+
+  File Name:
+    test_icd_codec.c
+
+  Summary:
+    Round trip test of the codec generated from example/icd_example.csv.
+
+  Description:
+    Packs the messages of the example ICD in the 32 x 32 IP1553 buffers,
+    checks the bus words against the ICD layout, unpacks them and compares
+    the fields, sign extension, two word fields and unused bits included.
+    Also checks the range check and engineering unit conversion functions.
+    Built and run on Linux by run_test.sh.
+*******************************************************************************/
+
+//DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+//DOM-IGNORE-END
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "app_ip1553_icd.h"
+
+static unsigned int failures = 0U;
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if ( !(cond) )                                                      \
+        {                                                                   \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                     \
+        }                                                                   \
+    } while (0)
+
+/* Buffers as given to IP1553_BuffersConfigSet() */
+static uint16_t buffers[APP_IP1553_ICD_BUFFERS_NUM][APP_IP1553_ICD_BUFFERS_SIZE];
+
+static void test_attitude_cmd(void)
+{
+    APP_IP1553_ICD_ATTITUDE_CMD_T in = { -12345, 9000, -1, 1U, 9U, 0xA5U };
+    APP_IP1553_ICD_ATTITUDE_CMD_T out;
+    const uint16_t* words = &buffers[APP_IP1553_ICD_ATTITUDE_CMD_SA][0];
+
+    memset(buffers, 0xFF, sizeof(buffers));
+    APP_IP1553_ICD_ATTITUDE_CMD_PackSA(&in, buffers);
+
+    CHECK(words[0] == 0xCFC7U);
+    CHECK(words[1] == 9000U);
+    CHECK(words[2] == 0xFFFFU);
+    /* valid bit 15, mode bits 11..8, sequence bits 7..0, other bits cleared */
+    CHECK(words[3] == 0x89A5U);
+    /* The word after the message is not written */
+    CHECK(words[APP_IP1553_ICD_ATTITUDE_CMD_WORD_COUNT] == 0xFFFFU);
+
+    memset(&out, 0, sizeof(out));
+    APP_IP1553_ICD_ATTITUDE_CMD_UnpackSA(buffers, &out);
+    CHECK(out.roll == in.roll);
+    CHECK(out.pitch == in.pitch);
+    CHECK(out.yaw == in.yaw);
+    CHECK(out.valid == in.valid);
+    CHECK(out.mode == in.mode);
+    CHECK(out.sequence == in.sequence);
+
+    CHECK(APP_IP1553_ICD_ATTITUDE_CMD_Check(&out) == true);
+    out.pitch = 9001;
+    CHECK(APP_IP1553_ICD_ATTITUDE_CMD_Check(&out) == false);
+    out.pitch = 9000;
+    out.mode = 10U;
+    CHECK(APP_IP1553_ICD_ATTITUDE_CMD_Check(&out) == false);
+
+    CHECK(APP_IP1553_ICD_ATTITUDE_CMD_ROLL_FromEng(-123.45f) == -12345);
+    CHECK(APP_IP1553_ICD_ATTITUDE_CMD_ROLL_FromEng(500.0f) == 18000);
+    CHECK(APP_IP1553_ICD_ATTITUDE_CMD_ROLL_ToEng(APP_IP1553_ICD_ATTITUDE_CMD_ROLL_FromEng(45.5f)) == 45.5f);
+}
+
+static void test_housekeeping(void)
+{
+    APP_IP1553_ICD_HOUSEKEEPING_T in = { -440, 0xAU, 28000U, 0x12345678UL, 1000U };
+    APP_IP1553_ICD_HOUSEKEEPING_T out;
+    const uint16_t* words = &buffers[APP_IP1553_ICD_HOUSEKEEPING_SA][0];
+
+    memset(buffers, 0, sizeof(buffers));
+    APP_IP1553_ICD_HOUSEKEEPING_PackSA(&in, buffers);
+
+    /* 12 bits two's complement temperature under a 4 bits status */
+    CHECK(words[0] == 0xAE48U);
+    CHECK(words[1] == 28000U);
+    /* Two word field, most significant word first */
+    CHECK(words[2] == 0x1234U);
+    CHECK(words[3] == 0x5678U);
+    CHECK(words[4] == 1000U);
+
+    memset(&out, 0, sizeof(out));
+    APP_IP1553_ICD_HOUSEKEEPING_UnpackSA(buffers, &out);
+    CHECK(out.temperature == in.temperature);
+    CHECK(out.status == in.status);
+    CHECK(out.bus_voltage == in.bus_voltage);
+    CHECK(out.uptime == in.uptime);
+    CHECK(out.error_count == in.error_count);
+
+    CHECK(APP_IP1553_ICD_HOUSEKEEPING_Check(&out) == true);
+    out.error_count = 1001U;
+    CHECK(APP_IP1553_ICD_HOUSEKEEPING_Check(&out) == false);
+
+    CHECK(APP_IP1553_ICD_HOUSEKEEPING_TEMPERATURE_FromEng(-55.0f) == -440);
+    CHECK(APP_IP1553_ICD_HOUSEKEEPING_TEMPERATURE_ToEng(-440) == -55.0f);
+    CHECK(APP_IP1553_ICD_HOUSEKEEPING_BUS_VOLTAGE_FromEng(-1.0f) == 0U);
+}
+
+int main(void)
+{
+    CHECK(APP_IP1553_ICD_ATTITUDE_CMD_RT == 1U);
+    CHECK(APP_IP1553_ICD_ATTITUDE_CMD_IS_RT_TX == false);
+    CHECK(APP_IP1553_ICD_HOUSEKEEPING_WORD_COUNT == 5U);
+    CHECK(APP_IP1553_ICD_HOUSEKEEPING_IS_RT_TX == true);
+
+    test_attitude_cmd();
+    test_housekeeping();
+
+    printf("%s\n", (failures == 0U) ? "PASS" : "FAIL");
+    return (failures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+/*******************************************************************************
+  MPU PLIB Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_mpu.c
+
+  Summary:
+    MPU PLIB Source File
+
+  Description:
+    Generated by tools/mpu_planner/mpu_planner.py from ATSAMRH71F20C.ld,
+    do not edit: change the rules and generate it again.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+#include "plib_mpu.h"
+#include "plib_mpu_local.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: MPU Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void MPU_Initialize(void)
+{
+    /*** Disable MPU            ***/
+    MPU->CTRL = 0;
+
+    /*** Configure MPU Regions  ***/
+
+    /* Region 0 Name: rom, Base Address: 0x10000000, Size: 128KB  */
+    MPU->RBAR = MPU_REGION(0U, 0x10000000U);
+    MPU->RASR = MPU_REGION_SIZE(16U) | MPU_RASR_AP(MPU_RASR_AP_READWRITE_Val) | MPU_ATTR_NORMAL_WT \
+                | MPU_ATTR_ENABLE  ;
+
+    /* Region 1 Name: ram, Base Address: 0x21000000, Size: 512KB  */
+    MPU->RBAR = MPU_REGION(1U, 0x21000000U);
+    MPU->RASR = MPU_REGION_SIZE(18U) | MPU_RASR_AP(MPU_RASR_AP_READWRITE_Val) | MPU_ATTR_NORMAL_WB_WA \
+                | MPU_ATTR_EXECUTE_NEVER | MPU_ATTR_ENABLE  ;
+
+    /* Region 2 Name: ram_nocache, Base Address: 0x21080000, Size: 256KB  */
+    MPU->RBAR = MPU_REGION(2U, 0x21080000U);
+    MPU->RASR = MPU_REGION_SIZE(17U) | MPU_RASR_AP(MPU_RASR_AP_READWRITE_Val) | MPU_ATTR_NORMAL \
+                | MPU_ATTR_SHAREABLE | MPU_ATTR_EXECUTE_NEVER | MPU_ATTR_ENABLE  ;
+
+    /* Region 3 Name: PERIPHERALS, Base Address: 0x40000000, Size: 512MB  */
+    MPU->RBAR = MPU_REGION(3U, 0x40000000U);
+    MPU->RASR = MPU_REGION_SIZE(28U) | MPU_RASR_AP(MPU_RASR_AP_READWRITE_Val) | MPU_ATTR_STRONGLY_ORDERED \
+                | MPU_ATTR_EXECUTE_NEVER | MPU_ATTR_ENABLE  ;
+
+    /* Disable Region 4*/
+    MPU->RBAR = MPU_RBAR_REGION(4U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 5*/
+    MPU->RBAR = MPU_RBAR_REGION(5U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 6*/
+    MPU->RBAR = MPU_RBAR_REGION(6U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 7*/
+    MPU->RBAR = MPU_RBAR_REGION(7U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 8*/
+    MPU->RBAR = MPU_RBAR_REGION(8U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 9*/
+    MPU->RBAR = MPU_RBAR_REGION(9U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 10*/
+    MPU->RBAR = MPU_RBAR_REGION(10U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 11*/
+    MPU->RBAR = MPU_RBAR_REGION(11U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 12*/
+    MPU->RBAR = MPU_RBAR_REGION(12U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 13*/
+    MPU->RBAR = MPU_RBAR_REGION(13U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 14*/
+    MPU->RBAR = MPU_RBAR_REGION(14U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Disable Region 15*/
+    MPU->RBAR = MPU_RBAR_REGION(15U) | MPU_RBAR_VALID_Msk;
+    MPU->RASR &= ~MPU_ATTR_ENABLE;
+
+    /* Enable Memory Management Fault */
+    SCB->SHCSR |= (SCB_SHCSR_MEMFAULTENA_Msk);
+
+    /* Enable MPU */
+    MPU->CTRL = MPU_CTRL_ENABLE_Msk  | MPU_CTRL_PRIVDEFENA_Msk;
+
+    __DSB();
+    __ISB();
+}
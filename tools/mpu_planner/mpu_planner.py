@@ -0,0 +1,530 @@
+#!/usr/bin/env python3
+"""
+MPU region planner.
+
+Reads the memory regions of a linker script (ATSAMRH71F20C.ld) and, when a
+GNU ld map file of the last build is given, the address and size of its
+output sections. Applies a list of attribute rules to memories, sections and
+address windows and emits the MPU_Initialize() function of the Harmony MPU
+PLIB (plib_mpu.c) with:
+ - each rule range covered by naturally aligned power of two regions, using
+   the sub-region disable bits to cover ranges that are not powers of two,
+ - the memory type (normal cached write-back or write-through, normal non
+   cached, device, strongly-ordered), access permission, shareable and
+   execute-never attributes of the rule,
+ - the unused regions disabled.
+
+Rules later in the list get higher region numbers, so they override the
+earlier ones where they overlap, as the MPU does. The planner uses it to save
+regions: a range may be widened over the ranges of the later rules, and the
+consecutive rules with the same attributes on contiguous ranges share their
+regions.
+
+Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+
+Subject to your compliance with these terms, you may use Microchip software
+and any derivatives exclusively with Microchip products. It is your
+responsibility to comply with third party license terms applicable to your
+use of third party software (including open source software) that may
+accompany Microchip software.
+
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+PARTICULAR PURPOSE.
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+"""
+
+import argparse
+import re
+import sys
+
+# Cortex-M7 MPU of the SAMRH71
+MPU_REGION_NUM = 16
+MPU_REGION_MIN_LOG2 = 5          # 32 bytes
+MPU_SUBREGION_MIN_LOG2 = 8       # sub-regions exist for regions of 256 bytes and more
+MPU_SUBREGION_NUM = 8
+
+# Memory types, as named in plib_mpu_local.h
+MEMORY_TYPES = {
+    "strongly_ordered": "MPU_ATTR_STRONGLY_ORDERED",
+    "device":           "MPU_ATTR_DEVICE",
+    "normal_wt":        "MPU_ATTR_NORMAL_WT",
+    "normal_wb":        "MPU_ATTR_NORMAL_WB",
+    "normal_wb_wa":     "MPU_ATTR_NORMAL_WB_WA",
+    "normal_nc":        "MPU_ATTR_NORMAL",
+}
+
+ACCESS = {
+    "rw":      "MPU_RASR_AP_READWRITE_Val",
+    "ro":      "MPU_RASR_AP_READONLY_Val",
+    "priv_rw": "MPU_RASR_AP_NOACCESS_PRIV_READWRITE_Val",
+    "priv_ro": "MPU_RASR_AP_NOACCESS_PRIV_READONLY_Val",
+    "none":    "MPU_RASR_AP_NOACCESS_Val",
+}
+
+# Default rules of the SAMRH71 applications: cached code, write-back data,
+# non cached DMA memory, write-through external SDRAM and strongly-ordered
+# peripherals. Data memories are execute-never.
+DEFAULT_RULES = """
+memory  rom          normal_wt
+memory  ram          normal_wb_wa  xn
+memory  ram_data     normal_wb_wa  xn
+memory  ram_nocache  normal_nc     xn shareable
+memory  ext_sdram    normal_wt     xn
+window  PERIPHERALS  0x40000000 0x20000000  strongly_ordered xn
+"""
+
+# Output sections holding code, they clear the execute-never attribute of the
+# rules covering them
+CODE_SECTION = re.compile(r"^\.(text|ramfunc|vectors|itcm|dinit)")
+
+
+class PlanError(Exception):
+    pass
+
+
+class Rule(object):
+    def __init__(self, kind, target, base, size, memtype, access, xn, shareable, grow, line):
+        self.kind = kind
+        self.target = target
+        self.base = base
+        self.size = size
+        self.memtype = memtype
+        self.access = access
+        self.xn = xn
+        self.shareable = shareable
+        self.grow = grow
+        self.line = line
+
+
+class Region(object):
+    def __init__(self, name, base, log2, srd, rule):
+        self.name = name
+        self.base = base
+        self.log2 = log2
+        self.srd = srd
+        self.rule = rule
+
+    @property
+    def size(self):
+        return 1 << self.log2
+
+
+def _eval(expr, defines):
+    """Evaluate a linker script expression built from integers and macros."""
+    for _ in range(16):
+        names = [n for n in re.findall(r"[A-Za-z_]\w*", expr) if n in defines]
+        if not names:
+            break
+        for n in names:
+            expr = re.sub(r"\b%s\b" % n, "(%s)" % defines[n], expr)
+    expr = re.sub(r"\b(0[xX][0-9a-fA-F]+|\d+)[uUlLkKmM]*\b", lambda m: m.group(1), expr)
+    if re.search(r"[A-Za-z_]\w*", re.sub(r"0[xX][0-9a-fA-F]+", "", expr)):
+        raise PlanError("cannot evaluate '%s'" % expr.strip())
+    return int(eval(expr, {"__builtins__": {}}, {}))
+
+
+def load_linker_script(path, overrides):
+    """Return {memory name: (origin, length)} of the MEMORY command.
+
+    The #define of the script are applied as the C preprocessor does for the
+    default build: the first definition wins and -D overrides all of them."""
+    defines = dict(overrides)
+    memories = {}
+    with open(path) as f:
+        text = f.read()
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+
+    for m in re.finditer(r"^\s*#\s*define\s+(\w+)\s+(.+?)\s*$", text, flags=re.M):
+        defines.setdefault(m.group(1), m.group(2))
+
+    block = re.search(r"\bMEMORY\s*\{(.*?)\}", text, flags=re.S)
+    if block is None:
+        raise PlanError("no MEMORY command in %s" % path)
+    for m in re.finditer(r"(\w+)\s*(?:\([^)]*\))?\s*:\s*ORIGIN\s*=\s*([^,]+),\s*LENGTH\s*=\s*([^\n]+)",
+                         block.group(1)):
+        name = m.group(1)
+        try:
+            origin = _eval(m.group(2), defines)
+            length = _eval(m.group(3), defines)
+        except PlanError as err:
+            memories[name] = str(err)
+            continue
+        memories[name] = (origin, length)
+    return memories
+
+
+def load_map(path):
+    """Return {output section name: (address, size)} of a GNU ld map file."""
+    sections = {}
+    started = False
+    pending = None
+    with open(path) as f:
+        for line in f:
+            if not started:
+                started = line.startswith("Linker script and memory map")
+                continue
+            if pending is not None:
+                m = re.match(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)", line)
+                if m:
+                    sections[pending] = (int(m.group(1), 16), int(m.group(2), 16))
+                pending = None
+                continue
+            m = re.match(r"^(\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+))?\s*$", line)
+            if m is None:
+                m = re.match(r"^(\.\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s", line)
+            if m is None:
+                continue
+            if m.group(2) is None:
+                pending = m.group(1)
+            else:
+                sections[m.group(1)] = (int(m.group(2), 16), int(m.group(3), 16))
+    if not started:
+        raise PlanError("%s is not a GNU ld map file" % path)
+    return sections
+
+
+def parse_rules(text, origin):
+    """Parse rule lines: KIND TARGET [BASE SIZE] TYPE [ACCESS] [xn] [shareable] [grow]."""
+    rules = []
+    for num, raw in enumerate(text.splitlines(), 1):
+        line = raw.split("#", 1)[0].split()
+        if not line:
+            continue
+        where = "%s:%d" % (origin, num)
+        kind = line[0]
+        if kind not in ("memory", "section", "window") or len(line) < 3:
+            raise PlanError("%s: expected 'memory|section|window TARGET ... TYPE'" % where)
+        target = line[1]
+        words = line[2:]
+        base = size = None
+        if kind == "window":
+            if len(words) < 3:
+                raise PlanError("%s: window needs a base address and a size" % where)
+            base, size = int(words[0], 0), int(words[1], 0)
+            words = words[2:]
+        memtype = words[0]
+        if memtype not in MEMORY_TYPES:
+            raise PlanError("%s: unknown memory type '%s'" % (where, memtype))
+        access, xn, shareable, grow = "rw", False, False, False
+        for w in words[1:]:
+            if w in ACCESS:
+                access = w
+            elif w == "xn":
+                xn = True
+            elif w == "shareable":
+                shareable = True
+            elif w == "grow":
+                grow = True
+            else:
+                raise PlanError("%s: unknown attribute '%s'" % (where, w))
+        rules.append(Rule(kind, target, base, size, memtype, access, xn, shareable, grow, where))
+    return rules
+
+
+def cover(start, end):
+    """Cover [start, end) exactly with MPU regions.
+
+    Returns a list of (base, log2 size, sub-region disable mask). The range
+    is covered by the smallest aligned region holding it when its bounds are
+    on sub-regions of that region, otherwise the part on sub-region bounds
+    is covered by that region and the edges are covered recursively."""
+    if start >= end:
+        return []
+    log2 = MPU_REGION_MIN_LOG2
+    while True:
+        base = start & ~((1 << log2) - 1)
+        if base + (1 << log2) >= end:
+            break
+        log2 += 1
+    size = 1 << log2
+
+    if (start == base) and (end == base + size):
+        return [(base, log2, 0)]
+
+    if log2 >= MPU_SUBREGION_MIN_LOG2:
+        sub = size // MPU_SUBREGION_NUM
+        inner_start = (start + sub - 1) & ~(sub - 1)
+        inner_end = end & ~(sub - 1)
+        if inner_start < inner_end:
+            srd = 0
+            for i in range(MPU_SUBREGION_NUM):
+                s = base + (i * sub)
+                if (s < inner_start) or (s + sub > inner_end):
+                    srd |= 1 << i
+            return cover(start, inner_start) + [(base, log2, srd)] + cover(inner_end, end)
+
+    middle = base + (size // 2)
+    return cover(start, middle) + cover(middle, end)
+
+
+def _same_attributes(a, b):
+    return (a.memtype, a.access, a.xn, a.shareable) == (b.memtype, b.access, b.xn, b.shareable)
+
+
+def _widen(start, end, later, grow):
+    """Cover [start, end), possibly widened over the later ranges.
+
+    The widened bounds tried are the power of two boundaries reachable
+    without leaving the later ranges contiguous to the range, or any of them
+    when grow is set. Returns the cover with the fewest regions, and the
+    least widened one among them."""
+    low, high = (0, 1 << 32) if grow else (start, end)
+    changed = True
+    while changed:
+        changed = False
+        for s, e in later:
+            if (s < low) and (e >= low):
+                low, changed = s, True
+            if (e > high) and (s <= high):
+                high, changed = e, True
+
+    starts = {start}
+    ends = {end}
+    for log2 in range(MPU_REGION_MIN_LOG2, 33):
+        mask = (1 << log2) - 1
+        if (start & ~mask) >= low:
+            starts.add(start & ~mask)
+        if ((end + mask) & ~mask) <= high:
+            ends.add((end + mask) & ~mask)
+
+    best = None
+    for s in sorted(starts, reverse=True):
+        for e in sorted(ends):
+            regions = cover(s, e)
+            if (best is None) or (len(regions) < len(best[0])) or \
+               ((len(regions) == len(best[0])) and ((e - s) < best[1])):
+                best = (regions, e - s)
+    return best[0]
+
+
+def plan(rules, memories, sections):
+    ranges = []
+    for rule in rules:
+        if rule.kind == "window":
+            start, end = rule.base, rule.base + rule.size
+        elif rule.kind == "memory":
+            if rule.target not in memories:
+                sys.stderr.write("mpu_planner: note: %s: no memory %s in the linker script, rule skipped\n"
+                                 % (rule.line, rule.target))
+                continue
+            if not isinstance(memories[rule.target], tuple):
+                sys.stderr.write("mpu_planner: warning: %s: memory %s skipped, %s\n"
+                                 % (rule.line, rule.target, memories[rule.target]))
+                continue
+            origin, length = memories[rule.target]
+            start, end = origin, origin + length
+        else:
+            if sections is None:
+                raise PlanError("%s: section rules need a map file (-m)" % rule.line)
+            if rule.target not in sections:
+                sys.stderr.write("mpu_planner: note: %s: no section %s in the map file, rule skipped\n"
+                                 % (rule.line, rule.target))
+                continue
+            address, size = sections[rule.target]
+            start, end = address, address + size
+
+        if start >= end:
+            continue
+
+        # Regions are 32 bytes aligned: a section is widened to whole blocks
+        # and shares its attributes with its neighbours in these blocks
+        align = (1 << MPU_REGION_MIN_LOG2) - 1
+        if ((start & align) != 0) or ((end & align) != 0):
+            sys.stderr.write("mpu_planner: warning: %s: 0x%08X-0x%08X widened to 32 bytes boundaries\n"
+                             % (rule.line, start, end))
+            start &= ~align
+            end = (end + align) & ~align
+
+        if rule.xn and (sections is not None):
+            for name, (address, size) in sorted(sections.items()):
+                if (size != 0) and CODE_SECTION.match(name) and (address < end) and (address + size > start):
+                    sys.stderr.write("mpu_planner: warning: %s: code section %s in %s, execute-never removed\n"
+                                     % (rule.line, name, rule.target))
+                    rule.xn = False
+                    break
+
+        if ranges and _same_attributes(ranges[-1][2], rule) and \
+           (rule.grow == ranges[-1][2].grow) and (start <= ranges[-1][1]) and (end >= ranges[-1][0]):
+            prev = ranges[-1]
+            ranges[-1] = (min(prev[0], start), max(prev[1], end), prev[2], prev[3] + "+" + rule.target)
+        else:
+            ranges.append((start, end, rule, rule.target))
+
+    regions = []
+    for index, (start, end, rule, name) in enumerate(ranges):
+        later = [(r[0], r[1]) for r in ranges[index + 1:]]
+        for base, log2, srd in _widen(start, end, later, rule.grow):
+            regions.append(Region(name, base, log2, srd, rule))
+
+    if len(regions) > MPU_REGION_NUM:
+        raise PlanError("%u regions needed, the MPU has %u" % (len(regions), MPU_REGION_NUM))
+    return regions
+
+
+def _size_text(size):
+    for unit, shift in (("GB", 30), ("MB", 20), ("KB", 10)):
+        if (size >> shift) != 0 and (size & ((1 << shift) - 1)) == 0:
+            return "%u%s" % (size >> shift, unit)
+    return "%uB" % size
+
+
+HEADER = """/*******************************************************************************
+  MPU PLIB Implementation
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_mpu.c
+
+  Summary:
+    MPU PLIB Source File
+
+  Description:
+    Generated by tools/mpu_planner/mpu_planner.py from %s,
+    do not edit: change the rules and generate it again.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2018 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+#include "plib_mpu.h"
+#include "plib_mpu_local.h"
+
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: MPU Implementation
+// *****************************************************************************
+// *****************************************************************************
+
+void MPU_Initialize(void)
+{
+    /*** Disable MPU            ***/
+    MPU->CTRL = 0;
+
+    /*** Configure MPU Regions  ***/"""
+
+FOOTER = """
+    /* Enable Memory Management Fault */
+    SCB->SHCSR |= (SCB_SHCSR_MEMFAULTENA_Msk);
+
+    /* Enable MPU */
+    MPU->CTRL = MPU_CTRL_ENABLE_Msk  | MPU_CTRL_PRIVDEFENA_Msk;
+
+    __DSB();
+    __ISB();
+}
+"""
+
+
+def generate(regions, source):
+    out = [HEADER % source]
+    w = out.append
+    for index, region in enumerate(regions):
+        rule = region.rule
+        attrs = [MEMORY_TYPES[rule.memtype]]
+        if rule.shareable:
+            attrs.append("MPU_ATTR_SHAREABLE")
+        if rule.xn:
+            attrs.append("MPU_ATTR_EXECUTE_NEVER")
+        if region.srd != 0:
+            attrs.append("MPU_SUBREGION_DISABLE(0x%02XU)" % region.srd)
+        w("")
+        w("    /* Region %u Name: %s, Base Address: 0x%08X, Size: %s  */"
+          % (index, region.name, region.base, _size_text(region.size)))
+        w("    MPU->RBAR = MPU_REGION(%uU, 0x%08XU);" % (index, region.base))
+        w("    MPU->RASR = MPU_REGION_SIZE(%uU) | MPU_RASR_AP(%s) | %s \\"
+          % (region.log2 - 1, ACCESS[rule.access], " | ".join(attrs[:1])))
+        w("                | %s ;" % " | ".join(attrs[1:] + ["MPU_ATTR_ENABLE "]))
+    for index in range(len(regions), MPU_REGION_NUM):
+        w("")
+        w("    /* Disable Region %u*/" % index)
+        w("    MPU->RBAR = MPU_RBAR_REGION(%uU) | MPU_RBAR_VALID_Msk;" % index)
+        w("    MPU->RASR &= ~MPU_ATTR_ENABLE;")
+    w(FOOTER)
+    return "\n".join(out)
+
+
+def print_plan(regions, stream):
+    stream.write("region  base        size    end         sub-regions  type              access   xn  name\n")
+    for index, region in enumerate(regions):
+        rule = region.rule
+        enabled = "".join("-" if (region.srd >> i) & 1 else "x" for i in range(MPU_SUBREGION_NUM)) \
+            if region.log2 >= MPU_SUBREGION_MIN_LOG2 else "n/a"
+        stream.write("%6u  0x%08X  %-6s  0x%08X  %-11s  %-16s  %-7s  %-2s  %s\n"
+                     % (index, region.base, _size_text(region.size), region.base + region.size, enabled,
+                        rule.memtype, rule.access, "x" if rule.xn else "-", region.name))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Generate the MPU regions of plib_mpu.c from a linker script")
+    parser.add_argument("linker_script", help="linker script (.ld)")
+    parser.add_argument("-m", "--map", help="GNU ld map file of the application, for section rules")
+    parser.add_argument("-r", "--rules", help="rule file (default: built-in SAMRH71 rules)")
+    parser.add_argument("-D", dest="defines", action="append", default=[], metavar="NAME=VALUE",
+                        help="override a macro of the linker script")
+    parser.add_argument("-o", "--output", help="generated plib_mpu.c (default: stdout)")
+    parser.add_argument("-p", "--print", action="store_true", help="print the plan on stderr")
+    args = parser.parse_args(argv)
+
+    try:
+        overrides = {}
+        for d in args.defines:
+            name, _, value = d.partition("=")
+            overrides[name] = value if value else "1"
+        memories = load_linker_script(args.linker_script, overrides)
+        sections = load_map(args.map) if args.map else None
+        if args.rules:
+            with open(args.rules) as f:
+                rules = parse_rules(f.read(), args.rules)
+        else:
+            rules = parse_rules(DEFAULT_RULES, "default")
+        regions = plan(rules, memories, sections)
+        text = generate(regions, args.linker_script.replace("\\", "/").split("/")[-1])
+    except (PlanError, OSError, ValueError, SyntaxError) as err:
+        sys.stderr.write("mpu_planner: error: %s\n" % err)
+        return 1
+
+    if args.print:
+        print_plan(regions, sys.stderr)
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
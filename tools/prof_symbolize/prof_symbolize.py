@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+"""
+Sampling profile symbolizer.
+
+Reads the console log of an application running the sampling profiler
+(app_prof.c), which holds the sample table printed between "PROF BEGIN" and
+"PROF END", and the symbol table of the application ELF file. Prints:
+ - the flat profile: the samples of each function, from the sampled PC,
+ - the call edge profile: the samples of each caller to callee edge, from
+   the sampled LR when it is in another function than the PC.
+
+The per function counts can also be written as a profile for the TCM
+placement planner (tools/tcm_planner).
+
+Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+
+Subject to your compliance with these terms, you may use Microchip software
+and any derivatives exclusively with Microchip products. It is your
+responsibility to comply with third party license terms applicable to your
+use of third party software (including open source software) that may
+accompany Microchip software.
+
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+PARTICULAR PURPOSE.
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+"""
+
+import argparse
+import bisect
+import re
+import shutil
+import subprocess
+import sys
+
+# nm tools tried in this order when --nm is not given
+NM_TOOLS = ["xc32-nm", "arm-none-eabi-nm", "nm"]
+
+# LR values from EXC_RETURN: the sample is in a handler before its first call
+EXC_RETURN_MIN = 0xF0000000
+
+UNKNOWN = "<unknown>"
+EXCEPTION = "<exception entry>"
+
+
+class ProfError(Exception):
+    pass
+
+
+class Dump(object):
+    def __init__(self):
+        self.rate = 0
+        self.samples = 0
+        self.dropped = 0
+        self.pairs = []
+
+
+def load_dump(path):
+    """Return the last complete dump of the log."""
+    dump = None
+    last = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = re.search(r"PROF BEGIN(.*)$", line)
+            if m is not None:
+                dump = Dump()
+                for key, value in re.findall(r"(\w+)=(\d+)", m.group(1)):
+                    if key in ("rate", "samples", "dropped"):
+                        setattr(dump, key, int(value))
+                continue
+            if dump is None:
+                continue
+            if re.search(r"PROF END", line):
+                last = dump
+                dump = None
+                continue
+            m = re.search(r"PROF ([0-9a-fA-F]{1,8}) ([0-9a-fA-F]{1,8}) (\d+)", line)
+            if m is not None:
+                dump.pairs.append((int(m.group(1), 16), int(m.group(2), 16), int(m.group(3))))
+    if last is None:
+        raise ProfError("no complete PROF BEGIN ... PROF END dump in %s" % path)
+    return last
+
+
+def run_nm(elf, tool):
+    tools = [tool] if tool else NM_TOOLS
+    for name in tools:
+        if shutil.which(name) is None:
+            continue
+        result = subprocess.run([name, "-S", "-n", "--defined-only", elf],
+                                stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+        if result.returncode != 0:
+            raise ProfError("%s: %s" % (name, result.stderr.strip()))
+        return result.stdout.splitlines()
+    raise ProfError("no nm tool found (%s), give the symbols with -s" % ", ".join(tools))
+
+
+class Symbols(object):
+    """Functions sorted by address, from 'ADDRESS [SIZE] TYPE NAME' nm lines."""
+
+    def __init__(self, lines):
+        functions = {}
+        for line in lines:
+            m = re.match(r"^([0-9a-fA-F]+)\s+(?:([0-9a-fA-F]+)\s+)?([tTwW])\s+(\S+)", line)
+            if m is None:
+                continue
+            start = int(m.group(1), 16) & ~1
+            size = int(m.group(2), 16) if m.group(2) else 0
+            # Keep one name per address, the sized one
+            if (start not in functions) or (size > functions[start][1]):
+                functions[start] = (m.group(4), size)
+        if not functions:
+            raise ProfError("no function in the symbol table")
+        self.starts = sorted(functions)
+        self.functions = [functions[s] for s in self.starts]
+
+    def lookup(self, address):
+        index = bisect.bisect_right(self.starts, address) - 1
+        if index < 0:
+            return UNKNOWN
+        name, size = self.functions[index]
+        if (size != 0) and (address >= self.starts[index] + size):
+            return UNKNOWN
+        return name
+
+
+def profile(dump, symbols):
+    flat = {}
+    edges = {}
+    for pc, lr, count in dump.pairs:
+        callee = symbols.lookup(pc & ~1)
+        flat[callee] = flat.get(callee, 0) + count
+        if lr >= EXC_RETURN_MIN:
+            caller = EXCEPTION
+        else:
+            # LR is the return address: the call instruction is before it
+            caller = symbols.lookup((lr & ~1) - 2)
+        if caller != callee:
+            edges[(caller, callee)] = edges.get((caller, callee), 0) + count
+    return flat, edges
+
+
+def report(dump, flat, edges, top, stream):
+    total = sum(flat.values())
+    w = stream.write
+    if total == 0:
+        w("No sample\n")
+        return
+    duration = (float(dump.samples) / dump.rate) if dump.rate else 0.0
+    w("Flat profile: %u samples at %u Hz, %.3f s, %u dropped\n\n"
+      % (dump.samples, dump.rate, duration, dump.dropped))
+    w("%9s %7s %7s  %s\n" % ("samples", "%", "cum %", "function"))
+    cumulated = 0
+    for name, count in sorted(flat.items(), key=lambda item: (-item[1], item[0]))[:top]:
+        cumulated += count
+        w("%9u %7.2f %7.2f  %s\n" % (count, 100.0 * count / total, 100.0 * cumulated / total, name))
+
+    w("\nCall edges: %u of the samples have a caller\n\n" % sum(edges.values()))
+    w("%9s %7s  %s\n" % ("samples", "%", "caller -> callee"))
+    for (caller, callee), count in sorted(edges.items(), key=lambda item: (-item[1], item[0]))[:top]:
+        w("%9u %7.2f  %s -> %s\n" % (count, 100.0 * count / total, caller, callee))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Print the flat and call edge profiles of a sampling profiler dump")
+    parser.add_argument("log", help="console log holding the PROF dump")
+    parser.add_argument("elf", nargs="?", help="application ELF file")
+    parser.add_argument("-s", "--symbols", help="output of 'xc32-nm -S' instead of the ELF file")
+    parser.add_argument("--nm", help="nm tool (default: %s)" % ", ".join(NM_TOOLS))
+    parser.add_argument("-n", "--top", type=int, default=30, help="lines of each profile (default: 30)")
+    parser.add_argument("-o", "--output", help="write the 'NAME COUNT' profile of the functions for tcm_planner")
+    args = parser.parse_args(argv)
+
+    try:
+        if args.symbols:
+            with open(args.symbols) as f:
+                symbols = Symbols(f.read().splitlines())
+        elif args.elf:
+            symbols = Symbols(run_nm(args.elf, args.nm))
+        else:
+            raise ProfError("give the ELF file or the symbols with -s")
+        dump = load_dump(args.log)
+        flat, edges = profile(dump, symbols)
+        report(dump, flat, edges, args.top, sys.stdout)
+        if args.output:
+            with open(args.output, "w") as f:
+                for name, count in sorted(flat.items(), key=lambda item: -item[1]):
+                    if not name.startswith("<"):
+                        f.write("%s %u\n" % (name, count))
+    except (ProfError, OSError, ValueError) as err:
+        sys.stderr.write("prof_symbolize: error: %s\n" % err)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
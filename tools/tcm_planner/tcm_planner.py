@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""
+TCM placement planner.
+
+Reads a profile of the application (samples or accesses per function and per
+variable) and its symbol table (xc32-nm -S output), and proposes the code to
+place in ITCM and the data to place in DTCM within the free size of each TCM:
+ - the symbols are ranked by profile count per byte and selected while they
+   fit, the ones that do not fit are skipped so smaller ones still can,
+ - for the SPW and IP1553 drivers, the project macro (SPW_TCM, IP1553_TCM)
+   that places their interrupt fast path is proposed when the profile shows
+   it, and VECTORS_IN_ITCM when interrupt handlers are hot,
+ - the other functions are listed to be marked with TCM_CODE and the other
+   variables with TCM_DATA.
+
+Copyright (C) 2024 Microchip Technology Inc. and its subsidiaries.
+
+Subject to your compliance with these terms, you may use Microchip software
+and any derivatives exclusively with Microchip products. It is your
+responsibility to comply with third party license terms applicable to your
+use of third party software (including open source software) that may
+accompany Microchip software.
+
+THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+PARTICULAR PURPOSE.
+
+IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+"""
+
+import argparse
+import re
+import sys
+
+# SAMRH71 tightly coupled memories
+ITCM_ADDR, ITCM_SIZE = 0x00000000, 0x20000
+DTCM_ADDR, DTCM_SIZE = 0x20000000, 0x40000
+
+# Drivers placing their interrupt fast path with a project macro, and the
+# symbols of this fast path
+DRIVERS = [
+    ("SPW_TCM", re.compile(r"^(SPW_InterruptHandler|SPW_(PKTRX|PKTTX|LINK|TCH)_\w+|spwObj|APP_SPW_Callback)$")),
+    ("IP1553_TCM", re.compile(r"^(IP1553_InterruptHandler|IP1553_(Get|Reset)\w*|IP1553_IrqStatusGet|ip1553Obj|APP_IP1553_Callback)$")),
+]
+
+# Interrupt handlers, hot ones make the vector fetch worth placing in ITCM
+HANDLER = re.compile(r"(_Handler|_InterruptHandler)$")
+
+
+class PlanError(Exception):
+    pass
+
+
+class Symbol(object):
+    def __init__(self, name, address, size, code):
+        self.name = name
+        self.address = address
+        self.size = size
+        self.code = code
+        self.count = 0
+
+    @property
+    def in_tcm(self):
+        if self.code:
+            return ITCM_ADDR <= self.address < ITCM_ADDR + ITCM_SIZE
+        return DTCM_ADDR <= self.address < DTCM_ADDR + DTCM_SIZE
+
+
+def load_symbols(path):
+    """Read 'ADDRESS SIZE TYPE NAME' lines of nm -S."""
+    symbols = {}
+    with open(path) as f:
+        for line in f:
+            m = re.match(r"^([0-9a-fA-F]+)\s+([0-9a-fA-F]+)\s+([tTdDbBrR])\s+(\S+)", line)
+            if m is None:
+                continue
+            size = int(m.group(2), 16)
+            if size == 0:
+                continue
+            code = m.group(3) in "tT"
+            address = int(m.group(1), 16) & ~1
+            symbols[m.group(4)] = Symbol(m.group(4), address, size, code)
+    if not symbols:
+        raise PlanError("no sized symbol in %s, use the output of 'xc32-nm -S'" % path)
+    return symbols
+
+
+def load_profile(path, symbols):
+    """Read 'NAME COUNT' or 'ADDRESS COUNT' lines, addresses are symbolized."""
+    ranges = sorted((s.address, s.address + s.size, s) for s in symbols.values())
+    unknown = 0
+    with open(path) as f:
+        for num, raw in enumerate(f, 1):
+            line = raw.split("#", 1)[0].replace(",", " ").split()
+            if not line:
+                continue
+            if len(line) < 2:
+                raise PlanError("%s:%d: expected 'NAME COUNT'" % (path, num))
+            key, count = line[0], int(line[1], 0)
+            symbol = symbols.get(key)
+            if (symbol is None) and re.match(r"^(0[xX])?[0-9a-fA-F]+$", key):
+                address = int(key, 16) & ~1
+                for start, end, s in ranges:
+                    if start <= address < end:
+                        symbol = s
+                        break
+            if symbol is None:
+                unknown += count
+                continue
+            symbol.count += count
+    return unknown
+
+
+def select(candidates, budget):
+    """Select the symbols with the most counts per byte that fit in budget."""
+    chosen = []
+    for s in sorted(candidates, key=lambda s: (-float(s.count) / s.size, s.size)):
+        if s.size <= budget:
+            chosen.append(s)
+            budget -= s.size
+    return chosen, budget
+
+
+def report(symbols, itcm_free, dtcm_free, min_share, stream):
+    hot = [s for s in symbols.values() if s.count > 0]
+    total = sum(s.count for s in hot)
+    if total == 0:
+        raise PlanError("the profile has no count on a known symbol")
+    hot = [s for s in hot if (100.0 * s.count / total) >= min_share]
+
+    code, itcm_left = select([s for s in hot if s.code and not s.in_tcm], itcm_free)
+    data, dtcm_left = select([s for s in hot if not s.code and not s.in_tcm], dtcm_free)
+
+    w = stream.write
+    for title, chosen, free, left in (("ITCM", code, itcm_free, itcm_left), ("DTCM", data, dtcm_free, dtcm_left)):
+        share = sum(s.count for s in chosen)
+        w("%s: %u symbols, %u of %u bytes, %.1f%% of the profile\n"
+          % (title, len(chosen), free - left, free, 100.0 * share / total))
+        for s in chosen:
+            w("  %-40s %6u bytes %8u counts %6.2f%%\n" % (s.name, s.size, s.count, 100.0 * s.count / total))
+    already = [s for s in hot if s.in_tcm]
+    if already:
+        w("Already in TCM: %s\n" % " ".join(s.name for s in already))
+    skipped = [s for s in hot if not s.in_tcm and s not in code and s not in data]
+    if skipped:
+        w("Not placed, no room left: %s\n" % " ".join(s.name for s in skipped))
+
+    chosen = code + data
+    macros = []
+    for macro, pattern in DRIVERS:
+        if any(pattern.match(s.name) for s in chosen):
+            macros.append(macro)
+    if any(HANDLER.search(s.name) for s in code):
+        macros.append("VECTORS_IN_ITCM")
+    w("\nProject macros: %s\n" % (" ".join(macros) if macros else "none"))
+
+    def placed_by_macro(s):
+        return any(pattern.match(s.name) and macro in macros for macro, pattern in DRIVERS)
+
+    others = [s for s in code if not placed_by_macro(s)]
+    if others:
+        w("Mark with TCM_CODE: %s\n" % " ".join(s.name for s in others))
+    others = [s for s in data if not placed_by_macro(s)]
+    if others:
+        w("Mark with TCM_DATA: %s\n" % " ".join(s.name for s in others))
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Propose the code and data to place in the TCM from a profile")
+    parser.add_argument("profile", help="profile, 'NAME COUNT' or 'ADDRESS COUNT' lines")
+    parser.add_argument("-s", "--symbols", required=True, help="output of 'xc32-nm -S' on the application ELF file")
+    parser.add_argument("-i", "--itcm", type=lambda v: int(v, 0), default=ITCM_SIZE,
+                        help="free ITCM size in bytes (default: 0x%x)" % ITCM_SIZE)
+    parser.add_argument("-d", "--dtcm", type=lambda v: int(v, 0), default=DTCM_SIZE,
+                        help="free DTCM size in bytes (default: 0x%x)" % DTCM_SIZE)
+    parser.add_argument("-m", "--min-share", type=float, default=0.1,
+                        help="ignore the symbols below this share of the profile in percent (default: 0.1)")
+    args = parser.parse_args(argv)
+
+    try:
+        symbols = load_symbols(args.symbols)
+        unknown = load_profile(args.profile, symbols)
+        if unknown != 0:
+            sys.stderr.write("tcm_planner: warning: %u counts out of the known symbols\n" % unknown)
+        report(symbols, args.itcm, args.dtcm, args.min_share, sys.stdout)
+    except (PlanError, OSError, ValueError) as err:
+        sys.stderr.write("tcm_planner: error: %s\n" % err)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())